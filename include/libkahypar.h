@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#ifndef LIBKAHYPAR_H
+#define LIBKAHYPAR_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef KAHYPAR_API
+#   if __GNUC__ >= 4
+#       define KAHYPAR_API __attribute__ ((visibility("default")))
+#   else
+#       define KAHYPAR_API
+#   endif
+#endif
+
+typedef unsigned int kahypar_hypernode_id_t;
+typedef unsigned int kahypar_hyperedge_id_t;
+typedef unsigned int kahypar_hypernode_weight_t;
+typedef int kahypar_hyperedge_weight_t;
+typedef int kahypar_partition_id_t;
+
+typedef enum {
+  KAHYPAR_OK = 0,
+  KAHYPAR_INVALID_CONTEXT,
+  KAHYPAR_INVALID_HYPERGRAPH,
+  KAHYPAR_INVALID_ARGUMENT
+} kahypar_status_t;
+
+/* Opaque partitioning configuration. A context is not modified by
+ * kahypar_partition and can be reused for any number of calls. */
+struct kahypar_context_s;
+typedef struct kahypar_context_s kahypar_context_t;
+
+/* Creates an unconfigured context. Console output is disabled by default. */
+KAHYPAR_API kahypar_context_t* kahypar_context_new(void);
+KAHYPAR_API void kahypar_context_free(kahypar_context_t* kahypar_context);
+
+/* Reads the configuration from an .ini preset (see the config directory). */
+KAHYPAR_API kahypar_status_t kahypar_configure_context_from_file(kahypar_context_t* kahypar_context,
+                                                                 const char* ini_file_name);
+
+KAHYPAR_API void kahypar_set_seed(kahypar_context_t* kahypar_context, int seed);
+KAHYPAR_API void kahypar_set_quiet(kahypar_context_t* kahypar_context, int quiet);
+
+/* Limits the wall-clock time of each kahypar_partition call to the given
+ * number of seconds (0 = no limit, the default). Once the time is spent,
+ * the call finishes as fast as possible with the best partition found so far. */
+KAHYPAR_API void kahypar_set_time_limit(kahypar_context_t* kahypar_context, double seconds);
+
+/* Cancellation hook: The callback is polled by the thread that runs
+ * kahypar_partition. As soon as it returns a non-zero value, the call stops
+ * as if the time limit was reached. Passing NULL removes the callback. */
+typedef int (*kahypar_cancel_callback_t)(void* data);
+KAHYPAR_API void kahypar_set_cancel_callback(kahypar_context_t* kahypar_context,
+                                             kahypar_cancel_callback_t callback, void* data);
+
+typedef enum {
+  KAHYPAR_PHASE_PREPROCESSING = 0,
+  KAHYPAR_PHASE_COARSENING,
+  KAHYPAR_PHASE_INITIAL_PARTITIONING,
+  KAHYPAR_PHASE_UNCOARSENING,
+  KAHYPAR_PHASE_V_CYCLE,
+  KAHYPAR_PHASE_FINISHED
+} kahypar_phase_t;
+
+/* Snapshot of a running kahypar_partition call. cut, km1 and imbalance
+ * refer to the current partition and are 0 as long as none exists. */
+typedef struct {
+  kahypar_phase_t phase;
+  unsigned int v_cycle;
+  kahypar_hypernode_id_t num_vertices;
+  kahypar_hyperedge_weight_t cut;
+  kahypar_hyperedge_weight_t km1;
+  double imbalance;
+  double elapsed_seconds;
+} kahypar_progress_t;
+
+/* Progress hook: The callback is called by the thread that runs
+ * kahypar_partition at the end of each phase and, at most every interval
+ * seconds, during coarsening and uncoarsening. In recursive bisection mode,
+ * only preprocessing and the final result are reported. Passing NULL
+ * removes the callback. */
+typedef void (*kahypar_progress_callback_t)(const kahypar_progress_t* progress, void* data);
+KAHYPAR_API void kahypar_set_progress_callback(kahypar_context_t* kahypar_context,
+                                               kahypar_progress_callback_t callback,
+                                               double interval, void* data);
+
+/* Partitions the hypergraph into num_blocks blocks of weight at most
+ * (1 + epsilon) * ceil(total weight / num_blocks).
+ *
+ * The pins of hyperedge e are hyperedges[hyperedge_indices[e]] to
+ * hyperedges[hyperedge_indices[e + 1] - 1] (0-based). The weight arrays
+ * may be NULL for unit weights. On success, partition[v] contains the
+ * block of vertex v and objective the value of the configured objective
+ * (cut or connectivity - 1). */
+KAHYPAR_API kahypar_status_t kahypar_partition(const kahypar_hypernode_id_t num_vertices,
+                                               const kahypar_hyperedge_id_t num_hyperedges,
+                                               const double epsilon,
+                                               const kahypar_partition_id_t num_blocks,
+                                               const kahypar_hypernode_weight_t* vertex_weights,
+                                               const kahypar_hyperedge_weight_t* hyperedge_weights,
+                                               const size_t* hyperedge_indices,
+                                               const kahypar_hyperedge_id_t* hyperedges,
+                                               kahypar_hyperedge_weight_t* objective,
+                                               const kahypar_context_t* kahypar_context,
+                                               kahypar_partition_id_t* partition);
+
+/* Updates a partition after an edit of the hypergraph, e.g., between two
+ * design iterations, instead of partitioning from scratch. The arrays
+ * describe the edited hypergraph as in kahypar_partition; removed vertices
+ * are not part of it, i.e., the caller renumbers the remaining ones.
+ *
+ * On input, partition[v] is the block of v in the previous partition or -1
+ * for an added vertex. changed_vertices lists the vertices whose weight
+ * changed and the pins of added, removed or modified hyperedges. Added
+ * vertices are assigned to the block they are most strongly connected to,
+ * then local search starts at the added and changed vertices, so the running
+ * time of the search depends on the size of the edit rather than on the size
+ * of the hypergraph. Only direct k-way presets are supported. */
+KAHYPAR_API kahypar_status_t kahypar_repartition(const kahypar_hypernode_id_t num_vertices,
+                                                 const kahypar_hyperedge_id_t num_hyperedges,
+                                                 const double epsilon,
+                                                 const kahypar_partition_id_t num_blocks,
+                                                 const kahypar_hypernode_weight_t* vertex_weights,
+                                                 const kahypar_hyperedge_weight_t* hyperedge_weights,
+                                                 const size_t* hyperedge_indices,
+                                                 const kahypar_hyperedge_id_t* hyperedges,
+                                                 const size_t num_changed_vertices,
+                                                 const kahypar_hypernode_id_t* changed_vertices,
+                                                 kahypar_hyperedge_weight_t* objective,
+                                                 const kahypar_context_t* kahypar_context,
+                                                 kahypar_partition_id_t* partition);
+
+/* Drop-in replacements for the hMetis 1.5 library interface. Both minimize
+ * the cut using the presets shipped with KaHyPar (recursive bisection and
+ * direct k-way, respectively). If options[0] != 0, options[7] is used as
+ * seed. Fixed vertices (options[6]) are not supported
+ * and lead to edgecut = -1. All other options are ignored.
+ *
+ * As in hMetis, ubfactor bounds the imbalance of each bisection in
+ * HMETIS_PartRecursive, i.e. a block of a bisection may have at most
+ * (50 + ubfactor)% of the weight. In HMETIS_PartKway, each block may be
+ * ubfactor% heavier than the average block weight. */
+KAHYPAR_API void HMETIS_PartRecursive(int nvtxs, int nhedges, int* vwgts, int* eptr, int* eind,
+                                      int* hewgts, int nparts, int ubfactor, int* options,
+                                      int* part, int* edgecut);
+KAHYPAR_API void HMETIS_PartKway(int nvtxs, int nhedges, int* vwgts, int* eptr, int* eind,
+                                 int* hewgts, int nparts, int ubfactor, int* options,
+                                 int* part, int* edgecut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* LIBKAHYPAR_H */
@@ -29,8 +29,13 @@
 #include <sys/ioctl.h>
 #endif
 
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <iostream>
 #include <limits>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "kahypar/kahypar.h"
@@ -79,7 +84,42 @@ po::options_description createGeneralOptionsDescription(Context& context, const
     "Hyperedges larger than cmaxnet are ignored during partitioning process.")
     ("vcycles",
     po::value<uint32_t>(&context.partition.global_search_iterations)->value_name("<uint32_t>"),
-    "# V-cycle iterations for direct k-way partitioning");
+    "# V-cycle iterations for direct k-way partitioning")
+    ("input-format",
+    po::value<std::string>()->value_name("<string>")->notifier(
+      [&](const std::string& format) {
+      context.partition.input_format = kahypar::inputFormatFromString(format);
+    }),
+    "Format of the hypergraph file: \n"
+    " - auto:           detect format (default)\n"
+    " - hmetis:         hMetis format\n"
+    " - patoh:          PaToH format\n"
+    " - mtx-row-net:    MatrixMarket, rows are hyperedges\n"
+    " - mtx-column-net: MatrixMarket, columns are hyperedges\n"
+    " - edgelist:       0-based edge list 'u v [weight]'")
+    ("binary-partition",
+    po::value<bool>(&context.partition.binary_partition_output)->value_name("<bool>"),
+    "Write the partition file in compact binary format \n"
+    "(default: false)")
+    ("input-partition",
+    po::value<std::string>(&context.partition.input_partition_filename)->value_name("<string>"),
+    "Improve the partition in this file (e.g. of a previous design iteration) with V-cycles "
+    "instead of partitioning from scratch. Only hypernodes of the same block are contracted, "
+    "so hypernodes only move if this improves the objective. Direct k-way mode only.")
+    ("time-limit",
+    po::value<double>(&context.partition.time_limit)->value_name("<double>"),
+    "Wall-clock time limit in seconds. Coarsening, initial partitioning and V-cycles stop "
+    "early and refinement gets cheaper to meet it. The best partition found so far is "
+    "returned. \n"
+    "(default: 0 = no limit)")
+    ("memory-limit",
+    po::value<size_t>(&context.partition.memory_limit)->value_name("<size_t>"),
+    "Memory limit in MB. If the estimated memory footprint exceeds it, the min-hash "
+    "sparsifier and community detection are disabled and, for the cut objective, k-way FM "
+    "is replaced by label propagation. For km1, only the sparsifier and community detection "
+    "can be shed: the n*k gain cache and the k priority queues of the km1 refiner have no "
+    "lean variant. Stops with an error if it still does not fit. \n"
+    "(default: 0 = no limit)");
   return options;
 }
 
@@ -140,7 +180,12 @@ po::options_description createCoarseningOptionsDescription(Context& context,
     }),
     "Acceptance/Tiebreaking criterion for contraction partners having the same score:\n"
     "random "
-    "prefer_unmatched");
+    "prefer_unmatched")
+    ("c-hierarchy-file",
+    po::value<std::string>(&context.coarsening.hierarchy_file)->value_name("<string>"),
+    "Store the coarsening hierarchy in this file and reuse it in later runs with the same\n"
+    "hypergraph and coarsening parameters (direct k-way mode only). Runs with a different\n"
+    "contraction limit continue coarsening from the stored hierarchy.");
   return options;
 }
 
@@ -372,6 +417,30 @@ po::options_description createRefinementOptionsDescription(Context& context,
 }
 
 
+std::string defaultPartitionFilename(const Context& context) {
+  std::string epsilon_str = std::to_string(context.partition.epsilon);
+  epsilon_str.erase(epsilon_str.find_last_not_of('0') + 1, std::string::npos);
+
+  return context.partition.graph_filename
+         + ".part"
+         + std::to_string(context.partition.k)
+         + ".epsilon"
+         + epsilon_str
+         + ".seed"
+         + std::to_string(context.partition.seed)
+         + ".KaHyPar";
+}
+
+// The notifiers throw std::invalid_argument for illegal option values.
+static inline void notifyOrExit(po::variables_map& vm) {
+  try {
+    po::notify(vm);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    std::exit(-1);
+  }
+}
+
 void processCommandLineInput(Context& context, int argc, char* argv[]) {
   const int num_columns = platform::getTerminalWidth();
 
@@ -394,22 +463,50 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
     po::value<std::string>(&context.partition.graph_filename)->value_name("<string>")->required(),
     "Hypergraph filename")
     ("blocks,k",
-    po::value<PartitionID>(&context.partition.k)->value_name("<int>")->required()->notifier(
+    po::value<PartitionID>(&context.partition.k)->value_name("<int>")->notifier(
       [&](const PartitionID) {
       context.partition.rb_lower_k = 0;
       context.partition.rb_upper_k = 0;
     }),
     "Number of blocks")
+    ("k-sweep",
+    po::value<std::string>()->value_name("<string>")->notifier(
+      [&](const std::string& list) {
+      std::istringstream values(list);
+      std::string value;
+      while (std::getline(values, value, ',')) {
+        // std::stoi also accepts trailing characters such as in "4x", so the
+        // whole value has to be consumed.
+        size_t num_consumed = 0;
+        PartitionID k = 0;
+        try {
+          k = std::stoi(value, &num_consumed);
+        } catch (const std::exception&) {
+          num_consumed = 0;
+        }
+        if (num_consumed == 0 || num_consumed != value.size() || k < 2) {
+          throw std::invalid_argument("Invalid k in --k-sweep: " + value);
+        }
+        context.partition.k_sweep.push_back(k);
+      }
+      if (context.partition.k_sweep.empty()) {
+        throw std::invalid_argument("--k-sweep requires at least one k");
+      }
+      context.partition.k = *std::max_element(context.partition.k_sweep.begin(),
+                                              context.partition.k_sweep.end());
+      context.partition.rb_lower_k = 0;
+      context.partition.rb_upper_k = 0;
+    }),
+    "Instead of -k: comma-separated list of block numbers. The hypergraph is partitioned "
+    "for each of them (one partition file per k). In direct k-way mode, all runs share one "
+    "coarsening hierarchy.")
     ("epsilon,e",
     po::value<double>(&context.partition.epsilon)->value_name("<double>")->required(),
     "Imbalance parameter epsilon")
     ("objective,o",
-    po::value<std::string>()->value_name("<string>")->required()->notifier([&](const std::string& s) {
-      if (s == "cut") {
-        context.partition.objective = Objective::cut;
-      } else if (s == "km1") {
-        context.partition.objective = Objective::km1;
-      }
+    po::value<std::string>()->value_name("<string>")->required()->notifier(
+      [&](const std::string& s) {
+      context.partition.objective = kahypar::objectiveFromString(s);
     }),
     "Objective: \n"
     " - cut : cut-net metric \n"
@@ -470,7 +567,11 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
     exit(0);
   }
 
-  po::notify(cmd_vm);
+  notifyOrExit(cmd_vm);
+  if (cmd_vm.count("blocks") == 0 && context.partition.k_sweep.empty()) {
+    std::cerr << "Either --blocks or --k-sweep is required." << std::endl;
+    std::exit(-1);
+  }
 
   std::ifstream file(context_path.c_str());
   if (!file) {
@@ -486,41 +587,51 @@ void processCommandLineInput(Context& context, int argc, char* argv[]) {
   .add(refinement_options);
 
   po::store(po::parse_config_file(file, ini_line_options, true), cmd_vm);
-  po::notify(cmd_vm);
-
+  notifyOrExit(cmd_vm);
 
-  std::string epsilon_str = std::to_string(context.partition.epsilon);
-  epsilon_str.erase(epsilon_str.find_last_not_of('0') + 1, std::string::npos);
 
-  context.partition.graph_partition_filename =
-    context.partition.graph_filename
-    + ".part"
-    + std::to_string(context.partition.k)
-    + ".epsilon"
-    + epsilon_str
-    + ".seed"
-    + std::to_string(context.partition.seed)
-    + ".KaHyPar";
+  context.partition.graph_partition_filename = defaultPartitionFilename(context);
 }
 
 
-void parseIniToContext(Context& context, const std::string& ini_filename) {
-  std::ifstream file(ini_filename.c_str());
-  if (!file) {
-    std::cerr << "Could not load context file at: " << ini_filename << std::endl;
-    std::exit(-1);
-  }
+// In contrast to processCommandLineInput, partitioning mode and objective
+// are also read from the ini file, since there is no command line. Illegal
+// option values raise std::invalid_argument.
+void parseIniToContext(Context& context, std::istream& ini) {
   const int num_columns = 80;
 
+  po::options_description partitioning_options("Partitioning Options", num_columns);
+  partitioning_options.add_options()
+    ("objective",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+      context.partition.objective = kahypar::objectiveFromString(s);
+    }),
+    "Objective")
+    ("mode",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& mode) {
+      context.partition.mode = kahypar::modeFromString(mode);
+    }),
+    "Partitioning mode");
+
   po::variables_map cmd_vm;
   po::options_description ini_line_options;
-  ini_line_options.add(createGeneralOptionsDescription(context, num_columns))
+  ini_line_options.add(partitioning_options)
+  .add(createGeneralOptionsDescription(context, num_columns))
   .add(createPreprocessingOptionsDescription(context, num_columns))
   .add(createCoarseningOptionsDescription(context, num_columns))
   .add(createInitialPartitioningOptionsDescription(context, num_columns))
   .add(createRefinementOptionsDescription(context, num_columns));
 
-  po::store(po::parse_config_file(file, ini_line_options, true), cmd_vm);
+  po::store(po::parse_config_file(ini, ini_line_options, true), cmd_vm);
   po::notify(cmd_vm);
 }
+
+void parseIniToContext(Context& context, const std::string& ini_filename) {
+  std::ifstream file(ini_filename.c_str());
+  if (!file) {
+    std::cerr << "Could not load context file at: " << ini_filename << std::endl;
+    std::exit(-1);
+  }
+  parseIniToContext(context, file);
+}
 }  // namespace kahypar
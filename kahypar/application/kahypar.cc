@@ -18,10 +18,13 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "kahypar/application/command_line_options.h"
 #include "kahypar/definitions.h"
@@ -30,6 +33,9 @@
 #include "kahypar/io/sql_plottools_serializer.h"
 #include "kahypar/kahypar.h"
 #include "kahypar/macros.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
+#include "kahypar/partition/memory_limit.h"
+#include "kahypar/partition/partitioner_session.h"
 #include "kahypar/utils/math.h"
 #include "kahypar/utils/randomize.h"
 
@@ -37,6 +43,129 @@ using kahypar::HighResClockTimepoint;
 using kahypar::Partitioner;
 using kahypar::Context;
 
+static void printAndWriteResults(const kahypar::Hypergraph& hypergraph, const Context& context,
+                                 const std::chrono::duration<double>& elapsed_seconds) {
+  if (!context.partition.quiet_mode) {
+    kahypar::io::printPartitioningResults(hypergraph, context, elapsed_seconds);
+    LOG << "";
+  }
+  kahypar::io::writePartitionFile(hypergraph,
+                                  context.partition.graph_partition_filename,
+                                  context.partition.binary_partition_output);
+
+  if (context.partition.sp_process_output) {
+    kahypar::io::serializer::serialize(context, hypergraph, elapsed_seconds);
+  }
+}
+
+// Assigns the hypernodes to the blocks given in the input partition file.
+static void applyInputPartition(kahypar::Hypergraph& hypergraph, const Context& context) {
+  const kahypar::io::IOStatus status = kahypar::io::applyPartitionFile(
+    context.partition.input_partition_filename, hypergraph);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    std::exit(1);
+  }
+}
+
+// Selects leaner data structures until the estimated memory footprint fits
+// into the memory limit or stops if this is impossible.
+static void applyMemoryLimit(const kahypar::HypernodeID num_hypernodes,
+                             const kahypar::HyperedgeID num_hyperedges,
+                             const size_t num_pins, const bool sparsify, Context& context) {
+  if (context.partition.memory_limit == 0) {
+    return;
+  }
+  kahypar::MemoryEstimate estimate;
+  if (!kahypar::memory::fitIntoMemoryLimit(num_hypernodes, num_hyperedges, num_pins, sparsify,
+                                           context, estimate)) {
+    std::cerr << "Error: the estimated memory footprint of "
+              << kahypar::memory::inMB(estimate.total()) << " ("
+              << kahypar::memory::describe(estimate) << ") exceeds the memory limit of "
+              << context.partition.memory_limit << " MB even with the leanest configuration"
+              << std::endl;
+    std::exit(1);
+  }
+}
+
+// The input hypergraph as raw arrays, which are available before the memory
+// limit is applied. Binary hypergraphs are used directly from the mapped
+// file, including their precomputed incident nets. Otherwise, the view points
+// into the parsed arrays.
+struct InputHypergraph {
+  kahypar::io::MemoryMappedFile binary_file { };
+  kahypar::io::BinaryHypergraphView view { };
+  kahypar::HyperedgeIndexVector index_vector { };
+  kahypar::HyperedgeVector edge_vector { };
+  kahypar::HyperedgeWeightVector hyperedge_weights { };
+  kahypar::HypernodeWeightVector hypernode_weights { };
+};
+
+static void loadInputHypergraph(const Context& context, InputHypergraph& input) {
+  kahypar::io::BinaryHypergraphView& view = input.view;
+  kahypar::io::IOStatus status;
+  if (kahypar::io::isBinaryHypergraphFile(context.partition.graph_filename)) {
+    status = kahypar::io::mapBinaryHypergraphFile(context.partition.graph_filename,
+                                                  input.binary_file, view);
+  } else {
+    status = kahypar::io::parseInputFile(
+      context.partition.graph_filename, context.partition.input_format, view.num_hypernodes,
+      view.num_hyperedges, input.index_vector, input.edge_vector, &input.hyperedge_weights,
+      &input.hypernode_weights, std::thread::hardware_concurrency());
+    view.num_pins = input.edge_vector.size();
+    view.hyperedge_offsets = input.index_vector.data();
+    view.pins = input.edge_vector.data();
+    view.hyperedge_weights = input.hyperedge_weights.empty() ?
+                             nullptr : input.hyperedge_weights.data();
+    view.hypernode_weights = input.hypernode_weights.empty() ?
+                             nullptr : input.hypernode_weights.data();
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    std::exit(1);
+  }
+}
+
+// Partitions the hypergraph for each k of the sweep. A larger k stops
+// coarsening earlier and only allows lighter nodes, so the runs are done in
+// order of decreasing k: each run replays the complete coarsening hierarchy
+// of the previous one and only coarsens the remaining levels itself.
+static void partitionSweep(const Context& sweep_context) {
+  InputHypergraph input;
+  loadInputHypergraph(sweep_context, input);
+  const kahypar::io::BinaryHypergraphView& view = input.view;
+
+  std::vector<kahypar::PartitionID> ks(sweep_context.partition.k_sweep);
+  std::sort(ks.begin(), ks.end(), std::greater<kahypar::PartitionID>());
+  ks.erase(std::unique(ks.begin(), ks.end()), ks.end());
+
+  // The largest k needs the most memory, so its configuration fits all runs.
+  Context limited_context(sweep_context);
+  limited_context.partition.k = ks.front();
+  applyMemoryLimit(view.num_hypernodes, view.num_hyperedges, view.num_pins,
+                   kahypar::memory::sparsifierIsActive(view.hyperedge_offsets,
+                                                       view.num_hyperedges, limited_context),
+                   limited_context);
+
+  kahypar::PartitionerSession session;
+  kahypar::CoarseningHierarchy hierarchy;
+  for (const kahypar::PartitionID k : ks) {
+    Context context(limited_context);
+    context.partition.k = k;
+    context.partition.graph_partition_filename = kahypar::defaultPartitionFilename(context);
+
+    const kahypar::Hypergraph& hypergraph = session.setHypergraph(
+      view.num_hypernodes, view.num_hyperedges, view.hyperedge_offsets, view.pins, k,
+      view.hyperedge_weights, view.hypernode_weights, view.hypernode_offsets,
+      view.incident_nets);
+
+    const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    session.partition(context, hierarchy);
+    const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    printAndWriteResults(hypergraph, context, end - start);
+  }
+}
+
 int main(int argc, char* argv[]) {
   Context context;
 
@@ -53,15 +182,49 @@ int main(int argc, char* argv[]) {
     std::exit(-1);
   }
 
+  if (!context.partition.input_partition_filename.empty() &&
+      (context.partition.mode != kahypar::Mode::direct_kway ||
+       !context.partition.k_sweep.empty())) {
+    std::cerr << "An input partition can only be improved in direct k-way mode "
+              << "and not in combination with --k-sweep." << std::endl;
+    std::exit(-1);
+  }
+
+  if (!context.partition.k_sweep.empty()) {
+    partitionSweep(context);
+    return 0;
+  }
+
   kahypar::Randomize::instance().setSeed(context.partition.seed);
 
-  kahypar::Hypergraph hypergraph(
-    kahypar::io::createHypergraphFromFile(context.partition.graph_filename,
-                                          context.partition.k));
+  // The memory limit is applied before the hypergraph allocates its k-dependent
+  // data structures.
+  kahypar::Hypergraph hypergraph;
+  {
+    InputHypergraph input;
+    loadInputHypergraph(context, input);
+    const kahypar::io::BinaryHypergraphView& view = input.view;
+    applyMemoryLimit(view.num_hypernodes, view.num_hyperedges, view.num_pins,
+                     kahypar::memory::sparsifierIsActive(view.hyperedge_offsets,
+                                                         view.num_hyperedges, context),
+                     context);
+    hypergraph.initialize(view.num_hypernodes, view.num_hyperedges, view.num_pins,
+                          view.hyperedge_offsets, view.pins, context.partition.k,
+                          view.hyperedge_weights, view.hypernode_weights,
+                          view.hypernode_offsets, view.incident_nets);
+  }
+
+  if (!context.partition.input_partition_filename.empty()) {
+    applyInputPartition(hypergraph, context);
+  }
 
   Partitioner partitioner;
   const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
-  partitioner.partition(hypergraph, context);
+  if (context.partition.input_partition_filename.empty()) {
+    partitioner.partition(hypergraph, context);
+  } else {
+    partitioner.improve(hypergraph, context);
+  }
   const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
   std::chrono::duration<double> elapsed_seconds = end - start;
 
@@ -72,16 +235,6 @@ int main(int argc, char* argv[]) {
   kahypar::io::printPartitioningStatistics();
 #endif
 
-  if (!context.partition.quiet_mode) {
-    kahypar::io::printPartitioningResults(hypergraph, context, elapsed_seconds);
-    LOG << "";
-  }
-  kahypar::io::writePartitionFile(hypergraph,
-                                  context.partition.graph_partition_filename);
-
-  if (context.partition.sp_process_output) {
-    kahypar::io::serializer::serialize(context, hypergraph, elapsed_seconds);
-  }
-
+  printAndWriteResults(hypergraph, context, elapsed_seconds);
   return 0;
 }
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kahypar/application/command_line_options.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/batch_manifest.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/io/sql_plottools_serializer.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/memory_limit.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/partitioner_session.h"
+
+namespace po = boost::program_options;
+
+using kahypar::Context;
+using kahypar::HighResClockTimepoint;
+using kahypar::Hypergraph;
+using kahypar::HyperedgeID;
+using kahypar::HypernodeID;
+using kahypar::PartitionID;
+using kahypar::PartitionerSession;
+using kahypar::io::BatchJob;
+using kahypar::io::IOStatus;
+
+// A hypergraph of the manifest. It is read once and only read by the jobs,
+// which build their own hypergraph from it. Binary hypergraphs stay mapped
+// and are used directly, including their precomputed incident nets. For the
+// other formats, the view points into the parsed arrays.
+struct SharedHypergraph {
+  kahypar::io::MemoryMappedFile binary_file { };
+  kahypar::io::BinaryHypergraphView view { };
+  kahypar::HyperedgeIndexVector index_vector { };
+  kahypar::HyperedgeVector edge_vector { };
+  kahypar::HyperedgeWeightVector hyperedge_weights { };
+  kahypar::HypernodeWeightVector hypernode_weights { };
+};
+
+static inline IOStatus loadSharedHypergraph(const std::string& filename,
+                                            const size_t num_threads,
+                                            SharedHypergraph& shared) {
+  if (kahypar::io::isBinaryHypergraphFile(filename)) {
+    return kahypar::io::mapBinaryHypergraphFile(filename, shared.binary_file, shared.view);
+  }
+  const IOStatus status = kahypar::io::parseInputFile(
+    filename, kahypar::InputFormat::automatic, shared.view.num_hypernodes,
+    shared.view.num_hyperedges, shared.index_vector, shared.edge_vector,
+    &shared.hyperedge_weights, &shared.hypernode_weights, num_threads);
+  shared.view.num_pins = shared.edge_vector.size();
+  shared.view.hyperedge_offsets = shared.index_vector.data();
+  shared.view.pins = shared.edge_vector.data();
+  shared.view.hyperedge_weights = shared.hyperedge_weights.empty() ?
+                                  nullptr : shared.hyperedge_weights.data();
+  shared.view.hypernode_weights = shared.hypernode_weights.empty() ?
+                                  nullptr : shared.hypernode_weights.data();
+  return status;
+}
+
+struct PreparedJob {
+  const SharedHypergraph* hypergraph;
+  Context context;
+  size_t estimated_memory;
+};
+
+// Estimated peak memory needed to partition a hypergraph with the
+// configuration of the job (see memory_limit.h).
+static inline size_t estimatedMemory(const SharedHypergraph& hypergraph, const Context& context) {
+  const kahypar::io::BinaryHypergraphView& view = hypergraph.view;
+  return kahypar::memory::estimate(
+    view.num_hypernodes, view.num_hyperedges, view.num_pins,
+    kahypar::memory::sparsifierIsActive(view.hyperedge_offsets, view.num_hyperedges, context),
+    context).total();
+}
+
+static inline void runJob(const PreparedJob& job, const bool sp_process_output,
+                          std::mutex& output_mutex) {
+  const kahypar::io::BinaryHypergraphView& view = job.hypergraph->view;
+  Context context(job.context);
+
+  // Consecutive jobs of a worker reuse the hypergraph memory of its session.
+  PartitionerSession& session = PartitionerSession::local();
+  const Hypergraph& hypergraph = session.setHypergraph(
+    view.num_hypernodes, view.num_hyperedges, view.hyperedge_offsets, view.pins,
+    context.partition.k, view.hyperedge_weights, view.hypernode_weights,
+    view.hypernode_offsets, view.incident_nets);
+
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  session.partition(context);
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+  const std::chrono::duration<double> elapsed_seconds = end - start;
+
+  kahypar::io::writePartitionFile(hypergraph, context.partition.graph_partition_filename,
+                                  context.partition.binary_partition_output);
+
+  std::ostringstream result;
+  if (sp_process_output) {
+    kahypar::io::serializer::serialize(context, hypergraph, elapsed_seconds, result);
+  } else {
+    result << context.partition.graph_partition_filename
+           << " cut=" << kahypar::metrics::hyperedgeCut(hypergraph)
+           << " km1=" << kahypar::metrics::km1(hypergraph)
+           << " imbalance=" << kahypar::metrics::imbalance(hypergraph, context)
+           << " time=" << elapsed_seconds.count() << "s" << std::endl;
+  }
+  std::lock_guard<std::mutex> lock(output_mutex);
+  std::cout << result.str() << std::flush;
+}
+
+// Jobs are started in the order of the manifest. A job is admitted as soon
+// as a worker is idle and its estimated memory fits into the budget.
+class JobScheduler {
+ public:
+  JobScheduler(const std::vector<PreparedJob>& jobs, const size_t memory_budget,
+               const bool sp_process_output) :
+    _jobs(jobs),
+    _memory_budget(memory_budget),
+    _sp_process_output(sp_process_output),
+    _mutex(),
+    _output_mutex(),
+    _admission(),
+    _next_job(0),
+    _memory_in_use(0) { }
+
+  JobScheduler(const JobScheduler&) = delete;
+  JobScheduler& operator= (const JobScheduler&) = delete;
+
+  JobScheduler(JobScheduler&&) = delete;
+  JobScheduler& operator= (JobScheduler&&) = delete;
+
+  ~JobScheduler() = default;
+
+  void run(const size_t num_threads) {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < std::min(num_threads, _jobs.size()); ++i) {
+      workers.emplace_back(&JobScheduler::work, this);
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+ private:
+  // A job that exceeds the budget on its own is started once no other job runs.
+  bool canAdmitNextJob() const {
+    return _next_job == _jobs.size() || _memory_budget == 0 || _memory_in_use == 0 ||
+           _memory_in_use + _jobs[_next_job].estimated_memory <= _memory_budget;
+  }
+
+  void work() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _admission.wait(lock, [this]() {
+          return canAdmitNextJob();
+        });
+      if (_next_job == _jobs.size()) {
+        return;
+      }
+      const PreparedJob& job = _jobs[_next_job++];
+      _memory_in_use += job.estimated_memory;
+      lock.unlock();
+
+      runJob(job, _sp_process_output, _output_mutex);
+
+      lock.lock();
+      _memory_in_use -= job.estimated_memory;
+      _admission.notify_all();
+    }
+  }
+
+  const std::vector<PreparedJob>& _jobs;
+  const size_t _memory_budget;
+  const bool _sp_process_output;
+  std::mutex _mutex;
+  std::mutex _output_mutex;
+  std::condition_variable _admission;
+  size_t _next_job;
+  size_t _memory_in_use;
+};
+
+int main(int argc, char* argv[]) {
+  std::string manifest_filename;
+  size_t num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  size_t memory_budget_mb = 0;
+  bool sp_process_output = false;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("help", "show help message")
+    ("manifest,m", po::value<std::string>(&manifest_filename)->value_name("<string>")->required(),
+    "Manifest with one job per line:\n"
+    "<hypergraph> <k> <epsilon> <seed> <preset.ini> [<partition file>]")
+    ("threads,t", po::value<size_t>(&num_threads)->value_name("<size_t>"),
+    "Number of jobs that are partitioned in parallel (default: number of cores)")
+    ("memory-budget", po::value<size_t>(&memory_budget_mb)->value_name("<size_t>"),
+    "Jobs are only started while the estimated memory of all running jobs stays below "
+    "this limit in MB. A job that exceeds the limit on its own runs alone. (default: 0 = no limit)")
+    ("sp-process,s", po::value<bool>(&sp_process_output)->value_name("<bool>"),
+    "Print a RESULT line for the SQL plot tools for each job (default: false)");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, options), vm);
+  if (vm.count("help") != 0 || argc == 1) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+  po::notify(vm);
+  num_threads = std::max(num_threads, static_cast<size_t>(1));
+
+  std::vector<BatchJob> jobs;
+  const IOStatus manifest_status = kahypar::io::parseBatchManifest(manifest_filename, jobs);
+  if (!manifest_status.ok()) {
+    std::cerr << "Error: " << manifest_status.message() << std::endl;
+    return 1;
+  }
+
+  // Every hypergraph and preset is read once, no matter how many jobs use it.
+  std::map<std::string, std::unique_ptr<SharedHypergraph> > hypergraphs;
+  std::map<std::string, Context> presets;
+  std::vector<PreparedJob> prepared_jobs;
+  for (const BatchJob& job : jobs) {
+    auto hypergraph = hypergraphs.find(job.graph_filename);
+    if (hypergraph == hypergraphs.end()) {
+      std::unique_ptr<SharedHypergraph> shared(new SharedHypergraph());
+      const IOStatus status = loadSharedHypergraph(job.graph_filename, num_threads, *shared);
+      if (!status.ok()) {
+        std::cerr << "Error: " << job.graph_filename << ": " << status.message() << std::endl;
+        return 1;
+      }
+      hypergraph = hypergraphs.emplace(job.graph_filename, std::move(shared)).first;
+    }
+
+    auto preset = presets.find(job.preset);
+    if (preset == presets.end()) {
+      std::ifstream ini(job.preset);
+      if (!ini) {
+        std::cerr << "Error: Could not load context file at: " << job.preset << std::endl;
+        return 1;
+      }
+      Context context;
+      try {
+        kahypar::parseIniToContext(context, ini);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: " << job.preset << ": " << e.what() << std::endl;
+        return 1;
+      }
+      preset = presets.emplace(job.preset, context).first;
+    }
+
+    Context context(preset->second);
+    context.partition.graph_filename = job.graph_filename;
+    context.partition.k = job.k;
+    context.partition.epsilon = job.epsilon;
+    context.partition.seed = job.seed;
+    context.partition.quiet_mode = true;
+    context.partition.graph_partition_filename = job.partition_filename.empty() ?
+                                                 kahypar::defaultPartitionFilename(context) :
+                                                 job.partition_filename;
+    if (context.partition.global_search_iterations != 0 &&
+        context.partition.mode == kahypar::Mode::recursive_bisection) {
+      std::cerr << "Error: " << job.preset
+                << ": V-Cycles are not supported in recursive bisection mode." << std::endl;
+      return 1;
+    }
+    // Jobs must neither exit nor prompt, so sanityCheck cannot be used.
+    std::string error;
+    if (!kahypar::isValidContext(context, error)) {
+      std::cerr << "Error: " << job.preset << ": " << error << std::endl;
+      return 1;
+    }
+    prepared_jobs.push_back({ hypergraph->second.get(), context,
+                              estimatedMemory(*hypergraph->second, context) });
+  }
+
+  JobScheduler scheduler(prepared_jobs, memory_budget_mb * 1024 * 1024, sp_process_output);
+  scheduler.run(num_threads);
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+
+#include <boost/program_options.hpp>
+
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/io/server_protocol.h"
+#include "kahypar/io/unix_socket.h"
+
+namespace po = boost::program_options;
+
+using kahypar::io::IOStatus;
+using kahypar::io::ServerCommand;
+using kahypar::io::ServerRequest;
+using kahypar::io::UnixSocket;
+
+// The server may run in another working directory.
+static std::string absolutePath(const std::string& filename) {
+  char path[PATH_MAX];
+  return realpath(filename.c_str(), path) != nullptr ? std::string(path) : filename;
+}
+
+int main(int argc, char* argv[]) {
+  std::string socket_path;
+  std::string partition_filename;
+  std::vector<std::string> tokens;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("help", "show help message")
+    ("socket,S", po::value<std::string>(&socket_path)->value_name("<string>")->required(),
+    "Path of the Unix domain socket of KaHyParServer")
+    ("output,o", po::value<std::string>(&partition_filename)->value_name("<string>"),
+    "File the partition of a PARTITION request is written to")
+    ("request", po::value<std::vector<std::string> >(&tokens)->required(),
+    "Request, e.g.:\n"
+    "LOAD <name> <hypergraph file>\n"
+    "UNLOAD <name>\n"
+    "PARTITION <name> <k> <epsilon> <seed> <preset.ini> [<warm start partition file>]\n"
+    "SHUTDOWN\n"
+    "Use -- before a request with a negative seed.");
+  po::positional_options_description positional;
+  positional.add("request", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+  if (vm.count("help") != 0 || argc == 1) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+  po::notify(vm);
+
+  std::string line;
+  for (const std::string& token : tokens) {
+    line += (line.empty() ? "" : " ") + token;
+  }
+  ServerRequest request;
+  const IOStatus request_status = kahypar::io::parseServerRequest(line, request);
+  if (!request_status.ok()) {
+    std::cerr << "Error: " << request_status.message() << std::endl;
+    return 1;
+  }
+  if (request.command == ServerCommand::load) {
+    line = "LOAD " + request.name + " " + absolutePath(request.graph_filename);
+  } else if (request.command == ServerCommand::partition) {
+    std::istringstream words(line);
+    std::string command, name, k, epsilon, seed;
+    words >> command >> name >> k >> epsilon >> seed;
+    line = "PARTITION " + name + " " + k + " " + epsilon + " " + seed + " " +
+           absolutePath(request.preset);
+    if (!request.warm_start_filename.empty()) {
+      line += " " + absolutePath(request.warm_start_filename);
+    }
+  }
+
+  UnixSocket server;
+  std::string response;
+  IOStatus status = kahypar::io::sendServerRequest(socket_path, line, server, response);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    return 1;
+  }
+
+  if (request.command != ServerCommand::partition) {
+    if (response != "OK") {
+      std::cerr << "Error: " << response.substr(response.find(' ') + 1) << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
+  kahypar::io::PartitionResponse result;
+  std::vector<kahypar::PartitionID> partition;
+  status = kahypar::io::parsePartitionResponse(response, result);
+  if (status.ok()) {
+    status = kahypar::io::readPartition(server, result, partition);
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    return 1;
+  }
+  if (!partition_filename.empty()) {
+    std::ofstream partition_file(partition_filename);
+    if (!partition_file) {
+      std::cerr << "Error: Could not open " << partition_filename << " for writing" << std::endl;
+      return 1;
+    }
+    for (const kahypar::PartitionID part : partition) {
+      partition_file << part << "\n";
+    }
+  }
+  std::cout << "cut=" << result.cut << " km1=" << result.km1
+            << " imbalance=" << result.imbalance << " time=" << result.seconds << "s"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+
+#include <boost/program_options.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kahypar/application/partitioning_server.h"
+
+namespace po = boost::program_options;
+
+using kahypar::PartitioningServer;
+using kahypar::io::IOStatus;
+using kahypar::io::UnixSocket;
+
+int main(int argc, char* argv[]) {
+  std::string socket_path;
+  size_t num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  std::vector<std::string> preloaded;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("help", "show help message")
+    ("socket,S", po::value<std::string>(&socket_path)->value_name("<string>")->required(),
+    "Path of the Unix domain socket the server listens on")
+    ("threads,t", po::value<size_t>(&num_threads)->value_name("<size_t>"),
+    "Number of requests that are served in parallel (default: number of cores)")
+    ("load,l", po::value<std::vector<std::string> >(&preloaded)->value_name("<name>=<file>"),
+    "Hypergraph that is loaded before the server accepts requests (can be repeated)");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, options), vm);
+  if (vm.count("help") != 0 || argc == 1) {
+    std::cout << options << std::endl;
+    return 0;
+  }
+  po::notify(vm);
+  num_threads = std::max(num_threads, static_cast<size_t>(1));
+
+  UnixSocket listener;
+  const IOStatus status = UnixSocket::listen(socket_path, listener);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    return 1;
+  }
+
+  PartitioningServer server(listener, num_threads);
+  for (const std::string& hypergraph : preloaded) {
+    const size_t separator = hypergraph.find('=');
+    if (separator == std::string::npos || separator == 0) {
+      std::cerr << "Error: expected --load <name>=<file>, got " << hypergraph << std::endl;
+      return 1;
+    }
+    const IOStatus load_status = server.load(hypergraph.substr(0, separator),
+                                             hypergraph.substr(separator + 1));
+    if (!load_status.ok()) {
+      std::cerr << "Error: " << load_status.message() << std::endl;
+      return 1;
+    }
+  }
+
+  server.run();
+  unlink(socket_path.c_str());
+  return 0;
+}
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "kahypar/application/command_line_options.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/io/server_protocol.h"
+#include "kahypar/io/unix_socket.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/partitioner_session.h"
+
+namespace kahypar {
+// A hypergraph that stays in memory until it is unloaded. Binary files are
+// memory mapped and used in place, including their precomputed incident
+// nets. All other formats are parsed once into the vectors.
+struct ResidentHypergraph {
+  io::MemoryMappedFile file { };
+  io::BinaryHypergraphView view { };
+  HyperedgeIndexVector index_vector { };
+  HyperedgeVector edge_vector { };
+  HyperedgeWeightVector hyperedge_weights { };
+  HypernodeWeightVector hypernode_weights { };
+};
+
+static inline io::IOStatus loadResidentHypergraph(const std::string& filename,
+                                                  ResidentHypergraph& resident) {
+  if (io::isBinaryHypergraphFile(filename)) {
+    return io::mapBinaryHypergraphFile(filename, resident.file, resident.view);
+  }
+  io::BinaryHypergraphView& view = resident.view;
+  const io::IOStatus status = io::parseInputFile(
+    filename, InputFormat::automatic, view.num_hypernodes, view.num_hyperedges,
+    resident.index_vector, resident.edge_vector, &resident.hyperedge_weights,
+    &resident.hypernode_weights, std::thread::hardware_concurrency());
+  if (!status.ok()) {
+    return status;
+  }
+  view.num_pins = resident.edge_vector.size();
+  view.hyperedge_offsets = resident.index_vector.data();
+  view.pins = resident.edge_vector.data();
+  view.hyperedge_weights = resident.hyperedge_weights.empty() ?
+                           nullptr : resident.hyperedge_weights.data();
+  view.hypernode_weights = resident.hypernode_weights.empty() ?
+                           nullptr : resident.hypernode_weights.data();
+  view.hypernode_offsets = nullptr;
+  view.incident_nets = nullptr;
+  return io::IOStatus();
+}
+
+// Accepts connections on the listening socket and hands them to a pool of
+// worker threads. Each worker partitions in its own PartitionerSession, so
+// consecutive requests of a worker reuse the hypergraph memory. Hypergraphs
+// are shared by reference counting, i.e., unloading a hypergraph does not
+// affect requests that already work on it.
+class PartitioningServer {
+ public:
+  // A client that does not send its request within the timeout or whose
+  // request is longer than kMaxRequestLength is disconnected, so that it
+  // cannot occupy a worker.
+  static constexpr double kDefaultRequestTimeout = 10.0;
+  static constexpr size_t kMaxRequestLength = 64 * 1024;
+
+  PartitioningServer(io::UnixSocket& listener, const size_t num_threads,
+                     const double request_timeout = kDefaultRequestTimeout) :
+    _listener(listener),
+    _num_threads(num_threads),
+    _request_timeout(request_timeout),
+    _mutex(),
+    _hypergraphs(),
+    _presets(),
+    _connections(),
+    _connection_available(),
+    _stopped(false) { }
+
+  PartitioningServer(const PartitioningServer&) = delete;
+  PartitioningServer& operator= (const PartitioningServer&) = delete;
+
+  PartitioningServer(PartitioningServer&&) = delete;
+  PartitioningServer& operator= (PartitioningServer&&) = delete;
+
+  ~PartitioningServer() = default;
+
+  io::IOStatus load(const std::string& name, const std::string& filename) {
+    std::shared_ptr<ResidentHypergraph> resident = std::make_shared<ResidentHypergraph>();
+    const io::IOStatus status = loadResidentHypergraph(filename, *resident);
+    if (!status.ok()) {
+      return status;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _hypergraphs[name] = resident;
+    return io::IOStatus();
+  }
+
+  // Returns after a SHUTDOWN request, once all accepted requests are answered.
+  void run() {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < _num_threads; ++i) {
+      workers.emplace_back(&PartitioningServer::work, this);
+    }
+    while (true) {
+      io::UnixSocket connection;
+      if (!_listener.accept(connection).ok()) {
+        break;
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      _connections.push(std::move(connection));
+      _connection_available.notify_one();
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopped = true;
+      _connection_available.notify_all();
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+ private:
+  // Path and modification time (seconds, nanoseconds) of a preset file
+  using PresetVersion = std::tuple<std::string, time_t, int64_t>;
+
+  void work() {
+    while (true) {
+      io::UnixSocket connection;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _connection_available.wait(lock, [this]() {
+            return _stopped || !_connections.empty();
+          });
+        if (_connections.empty()) {
+          return;
+        }
+        connection = std::move(_connections.front());
+        _connections.pop();
+      }
+      serve(connection);
+    }
+  }
+
+  void serve(io::UnixSocket& connection) {
+    std::string line;
+    if (!connection.setTimeout(_request_timeout).ok() ||
+        !connection.readLine(line, kMaxRequestLength)) {
+      return;
+    }
+    io::ServerRequest request;
+    io::IOStatus status = io::parseServerRequest(line, request);
+    std::string response;
+    if (status.ok()) {
+      switch (request.command) {
+        case io::ServerCommand::load:
+          status = load(request.name, request.graph_filename);
+          break;
+        case io::ServerCommand::unload:
+          status = unload(request.name);
+          break;
+        case io::ServerCommand::partition:
+          status = partition(request, response);
+          break;
+        case io::ServerCommand::shutdown:
+          _listener.shutdown();
+          break;
+      }
+    }
+    if (!status.ok()) {
+      response = "ERROR " + status.message() + "\n";
+    } else if (response.empty()) {
+      response = "OK\n";
+    }
+    connection.write(response);
+  }
+
+  io::IOStatus unload(const std::string& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_hypergraphs.erase(name) == 0) {
+      return io::IOStatus::error("Unknown hypergraph '" + name + "'");
+    }
+    return io::IOStatus();
+  }
+
+  std::shared_ptr<const ResidentHypergraph> find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto hypergraph = _hypergraphs.find(name);
+    return hypergraph == _hypergraphs.end() ? nullptr : hypergraph->second;
+  }
+
+  // Each version of a preset file, identified by its path and modification
+  // time, is read once. An edited preset is read again by the next request.
+  // Presets are never removed, so the returned context stays valid.
+  io::IOStatus preset(const std::string& filename, const Context*& context) {
+    struct stat file_status;
+    if (stat(filename.c_str(), &file_status) != 0) {
+      return io::IOStatus::error("Could not load context file at: " + filename);
+    }
+    const PresetVersion version(filename, file_status.st_mtim.tv_sec,
+                                file_status.st_mtim.tv_nsec);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto preset = _presets.find(version);
+    if (preset == _presets.end()) {
+      std::ifstream ini(filename);
+      if (!ini) {
+        return io::IOStatus::error("Could not load context file at: " + filename);
+      }
+      Context parsed;
+      try {
+        parseIniToContext(parsed, ini);
+      } catch (const std::exception& e) {
+        return io::IOStatus::error(filename + ": " + e.what());
+      }
+      preset = _presets.emplace(version, parsed).first;
+    }
+    context = &preset->second;
+    return io::IOStatus();
+  }
+
+  io::IOStatus partition(const io::ServerRequest& request, std::string& response) {
+    const std::shared_ptr<const ResidentHypergraph> resident = find(request.name);
+    if (resident == nullptr) {
+      return io::IOStatus::error("Unknown hypergraph '" + request.name + "'");
+    }
+    const io::BinaryHypergraphView& view = resident->view;
+    if (view.num_hypernodes < static_cast<HypernodeID>(request.k)) {
+      return io::IOStatus::error("k exceeds the number of hypernodes");
+    }
+
+    const Context* configured_context = nullptr;
+    io::IOStatus status = preset(request.preset, configured_context);
+    if (!status.ok()) {
+      return status;
+    }
+    Context context(*configured_context);
+    context.partition.graph_filename = request.name;
+    context.partition.k = request.k;
+    context.partition.epsilon = request.epsilon;
+    context.partition.seed = request.seed;
+    context.partition.quiet_mode = true;
+    if (context.partition.global_search_iterations != 0 &&
+        context.partition.mode == Mode::recursive_bisection) {
+      return io::IOStatus::error("V-Cycles are not supported in recursive bisection mode.");
+    }
+    if (!request.warm_start_filename.empty() &&
+        context.partition.mode != Mode::direct_kway) {
+      return io::IOStatus::error("Warm starts are only supported in direct k-way mode.");
+    }
+    // Workers must neither exit nor prompt, so sanityCheck cannot be used.
+    std::string error;
+    if (!isValidContext(context, error)) {
+      return io::IOStatus::error(request.preset + ": " + error);
+    }
+
+    std::vector<PartitionID> warm_start;
+    if (!request.warm_start_filename.empty()) {
+      status = io::parsePartitionFile(request.warm_start_filename, warm_start);
+      if (!status.ok()) {
+        return status;
+      }
+      if (warm_start.size() != view.num_hypernodes) {
+        return io::IOStatus::error(request.warm_start_filename + " does not contain a block ID "
+                               "for each hypernode");
+      }
+      for (const PartitionID part : warm_start) {
+        if (part < 0 || part >= request.k) {
+          return io::IOStatus::error("Invalid block ID " + std::to_string(part) + " in " +
+                                 request.warm_start_filename);
+        }
+      }
+    }
+
+    PartitionerSession& session = PartitionerSession::local();
+    Hypergraph& hypergraph = session.setHypergraph(
+      view.num_hypernodes, view.num_hyperedges, view.hyperedge_offsets, view.pins, request.k,
+      view.hyperedge_weights, view.hypernode_weights, view.hypernode_offsets, view.incident_nets);
+
+    const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    if (warm_start.empty()) {
+      session.partition(context);
+    } else {
+      for (const HypernodeID& hn : hypergraph.nodes()) {
+        hypergraph.setNodePart(hn, warm_start[hn]);
+      }
+      session.improve(context);
+    }
+    const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::ostringstream out;
+    out << "OK " << hypergraph.initialNumNodes()
+        << " " << metrics::hyperedgeCut(hypergraph)
+        << " " << metrics::km1(hypergraph)
+        << " " << metrics::imbalance(hypergraph, context)
+        << " " << elapsed_seconds.count() << "\n";
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      out << hypergraph.partID(hn) << "\n";
+    }
+    response = out.str();
+    return io::IOStatus();
+  }
+
+  io::UnixSocket& _listener;
+  const size_t _num_threads;
+  const double _request_timeout;
+  std::mutex _mutex;
+  std::map<std::string, std::shared_ptr<const ResidentHypergraph> > _hypergraphs;
+  std::map<PresetVersion, Context> _presets;
+  std::queue<io::UnixSocket> _connections;
+  std::condition_variable _connection_available;
+  bool _stopped;
+};
+}  // namespace kahypar
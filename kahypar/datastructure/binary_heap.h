@@ -26,6 +26,7 @@
 #include <memory>
 #include <vector>
 
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/macros.h"
 
 namespace kahypar {
@@ -52,17 +53,17 @@ class BinaryHeapBase {
     KeyType key;
   };
 
+  // The arrays are taken from the scratch buffer pools of the calling thread,
+  // so heaps that are rebuilt in every refinement call reuse their memory.
+  // Value-initialized elements are sentinels with handle 0.
   explicit BinaryHeapBase(const IDType& size) :
-    _heap(std::make_unique<HeapElement[]>(static_cast<size_t>(size) + 1)),
-    _handles(std::make_unique<size_t[]>(size)),
+    _heap_buffer(HeapBufferPool::local().acquire(static_cast<size_t>(size) + 1)),
+    _handles_buffer(HandleBufferPool::local().acquire(size)),
+    _heap(_heap_buffer->data()),
+    _handles(_handles_buffer->data()),
     _compare(),
     _next_slot(0),
     _max_size(size + 1) {
-    for (size_t i = 0; i < size; ++i) {
-      _heap[i] = HeapElement(BinaryHeapTraits<Derived>::sentinel());
-      _handles[i] = 0;
-    }
-    _heap[size] = HeapElement(BinaryHeapTraits<Derived>::sentinel());
     ++_next_slot;  // _heap[0] is sentinel
   }
 
@@ -317,6 +318,8 @@ class BinaryHeapBase {
 
   friend void swap(BinaryHeapBase& a, BinaryHeapBase& b) {
     using std::swap;
+    swap(a._heap_buffer, b._heap_buffer);
+    swap(a._handles_buffer, b._handles_buffer);
     swap(a._heap, b._heap);
     swap(a._handles, b._handles);
     swap(a._compare, b._compare);
@@ -324,8 +327,13 @@ class BinaryHeapBase {
     swap(a._max_size, b._max_size);
   }
 
-  std::unique_ptr<HeapElement[]> _heap;
-  std::unique_ptr<size_t[]> _handles;
+  using HeapBufferPool = ScratchBufferPool<std::vector<HeapElement> >;
+  using HandleBufferPool = ScratchBufferPool<std::vector<size_t> >;
+
+  typename HeapBufferPool::Handle _heap_buffer;
+  typename HandleBufferPool::Handle _handles_buffer;
+  HeapElement* _heap;
+  size_t* _handles;
 
   Comparator _compare;
   unsigned int _next_slot;
@@ -110,12 +110,14 @@ class ConnectivitySets final {
 
   explicit ConnectivitySets(const HyperedgeID num_hyperedges, const PartitionID k) :
     _k(k),
+    _capacity(0),
     _connectivity_sets(nullptr) {
     initialize(num_hyperedges, _k);
   }
 
   ConnectivitySets() :
     _k(0),
+    _capacity(0),
     _connectivity_sets(nullptr) { }
 
 
@@ -126,22 +128,31 @@ class ConnectivitySets final {
 
   ConnectivitySets(ConnectivitySets&& other) noexcept :
     _k(other._k),
+    _capacity(other._capacity),
     _connectivity_sets(std::move(other._connectivity_sets)) {
     other._k = 0;
+    other._capacity = 0;
     other._connectivity_sets = nullptr;
   }
 
   ConnectivitySets& operator= (ConnectivitySets&& other) noexcept {
     _k = other._k;
+    _capacity = other._capacity;
     _connectivity_sets = std::move(other._connectivity_sets);
     other._k = 0;
+    other._capacity = 0;
     other._connectivity_sets = nullptr;
     return *this;
   }
 
+  // The memory arena is only reallocated if it is too small.
   void initialize(const HyperedgeID num_hyperedges, const PartitionID k) {
     _k = k;
-    _connectivity_sets = std::make_unique<Byte[]>(num_hyperedges * sizeOfConnectivitySet());
+    const size_t size = static_cast<size_t>(num_hyperedges) * sizeOfConnectivitySet();
+    if (size > _capacity) {
+      _connectivity_sets = std::make_unique<Byte[]>(size);
+      _capacity = size;
+    }
     for (HyperedgeID i = 0; i < num_hyperedges; ++i) {
       new(get(i))ConnectivitySet(_k);
     }
@@ -176,6 +187,7 @@ class ConnectivitySets final {
   }
 
   PartitionID _k;
+  size_t _capacity;
   std::unique_ptr<Byte[]> _connectivity_sets;
 };
 }  // namespace ds
@@ -0,0 +1,448 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/scratch_buffer_pool.h"
+#include "kahypar/macros.h"
+#include "kahypar/meta/int_to_type.h"
+
+namespace kahypar {
+namespace ds {
+// Addressable d-ary heap that provides the same interface as BinaryHeapBase.
+// In contrast to the binary heap, keys and ids are stored in separate arrays
+// (structure of arrays). The children of heap position p are located at
+// positions [p * D + 1, p * D + D] and therefore the keys of all children
+// of a node are stored contiguously. Thus a downHeap step only touches one
+// cache line of keys per level, while the number of levels shrinks by a
+// factor of log2(D). If SSE4.1 is available, the child with maximum
+// (minimum) key of a full 4-ary child group of 32 bit integer keys
+// is determined using SIMD instructions.
+template <class Derived, size_t D>
+class DAryHeapBase {
+ private:
+  using KeyType = typename BinaryHeapTraits<Derived>::KeyType;
+  using IDType = typename BinaryHeapTraits<Derived>::IDType;
+  using Comparator = typename BinaryHeapTraits<Derived>::Comparator;
+
+  static_assert(D >= 2, "d-ary heap needs at least two children per node");
+
+  static constexpr bool use_simd_child_selection =
+#if defined(__SSE4_1__)
+    D == 4 && std::is_same<KeyType, int32_t>::value;
+#else
+    false;
+#endif
+
+ protected:
+  // As in BinaryHeapBase, the arrays are taken from the scratch buffer pools
+  // of the calling thread. Ids and handles are value-initialized to 0.
+  explicit DAryHeapBase(const IDType& size) :
+    _keys_buffer(KeyBufferPool::local().acquire(static_cast<size_t>(size) + D)),
+    _ids_buffer(IDBufferPool::local().acquire(static_cast<size_t>(size) + D)),
+    _handles_buffer(HandleBufferPool::local().acquire(size)),
+    _keys(_keys_buffer->data()),
+    _ids(_ids_buffer->data()),
+    _handles(_handles_buffer->data()),
+    _compare(),
+    _size(0),
+    _max_size(size) {
+    std::fill(_keys, _keys + static_cast<size_t>(size) + D, BinaryHeapTraits<Derived>::sentinel());
+  }
+
+ public:
+  static constexpr size_t arity = D;
+
+  DAryHeapBase(const DAryHeapBase&) = delete;
+  DAryHeapBase& operator= (const DAryHeapBase&) = delete;
+
+  DAryHeapBase(DAryHeapBase&&) = default;
+  DAryHeapBase& operator= (DAryHeapBase&&) = default;
+
+  ~DAryHeapBase() = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+  inline const KeyType & getKey(const IDType& id) const {
+    ASSERT(contains(id), "Accessing invalid element:" << id);
+    return _keys[_handles[id]];
+  }
+
+  inline bool contains(const IDType& id) const {
+    const size_t handle = _handles[id];
+    return handle < _size && _ids[handle] == id;
+  }
+
+  // Runs in O(size()), because unused slots have to contain the sentinel key.
+  inline void clear() {
+    for (size_t i = 0; i < _size; ++i) {
+      _keys[i] = BinaryHeapTraits<Derived>::sentinel();
+    }
+    _size = 0;
+  }
+
+  inline void push(const IDType& id, const KeyType& key) {
+    ASSERT(!contains(id), "pushing already contained element" << id);
+    ASSERT(_size + 1 <= _max_size, "heap size overflow");
+
+    const size_t handle = _size++;
+    _keys[handle] = key;
+    _ids[handle] = id;
+    _handles[id] = handle;
+    upHeap(handle);
+    ASSERT(_keys[_handles[id]] == key, "Push failed - wrong key:"
+           << _keys[_handles[id]] << "!=" << key);
+    ASSERT(_ids[_handles[id]] == id, "Push failed - wrong id:"
+           << _ids[_handles[id]] << "!=" << id);
+  }
+
+  inline void decreaseKey(const IDType& id, const KeyType& new_key) {
+    ASSERT(contains(id), "Calling decreaseKey for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    _keys[handle] = new_key;
+    static_cast<Derived*>(this)->decreaseKeyImpl(handle);
+    ASSERT(_keys[_handles[id]] == new_key, "decreaseKey failed - wrong key:" <<
+           _keys[_handles[id]] << "!=" << new_key);
+  }
+
+  inline void increaseKey(const IDType& id, const KeyType& new_key) {
+    ASSERT(contains(id), "Calling increaseKey for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    _keys[handle] = new_key;
+    static_cast<Derived*>(this)->increaseKeyImpl(handle);
+    ASSERT(_keys[_handles[id]] == new_key, "increaseKey failed - wrong key:" <<
+           _keys[_handles[id]] << "!=" << new_key);
+  }
+
+  inline void decreaseKeyBy(const IDType& id, const KeyType& key_delta) {
+    ASSERT(contains(id), "Calling decreaseKeyBy for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    _keys[handle] -= key_delta;
+    static_cast<Derived*>(this)->decreaseKeyImpl(handle);
+  }
+
+  inline void increaseKeyBy(const IDType& id, const KeyType& key_delta) {
+    ASSERT(contains(id), "Calling increaseKeyBy for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    _keys[handle] += key_delta;
+    static_cast<Derived*>(this)->increaseKeyImpl(handle);
+  }
+
+  inline void remove(const IDType& id) {
+    ASSERT(contains(id), "trying to delete element not in heap:" << id);
+
+    const size_t node_handle = _handles[id];
+    const size_t swap_handle = --_size;
+    const KeyType node_key = _keys[node_handle];
+    _keys[node_handle] = _keys[swap_handle];
+    _ids[node_handle] = _ids[swap_handle];
+    _handles[_ids[node_handle]] = node_handle;
+    _keys[swap_handle] = BinaryHeapTraits<Derived>::sentinel();
+    if (node_handle != swap_handle) {
+      if (_compare(node_key, _keys[node_handle])) {
+        upHeap(node_handle);
+      } else if (_compare(_keys[node_handle], node_key)) {
+        downHeap(node_handle);
+      }
+    }
+  }
+
+  inline void updateKey(const IDType& id, const KeyType& new_key) {
+    ASSERT(contains(id), "Calling updateKey for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    if (_compare(new_key, _keys[handle])) {
+      _keys[handle] = new_key;
+      downHeap(handle);
+    } else {
+      _keys[handle] = new_key;
+      upHeap(handle);
+    }
+    ASSERT(_keys[_handles[id]] == new_key, "updateKey failed - wrong key:" <<
+           _keys[_handles[id]] << "!=" << new_key);
+  }
+
+  inline void updateKeyBy(const IDType& id, const KeyType& key_delta) {
+    ASSERT(contains(id), "Calling updateKeyBy for element not contained in Queue:" << id);
+
+    const size_t handle = _handles[id];
+    _keys[handle] += key_delta;
+    if (_compare(key_delta, 0)) {
+      downHeap(handle);
+    } else {
+      upHeap(handle);
+    }
+  }
+
+  inline void pop() {
+    ASSERT(!empty(), "Deleting from empty heap");
+
+    const size_t swap_handle = --_size;
+    _keys[0] = _keys[swap_handle];
+    _ids[0] = _ids[swap_handle];
+    _handles[_ids[0]] = 0;
+    _keys[swap_handle] = BinaryHeapTraits<Derived>::sentinel();
+    if (!empty()) {
+      downHeap(0);
+    }
+    ASSERT(isHeap(), "Heap invariant violated!");
+  }
+
+  inline const IDType & top() const {
+    ASSERT(!empty(), "Heap is empty");
+    return _ids[0];
+  }
+
+  inline const KeyType & topKey() const {
+    ASSERT(!empty(), "Heap is empty");
+    return _keys[0];
+  }
+
+ protected:
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void upHeap(size_t heap_position) {
+    ASSERT(_size > heap_position, "position specified larger than heap size");
+
+    const KeyType rising_key = _keys[heap_position];
+    const IDType rising_id = _ids[heap_position];
+    while (heap_position > 0) {
+      const size_t parent = (heap_position - 1) / D;
+      if (!_compare(_keys[parent], rising_key)) {
+        break;
+      }
+      _keys[heap_position] = _keys[parent];
+      _ids[heap_position] = _ids[parent];
+      _handles[_ids[heap_position]] = heap_position;
+      heap_position = parent;
+    }
+
+    _keys[heap_position] = rising_key;
+    _ids[heap_position] = rising_id;
+    _handles[rising_id] = heap_position;
+    ASSERT(isHeap(), "Heap invariant violated!");
+  }
+
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void downHeap(size_t heap_position) {
+    ASSERT(_size > heap_position, "position specified larger than heap size");
+
+    const KeyType dropping_key = _keys[heap_position];
+    const IDType dropping_id = _ids[heap_position];
+    size_t first_child = heap_position * D + 1;
+    while (first_child < _size) {
+      const size_t best_child = bestChild(first_child,
+                                          meta::Int2Type<use_simd_child_selection>());
+      if (!_compare(dropping_key, _keys[best_child])) {
+        break;
+      }
+      _keys[heap_position] = _keys[best_child];
+      _ids[heap_position] = _ids[best_child];
+      _handles[_ids[heap_position]] = heap_position;
+      heap_position = best_child;
+      first_child = heap_position * D + 1;
+    }
+
+    _keys[heap_position] = dropping_key;
+    _ids[heap_position] = dropping_id;
+    _handles[dropping_id] = heap_position;
+    ASSERT(isHeap(), "Heap invariant violated!");
+  }
+
+  // Slots in [_size, _max_size + D) always contain the sentinel key, which
+  // loses every comparison. We therefore can always scan complete child groups.
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t bestChild(const size_t first_child,
+                                                   meta::Int2Type<false>) const {
+    size_t best_child = first_child;
+    for (size_t child = first_child + 1; child < first_child + D; ++child) {
+      best_child = _compare(_keys[best_child], _keys[child]) ? child : best_child;
+    }
+    return best_child;
+  }
+
+#if defined(__SSE4_1__)
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t bestChild(const size_t first_child,
+                                                   meta::Int2Type<true>) const {
+    const __m128i keys =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(_keys + first_child));
+    // Reduce to the best key of the group and broadcast it to all lanes
+    __m128i best = selectBest(keys, _mm_shuffle_epi32(keys, _MM_SHUFFLE(2, 3, 0, 1)),
+                              _compare);
+    best = selectBest(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)), _compare);
+    const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, best)));
+    // lowest set bit == first child with best key (same tie breaking as scalar version)
+    return first_child + __builtin_ctz(mask);
+  }
+
+  static KAHYPAR_ATTRIBUTE_ALWAYS_INLINE __m128i selectBest(const __m128i a, const __m128i b,
+                                                            const std::less<int32_t>&) {
+    return _mm_max_epi32(a, b);
+  }
+
+  static KAHYPAR_ATTRIBUTE_ALWAYS_INLINE __m128i selectBest(const __m128i a, const __m128i b,
+                                                            const std::greater<int32_t>&) {
+    return _mm_min_epi32(a, b);
+  }
+#endif
+
+  bool isHeap() const {
+    for (size_t i = 1; i < _size; ++i) {
+      if (_compare(_keys[(i - 1) / D], _keys[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend void swap(DAryHeapBase& a, DAryHeapBase& b) {
+    using std::swap;
+    swap(a._keys_buffer, b._keys_buffer);
+    swap(a._ids_buffer, b._ids_buffer);
+    swap(a._handles_buffer, b._handles_buffer);
+    swap(a._keys, b._keys);
+    swap(a._ids, b._ids);
+    swap(a._handles, b._handles);
+    swap(a._compare, b._compare);
+    swap(a._size, b._size);
+    swap(a._max_size, b._max_size);
+  }
+
+  using KeyBufferPool = ScratchBufferPool<std::vector<KeyType> >;
+  using IDBufferPool = ScratchBufferPool<std::vector<IDType> >;
+  using HandleBufferPool = ScratchBufferPool<std::vector<size_t> >;
+
+  typename KeyBufferPool::Handle _keys_buffer;
+  typename IDBufferPool::Handle _ids_buffer;
+  typename HandleBufferPool::Handle _handles_buffer;
+  KeyType* _keys;
+  IDType* _ids;
+  size_t* _handles;
+
+  Comparator _compare;
+  size_t _size;
+  size_t _max_size;
+};
+
+template <typename IDType_, typename KeyType_, size_t D = 4>
+class DAryMaxHeap final : public DAryHeapBase<DAryMaxHeap<IDType_, KeyType_, D>, D>{
+  using Base = DAryHeapBase<DAryMaxHeap<IDType_, KeyType_, D>, D>;
+  friend Base;
+
+ public:
+  using IDType = typename BinaryHeapTraits<DAryMaxHeap>::IDType;
+  using KeyType = typename BinaryHeapTraits<DAryMaxHeap>::KeyType;
+
+  // Second parameter is used to satisfy EnhancedBucketPQ interface
+  explicit DAryMaxHeap(const IDType& storage_initializer,
+                       const KeyType& UNUSED(unused) = 0) :
+    Base(storage_initializer) { }
+
+  friend void swap(DAryMaxHeap& a, DAryMaxHeap& b) {
+    using std::swap;
+    swap(static_cast<Base&>(a), static_cast<Base&>(b));
+  }
+
+ protected:
+  inline void decreaseKeyImpl(const size_t handle) {
+    Base::downHeap(handle);
+  }
+
+  inline void increaseKeyImpl(const size_t handle) {
+    Base::upHeap(handle);
+  }
+};
+
+template <typename IDType_, typename KeyType_, size_t D = 4>
+class DAryMinHeap final : public DAryHeapBase<DAryMinHeap<IDType_, KeyType_, D>, D>{
+  using Base = DAryHeapBase<DAryMinHeap<IDType_, KeyType_, D>, D>;
+  friend Base;
+
+ public:
+  using IDType = typename BinaryHeapTraits<DAryMinHeap>::IDType;
+  using KeyType = typename BinaryHeapTraits<DAryMinHeap>::KeyType;
+
+  // Second parameter is used to satisfy EnhancedBucketPQ interface
+  explicit DAryMinHeap(const IDType& storage_initializer,
+                       const KeyType& UNUSED(unused) = 0) :
+    Base(storage_initializer) { }
+
+  friend void swap(DAryMinHeap& a, DAryMinHeap& b) {
+    using std::swap;
+    swap(static_cast<Base&>(a), static_cast<Base&>(b));
+  }
+
+ protected:
+  inline void decreaseKeyImpl(const size_t handle) {
+    Base::upHeap(handle);
+  }
+
+  inline void increaseKeyImpl(const size_t handle) {
+    Base::downHeap(handle);
+  }
+};
+
+// Traits specialization for d-ary max heap:
+template <typename IDType_, typename KeyType_, size_t D>
+class BinaryHeapTraits<DAryMaxHeap<IDType_, KeyType_, D> >{
+ public:
+  using IDType = IDType_;
+  using KeyType = KeyType_;
+  using Comparator = std::less<KeyType>;
+
+  // lowest() instead of max(): unused slots have to lose every comparison
+  static constexpr KeyType sentinel() {
+    return std::numeric_limits<KeyType_>::lowest();
+  }
+};
+
+// Traits specialization for d-ary min heap:
+template <typename IDType_, typename KeyType_, size_t D>
+class BinaryHeapTraits<DAryMinHeap<IDType_, KeyType_, D> >{
+ public:
+  using IDType = IDType_;
+  using KeyType = KeyType_;
+  using Comparator = std::greater<KeyType>;
+
+  static constexpr KeyType sentinel() {
+    return std::numeric_limits<KeyType_>::max();
+  }
+};
+}  // namespace ds
+}  // namespace kahypar
@@ -39,14 +39,16 @@ class FastResetFlagArray {
   explicit FastResetFlagArray(const size_t size) :
     _v(std::make_unique<UnderlyingType[]>(size)),
     _threshold(1),
-    _size(size) {
+    _size(size),
+    _capacity(size) {
     memset(_v.get(), 0, size * sizeof(UnderlyingType));
   }
 
   FastResetFlagArray() :
     _v(nullptr),
     _threshold(1),
-    _size(0) { }
+    _size(0),
+    _capacity(0) { }
 
   FastResetFlagArray(const FastResetFlagArray&) = delete;
   FastResetFlagArray& operator= (const FastResetFlagArray&) = delete;
@@ -60,6 +62,8 @@ class FastResetFlagArray {
     using std::swap;
     swap(_v, other._v);
     swap(_threshold, other._threshold);
+    swap(_size, other._size);
+    swap(_capacity, other._capacity);
   }
 
   bool operator[] (const size_t i) const {
@@ -84,9 +88,21 @@ class FastResetFlagArray {
     ASSERT(_v == nullptr, "Error");
     _v = std::make_unique<UnderlyingType[]>(size);
     _size = size;
+    _capacity = size;
     memset(_v.get(), (initialiser ? 1 : 0), size * sizeof(UnderlyingType));
   }
 
+  // Clears all flags. The array is only reallocated if it has to grow.
+  void resize(const size_t size) {
+    if (size > _capacity) {
+      _v = std::make_unique<UnderlyingType[]>(size);
+      _capacity = size;
+    }
+    _size = size;
+    _threshold = 1;
+    memset(_v.get(), 0, size * sizeof(UnderlyingType));
+  }
+
  private:
   bool isSet(size_t i) const {
     return _v[i] == _threshold;
@@ -95,6 +111,7 @@ class FastResetFlagArray {
   std::unique_ptr<UnderlyingType[]> _v;
   UnderlyingType _threshold;
   size_t _size;
+  size_t _capacity;
 };
 
 template <typename UnderlyingType>
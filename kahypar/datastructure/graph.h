@@ -702,7 +702,7 @@ class Graph {
   std::vector<ClusterID> _cluster_id;
   std::vector<size_t> _cluster_size;
   std::vector<IncidentClusterWeight> _incident_cluster_weight;
-  SparseMap<ClusterID, size_t> _incident_cluster_weight_position;
+  DynamicSparseMap<ClusterID, size_t> _incident_cluster_weight_position;
   std::vector<NodeID> _hypernode_mapping;
 };
 
@@ -19,11 +19,22 @@
 ******************************************************************************/
 #pragma once
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
 #include <limits>
 #include <utility>
 #include <vector>
 
+#include "kahypar/macros.h"
+
 namespace std   {
 template <typename T, typename V>
 struct numeric_limits<pair<T, V> >{
@@ -50,35 +61,91 @@ struct SimpleHash<std::pair<int, int> >{
   }
 };
 
+// Metadata byte that is stored for each slot of the hash tables below.
+// Full slots store the 7 highest bits of the (mixed) hash value of their key.
+// Empty and deleted slots use negative values. Sentinel bytes are used to
+// pad the control array, such that a group can always be loaded completely.
+enum class ControlByte : int8_t {
+  empty = -128,
+  deleted = -2,
+  sentinel = -1
+};
+
+// A group of consecutive control bytes that is compared in parallel using
+// SSE2 (16 slots) or AVX2 (32 slots). Match results are bitmasks in which
+// bit i corresponds to the i-th slot of the group.
+class ControlGroup {
+ public:
+#if defined(__AVX2__)
+  static constexpr size_t kWidth = 32;
+#else
+  static constexpr size_t kWidth = 16;
+#endif
+  using Mask = uint32_t;
+
+  explicit ControlGroup(const int8_t* ctrl) :
+#if defined(__AVX2__)
+    _ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl))) { }
+#elif defined(__SSE2__)
+    _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) { }
+#else
+    _ctrl(ctrl) { }
+#endif
+
+  Mask match(const int8_t h2) const {
+#if defined(__AVX2__)
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_ctrl, _mm256_set1_epi8(h2)));
+#elif defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8(h2)));
+#else
+    Mask mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<Mask>(_ctrl[i] == h2) << i;
+    }
+    return mask;
+#endif
+  }
+
+  Mask matchEmpty() const {
+    return match(static_cast<int8_t>(ControlByte::empty));
+  }
+
+  Mask matchDeleted() const {
+    return match(static_cast<int8_t>(ControlByte::deleted));
+  }
+
+  static size_t lowestSetBit(const Mask mask) {
+    ASSERT(mask != 0);
+    return __builtin_ctz(mask);
+  }
+
+ private:
+#if defined(__AVX2__)
+  __m256i _ctrl;
+#elif defined(__SSE2__)
+  __m128i _ctrl;
+#else
+  const int8_t* _ctrl;
+#endif
+};
 
 template <typename HashTable>
 class HashTableIterator {
  private:
-  using HashMap = HashTable;
-  using Element = typename HashMap::Element;
-  using Position = typename HashMap::Position;
+  using Element = typename HashTable::Element;
+  using Position = typename HashTable::Position;
 
  public:
-  HashTableIterator(const HashMap& hm, const Position offset) :
-    _hm(hm),
-    _offset(offset),
-    _specials(0),
-    _num_specials(_hm.getNumSpecials()) { }
+  HashTableIterator(const HashTable& ht, const Position offset) :
+    _ht(ht),
+    _offset(offset) { }
 
   const Element& operator* () {
-    const Element* res = _hm.getSpecialElement(_specials);
-    if (res) {
-      return *res;
-    } else {
-      return _hm._ht[_hm._poses[_offset - _specials]];
-    }
+    return _ht._ht[_ht._poses[_offset]];
   }
 
   HashTableIterator& operator++ () {
     ++_offset;
-    if (_specials < _num_specials) {
-      ++_specials;
-    }
     return *this;
   }
 
@@ -91,61 +158,87 @@ class HashTableIterator {
   }
 
  private:
-  const HashMap& _hm;
+  const HashTable& _ht;
   Position _offset;
-  Position _specials;
-  Position _num_specials;
 };
 
-template <typename Key, typename Value, typename Hash = SimpleHash<Key>,
-          bool Cache = true, size_t SizeFactor = 2>
-class HashMap {
- public:
-  using Element = std::pair<Key, Value>;
-  using key_type = Key;
-  using mapped_type = Value;
+template <typename Key>
+struct SetKey {
+  const Key& operator() (const Key& key) const {
+    return key;
+  }
+};
 
- private:
-  using Position = uint32_t;
+template <typename Key>
+struct MapKey {
+  template <typename Element>
+  const Key& operator() (const Element& element) const {
+    return element.first;
+  }
+};
 
+// Open addressing hash table with linear probing that stores one control byte
+// per slot (Swiss table style). Lookups first compare the 7 bit hash fragments
+// of a whole group of slots in parallel and only compare keys of matching slots.
+// Probing does not wrap around: slots behind the last home position
+// serve as overflow area. Positions of all contained elements are stored in
+// insertion order, which allows O(size) clearing and deterministic iteration.
+// Since the state of a slot is stored in its control byte, there are no reserved
+// key values (as opposed to the former empty/deleted key approach).
+template <typename Key, typename Element_, typename KeyOf, typename Hash,
+          bool Cache, size_t SizeFactor, bool Erasable>
+class ControlByteHashTable {
  public:
-  using Iterator = HashTableIterator<HashMap>;
+  using Element = Element_;
+  using Position = uint32_t;
+  using Iterator = HashTableIterator<ControlByteHashTable>;
 
   friend Iterator;
 
-  explicit HashMap(const uint64_t max_size = 0) :
-    _empty_element_key(false),
-    _deleted_element_key(false),
-    _empty_element(std::numeric_limits<Key>::max(), Value()),
-    _deleted_element(_empty_element.first - 1, Value()),
+ private:
+  static constexpr Position kInvalidPosition = std::numeric_limits<Position>::max();
+
+ public:
+  explicit ControlByteHashTable(const uint64_t max_size = 0) :
     _ht_size(max_size * SizeFactor),
     _max_size(max_size),
-    _ht(_ht_size + _max_size * 1.1, std::make_pair(_empty_element.first, Value())),
+    _ctrl(),
+    _ht(),
     _poses(),
-    _pos_in_position(_ht_size + _max_size * 1.1),
+    _pos_in_position(),
+    _deleted_poses(),
+    _num_deleted(0),
     _hash(),
-    _last_key(_empty_element.first),
-    _last_position(0) {
-    _poses.reserve(max_size);
+    _key_of(),
+    _last_key(),
+    _last_position(kInvalidPosition),
+    _fragment(0) {
+    allocate(max_size);
   }
 
-  HashMap(const HashMap&) = default;
-  HashMap(HashMap&&) = default;
+  ControlByteHashTable(const ControlByteHashTable&) = default;
+  ControlByteHashTable(ControlByteHashTable&&) = default;
 
-  HashMap& operator= (const HashMap& other) = delete;
-  HashMap& operator= (HashMap&& other) = delete;
+  ControlByteHashTable& operator= (const ControlByteHashTable& other) = default;
+  ControlByteHashTable& operator= (ControlByteHashTable&& other) = default;
 
-  ~HashMap() = default;
+  ~ControlByteHashTable() = default;
 
-  void reserve(const uint32_t max_size) {
+  // Removes all elements and prepares the table for up to max_size elements.
+  // Memory is only reallocated if the table is too small. Otherwise only the
+  // home area is resized, which keeps the probe sequences of small
+  // sets compact if the same table is reused for sets of varying size.
+  void reserve(const uint64_t max_size) {
+    clear();
+    if (max_size * SizeFactor + overflowSize(max_size) > _ht.size()) {
+      allocate(max_size);
+    }
     _ht_size = max_size * SizeFactor;
     _max_size = max_size;
-    _ht.resize(_ht_size + _max_size * 1.1, std::make_pair(_empty_element.first, Value()));
-    _pos_in_position.resize(_ht_size + _max_size * 1.1);
   }
 
-  size_t size() const {
-    return _poses.size() + _empty_element_key + _deleted_element_key;
+  uint64_t size() const {
+    return _poses.size();
   }
 
   Iterator begin() const {
@@ -160,385 +253,305 @@ class HashMap {
     return size() == 0;
   }
 
-  void erase(const Key& key) {
-    if (key == _empty_element.first) {
-      _empty_element_key = false;
-      return;
-    }
-
-    if (key == _deleted_element.first) {
-      _deleted_element_key = false;
-      return;
-    }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos].first != _empty_element.first) {
-      _ht[pos].first = _deleted_element.first;
-      const uint32_t pos_of_deleted = _pos_in_position[pos];
-      _pos_in_position[_poses.back()] = pos_of_deleted;
-      std::swap(_poses[pos_of_deleted], _poses.back());
-      _poses.resize(_poses.size() - 1);
-    }
-  }
-
-  Value& operator[] (const Key& key) {
-    if (key == _empty_element.first) {
-      if (!_empty_element_key) {
-        _empty_element_key = true;
-        _empty_element.second = Value();
-      }
-      return _empty_element.second;
-    }
-
-    if (key == _deleted_element.first) {
-      if (!_deleted_element_key) {
-        _deleted_element_key = true;
-        _deleted_element.second = Value();
-      }
-      return _deleted_element.second;
-    }
-
-    const Position pos = findPosition(key);
-
-    if (_ht[pos].first == _empty_element.first) {
-      _ht[pos].first = key;
-      _ht[pos].second = Value();
-      _poses.push_back(pos);
-      _pos_in_position[pos] = _poses.size() - 1;
-    }
-
-    return _ht[pos].second;
+  bool contains(const Key& key) {
+    return isFull(_ctrl[findPosition(key)]);
   }
 
-  bool contains(const Key& key) {
-    if (key == _empty_element.first) {
-      return _empty_element_key;
+  void clear() {
+    for (const Position pos : _poses) {
+      _ctrl[pos] = static_cast<int8_t>(ControlByte::empty);
     }
-
-    if (key == _deleted_element.first) {
-      return _deleted_element_key;
+    for (const Position pos : _deleted_poses) {
+      _ctrl[pos] = static_cast<int8_t>(ControlByte::empty);
     }
-
-    return _ht[findPosition(key)].first != _empty_element.first;
+    _poses.clear();
+    _deleted_poses.clear();
+    _num_deleted = 0;
+    _last_position = kInvalidPosition;
   }
 
-  void insert(const Element& elem) {
-    insertImpl(elem.first, elem.second);
+  void swap(ControlByteHashTable& other) {
+    std::swap(_ht_size, other._ht_size);
+    std::swap(_max_size, other._max_size);
+    _ctrl.swap(other._ctrl);
+    _ht.swap(other._ht);
+    _poses.swap(other._poses);
+    _pos_in_position.swap(other._pos_in_position);
+    _deleted_poses.swap(other._deleted_poses);
+    std::swap(_num_deleted, other._num_deleted);
+    std::swap(_last_key, other._last_key);
+    std::swap(_last_position, other._last_position);
+    std::swap(_fragment, other._fragment);
   }
 
-  void insert(const Key& key, const Value& value) {
-    insertImpl(key, value);
+ protected:
+  static bool isFull(const int8_t ctrl) {
+    return ctrl >= 0;
   }
 
-  void clear() {
-    for (const auto& pos : _poses) {
-      _ht[pos].first = _empty_element.first;
+  // Returns the position of key or, if key is not contained, the first
+  // deleted or empty slot of its probe sequence.
+  Position findPosition(const Key& key) {
+    if (Cache && _last_position != kInvalidPosition && key == _last_key) {
+      return _last_position;
     }
-    _poses.clear();
-
-    _last_key = _empty_element.first;
-    _last_position = 0;
-
-    _empty_element_key = false;
-    _deleted_element_key = false;
-  }
 
-  void swap(HashMap& hash_map) {
-    std::swap(_ht_size, hash_map._ht_size);
-    std::swap(_max_size, hash_map._max_size);
-    _ht.swap(hash_map._ht);
-    _poses.swap(hash_map._poses);
-    std::swap(_last_key, hash_map._last_key);
-    std::swap(_last_position, hash_map._last_position);
-    _pos_in_position.swap(hash_map._pos_in_position);
-    _empty_element.swap(hash_map._empty_element);
-    _deleted_element.swap(hash_map._deleted_element);
-    std::swap(_empty_element_key, hash_map._empty_element_key);
-    std::swap(_deleted_element_key, hash_map._deleted_element_key);
-  }
+    const size_t hash = _hash(key);
+    _fragment = h2(hash);
+    const Position num_slots = _ht.size();
+    Position first_deleted = kInvalidPosition;
+    for (Position pos = hash % _ht_size; pos < num_slots; pos += ControlGroup::kWidth) {
+      const ControlGroup group(&_ctrl[pos]);
+      for (ControlGroup::Mask candidates = group.match(_fragment); candidates != 0;
+           candidates &= candidates - 1) {
+        const Position candidate = pos + ControlGroup::lowestSetBit(candidates);
+        if (_key_of(_ht[candidate]) == key) {
+          return cache(key, candidate);
+        }
+      }
+      if (Erasable && first_deleted == kInvalidPosition) {
+        const ControlGroup::Mask deleted_slots = group.matchDeleted();
+        if (deleted_slots != 0) {
+          first_deleted = pos + ControlGroup::lowestSetBit(deleted_slots);
+        }
+      }
+      const ControlGroup::Mask empty_slots = group.matchEmpty();
+      if (empty_slots != 0) {
+        // key is not contained: prefer to reuse deleted slots for insertions
+        return cache(key, first_deleted != kInvalidPosition ?
+                     first_deleted : pos + ControlGroup::lowestSetBit(empty_slots));
+      }
+    }
 
- private:
-  Position getNumSpecials() const {
-    return _empty_element_key + _deleted_element_key;
+    std::cerr << "hash table overflowed" << std::endl;
+    std::exit(-1);
   }
 
-  const Element* getSpecialElement(const Position offset) const {
-    if (_empty_element_key && offset == 0) {
-      return &_empty_element;
+  // Marks the (non-full) slot at pos returned by the last call of findPosition
+  // as occupied. The element itself has to be written by the caller.
+  void occupy(const Position pos) {
+    ASSERT(!isFull(_ctrl[pos]), V(pos));
+    if (Erasable && _ctrl[pos] == static_cast<int8_t>(ControlByte::deleted)) {
+      // pos stays in _deleted_poses until the next compaction
+      --_num_deleted;
     }
-    if (_deleted_element_key && offset == 1) {
-      return &_deleted_element;
+    _ctrl[pos] = _fragment;
+    _poses.push_back(pos);
+    if (Erasable) {
+      _pos_in_position[pos] = _poses.size() - 1;
     }
-    return nullptr;
   }
 
-  void insertImpl(const Key& key, const Value& value) {
-    if (key == _empty_element.first) {
-      if (!_empty_element_key) {
-        _empty_element_key = true;
-        _empty_element.second = value;
-      }
-      return;
+  void release(const Position pos) {
+    ASSERT(Erasable, "Table does not support deletions");
+    ASSERT(isFull(_ctrl[pos]), V(pos));
+    // A deleted slot cannot become empty, because that would break
+    // the probe sequences of elements that were inserted after it.
+    _ctrl[pos] = static_cast<int8_t>(ControlByte::deleted);
+    ++_num_deleted;
+    _deleted_poses.push_back(pos);
+    if (_deleted_poses.size() > 2 * _num_deleted + ControlGroup::kWidth) {
+      compactDeletedPositions();
     }
+    const Position pos_of_deleted = _pos_in_position[pos];
+    _pos_in_position[_poses.back()] = pos_of_deleted;
+    std::swap(_poses[pos_of_deleted], _poses.back());
+    _poses.pop_back();
+  }
 
-    if (key == _deleted_element.first) {
-      if (!_deleted_element_key) {
-        _deleted_element_key = true;
-        _deleted_element.second = value;
+  uint64_t _ht_size;
+  uint64_t _max_size;
+  std::vector<int8_t> _ctrl;
+  std::vector<Element> _ht;
+  std::vector<Position> _poses;
+  std::vector<Position> _pos_in_position;
+  // Deleted slots that are reused by insertions are only removed from
+  // _deleted_poses by compactDeletedPositions, which keeps release O(1).
+  std::vector<Position> _deleted_poses;
+  uint64_t _num_deleted;
+  Hash _hash;
+  KeyOf _key_of;
+
+ private:
+  static uint64_t overflowSize(const uint64_t max_size) {
+    return max_size * 1.1;
+  }
+
+  // Fragment of the hash value that is stored in the control byte. Since the
+  // home position is derived from the lower bits, the fragment is taken from
+  // the upper bits of the mixed hash value.
+  static int8_t h2(const size_t hash) {
+    return static_cast<int8_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 57);
+  }
+
+  // Removes slots that were reused by insertions and duplicates of slots that
+  // were deleted several times. This happens once more than half of the
+  // entries are stale, so erase/insert churn cannot grow _deleted_poses
+  // beyond twice the number of deleted slots.
+  void compactDeletedPositions() {
+    size_t num_kept = 0;
+    for (size_t i = 0; i < _deleted_poses.size(); ++i) {
+      const Position pos = _deleted_poses[i];
+      if (_ctrl[pos] == static_cast<int8_t>(ControlByte::deleted)) {
+        // temporarily marked to skip duplicates
+        _ctrl[pos] = static_cast<int8_t>(ControlByte::sentinel);
+        _deleted_poses[num_kept++] = pos;
       }
-      return;
     }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos].first == _empty_element.first) {
-      _ht[pos].first = key;
-      _ht[pos].second = value;
-      _poses.push_back(pos);
-      _pos_in_position[pos] = _poses.size() - 1;
+    _deleted_poses.resize(num_kept);
+    for (const Position pos : _deleted_poses) {
+      _ctrl[pos] = static_cast<int8_t>(ControlByte::deleted);
     }
+    ASSERT(_deleted_poses.size() == _num_deleted, V(_deleted_poses.size()) << V(_num_deleted));
   }
 
-  Position findPosition(const Key& key) {
-    if (Cache && key == _last_key) {
-      return _last_position;
+  Position cache(const Key& key, const Position pos) {
+    if (Cache) {
+      _last_key = key;
+      _last_position = pos;
     }
+    return pos;
+  }
 
-    const Position startPosition = _hash(key) % _ht_size;
-    for (Position pos = startPosition; pos < _ht.size(); ++pos) {
-      if (_ht[pos].first == _empty_element.first || _ht[pos].first == key) {
-        if (Cache) {
-          _last_key = key;
-          _last_position = pos;
-        }
-        return pos;
-      }
+  void allocate(const uint64_t max_size) {
+    const uint64_t num_slots = max_size * SizeFactor + overflowSize(max_size);
+    _ht.assign(num_slots, Element());
+    _ctrl.assign(num_slots, static_cast<int8_t>(ControlByte::empty));
+    _ctrl.resize(num_slots + ControlGroup::kWidth, static_cast<int8_t>(ControlByte::sentinel));
+    if (Erasable) {
+      _pos_in_position.assign(num_slots, 0);
     }
-
-    std::cerr << "hash table overflowed" << std::endl;
-    std::exit(-1);
+    _poses.reserve(max_size);
   }
 
-  const Position _num_specials = 2;
-  bool _empty_element_key;
-  bool _deleted_element_key;
-  Element _empty_element;
-  Element _deleted_element;
-  uint64_t _ht_size;
-  uint64_t _max_size;
-  std::vector<Element> _ht;
-  std::vector<Position> _poses;
-  std::vector<uint32_t> _pos_in_position;
-  Hash _hash;
   Key _last_key;
   Position _last_position;
+  // control byte of the key that was probed most recently
+  int8_t _fragment;
 };
 
 template <typename Key, typename Value, typename Hash = SimpleHash<Key>,
           bool Cache = true, size_t SizeFactor = 2>
-class InsertOnlyHashMap {
+class HashMap : public ControlByteHashTable<Key, std::pair<Key, Value>, MapKey<Key>,
+                                            Hash, Cache, SizeFactor, true>{
+  using Base = ControlByteHashTable<Key, std::pair<Key, Value>, MapKey<Key>,
+                                    Hash, Cache, SizeFactor, true>;
+
  public:
   using Element = std::pair<Key, Value>;
   using key_type = Key;
   using mapped_type = Value;
 
- private:
-  using Position = uint32_t;
-
- public:
-  using Iterator = HashTableIterator<InsertOnlyHashMap>;
-
-  friend Iterator;
-
-  explicit InsertOnlyHashMap(const uint64_t max_size = 0) :
-    _empty_element_key(false),
-    _empty_element(std::numeric_limits<Key>::max(), Value()),
-    _ht_size(max_size * SizeFactor),
-    _max_size(max_size),
-    _ht(_ht_size + _max_size * 1.1, std::make_pair(_empty_element.first, Value())),
-    _poses(),
-    _hash(),
-    _last_key(_empty_element.first),
-    _last_position(0) {
-    _poses.reserve(max_size);
-  }
-
-  InsertOnlyHashMap(const InsertOnlyHashMap&) = default;
-  InsertOnlyHashMap(InsertOnlyHashMap&&) = default;
-
-  InsertOnlyHashMap& operator= (const InsertOnlyHashMap& other) = default;
-  InsertOnlyHashMap& operator= (InsertOnlyHashMap&& other) = default;
-
-  ~InsertOnlyHashMap() = default;
-
-  void reserve(const uint32_t max_size) {
-    _ht_size = max_size * SizeFactor;
-    _max_size = max_size;
-    _ht.resize(_ht_size + _max_size * 1.1, std::make_pair(_empty_element, Value()));
-  }
+  explicit HashMap(const uint64_t max_size = 0) :
+    Base(max_size) { }
 
-  uint64_t size() const {
-    return _poses.size() + _empty_element_key;
-  }
+  HashMap(const HashMap&) = default;
+  HashMap(HashMap&&) = default;
 
-  Iterator begin() const {
-    return Iterator(*this, 0);
-  }
+  HashMap& operator= (const HashMap& other) = delete;
+  HashMap& operator= (HashMap&& other) = delete;
 
-  Iterator end() const {
-    return Iterator(*this, size());
-  }
+  ~HashMap() = default;
 
-  bool empty() const {
-    return size() == 0;
+  void erase(const Key& key) {
+    const Position pos = Base::findPosition(key);
+    if (Base::isFull(_ctrl[pos])) {
+      Base::release(pos);
+    }
   }
 
   Value& operator[] (const Key& key) {
-    if (key == _empty_element.first) {
-      if (!_empty_element_key) {
-        _empty_element_key = true;
-        _empty_element.second = Value();
-      }
-      return _empty_element.second;
-    }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos].first == _empty_element.first) {
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
       _ht[pos].first = key;
       _ht[pos].second = Value();
-      _poses.push_back(pos);
     }
-
     return _ht[pos].second;
   }
 
-  bool contains(const Key& key) {
-    if (key == _empty_element.first) {
-      return _empty_element_key;
-    }
-
-    return _ht[findPosition(key)].first != _empty_element.first;
-  }
-
   void insert(const Element& elem) {
-    insertImpl(elem.first, elem.second);
+    insert(elem.first, elem.second);
   }
 
   void insert(const Key& key, const Value& value) {
-    insertImpl(key, value);
-  }
-
-  void clear() {
-    for (const auto& pos : _poses) {
-      _ht[pos].first = _empty_element;
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
+      _ht[pos].first = key;
+      _ht[pos].second = value;
     }
+  }
 
-    _poses.clear();
+ private:
+  using Position = typename Base::Position;
+  using Base::_ctrl;
+  using Base::_ht;
+};
 
-    _last_key = _empty_element;
-    _last_position = 0;
+template <typename Key, typename Value, typename Hash = SimpleHash<Key>,
+          bool Cache = true, size_t SizeFactor = 2>
+class InsertOnlyHashMap : public ControlByteHashTable<Key, std::pair<Key, Value>, MapKey<Key>,
+                                                      Hash, Cache, SizeFactor, false>{
+  using Base = ControlByteHashTable<Key, std::pair<Key, Value>, MapKey<Key>,
+                                    Hash, Cache, SizeFactor, false>;
 
-    _empty_element_key = false;
-  }
+ public:
+  using Element = std::pair<Key, Value>;
+  using key_type = Key;
+  using mapped_type = Value;
 
-  void swap(InsertOnlyHashMap& hash_map) {
-    std::swap(_ht_size, hash_map._ht_size);
-    std::swap(_max_size, hash_map._max_size);
-    _ht.swap(hash_map._ht);
-    _poses.swap(hash_map._poses);
-    std::swap(_last_key, hash_map._last_key);
-    std::swap(_last_position, hash_map._last_position);
-    _empty_element.swap(hash_map._empty_element);
-    std::swap(_empty_element_key, hash_map._empty_element_key);
-  }
+  explicit InsertOnlyHashMap(const uint64_t max_size = 0) :
+    Base(max_size) { }
 
- private:
-  Position getNumSpecials() const {
-    return _empty_element_key;
-  }
+  InsertOnlyHashMap(const InsertOnlyHashMap&) = default;
+  InsertOnlyHashMap(InsertOnlyHashMap&&) = default;
 
-  const Element* getSpecialElement(const Position offset) const {
-    if (_empty_element_key && offset == 0) {
-      return &_empty_element;
-    }
-    return nullptr;
-  }
+  InsertOnlyHashMap& operator= (const InsertOnlyHashMap& other) = default;
+  InsertOnlyHashMap& operator= (InsertOnlyHashMap&& other) = default;
 
-  void insertImpl(const Key& key, const Value& value) {
-    if (key == _empty_element.first) {
-      if (!_empty_element_key) {
-        _empty_element_key = true;
-        _empty_element.second = value;
-      }
-      return;
-    }
+  ~InsertOnlyHashMap() = default;
 
-    const Position pos = findPosition(key);
-    if (_ht[pos].first == _empty_element.first) {
+  Value& operator[] (const Key& key) {
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
       _ht[pos].first = key;
-      _ht[pos].second = value;
-      _poses.push_back(pos);
+      _ht[pos].second = Value();
     }
+    return _ht[pos].second;
   }
 
-  Position findPosition(const Key& key) {
-    if (Cache && key == _last_key) {
-      return _last_position;
-    }
+  void insert(const Element& elem) {
+    insert(elem.first, elem.second);
+  }
 
-    const Position startPosition = _hash(key) % _ht_size;
-    for (Position pos = startPosition; pos < _ht.size(); ++pos) {
-      if (_ht[pos].first == _empty_element.first || _ht[pos].first == key) {
-        if (Cache) {
-          _last_key = key;
-          _last_position = pos;
-        }
-        return pos;
-      }
+  void insert(const Key& key, const Value& value) {
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
+      _ht[pos].first = key;
+      _ht[pos].second = value;
     }
-
-    std::cerr << "hash table overflowed" << std::endl;
-    std::exit(-1);
   }
 
-  const Position _num_specials = 1;
-  bool _empty_element_key;
-  Element _empty_element;
-  uint64_t _ht_size;
-  uint64_t _max_size;
-  std::vector<Element> _ht;
-  std::vector<Position> _poses;
-  Hash _hash;
-  Key _last_key;
-  Position _last_position;
+ private:
+  using Position = typename Base::Position;
+  using Base::_ctrl;
+  using Base::_ht;
 };
 
 template <typename Key, typename Hash = SimpleHash<Key>, bool Cache = true, size_t SizeFactor = 2>
-class HashSet {
+class HashSet : public ControlByteHashTable<Key, Key, SetKey<Key>,
+                                            Hash, Cache, SizeFactor, true>{
+  using Base = ControlByteHashTable<Key, Key, SetKey<Key>, Hash, Cache, SizeFactor, true>;
+
  public:
   using Element = Key;
   using key_type = Key;
 
- private:
-  using Position = uint32_t;
-
- public:
-  using Iterator = HashTableIterator<HashSet>;
-
-  friend Iterator;
-
   explicit HashSet(const uint64_t max_size = 0) :
-    _empty_element_key(false),
-    _deleted_element_key(false),
-    _empty_element(std::numeric_limits<Key>::max()),
-    _deleted_element(_empty_element - 1),
-    _ht_size(max_size * SizeFactor),
-    _max_size(max_size),
-    _ht(_ht_size + _max_size * 1.1, _empty_element),
-    _pos_in_position(_ht_size + _max_size * 1.1),
-    _last_key(_empty_element),
-    _last_position(0) {
-    _poses.reserve(max_size);
-  }
+    Base(max_size) { }
 
   HashSet(const HashSet&) = default;
   HashSet(HashSet&&) = default;
@@ -548,190 +561,37 @@ class HashSet {
 
   ~HashSet() = default;
 
-  void reserve(const uint32_t max_size) {
-    _ht_size = max_size * SizeFactor;
-    _max_size = max_size;
-    _ht.resize(_ht_size + _max_size * 1.1, _empty_element);
-    _pos_in_position.resize(_ht_size + _max_size * 1.1);
-  }
-
-  uint64_t size() const {
-    return _poses.size() + _empty_element_key + _deleted_element_key;
-  }
-
-  Iterator begin() const {
-    return Iterator(*this, 0);
-  }
-
-  Iterator end() const {
-    return Iterator(*this, size());
-  }
-
-  bool empty() const {
-    return size() == 0;
-  }
-
   void erase(const Key& key) {
-    if (key == _empty_element) {
-      _empty_element_key = false;
-      return;
+    const Position pos = Base::findPosition(key);
+    if (Base::isFull(_ctrl[pos])) {
+      Base::release(pos);
     }
-
-    if (key == _deleted_element) {
-      _deleted_element_key = false;
-      return;
-    }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos] != _empty_element) {
-      _ht[pos] = _deleted_element;
-      const uint32_t pos_of_deleted = _pos_in_position[pos];
-      _pos_in_position[_poses.back()] = pos_of_deleted;
-      std::swap(_poses[pos_of_deleted], _poses.back());
-      _poses.resize(_poses.size() - 1);
-    }
-  }
-
-  bool contains(const Key& key) {
-    if (key == _empty_element) {
-      return _empty_element_key;
-    }
-
-    if (key == _deleted_element) {
-      return _deleted_element_key;
-    }
-
-    return _ht[findPosition(key)] != _empty_element;
   }
 
   void insert(const Key& key) {
-    insertImpl(key);
-  }
-
-  void clear() {
-    for (const auto& pos : _poses) {
-      _ht[pos] = _empty_element;
-    }
-
-    _poses.clear();
-
-    _last_key = _empty_element;
-    _last_position = 0;
-
-    _empty_element_key = false;
-    _deleted_element_key = false;
-  }
-
-  void swap(HashSet& hash_set) {
-    std::swap(_ht_size, hash_set._ht_size);
-    std::swap(_max_size, hash_set._max_size);
-    _ht.swap(hash_set._ht);
-    _poses.swap(hash_set._poses);
-    std::swap(_last_key, hash_set._last_key);
-    std::swap(_last_position, hash_set._last_position);
-    _pos_in_position.swap(hash_set._pos_in_position);
-    std::swap(_empty_element_key, hash_set._empty_element_key);
-    std::swap(_deleted_element_key, hash_set._deleted_element_key);
-  }
-
- private:
-  Position getNumSpecials() const {
-    return _empty_element_key + _deleted_element_key;
-  }
-
-  const Element* getSpecialElement(const Position offset) const {
-    if (_empty_element_key && offset == 0) {
-      return &_empty_element;
-    }
-    if (_deleted_element_key && offset == 1) {
-      return &_deleted_element;
-    }
-    return nullptr;
-  }
-
-  void insertImpl(const Key& key) {
-    if (key == _empty_element) {
-      if (!_empty_element_key) {
-        _empty_element_key = true;
-      }
-      return;
-    }
-
-    if (key == _deleted_element) {
-      if (!_deleted_element_key) {
-        _deleted_element_key = true;
-      }
-      return;
-    }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos] == _empty_element) {
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
       _ht[pos] = key;
-      _poses.push_back(pos);
-      _pos_in_position[pos] = _poses.size() - 1;
     }
   }
 
-  Position findPosition(const Key& key) {
-    if (Cache && key == _last_key) {
-      return _last_position;
-    }
-
-    const Position startPosition = _hash(key) % _ht_size;
-    for (Position pos = startPosition; pos < _ht.size(); ++pos) {
-      if (_ht[pos] == _empty_element || _ht[pos] == key) {
-        if (Cache) {
-          _last_key = key;
-          _last_position = pos;
-        }
-        return pos;
-      }
-    }
-
-    std::cerr << "hash table overflowed" << std::endl;
-    std::exit(-1);
-  }
-
-  const Position _num_specials = 2;
-  bool _empty_element_key;
-  bool _deleted_element_key;
-  const Key _empty_element;
-  const Key _deleted_element;
-  uint64_t _ht_size;
-  uint64_t _max_size;
-  std::vector<Element> _ht;
-  std::vector<Position> _poses;
-  std::vector<uint32_t> _pos_in_position;
-  Hash _hash;
-  Key _last_key;
-  Position _last_position;
+ private:
+  using Position = typename Base::Position;
+  using Base::_ctrl;
+  using Base::_ht;
 };
 
 template <typename Key, typename Hash = SimpleHash<Key>, bool Cache = true, size_t SizeFactor = 2>
-class InsertOnlyHashSet {
- public:
-  using Element = Key;
-
- private:
-  using Position = uint32_t;
+class InsertOnlyHashSet : public ControlByteHashTable<Key, Key, SetKey<Key>,
+                                                      Hash, Cache, SizeFactor, false>{
+  using Base = ControlByteHashTable<Key, Key, SetKey<Key>, Hash, Cache, SizeFactor, false>;
 
  public:
-  using Iterator = HashTableIterator<InsertOnlyHashSet>;
-
-  friend Iterator;
+  using Element = Key;
 
   explicit InsertOnlyHashSet(const uint64_t max_size = 0) :
-    _empty_element_key(false),
-    _empty_element(std::numeric_limits<Key>::max()),
-    _ht_size(max_size * SizeFactor),
-    _max_size(max_size),
-    _ht(_ht_size + _max_size * 1.1, _empty_element),
-    _poses(),
-    _hash(),
-    _last_key(_empty_element),
-    _last_position(0) {
-    _poses.reserve(max_size);
-  }
+    Base(max_size) { }
 
   InsertOnlyHashSet(const InsertOnlyHashSet&) = default;
   InsertOnlyHashSet(InsertOnlyHashSet&&) = default;
@@ -741,118 +601,18 @@ class InsertOnlyHashSet {
 
   ~InsertOnlyHashSet() = default;
 
-  void reserve(const uint32_t max_size) {
-    _ht_size = max_size * SizeFactor;
-    _max_size = max_size;
-    _ht.resize(_ht_size + _max_size * 1.1, _empty_element);
-  }
-
-  uint64_t size() const {
-    return _poses.size() + _empty_element_key;
-  }
-
-  Iterator begin() const {
-    return Iterator(*this, 0);
-  }
-
-  Iterator end() const {
-    return Iterator(*this, size());
-  }
-
-  bool empty() const {
-    return size() == 0;
-  }
-
-  bool contains(const Key& key) {
-    if (key == _empty_element) {
-      return _empty_element_key;
-    }
-    return _ht[findPosition(key)] != _empty_element;
-  }
-
   void insert(const Key& key) {
-    insertImpl(key);
-  }
-
-  void clear() {
-    for (const auto& pos : _poses) {
-      _ht[pos] = _empty_element;
-    }
-
-    _poses.clear();
-
-    _last_key = _empty_element;
-    _last_position = 0;
-
-    _empty_element_key = false;
-  }
-
-  void swap(InsertOnlyHashSet& hash_set) {
-    std::swap(_ht_size, hash_set._ht_size);
-    std::swap(_max_size, hash_set._max_size);
-    _ht.swap(hash_set._ht);
-    _poses.swap(hash_set._poses);
-    std::swap(_last_key, hash_set._last_key);
-    std::swap(_last_position, hash_set._last_position);
-    std::swap(_empty_element_key, hash_set._empty_element_key);
-  }
-
- private:
-  Position getNumSpecials() const {
-    return _empty_element_key;
-  }
-
-  const Element* getSpecialElement(const Position offset) const {
-    if (_empty_element_key && offset == 0) {
-      return &_empty_element;
-    } else {
-      return nullptr;
-    }
-  }
-
-  void insertImpl(const Key& key) {
-    if (key == _empty_element && !_empty_element_key) {
-      _empty_element_key = true;
-      return;
-    }
-
-    const Position pos = findPosition(key);
-    if (_ht[pos] == _empty_element) {
+    const Position pos = Base::findPosition(key);
+    if (!Base::isFull(_ctrl[pos])) {
+      Base::occupy(pos);
       _ht[pos] = key;
-      _poses.push_back(pos);
-    }
-  }
-
-  Position findPosition(const Key& key) {
-    if (Cache && key == _last_key) {
-      return _last_position;
-    }
-
-    const Position startPosition = _hash(key) % _ht_size;
-    for (Position pos = startPosition; pos < _ht.size(); ++pos) {
-      if (_ht[pos] == _empty_element || _ht[pos] == key) {
-        if (Cache) {
-          _last_key = key;
-          _last_position = pos;
-        }
-        return pos;
-      }
     }
-
-    std::cerr << "hash table overflowed" << std::endl;
-    std::exit(-1);
   }
 
-  const Position _num_specials = 2;
-  bool _empty_element_key;
-  const Key _empty_element;
-  uint64_t _ht_size;
-  uint64_t _max_size;
-  std::vector<Element> _ht;
-  std::vector<Position> _poses;
-  Hash _hash;
-  Key _last_key;
-  Position _last_position;
+ private:
+  using Position = typename Base::Position;
+  using Base::_ctrl;
+  using Base::_ht;
 };
 }  // namespace ds
 }  // namespace kahypar
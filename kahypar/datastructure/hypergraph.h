@@ -504,68 +504,135 @@ class GenericHypergraph {
                     const PartitionID k = 2,
                     const HyperedgeWeightVector* hyperedge_weights = nullptr,
                     const HypernodeWeightVector* hypernode_weights = nullptr) :
-    _num_hypernodes(num_hypernodes),
-    _num_hyperedges(num_hyperedges),
-    _num_pins(edge_vector.size()),
-    _total_weight(0),
-    _k(k),
-    _type(Type::Unweighted),
-    _current_num_hypernodes(_num_hypernodes),
-    _current_num_hyperedges(_num_hyperedges),
-    _current_num_pins(_num_pins),
-    _threshold_active(1),
-    _threshold_marked(2),
-    _hypernodes(_num_hypernodes, Hypernode(0, 0, 1)),
-    _hyperedges(_num_hyperedges, Hyperedge(0, 0, 1)),
-    _incidence_array(2 * _num_pins, 0),
-    _communities(_num_hypernodes, 0),
-    _part_info(_k),
-    _pins_in_part(_num_hyperedges * k),
-    _connectivity_sets(_num_hyperedges, k),
-    _hes_not_containing_u(_num_hyperedges) {
+    GenericHypergraph(num_hypernodes, num_hyperedges, edge_vector.size(), index_vector.data(),
+                      edge_vector.data(), k,
+                      hyperedge_weights != nullptr && !hyperedge_weights->empty() ?
+                      hyperedge_weights->data() : nullptr,
+                      hypernode_weights != nullptr && !hypernode_weights->empty() ?
+                      hypernode_weights->data() : nullptr) { }
+
+  /*!
+   * Construct a hypergraph from raw arrays, e.g. from a memory mapped file.
+   *
+   * \param num_hypernodes Number of hypernodes |V|
+   * \param num_hyperedges Number of hyperedges |E|
+   * \param num_pins Number of pins
+   * \param hyperedge_offsets |E|+1 offsets of the pins of each hyperedge in pins
+   * \param pins Stores the pins of all hyperedges.
+   * \param k Number of blocks the hypergraph should be partitioned in
+   * \param hyperedge_weights Optional weight for each hyperedge
+   * \param hypernode_weights Optional weight for each hypernode
+   * \param hypernode_offsets Optional |V|+1 offsets of the incident nets of each hypernode
+   * \param incident_nets Optional incident nets of all hypernodes in increasing order.
+   * If given, the incident nets are not recomputed from the pins.
+   */
+  GenericHypergraph(const HypernodeID num_hypernodes,
+                    const HyperedgeID num_hyperedges,
+                    const size_t num_pins,
+                    const size_t* hyperedge_offsets,
+                    const HypernodeID* pins,
+                    const PartitionID k,
+                    const HyperedgeWeight* hyperedge_weights,
+                    const HypernodeWeight* hypernode_weights,
+                    const size_t* hypernode_offsets = nullptr,
+                    const HyperedgeID* incident_nets = nullptr) :
+    GenericHypergraph() {
+    initialize(num_hypernodes, num_hyperedges, num_pins, hyperedge_offsets, pins, k,
+               hyperedge_weights, hypernode_weights, hypernode_offsets, incident_nets);
+  }
+
+  /*!
+   * Replaces the hypergraph by the one given as raw arrays (see above).
+   * In contrast to constructing a new hypergraph, the memory of the current
+   * hypergraph is reused if it is large enough.
+   */
+  void initialize(const HypernodeID num_hypernodes,
+                  const HyperedgeID num_hyperedges,
+                  const size_t num_pins,
+                  const size_t* hyperedge_offsets,
+                  const HypernodeID* pins,
+                  const PartitionID k,
+                  const HyperedgeWeight* hyperedge_weights,
+                  const HypernodeWeight* hypernode_weights,
+                  const size_t* hypernode_offsets = nullptr,
+                  const HyperedgeID* incident_nets = nullptr) {
+    _num_hypernodes = num_hypernodes;
+    _num_hyperedges = num_hyperedges;
+    _num_pins = num_pins;
+    _total_weight = 0;
+    _k = k;
+    _type = Type::Unweighted;
+    _current_num_hypernodes = _num_hypernodes;
+    _current_num_hyperedges = _num_hyperedges;
+    _current_num_pins = _num_pins;
+    _threshold_active = 1;
+    _threshold_marked = 2;
+    _hypernodes.assign(_num_hypernodes, Hypernode(0, 0, 1));
+    _hyperedges.assign(_num_hyperedges, Hyperedge(0, 0, 1));
+    _incidence_array.assign(2 * _num_pins, 0);
+    _communities.assign(_num_hypernodes, 0);
+    _part_info.assign(_k, PartInfo());
+    _pins_in_part.assign(static_cast<size_t>(_num_hyperedges) * k, 0);
+    _connectivity_sets.initialize(_num_hyperedges, k);
+    _hes_not_containing_u.resize(_num_hyperedges);
+
+    ASSERT((hypernode_offsets == nullptr) == (incident_nets == nullptr),
+           "Incident nets require hypernode offsets");
+    const bool compute_incident_nets = incident_nets == nullptr;
     VertexID edge_vector_index = 0;
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
       hyperedge(i).setFirstEntry(edge_vector_index);
-      for (VertexID pin_index = index_vector[i];
-           pin_index < index_vector[static_cast<size_t>(i) + 1]; ++pin_index) {
+      for (VertexID pin_index = hyperedge_offsets[i];
+           pin_index < hyperedge_offsets[static_cast<size_t>(i) + 1]; ++pin_index) {
         hyperedge(i).incrementSize();
-        hyperedge(i).hash += math::hash(edge_vector[pin_index]);
-        _incidence_array[pin_index] = edge_vector[pin_index];
-        hypernode(edge_vector[pin_index]).incrementSize();
+        hyperedge(i).hash += math::hash(pins[pin_index]);
+        _incidence_array[pin_index] = pins[pin_index];
+        if (compute_incident_nets) {
+          hypernode(pins[pin_index]).incrementSize();
+        }
         ++edge_vector_index;
       }
     }
 
-    hypernode(0).setFirstEntry(_num_pins);
-    for (HypernodeID i = 0; i < _num_hypernodes - 1; ++i) {
-      hypernode(i + 1).setFirstEntry(hypernode(i).firstInvalidEntry());
-      hypernode(i).setSize(0);
-    }
-    hypernode(num_hypernodes - 1).setSize(0);
+    if (compute_incident_nets) {
+      hypernode(0).setFirstEntry(_num_pins);
+      for (HypernodeID i = 0; i < _num_hypernodes - 1; ++i) {
+        hypernode(i + 1).setFirstEntry(hypernode(i).firstInvalidEntry());
+        hypernode(i).setSize(0);
+      }
+      hypernode(num_hypernodes - 1).setSize(0);
 
-    for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
-      for (VertexID pin_index = index_vector[i]; pin_index <
-           index_vector[static_cast<size_t>(i) + 1]; ++pin_index) {
-        const HypernodeID pin = edge_vector[pin_index];
-        _incidence_array[hypernode(pin).firstInvalidEntry()] = i;
-        hypernode(pin).incrementSize();
+      for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
+        for (VertexID pin_index = hyperedge_offsets[i]; pin_index <
+             hyperedge_offsets[static_cast<size_t>(i) + 1]; ++pin_index) {
+          const HypernodeID pin = pins[pin_index];
+          _incidence_array[hypernode(pin).firstInvalidEntry()] = i;
+          hypernode(pin).incrementSize();
+        }
       }
+    } else {
+      ASSERT(hypernode_offsets[_num_hypernodes] == _num_pins, V(_num_pins));
+      for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
+        hypernode(i).setFirstEntry(_num_pins + hypernode_offsets[i]);
+        hypernode(i).setSize(hypernode_offsets[static_cast<size_t>(i) + 1] - hypernode_offsets[i]);
+      }
+      std::copy(incident_nets, incident_nets + _num_pins, _incidence_array.begin() + _num_pins);
     }
 
     bool has_hyperedge_weights = false;
-    if (hyperedge_weights != nullptr && !hyperedge_weights->empty()) {
+    if (hyperedge_weights != nullptr) {
       has_hyperedge_weights = true;
       for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
-        hyperedge(i).setWeight((*hyperedge_weights)[i]);
+        hyperedge(i).setWeight(hyperedge_weights[i]);
       }
     }
 
     bool has_hypernode_weights = false;
-    if (hypernode_weights != nullptr && !hypernode_weights->empty()) {
+    if (hypernode_weights != nullptr) {
       has_hypernode_weights = true;
       for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
-        hypernode(i).setWeight((*hypernode_weights)[i]);
-        _total_weight += (*hypernode_weights)[i];
+        hypernode(i).setWeight(hypernode_weights[i]);
+        _total_weight += hypernode_weights[i];
       }
     } else {
       _total_weight = _num_hypernodes;
@@ -845,6 +912,10 @@ class GenericHypergraph {
         connectHyperedgeToRepresentative(_incidence_array[he_it], u, first_call);
       }
     }
+    if (partID(v) != kInvalidPartition) {
+      // Uncontraction adds v to the block of u again.
+      --_part_info[partID(v)].size;
+    }
     hypernode(v).disable();
     --_current_num_hypernodes;
     return Memento { u, u_offset, u_size, v };
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/sparse_map.h"
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+// Describes how a buffer type is created and how it is cleared before it is
+// handed out again. Buffers with fixed capacity are only reused for requests
+// that fit into their capacity.
+template <typename Buffer = Mandatory>
+struct ScratchBufferTraits;
+
+template <typename T>
+struct ScratchBufferTraits<std::vector<T> >{
+  static constexpr bool kFixedCapacity = false;
+
+  static std::unique_ptr<std::vector<T> > create(const size_t size) {
+    return std::make_unique<std::vector<T> >(size);
+  }
+
+  // Vectors are handed out with size elements, each value-initialized.
+  static void reset(std::vector<T>& buffer, const size_t size) {
+    buffer.assign(size, T());
+  }
+};
+
+template <typename UnderlyingType>
+struct ScratchBufferTraits<FastResetFlagArray<UnderlyingType> >{
+  static constexpr bool kFixedCapacity = true;
+
+  static std::unique_ptr<FastResetFlagArray<UnderlyingType> > create(const size_t size) {
+    return std::make_unique<FastResetFlagArray<UnderlyingType> >(size);
+  }
+
+  static void reset(FastResetFlagArray<UnderlyingType>& buffer, const size_t) {
+    buffer.reset();
+  }
+};
+
+template <typename Key, typename Value>
+struct ScratchBufferTraits<SparseMap<Key, Value> >{
+  static constexpr bool kFixedCapacity = true;
+
+  static std::unique_ptr<SparseMap<Key, Value> > create(const size_t size) {
+    return std::make_unique<SparseMap<Key, Value> >(size);
+  }
+
+  static void reset(SparseMap<Key, Value>& buffer, const size_t) {
+    buffer.clear();
+  }
+};
+
+struct ScratchBufferPoolStats {
+  size_t acquisitions = 0;
+  size_t reuses = 0;
+  size_t allocations = 0;
+  size_t reallocations = 0;
+  size_t in_use = 0;
+  size_t max_in_use = 0;
+};
+
+// Statistics summed up over all scratch buffer pools of the calling thread.
+inline ScratchBufferPoolStats & scratchBufferPoolStats() {
+  static thread_local ScratchBufferPoolStats stats;
+  return stats;
+}
+
+// Pool of reusable temporary buffers. Instead of allocating a temporary
+// in every call, hot paths acquire a cleared buffer from the pool of the
+// calling thread. The buffer is returned to the pool once the handle goes
+// out of scope, i.e. the lifetime of a buffer is bound to the phase it is
+// used in.
+template <typename Buffer = Mandatory>
+class ScratchBufferPool {
+ private:
+  using Traits = ScratchBufferTraits<Buffer>;
+
+  struct Entry {
+    std::unique_ptr<Buffer> buffer;
+    size_t capacity;
+    bool in_use;
+  };
+
+ public:
+  class Handle {
+ public:
+    Handle(ScratchBufferPool& pool, const size_t entry) :
+      _pool(&pool),
+      _entry(entry) { }
+
+    Handle(const Handle&) = delete;
+    Handle& operator= (const Handle&) = delete;
+
+    Handle(Handle&& other) :
+      _pool(other._pool),
+      _entry(other._entry) {
+      other._pool = nullptr;
+    }
+
+    Handle& operator= (Handle&& other) {
+      if (this != &other) {
+        if (_pool != nullptr) {
+          _pool->release(_entry);
+        }
+        _pool = other._pool;
+        _entry = other._entry;
+        other._pool = nullptr;
+      }
+      return *this;
+    }
+
+    ~Handle() {
+      if (_pool != nullptr) {
+        _pool->release(_entry);
+      }
+    }
+
+    Buffer& operator* () const {
+      return *_pool->_entries[_entry].buffer;
+    }
+
+    Buffer* operator-> () const {
+      return _pool->_entries[_entry].buffer.get();
+    }
+
+ private:
+    ScratchBufferPool* _pool;
+    size_t _entry;
+  };
+
+  ScratchBufferPool() :
+    _entries(),
+    _stats() { }
+
+  ScratchBufferPool(const ScratchBufferPool&) = delete;
+  ScratchBufferPool& operator= (const ScratchBufferPool&) = delete;
+
+  ScratchBufferPool(ScratchBufferPool&&) = delete;
+  ScratchBufferPool& operator= (ScratchBufferPool&&) = delete;
+
+  ~ScratchBufferPool() = default;
+
+  // Each thread has its own pool, so acquiring buffers needs no synchronization.
+  static ScratchBufferPool& local() {
+    static thread_local ScratchBufferPool pool;
+    return pool;
+  }
+
+  // Returns a cleared buffer that can hold at least size elements.
+  Handle acquire(const size_t size) {
+    size_t free_entry = _entries.size();
+    for (size_t i = 0; i < _entries.size(); ++i) {
+      if (!_entries[i].in_use) {
+        if (!Traits::kFixedCapacity || _entries[i].capacity >= size) {
+          free_entry = i;
+          break;
+        }
+        free_entry = i;
+      }
+    }
+
+    if (free_entry == _entries.size()) {
+      _entries.emplace_back(Entry { Traits::create(size), size, false });
+      countAllocation();
+    } else if (Traits::kFixedCapacity && _entries[free_entry].capacity < size) {
+      // Only too small buffers are available: replace one of them instead of
+      // adding a new entry, which keeps the number of pooled buffers bounded
+      // by the maximum number of simultaneously used buffers.
+      _entries[free_entry].buffer = Traits::create(size);
+      _entries[free_entry].capacity = size;
+      countReallocation();
+    } else {
+      Traits::reset(*_entries[free_entry].buffer, size);
+      _entries[free_entry].capacity = std::max(_entries[free_entry].capacity, size);
+      countReuse();
+    }
+
+    _entries[free_entry].in_use = true;
+    countAcquisition();
+    return Handle(*this, free_entry);
+  }
+
+  // Frees all buffers that are currently not in use.
+  void releaseMemory() {
+    for (Entry& entry : _entries) {
+      if (!entry.in_use) {
+        entry.buffer = Traits::create(0);
+        entry.capacity = 0;
+      }
+    }
+  }
+
+  size_t numBuffers() const {
+    return _entries.size();
+  }
+
+  const ScratchBufferPoolStats & stats() const {
+    return _stats;
+  }
+
+ private:
+  void release(const size_t entry) {
+    ASSERT(_entries[entry].in_use, V(entry));
+    _entries[entry].in_use = false;
+    --_stats.in_use;
+    --scratchBufferPoolStats().in_use;
+  }
+
+  void countAcquisition() {
+    for (ScratchBufferPoolStats* stats : { &_stats, &scratchBufferPoolStats() }) {
+      ++stats->acquisitions;
+      ++stats->in_use;
+      stats->max_in_use = std::max(stats->max_in_use, stats->in_use);
+    }
+  }
+
+  void countAllocation() {
+    ++_stats.allocations;
+    ++scratchBufferPoolStats().allocations;
+  }
+
+  void countReallocation() {
+    ++_stats.reallocations;
+    ++scratchBufferPoolStats().reallocations;
+  }
+
+  void countReuse() {
+    ++_stats.reuses;
+    ++scratchBufferPoolStats().reuses;
+  }
+
+  std::vector<Entry> _entries;
+  ScratchBufferPoolStats _stats;
+};
+}  // namespace ds
+}  // namespace kahypar
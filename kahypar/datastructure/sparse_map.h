@@ -31,6 +31,7 @@
 #include <utility>
 #include <vector>
 
+#include "kahypar/datastructure/timestamped_index_table.h"
 #include "kahypar/macros.h"
 #include "kahypar/meta/mandatory.h"
 
@@ -192,5 +193,100 @@ class SparseMap final : public SparseMapBase<Key, Value, SparseMap<Key, Value> >
   using Base::_dense;
   using Base::_size;
 };
+// Sparse map whose memory is proportional to the number of touched keys
+// instead of the size of the key universe. Clearing is O(1) via timestamps.
+// Elements are stored in insertion order, i.e. iteration order is the same
+// as for SparseMap.
+template <typename Key = Mandatory,
+          typename Value = Mandatory>
+class DynamicSparseMap {
+ public:
+  struct MapElement {
+    Key key;
+    Value value;
+  };
+
+  explicit DynamicSparseMap(const size_t max_size) :
+    _index(max_size),
+    _dense() {
+    // begin() has to be a valid pointer even if no element was added yet
+    _dense.reserve(16);
+  }
+
+  DynamicSparseMap(const DynamicSparseMap&) = delete;
+  DynamicSparseMap& operator= (const DynamicSparseMap&) = delete;
+
+  DynamicSparseMap(DynamicSparseMap&&) = default;
+  DynamicSparseMap& operator= (DynamicSparseMap&&) = default;
+
+  ~DynamicSparseMap() = default;
+
+  size_t size() const {
+    return _index.size();
+  }
+
+  bool contains(const Key key) const {
+    return _index.find(key) != IndexTable::kInvalidIndex;
+  }
+
+  void add(const Key key, const Value value) {
+    if (!contains(key)) {
+      insert(key, value);
+    }
+  }
+
+  const MapElement* begin() const {
+    return _dense.data();
+  }
+
+  const MapElement* end() const {
+    return _dense.data() + _index.size();
+  }
+
+  MapElement* begin() {
+    return _dense.data();
+  }
+
+  MapElement* end() {
+    return _dense.data() + _index.size();
+  }
+
+  void clear() {
+    _index.clear();
+  }
+
+  Value& operator[] (const Key key) {
+    const uint32_t index = _index.find(key);
+    if (index == IndexTable::kInvalidIndex) {
+      return insert(key, Value());
+    }
+    return _dense[index].value;
+  }
+
+  const Value & get(const Key key) const {
+    ASSERT(contains(key), V(key));
+    return _dense[_index.find(key)].value;
+  }
+
+  size_t sizeInBytes() const {
+    return _index.sizeInBytes() + _dense.capacity() * sizeof(MapElement);
+  }
+
+ private:
+  using IndexTable = TimestampedIndexTable<Key>;
+
+  Value& insert(const Key key, const Value value) {
+    const uint32_t index = _index.insert(key);
+    if (index == _dense.size()) {
+      _dense.push_back(MapElement { key, value });
+    } else {
+      _dense[index] = MapElement { key, value };
+    }
+    return _dense[index].value;
+  }
+
+  IndexTable _index;
+  std::vector<MapElement> _dense;
+};
 }  // namespace ds
 }  // namespace kahypar
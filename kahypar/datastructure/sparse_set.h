@@ -28,7 +28,9 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "kahypar/datastructure/timestamped_index_table.h"
 #include "kahypar/macros.h"
 #include "kahypar/meta/mandatory.h"
 
@@ -197,5 +199,64 @@ class InsertOnlySparseSet final : public SparseSetBase<ValueType,
   using Base::_sparse;
   using Base::_dense;
 };
+// Insert-only sparse set whose memory is proportional to the number of
+// touched elements instead of the size of the universe. Clearing is O(1).
+template <typename ValueType = Mandatory>
+class DynamicSparseSet {
+ public:
+  explicit DynamicSparseSet(const ValueType k) :
+    _index(k),
+    _dense() {
+    // begin() has to be a valid pointer even if no element was added yet
+    _dense.reserve(16);
+  }
+
+  DynamicSparseSet(const DynamicSparseSet&) = delete;
+  DynamicSparseSet& operator= (const DynamicSparseSet&) = delete;
+
+  DynamicSparseSet(DynamicSparseSet&&) = default;
+  DynamicSparseSet& operator= (DynamicSparseSet&&) = default;
+
+  ~DynamicSparseSet() = default;
+
+  ValueType size() const {
+    return _index.size();
+  }
+
+  bool contains(const ValueType value) const {
+    return _index.find(value) != TimestampedIndexTable<ValueType>::kInvalidIndex;
+  }
+
+  void add(const ValueType value) {
+    if (!contains(value)) {
+      const uint32_t index = _index.insert(value);
+      if (index == _dense.size()) {
+        _dense.push_back(value);
+      } else {
+        _dense[index] = value;
+      }
+    }
+  }
+
+  const ValueType* begin() const {
+    return _dense.data();
+  }
+
+  const ValueType* end() const {
+    return _dense.data() + _index.size();
+  }
+
+  void clear() {
+    _index.clear();
+  }
+
+  size_t sizeInBytes() const {
+    return _index.sizeInBytes() + _dense.capacity() * sizeof(ValueType);
+  }
+
+ private:
+  TimestampedIndexTable<ValueType> _index;
+  std::vector<ValueType> _dense;
+};
 }  // namespace ds
 }  // namespace kahypar
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+// Maps keys of the universe [0, max_size) to consecutive indices [0, size).
+// Slots carry a timestamp, which allows to clear the table in O(1) by
+// incrementing the current timestamp. As long as only a small number of
+// keys is used, the table is a small open addressing hash table with linear
+// probing, i.e. memory is proportional to the number of touched keys.
+// If the table grows to the size of the universe, it switches to a directly
+// indexed array of max_size slots.
+template <typename Key = Mandatory>
+class TimestampedIndexTable {
+ private:
+  using Timestamp = uint32_t;
+
+  struct Slot {
+    Key key;
+    Timestamp timestamp;
+    uint32_t index;
+  };
+
+  static constexpr size_t kInitialCapacity = 16;
+
+ public:
+  static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  explicit TimestampedIndexTable(const size_t max_size) :
+    _max_size(max_size),
+    _size(0),
+    _timestamp(1),
+    _direct(false),
+    _mask(0),
+    _slots() {
+    allocate(std::min(kInitialCapacity, roundUpToPowerOfTwo(max_size)));
+  }
+
+  TimestampedIndexTable(const TimestampedIndexTable&) = delete;
+  TimestampedIndexTable& operator= (const TimestampedIndexTable&) = delete;
+
+  TimestampedIndexTable(TimestampedIndexTable&&) = default;
+  TimestampedIndexTable& operator= (TimestampedIndexTable&&) = default;
+
+  ~TimestampedIndexTable() = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool isDirectlyIndexed() const {
+    return _direct;
+  }
+
+  size_t capacity() const {
+    return _slots.size();
+  }
+
+  size_t sizeInBytes() const {
+    return _slots.size() * sizeof(Slot);
+  }
+
+  uint32_t find(const Key key) const {
+    ASSERT(static_cast<size_t>(key) < _max_size, V(key) << V(_max_size));
+    if (_direct) {
+      const Slot& slot = _slots[key];
+      return slot.timestamp == _timestamp ? slot.index : kInvalidIndex;
+    }
+    for (size_t pos = hash(key); ; pos = (pos + 1) & _mask) {
+      const Slot& slot = _slots[pos];
+      if (slot.timestamp != _timestamp) {
+        return kInvalidIndex;
+      } else if (slot.key == key) {
+        return slot.index;
+      }
+    }
+  }
+
+  // Assigns the next free index to key. Key must not be contained.
+  uint32_t insert(const Key key) {
+    ASSERT(find(key) == kInvalidIndex, V(key));
+    if (!_direct && 2 * (_size + 1) > _slots.size()) {
+      grow();
+    }
+    const uint32_t index = _size++;
+    place(key, index);
+    return index;
+  }
+
+  void clear() {
+    _size = 0;
+    ++_timestamp;
+    if (_timestamp == std::numeric_limits<Timestamp>::max()) {
+      for (Slot& slot : _slots) {
+        slot.timestamp = 0;
+      }
+      _timestamp = 1;
+    }
+  }
+
+ private:
+  FRIEND_TEST(ATimestampedIndexTable, HandlesTimestampOverflow);
+
+  static size_t roundUpToPowerOfTwo(const size_t value) {
+    size_t power = 1;
+    while (power < value) {
+      power <<= 1;
+    }
+    return power;
+  }
+
+  size_t hash(const Key key) const {
+    // Fibonacci hashing: use the high bits of the product
+    return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL >> 32) & _mask;
+  }
+
+  void place(const Key key, const uint32_t index) {
+    size_t pos = key;
+    if (!_direct) {
+      pos = hash(key);
+      while (_slots[pos].timestamp == _timestamp) {
+        pos = (pos + 1) & _mask;
+      }
+    }
+    _slots[pos] = Slot { key, _timestamp, index };
+  }
+
+  void allocate(const size_t capacity) {
+    _direct = capacity >= _max_size;
+    const size_t num_slots = _direct ? _max_size : capacity;
+    _slots.assign(num_slots, Slot { Key(), 0, kInvalidIndex });
+    _mask = _direct ? 0 : num_slots - 1;
+  }
+
+  void grow() {
+    std::vector<Slot> old_slots;
+    old_slots.swap(_slots);
+    allocate(2 * old_slots.size());
+    for (const Slot& slot : old_slots) {
+      if (slot.timestamp == _timestamp) {
+        place(slot.key, slot.index);
+      }
+    }
+  }
+
+  const size_t _max_size;
+  uint32_t _size;
+  Timestamp _timestamp;
+  bool _direct;
+  size_t _mask;
+  std::vector<Slot> _slots;
+};
+
+template <typename Key>
+constexpr size_t TimestampedIndexTable<Key>::kInitialCapacity;
+template <typename Key>
+constexpr uint32_t TimestampedIndexTable<Key>::kInvalidIndex;
+}  // namespace ds
+}  // namespace kahypar
@@ -29,6 +29,10 @@
 // Use bucket PQ for FM refinement.
 // #define USE_BUCKET_QUEUE
 
+// Use cache-friendly d-ary heaps instead of binary heaps for
+// FM refinement and coarsening.
+// #define USE_DARY_HEAP
+
 // Gather advanced statistics
 // #define GATHER_STATS
 
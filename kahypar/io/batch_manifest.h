@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/memory_mapped_file.h"
+
+namespace kahypar {
+namespace io {
+struct BatchJob {
+  std::string graph_filename;
+  PartitionID k;
+  double epsilon;
+  int seed;
+  std::string preset;
+  // empty, if the default name of KaHyPar should be used
+  std::string partition_filename;
+};
+
+// Parses a batch manifest with one job per line:
+//   <hypergraph> <k> <epsilon> <seed> <preset.ini> [<partition file>]
+// Empty lines and lines starting with '#' are ignored.
+static inline IOStatus parseBatchManifest(std::istream& manifest, std::vector<BatchJob>& jobs) {
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(manifest, line)) {
+    ++line_number;
+    std::istringstream tokens(line);
+    std::string first;
+    if (!(tokens >> first) || first[0] == '#') {
+      continue;
+    }
+    BatchJob job { first, 0, 0.0, 0, "", "" };
+    if (!(tokens >> job.k >> job.epsilon >> job.seed >> job.preset)) {
+      return IOStatus::error("Expected <hypergraph> <k> <epsilon> <seed> <preset> (line " +
+                             std::to_string(line_number) + ")");
+    }
+    if (job.k < 2 || job.epsilon < 0) {
+      return IOStatus::error("Invalid k or epsilon (line " + std::to_string(line_number) + ")");
+    }
+    tokens >> job.partition_filename;
+    std::string trailing;
+    if (tokens >> trailing) {
+      return IOStatus::error("Unexpected token '" + trailing + "' (line " +
+                             std::to_string(line_number) + ")");
+    }
+    jobs.push_back(job);
+  }
+  return IOStatus();
+}
+
+static inline IOStatus parseBatchManifest(const std::string& filename,
+                                          std::vector<BatchJob>& jobs) {
+  std::ifstream manifest(filename);
+  if (!manifest) {
+    return IOStatus::error("Could not open manifest " + filename);
+  }
+  return parseBatchManifest(manifest, jobs);
+}
+}  // namespace io
+}  // namespace kahypar
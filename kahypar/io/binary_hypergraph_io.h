@@ -0,0 +1,474 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/buffered_writer.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+// Binary hypergraph format, which can be loaded without parsing:
+//
+//   header                (BinaryHypergraphHeader)
+//   hyperedge offsets     (m + 1) x uint64
+//   pins                  #pins x uint32
+//   hyperedge weights     m x int32    (only for edge weighted hypergraphs)
+//   hypernode weights     n x uint32   (only for node weighted hypergraphs)
+//   hypernode offsets     (n + 1) x uint64
+//   incident nets         #pins x uint32
+//
+// Each section is padded with zeros to a multiple of 8 bytes. The checksum
+// covers everything after the header. The incident nets of each hypernode
+// are stored in increasing order, i.e. they form the transpose of the pins.
+struct BinaryHypergraphHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t type;
+  uint64_t num_hypernodes;
+  uint64_t num_hyperedges;
+  uint64_t num_pins;
+  uint64_t checksum;
+};
+
+static_assert(sizeof(BinaryHypergraphHeader) == 48, "Unexpected padding in binary header");
+static_assert(sizeof(size_t) == sizeof(uint64_t), "Offsets are stored as 64 bit integers");
+static_assert(sizeof(HypernodeID) == sizeof(uint32_t) && sizeof(HyperedgeID) == sizeof(uint32_t) &&
+              sizeof(HypernodeWeight) == sizeof(uint32_t) &&
+              sizeof(HyperedgeWeight) == sizeof(int32_t),
+              "Binary format assumes 32 bit IDs and weights");
+
+static constexpr char kBinaryHypergraphMagic[8] = { 'K', 'H', 'P', 'R', 'B', 'I', 'N', '\0' };
+static constexpr uint32_t kBinaryHypergraphVersion = 1;
+
+namespace internal {
+static inline size_t paddedSize(const size_t num_bytes) {
+  return (num_bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+// Word-wise FNV-1a. The data has to be padded to a multiple of 8 bytes.
+class BinaryChecksum {
+ public:
+  BinaryChecksum() :
+    _hash(0xcbf29ce484222325ULL) { }
+
+  void update(const char* data, const size_t num_bytes) {
+    ASSERT(num_bytes % sizeof(uint64_t) == 0, V(num_bytes));
+    for (size_t i = 0; i < num_bytes; i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(uint64_t));
+      _hash = (_hash ^ word) * 0x100000001b3ULL;
+    }
+  }
+
+  uint64_t value() const {
+    return _hash;
+  }
+
+ private:
+  uint64_t _hash;
+};
+
+class BinarySectionWriter {
+ public:
+  explicit BinarySectionWriter(std::ofstream& out_stream) :
+    _out_stream(out_stream),
+    _buffer(),
+    _checksum() { }
+
+  BinarySectionWriter(const BinarySectionWriter&) = delete;
+  BinarySectionWriter& operator= (const BinarySectionWriter&) = delete;
+
+  template <typename T>
+  void write(const std::vector<T>& section) {
+    const size_t num_bytes = section.size() * sizeof(T);
+    _buffer.assign(paddedSize(num_bytes), 0);
+    if (num_bytes > 0) {
+      std::memcpy(_buffer.data(), section.data(), num_bytes);
+    }
+    _checksum.update(_buffer.data(), _buffer.size());
+    _out_stream.write(_buffer.data(), _buffer.size());
+  }
+
+  uint64_t checksum() const {
+    return _checksum.value();
+  }
+
+ private:
+  std::ofstream& _out_stream;
+  std::vector<char> _buffer;
+  BinaryChecksum _checksum;
+};
+
+template <typename T>
+static inline const T* binarySection(const char*& pos, const size_t num_elements) {
+  const T* section = reinterpret_cast<const T*>(pos);
+  pos += paddedSize(num_elements * sizeof(T));
+  return section;
+}
+
+static inline bool isValidCSR(const size_t* offsets, const size_t num_entries,
+                              const uint32_t* targets, const size_t num_targets,
+                              const size_t num_pins) {
+  if (offsets[0] != 0 || offsets[num_entries] != num_pins) {
+    return false;
+  }
+  for (size_t i = 0; i < num_entries; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < num_pins; ++i) {
+    if (targets[i] >= num_targets) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks that the incident nets are the transpose of the pins, i.e., that
+// each hypernode lists exactly the hyperedges containing it in increasing
+// order. Both arrays have to be valid CSR arrays (see isValidCSR).
+static inline bool isTransposed(const size_t* hyperedge_offsets, const size_t num_hyperedges,
+                                const HypernodeID* pins, const size_t* hypernode_offsets,
+                                const size_t num_hypernodes, const HyperedgeID* incident_nets) {
+  std::vector<size_t> next_incident_net(hypernode_offsets, hypernode_offsets + num_hypernodes);
+  for (size_t he = 0; he < num_hyperedges; ++he) {
+    for (size_t i = hyperedge_offsets[he]; i < hyperedge_offsets[he + 1]; ++i) {
+      const HypernodeID pin = pins[i];
+      if (next_incident_net[pin] == hypernode_offsets[pin + 1] ||
+          incident_nets[next_incident_net[pin]] != he) {
+        return false;
+      }
+      ++next_incident_net[pin];
+    }
+  }
+  // Since both arrays contain all pins, every hypernode has been completed.
+  return true;
+}
+}  // namespace internal
+
+static inline bool isBinaryHypergraphFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(kBinaryHypergraphMagic)] = { };
+  file.read(magic, sizeof(magic));
+  return file && std::memcmp(magic, kBinaryHypergraphMagic, sizeof(magic)) == 0;
+}
+
+static inline IOStatus writeBinaryHypergraphFile(const Hypergraph& hypergraph,
+                                                 const std::string& filename) {
+  ASSERT(!filename.empty(), "No filename for hypergraph file specified");
+  ALWAYS_ASSERT(!hypergraph.isModified(), "Hypergraph is modified. Reindexing HNs/HEs necessary.");
+
+  std::ofstream out_stream(filename.c_str(), std::ios::binary);
+  if (!out_stream) {
+    return IOStatus::error("Could not open file " + filename + " for writing");
+  }
+
+  BinaryHypergraphHeader header;
+  std::memcpy(header.magic, kBinaryHypergraphMagic, sizeof(header.magic));
+  header.version = kBinaryHypergraphVersion;
+  header.type = static_cast<int32_t>(hypergraph.type());
+  header.num_hypernodes = hypergraph.initialNumNodes();
+  header.num_hyperedges = hypergraph.initialNumEdges();
+  header.num_pins = hypergraph.initialNumPins();
+  header.checksum = 0;
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  const bool has_hyperedge_weights = hypergraph.type() == HypergraphType::EdgeWeights ||
+                                     hypergraph.type() == HypergraphType::EdgeAndNodeWeights;
+  const bool has_hypernode_weights = hypergraph.type() == HypergraphType::NodeWeights ||
+                                     hypergraph.type() == HypergraphType::EdgeAndNodeWeights;
+
+  internal::BinarySectionWriter writer(out_stream);
+  {
+    std::vector<size_t> offsets(1, 0);
+    std::vector<HypernodeID> pins;
+    pins.reserve(header.num_pins);
+    std::vector<HyperedgeWeight> weights;
+    for (const HyperedgeID& he : hypergraph.edges()) {
+      for (const HypernodeID& pin : hypergraph.pins(he)) {
+        pins.push_back(pin);
+      }
+      offsets.push_back(pins.size());
+      if (has_hyperedge_weights) {
+        weights.push_back(hypergraph.edgeWeight(he));
+      }
+    }
+    writer.write(offsets);
+    writer.write(pins);
+    writer.write(weights);
+  }
+  {
+    std::vector<size_t> offsets(1, 0);
+    std::vector<HyperedgeID> incident_nets;
+    incident_nets.reserve(header.num_pins);
+    std::vector<HypernodeWeight> weights;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+        incident_nets.push_back(he);
+      }
+      offsets.push_back(incident_nets.size());
+      if (has_hypernode_weights) {
+        weights.push_back(hypergraph.nodeWeight(hn));
+      }
+    }
+    writer.write(weights);
+    writer.write(offsets);
+    writer.write(incident_nets);
+  }
+
+  header.checksum = writer.checksum();
+  out_stream.seekp(0);
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out_stream.close();
+  if (!out_stream) {
+    return IOStatus::error("Could not write file " + filename);
+  }
+  return IOStatus();
+}
+
+// The sections of a memory mapped binary hypergraph file. The pointers are
+// valid as long as the file stays mapped.
+struct BinaryHypergraphView {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  size_t num_pins = 0;
+  const size_t* hyperedge_offsets = nullptr;
+  const HypernodeID* pins = nullptr;
+  const HyperedgeWeight* hyperedge_weights = nullptr;  // nullptr for unit weights
+  const HypernodeWeight* hypernode_weights = nullptr;  // nullptr for unit weights
+  const size_t* hypernode_offsets = nullptr;
+  const HyperedgeID* incident_nets = nullptr;
+};
+
+// Maps a hypergraph in binary format and validates it.
+static inline IOStatus mapBinaryHypergraphFile(const std::string& filename,
+                                               MemoryMappedFile& file,
+                                               BinaryHypergraphView& view) {
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+
+  BinaryHypergraphHeader header;
+  if (file.size() < sizeof(header)) {
+    return IOStatus::error(filename + " is not a binary hypergraph file");
+  }
+  std::memcpy(&header, file.begin(), sizeof(header));
+  if (std::memcmp(header.magic, kBinaryHypergraphMagic, sizeof(header.magic)) != 0) {
+    return IOStatus::error(filename + " is not a binary hypergraph file");
+  } else if (header.version != kBinaryHypergraphVersion) {
+    return IOStatus::error("Unsupported binary format version " + std::to_string(header.version)
+                           + " (expected " + std::to_string(kBinaryHypergraphVersion) + ")");
+  }
+
+  const HypergraphType type = static_cast<HypergraphType>(header.type);
+  if (type != HypergraphType::Unweighted && type != HypergraphType::EdgeWeights &&
+      type != HypergraphType::NodeWeights && type != HypergraphType::EdgeAndNodeWeights) {
+    return IOStatus::error("Hypergraph in file has wrong type " + std::to_string(header.type));
+  } else if (header.num_hypernodes == 0 ||
+             header.num_hypernodes > std::numeric_limits<HypernodeID>::max() ||
+             header.num_hyperedges > std::numeric_limits<HyperedgeID>::max() ||
+             header.num_pins > std::numeric_limits<uint32_t>::max() / 2) {
+    return IOStatus::error("Invalid hypergraph dimensions in binary header");
+  }
+
+  const bool has_hyperedge_weights = type == HypergraphType::EdgeWeights ||
+                                     type == HypergraphType::EdgeAndNodeWeights;
+  const bool has_hypernode_weights = type == HypergraphType::NodeWeights ||
+                                     type == HypergraphType::EdgeAndNodeWeights;
+  const size_t n = header.num_hypernodes;
+  const size_t m = header.num_hyperedges;
+  const size_t num_pins = header.num_pins;
+  const size_t payload_size = internal::paddedSize((m + 1) * sizeof(size_t)) +
+                              internal::paddedSize(num_pins * sizeof(HypernodeID)) +
+                              (has_hyperedge_weights ?
+                               internal::paddedSize(m * sizeof(HyperedgeWeight)) : 0) +
+                              (has_hypernode_weights ?
+                               internal::paddedSize(n * sizeof(HypernodeWeight)) : 0) +
+                              internal::paddedSize((n + 1) * sizeof(size_t)) +
+                              internal::paddedSize(num_pins * sizeof(HyperedgeID));
+  if (file.size() != sizeof(header) + payload_size) {
+    return IOStatus::error("Binary hypergraph file " + filename + " has size "
+                           + std::to_string(file.size()) + " but header requires "
+                           + std::to_string(sizeof(header) + payload_size));
+  }
+
+  const char* pos = file.begin() + sizeof(header);
+  internal::BinaryChecksum checksum;
+  checksum.update(pos, payload_size);
+  if (checksum.value() != header.checksum) {
+    return IOStatus::error("Checksum mismatch in binary hypergraph file " + filename);
+  }
+
+  const size_t* hyperedge_offsets = internal::binarySection<size_t>(pos, m + 1);
+  const HypernodeID* pins = internal::binarySection<HypernodeID>(pos, num_pins);
+  const HyperedgeWeight* hyperedge_weights = has_hyperedge_weights ?
+                                             internal::binarySection<HyperedgeWeight>(pos, m) :
+                                             nullptr;
+  const HypernodeWeight* hypernode_weights = has_hypernode_weights ?
+                                             internal::binarySection<HypernodeWeight>(pos, n) :
+                                             nullptr;
+  const size_t* hypernode_offsets = internal::binarySection<size_t>(pos, n + 1);
+  const HyperedgeID* incident_nets = internal::binarySection<HyperedgeID>(pos, num_pins);
+  ASSERT(pos == file.end());
+
+  if (!internal::isValidCSR(hyperedge_offsets, m, pins, n, num_pins) ||
+      !internal::isValidCSR(hypernode_offsets, n, incident_nets, m, num_pins)) {
+    return IOStatus::error("Invalid pins or incident nets in binary hypergraph file " + filename);
+  } else if (!internal::isTransposed(hyperedge_offsets, m, pins, hypernode_offsets, n,
+                                     incident_nets)) {
+    return IOStatus::error("Incident nets do not match the pins in binary hypergraph file "
+                           + filename);
+  }
+
+  view.num_hypernodes = n;
+  view.num_hyperedges = m;
+  view.num_pins = num_pins;
+  view.hyperedge_offsets = hyperedge_offsets;
+  view.pins = pins;
+  view.hyperedge_weights = hyperedge_weights;
+  view.hypernode_weights = hypernode_weights;
+  view.hypernode_offsets = hypernode_offsets;
+  view.incident_nets = incident_nets;
+  return IOStatus();
+}
+
+// Loads a hypergraph in binary format. The arrays are passed to the hypergraph
+// directly from the memory mapped file, including the precomputed incident nets.
+static inline IOStatus readBinaryHypergraphFile(const std::string& filename,
+                                                const PartitionID num_parts,
+                                                Hypergraph& hypergraph) {
+  MemoryMappedFile file;
+  BinaryHypergraphView view;
+  const IOStatus status = mapBinaryHypergraphFile(filename, file, view);
+  if (!status.ok()) {
+    return status;
+  }
+  hypergraph = Hypergraph(view.num_hypernodes, view.num_hyperedges, view.num_pins,
+                          view.hyperedge_offsets, view.pins, num_parts,
+                          view.hyperedge_weights, view.hypernode_weights,
+                          view.hypernode_offsets, view.incident_nets);
+  return IOStatus();
+}
+
+// Compact binary partition format:
+//
+//   header                (BinaryPartitionHeader)
+//   block IDs             n x int32
+struct BinaryPartitionHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t k;
+  uint64_t num_hypernodes;
+};
+
+static_assert(sizeof(BinaryPartitionHeader) == 24, "Unexpected padding in binary header");
+static_assert(sizeof(PartitionID) == sizeof(int32_t), "Binary format assumes 32 bit block IDs");
+
+static constexpr char kBinaryPartitionMagic[8] = { 'K', 'H', 'P', 'R', 'P', 'R', 'T', '\0' };
+static constexpr uint32_t kBinaryPartitionVersion = 1;
+
+static inline bool isBinaryPartitionFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(kBinaryPartitionMagic)] = { };
+  file.read(magic, sizeof(magic));
+  return file && std::memcmp(magic, kBinaryPartitionMagic, sizeof(magic)) == 0;
+}
+
+static inline IOStatus writeBinaryPartitionFile(const Hypergraph& hypergraph,
+                                                const std::string& filename) {
+  ASSERT(!filename.empty(), "No filename for partition file specified");
+  BufferedWriter writer;
+  IOStatus status = writer.open(filename, BufferedWriter::Mode::direct);
+  if (!status.ok()) {
+    return status;
+  }
+
+  BinaryPartitionHeader header;
+  std::memcpy(header.magic, kBinaryPartitionMagic, sizeof(header.magic));
+  header.version = kBinaryPartitionVersion;
+  header.k = hypergraph.k();
+  header.num_hypernodes = hypergraph.initialNumNodes();
+  writer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    const PartitionID part = hypergraph.partID(hn);
+    writer.write(reinterpret_cast<const char*>(&part), sizeof(part));
+  }
+  return writer.close();
+}
+
+static inline IOStatus readBinaryPartitionFile(const std::string& filename,
+                                               std::vector<PartitionID>& partition) {
+  MemoryMappedFile file;
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+
+  BinaryPartitionHeader header;
+  if (file.size() < sizeof(header)) {
+    return IOStatus::error(filename + " is not a binary partition file");
+  }
+  std::memcpy(&header, file.begin(), sizeof(header));
+  if (std::memcmp(header.magic, kBinaryPartitionMagic, sizeof(header.magic)) != 0) {
+    return IOStatus::error(filename + " is not a binary partition file");
+  } else if (header.version != kBinaryPartitionVersion) {
+    return IOStatus::error("Unsupported binary format version " + std::to_string(header.version)
+                           + " (expected " + std::to_string(kBinaryPartitionVersion) + ")");
+  } else if (header.num_hypernodes > (file.size() - sizeof(header)) / sizeof(PartitionID)) {
+    // checked before computing the required size, which could overflow
+    return IOStatus::error("Binary partition file " + filename + " has size "
+                           + std::to_string(file.size()) + " but header requires "
+                           + std::to_string(header.num_hypernodes) + " block IDs");
+  } else if (file.size() != sizeof(header) + header.num_hypernodes * sizeof(PartitionID)) {
+    return IOStatus::error("Binary partition file " + filename + " has size "
+                           + std::to_string(file.size()) + " but header requires "
+                           + std::to_string(sizeof(header) +
+                                            header.num_hypernodes * sizeof(PartitionID)));
+  }
+
+  const size_t first = partition.size();
+  partition.resize(first + header.num_hypernodes);
+  if (header.num_hypernodes > 0) {
+    std::memcpy(partition.data() + first, file.begin() + sizeof(header),
+                header.num_hypernodes * sizeof(PartitionID));
+  }
+  for (size_t i = first; i < partition.size(); ++i) {
+    if (partition[i] < 0 || partition[i] >= header.k) {
+      partition.resize(first);
+      return IOStatus::error("Hypernode " + std::to_string(i - first) + " is assigned to "
+                             + "invalid block in binary partition file " + filename);
+    }
+  }
+  return IOStatus();
+}
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,316 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+// Output file with a large buffer, which is written via write(2) once it is
+// full. Integers are formatted without streams. In contrast to std::ofstream
+// with std::endl, lines are never flushed individually.
+//
+// In Mode::direct, the file is opened with O_DIRECT (if supported by the
+// file system), i.e. large outputs bypass the page cache. Only the last
+// (partial) block is written without O_DIRECT.
+//
+// A writer opened via openAt() writes to a region of a file that is owned by
+// another writer using pwrite(2). This allows several threads to fill
+// disjoint parts of the same file.
+class BufferedWriter {
+ public:
+  enum class Mode : uint8_t {
+    buffered,
+    direct
+  };
+
+  static constexpr size_t kAlignment = 4096;
+
+  // The buffer holds at least two blocks: In Mode::direct, a flush only writes
+  // whole blocks, which then frees at least kAlignment bytes for an integer.
+  explicit BufferedWriter(const size_t buffer_size = 1024 * 1024) :
+    _buffer(nullptr, &std::free),
+    _capacity(std::max((buffer_size + kAlignment - 1) / kAlignment, static_cast<size_t>(2)) *
+              kAlignment),
+    _size(0),
+    _fd(-1),
+    _offset(-1),
+    _owns_file(false),
+    _direct(false),
+    _error(0),
+    _filename() {
+    void* buffer = nullptr;
+    if (posix_memalign(&buffer, kAlignment, _capacity) != 0) {
+      throw std::bad_alloc();
+    }
+    _buffer.reset(static_cast<char*>(buffer));
+  }
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator= (const BufferedWriter&) = delete;
+
+  BufferedWriter(BufferedWriter&&) = delete;
+  BufferedWriter& operator= (BufferedWriter&&) = delete;
+
+  ~BufferedWriter() {
+    close();
+  }
+
+  IOStatus open(const std::string& filename, const Mode mode = Mode::buffered) {
+    ASSERT(_fd == -1, "Writer is already open");
+    _filename = filename;
+    _size = 0;
+    _error = 0;
+    _offset = -1;
+    _owns_file = true;
+    _direct = false;
+#ifdef O_DIRECT
+    if (mode == Mode::direct) {
+      _fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+      _direct = _fd != -1;
+    }
+#endif
+    if (_fd == -1) {
+      // file systems such as tmpfs do not support O_DIRECT
+      _fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (_fd == -1) {
+      return IOStatus::error("Could not open file " + filename + " for writing: "
+                             + std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  // Writes to the file of the given (open) writer starting at offset. The
+  // file has to stay open until this writer is closed.
+  void openAt(const BufferedWriter& file, const uint64_t offset) {
+    ASSERT(_fd == -1, "Writer is already open");
+    ASSERT(file.isOpen(), "File is not open");
+    _filename = file._filename;
+    _fd = file._fd;
+    _offset = offset;
+    _owns_file = false;
+    _size = 0;
+    _error = 0;
+    _direct = false;
+  }
+
+  bool isOpen() const {
+    return _fd != -1;
+  }
+
+  // Writes the remaining buffer and closes the file. Reports the first error
+  // that occurred since the file was opened.
+  IOStatus close() {
+    if (_fd == -1) {
+      return IOStatus();
+    }
+#ifdef O_DIRECT
+    if (_direct) {
+      flush(/* only whole blocks */ true);
+      if (fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) & ~O_DIRECT) == -1) {
+        recordError(errno);
+      }
+      _direct = false;
+    }
+#endif
+    flush(false);
+    if (_owns_file && ::close(_fd) == -1) {
+      recordError(errno);
+    }
+    _fd = -1;
+    if (_error != 0) {
+      return IOStatus::error("Could not write file " + _filename + ": " + std::strerror(_error));
+    }
+    return IOStatus();
+  }
+
+  void write(const char* data, size_t size) {
+    while (size > 0) {
+      if (_size == _capacity) {
+        flush(_direct);
+      }
+      const size_t num_bytes = std::min(size, _capacity - _size);
+      std::memcpy(_buffer.get() + _size, data, num_bytes);
+      _size += num_bytes;
+      data += num_bytes;
+      size -= num_bytes;
+    }
+  }
+
+  BufferedWriter& operator<< (const char c) {
+    if (_size == _capacity) {
+      flush(_direct);
+    }
+    _buffer.get()[_size++] = c;
+    return *this;
+  }
+
+  BufferedWriter& operator<< (const bool value) {
+    return *this << (value ? '1' : '0');
+  }
+
+  BufferedWriter& operator<< (const char* str) {
+    write(str, std::strlen(str));
+    return *this;
+  }
+
+  BufferedWriter& operator<< (const std::string& str) {
+    write(str.data(), str.size());
+    return *this;
+  }
+
+  // Number of characters written by operator<< for the given integer.
+  template <typename T,
+            typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  static size_t numCharacters(const T value) {
+    using Unsigned = typename std::make_unsigned<T>::type;
+    Unsigned magnitude = static_cast<Unsigned>(value);
+    size_t num_characters = 1;
+    if (isNegative(value, std::is_signed<T>())) {
+      ++num_characters;
+      magnitude = static_cast<Unsigned>(Unsigned(0) - magnitude);
+    }
+    while (magnitude >= 10) {
+      ++num_characters;
+      magnitude /= 10;
+    }
+    return num_characters;
+  }
+
+  template <typename T,
+            typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  BufferedWriter& operator<< (const T value) {
+    // 20 digits and a sign suffice for all 64 bit integers
+    static constexpr size_t kMaxDigits = 21;
+    if (_capacity - _size < kMaxDigits) {
+      flush(_direct);
+    }
+    using Unsigned = typename std::make_unsigned<T>::type;
+    Unsigned magnitude = static_cast<Unsigned>(value);
+    char* out = _buffer.get() + _size;
+    if (isNegative(value, std::is_signed<T>())) {
+      *out++ = '-';
+      magnitude = static_cast<Unsigned>(Unsigned(0) - magnitude);
+    }
+    char digits[kMaxDigits];
+    size_t num_digits = 0;
+    do {
+      digits[num_digits++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    while (num_digits > 0) {
+      *out++ = digits[--num_digits];
+    }
+    _size = out - _buffer.get();
+    return *this;
+  }
+
+ private:
+  template <typename T>
+  static bool isNegative(const T value, std::true_type) {
+    return value < 0;
+  }
+
+  template <typename T>
+  static bool isNegative(const T, std::false_type) {
+    return false;
+  }
+
+  // In direct mode, only whole blocks are written and the remaining bytes
+  // are moved to the front of the buffer.
+  void flush(const bool whole_blocks) {
+    const size_t num_bytes = whole_blocks ? _size / kAlignment * kAlignment : _size;
+    size_t written = 0;
+    while (written < num_bytes && _error == 0) {
+      const ssize_t result = _offset == -1 ?
+                             ::write(_fd, _buffer.get() + written, num_bytes - written) :
+                             ::pwrite(_fd, _buffer.get() + written, num_bytes - written,
+                                      _offset + written);
+      if (result == -1) {
+        if (errno != EINTR) {
+          recordError(errno);
+        }
+      } else {
+        written += result;
+      }
+    }
+    if (_offset != -1) {
+      _offset += written;
+    }
+    std::memmove(_buffer.get(), _buffer.get() + num_bytes, _size - num_bytes);
+    _size -= num_bytes;
+  }
+
+  void recordError(const int error) {
+    if (_error == 0) {
+      _error = error;
+    }
+  }
+
+  std::unique_ptr<char, decltype(& std::free)> _buffer;
+  const size_t _capacity;
+  size_t _size;
+  int _fd;
+  // write position for regions of files owned by other writers, -1 otherwise
+  off_t _offset;
+  bool _owns_file;
+  bool _direct;
+  int _error;
+  std::string _filename;
+};
+
+// Writers that report errors on the console. If the file cannot be opened,
+// the status is returned as well, so that the caller does not write its
+// output into a closed writer.
+static inline IOStatus openOutputFile(BufferedWriter& writer, const std::string& filename,
+                                      const BufferedWriter::Mode mode =
+                                        BufferedWriter::Mode::buffered) {
+  const IOStatus status = writer.open(filename, mode);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+  }
+  return status;
+}
+
+static inline void closeOutputFile(BufferedWriter& writer) {
+  const IOStatus status = writer.close();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+  }
+}
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
+
+namespace kahypar {
+namespace io {
+// Binary format of a stored coarsening hierarchy:
+//
+//   header                (CoarseningHierarchyHeader)
+//   configuration         configuration_size x char
+//   random state          random_state_size x char
+//   communities           num_communities x int32
+//   contractions          num_contractions x 8 x uint32
+//
+// Each contraction consists of the contraction memento (u, u_first_entry,
+// u_size, v) and the ranges of single-node and parallel nets removed after
+// the contraction. Sections are padded like in the binary hypergraph format
+// and covered by the checksum.
+struct CoarseningHierarchyHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t max_allowed_node_weight;
+  uint64_t hypergraph_fingerprint;
+  uint64_t contraction_limit;
+  uint64_t configuration_size;
+  uint64_t random_state_size;
+  uint64_t num_communities;
+  uint64_t num_contractions;
+  uint64_t checksum;
+};
+
+static_assert(sizeof(CoarseningHierarchyHeader) == 72, "Unexpected padding in binary header");
+
+static constexpr char kCoarseningHierarchyMagic[8] = { 'K', 'H', 'P', 'R', 'C', 'H', 'Y', '\0' };
+static constexpr uint32_t kCoarseningHierarchyVersion = 1;
+static constexpr size_t kCoarseningHierarchyEntrySize = 8;
+
+static inline IOStatus writeCoarseningHierarchyFile(const CoarseningHierarchy& hierarchy,
+                                                    const std::string& filename) {
+  std::ofstream out_stream(filename.c_str(), std::ios::binary);
+  if (!out_stream) {
+    return IOStatus::error("Could not open file " + filename + " for writing");
+  }
+
+  CoarseningHierarchyHeader header;
+  std::memcpy(header.magic, kCoarseningHierarchyMagic, sizeof(header.magic));
+  header.version = kCoarseningHierarchyVersion;
+  header.max_allowed_node_weight = hierarchy.max_allowed_node_weight;
+  header.hypergraph_fingerprint = hierarchy.hypergraph_fingerprint;
+  header.contraction_limit = hierarchy.contraction_limit;
+  header.configuration_size = hierarchy.configuration.size();
+  header.random_state_size = hierarchy.random_state.size();
+  header.num_communities = hierarchy.communities.size();
+  header.num_contractions = hierarchy.history.size();
+  header.checksum = 0;
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  internal::BinarySectionWriter writer(out_stream);
+  writer.write(std::vector<char>(hierarchy.configuration.begin(), hierarchy.configuration.end()));
+  writer.write(std::vector<char>(hierarchy.random_state.begin(), hierarchy.random_state.end()));
+  writer.write(hierarchy.communities);
+  std::vector<uint32_t> contractions;
+  contractions.reserve(kCoarseningHierarchyEntrySize * hierarchy.history.size());
+  for (const CoarseningMemento& memento : hierarchy.history) {
+    contractions.push_back(memento.contraction_memento.u);
+    contractions.push_back(memento.contraction_memento.u_first_entry);
+    contractions.push_back(memento.contraction_memento.u_size);
+    contractions.push_back(memento.contraction_memento.v);
+    contractions.push_back(memento.one_pin_hes_begin);
+    contractions.push_back(memento.one_pin_hes_size);
+    contractions.push_back(memento.parallel_hes_begin);
+    contractions.push_back(memento.parallel_hes_size);
+  }
+  writer.write(contractions);
+
+  header.checksum = writer.checksum();
+  out_stream.seekp(0);
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out_stream.close();
+  if (!out_stream) {
+    return IOStatus::error("Could not write file " + filename);
+  }
+  return IOStatus();
+}
+
+static inline IOStatus readCoarseningHierarchyFile(const std::string& filename,
+                                                   CoarseningHierarchy& hierarchy) {
+  MemoryMappedFile file;
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+
+  CoarseningHierarchyHeader header;
+  if (file.size() < sizeof(header)) {
+    return IOStatus::error(filename + " is not a coarsening hierarchy file");
+  }
+  std::memcpy(&header, file.begin(), sizeof(header));
+  if (std::memcmp(header.magic, kCoarseningHierarchyMagic, sizeof(header.magic)) != 0) {
+    return IOStatus::error(filename + " is not a coarsening hierarchy file");
+  } else if (header.version != kCoarseningHierarchyVersion) {
+    return IOStatus::error("Unsupported coarsening hierarchy version "
+                           + std::to_string(header.version) + " (expected "
+                           + std::to_string(kCoarseningHierarchyVersion) + ")");
+  }
+
+  const size_t max_entries = file.size() / sizeof(uint32_t);
+  if (header.configuration_size > file.size() || header.random_state_size > file.size() ||
+      header.num_communities > max_entries || header.num_contractions > max_entries) {
+    return IOStatus::error("Coarsening hierarchy file " + filename + " is truncated");
+  }
+  const size_t payload_size =
+    internal::paddedSize(header.configuration_size) +
+    internal::paddedSize(header.random_state_size) +
+    internal::paddedSize(header.num_communities * sizeof(ClusterID)) +
+    internal::paddedSize(header.num_contractions * kCoarseningHierarchyEntrySize *
+                         sizeof(uint32_t));
+  if (file.size() != sizeof(header) + payload_size) {
+    return IOStatus::error("Coarsening hierarchy file " + filename + " has size "
+                           + std::to_string(file.size()) + " but header requires "
+                           + std::to_string(sizeof(header) + payload_size));
+  }
+
+  const char* pos = file.begin() + sizeof(header);
+  internal::BinaryChecksum checksum;
+  checksum.update(pos, payload_size);
+  if (checksum.value() != header.checksum) {
+    return IOStatus::error("Checksum mismatch in coarsening hierarchy file " + filename);
+  }
+
+  const char* configuration = internal::binarySection<char>(pos, header.configuration_size);
+  const char* random_state = internal::binarySection<char>(pos, header.random_state_size);
+  const ClusterID* communities = internal::binarySection<ClusterID>(pos,
+                                                                    header.num_communities);
+  const uint32_t* contractions =
+    internal::binarySection<uint32_t>(pos, header.num_contractions *
+                                      kCoarseningHierarchyEntrySize);
+  ASSERT(pos == file.end());
+
+  hierarchy.hypergraph_fingerprint = header.hypergraph_fingerprint;
+  hierarchy.configuration.assign(configuration, header.configuration_size);
+  hierarchy.contraction_limit = header.contraction_limit;
+  hierarchy.max_allowed_node_weight = header.max_allowed_node_weight;
+  hierarchy.random_state.assign(random_state, header.random_state_size);
+  hierarchy.communities.assign(communities, communities + header.num_communities);
+  hierarchy.history.clear();
+  hierarchy.history.reserve(header.num_contractions);
+  for (size_t i = 0; i < header.num_contractions; ++i) {
+    const uint32_t* entry = contractions + i * kCoarseningHierarchyEntrySize;
+    hierarchy.history.emplace_back(Hypergraph::ContractionMemento { entry[0], entry[1],
+                                                                    entry[2], entry[3] });
+    hierarchy.history.back().one_pin_hes_begin = entry[4];
+    hierarchy.history.back().one_pin_hes_size = entry[5];
+    hierarchy.history.back().parallel_hes_begin = entry[6];
+    hierarchy.history.back().parallel_hes_size = entry[7];
+  }
+  return IOStatus();
+}
+}  // namespace io
+}  // namespace kahypar
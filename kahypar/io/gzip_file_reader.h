@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#ifdef KAHYPAR_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+static inline bool isGzipFile(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  unsigned char magic[2] = { 0, 0 };
+  file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+  return file && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+static inline IOStatus zlibUnavailable(const std::string& filename) {
+  return IOStatus::error("Cannot read gzip compressed file " + filename +
+                         ": KaHyPar was built without zlib");
+}
+
+#ifdef KAHYPAR_USE_ZLIB
+// Decompresses a gzip file on a background thread, such that decompression
+// overlaps with parsing. The decompressed data is handed out in blocks that
+// end at a line break (except for the last block), i.e. lines never span
+// two blocks and line-based parsers can process each block on its own.
+class GzipLineBlockReader {
+ public:
+  explicit GzipLineBlockReader(const size_t block_size = 4 * 1024 * 1024,
+                               const size_t max_queued_blocks = 4) :
+    _block_size(block_size),
+    _max_queued_blocks(max_queued_blocks),
+    _file(nullptr),
+    _filename(),
+    _thread(),
+    _mutex(),
+    _block_available(),
+    _space_available(),
+    _queue(),
+    _free_blocks(),
+    _current(),
+    _finished(false),
+    _stop(false),
+    _status() { }
+
+  GzipLineBlockReader(const GzipLineBlockReader&) = delete;
+  GzipLineBlockReader& operator= (const GzipLineBlockReader&) = delete;
+
+  GzipLineBlockReader(GzipLineBlockReader&&) = delete;
+  GzipLineBlockReader& operator= (GzipLineBlockReader&&) = delete;
+
+  ~GzipLineBlockReader() {
+    if (_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+      }
+      _space_available.notify_all();
+      _thread.join();
+    }
+    if (_file != nullptr) {
+      gzclose(_file);
+    }
+  }
+
+  IOStatus open(const std::string& filename) {
+    ASSERT(_file == nullptr, "Reader is already open");
+    _filename = filename;
+    _file = gzopen(filename.c_str(), "rb");
+    if (_file == nullptr) {
+      return IOStatus::error("Could not open file " + filename + ": " + std::strerror(errno));
+    }
+    gzbuffer(_file, 1024 * 1024);
+    _thread = std::thread(&GzipLineBlockReader::decompress, this);
+    return IOStatus();
+  }
+
+  // Returns the next block of decompressed data. The block stays valid until
+  // the next call. Returns false at the end of the input or if an error
+  // occurred, which is reported by status().
+  bool next(const char*& begin, const char*& end) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_current.empty()) {
+      _free_blocks.push_back(std::move(_current));
+      _current.clear();
+    }
+    _block_available.wait(lock, [&]() {
+        return !_queue.empty() || _finished;
+      });
+    if (_queue.empty()) {
+      return false;
+    }
+    _current = std::move(_queue.front());
+    _queue.pop_front();
+    lock.unlock();
+    _space_available.notify_one();
+    begin = _current.data();
+    end = _current.data() + _current.size();
+    return true;
+  }
+
+  const IOStatus & status() const {
+    return _status;
+  }
+
+ private:
+  void decompress() {
+    std::vector<char> carry;
+    while (true) {
+      std::vector<char> block = freeBlock();
+      block.assign(carry.begin(), carry.end());
+      block.resize(carry.size() + _block_size);
+      const int bytes_read = gzread(_file, block.data() + carry.size(),
+                                    static_cast<unsigned>(_block_size));
+      if (bytes_read < 0) {
+        int error = Z_OK;
+        const char* message = gzerror(_file, &error);
+        finish(IOStatus::error("Could not decompress " + _filename + ": " + message));
+        return;
+      }
+      block.resize(carry.size() + bytes_read);
+      carry.clear();
+      if (bytes_read == 0) {
+        if (!block.empty() && !push(std::move(block))) {
+          return;
+        }
+        finish(IOStatus());
+        return;
+      }
+
+      // Lines that do not end in this block are passed on with the next one.
+      size_t line_end = block.size();
+      while (line_end > 0 && block[line_end - 1] != '\n') {
+        --line_end;
+      }
+      carry.assign(block.begin() + line_end, block.end());
+      block.resize(line_end);
+      if (!block.empty() && !push(std::move(block))) {
+        return;
+      }
+    }
+  }
+
+  std::vector<char> freeBlock() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<char> block;
+    if (!_free_blocks.empty()) {
+      block = std::move(_free_blocks.back());
+      _free_blocks.pop_back();
+    }
+    return block;
+  }
+
+  // Returns false if the reader was closed before the input was consumed.
+  bool push(std::vector<char>&& block) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _space_available.wait(lock, [&]() {
+        return _queue.size() < _max_queued_blocks || _stop;
+      });
+    if (_stop) {
+      return false;
+    }
+    _queue.push_back(std::move(block));
+    lock.unlock();
+    _block_available.notify_one();
+    return true;
+  }
+
+  void finish(const IOStatus& status) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _status = status;
+      _finished = true;
+    }
+    _block_available.notify_one();
+  }
+
+  const size_t _block_size;
+  const size_t _max_queued_blocks;
+  gzFile _file;
+  std::string _filename;
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _block_available;
+  std::condition_variable _space_available;
+  std::deque<std::vector<char> > _queue;
+  std::vector<std::vector<char> > _free_blocks;
+  std::vector<char> _current;
+  bool _finished;
+  bool _stop;
+  IOStatus _status;
+};
+
+// Stream buffer on top of GzipLineBlockReader, which allows to read gzip
+// compressed files via std::istream.
+class GzipStreamBuffer : public std::streambuf {
+ public:
+  GzipStreamBuffer() :
+    _reader() { }
+
+  IOStatus open(const std::string& filename) {
+    return _reader.open(filename);
+  }
+
+ protected:
+  int_type underflow() override {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    if (!_reader.next(begin, end)) {
+      return traits_type::eof();
+    }
+    char* data = const_cast<char*>(begin);
+    setg(data, data, data + (end - begin));
+    return traits_type::to_int_type(*gptr());
+  }
+
+ private:
+  GzipLineBlockReader _reader;
+};
+#endif
+
+// Input file stream that transparently decompresses gzip compressed files.
+class InputFileStream : public std::istream {
+ public:
+  explicit InputFileStream(const std::string& filename) :
+    std::istream(nullptr),
+    _buffer() {
+    if (isGzipFile(filename)) {
+#ifdef KAHYPAR_USE_ZLIB
+      std::unique_ptr<GzipStreamBuffer> buffer = std::make_unique<GzipStreamBuffer>();
+      if (buffer->open(filename).ok()) {
+        _buffer = std::move(buffer);
+      }
+#endif
+    } else {
+      std::unique_ptr<std::filebuf> buffer = std::make_unique<std::filebuf>();
+      if (buffer->open(filename, std::ios::in) != nullptr) {
+        _buffer = std::move(buffer);
+      }
+    }
+    rdbuf(_buffer.get());
+    if (_buffer == nullptr) {
+      setstate(std::ios::failbit);
+    }
+  }
+
+  InputFileStream(const InputFileStream&) = delete;
+  InputFileStream& operator= (const InputFileStream&) = delete;
+
+  bool is_open() const {
+    return _buffer != nullptr;
+  }
+
+  void close() {
+    rdbuf(nullptr);
+    _buffer.reset();
+  }
+
+ private:
+  std::unique_ptr<std::streambuf> _buffer;
+};
+}  // namespace io
+}  // namespace kahypar
@@ -20,20 +20,31 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/buffered_writer.h"
+#include "kahypar/io/gzip_file_reader.h"
+#include "kahypar/io/input_formats.h"
+#include "kahypar/io/line_scanner.h"
+#include "kahypar/io/memory_mapped_file.h"
 
 namespace kahypar {
 namespace io {
 using Mapping = std::unordered_map<HypernodeID, HypernodeID>;
 
-static inline void readHGRHeader(std::ifstream& file, HyperedgeID& num_hyperedges,
+static inline void readHGRHeader(std::istream& file, HyperedgeID& num_hyperedges,
                                  HypernodeID& num_hypernodes, HypergraphType& hypergraph_type) {
   std::string line;
   std::getline(file, line);
@@ -49,134 +60,670 @@ static inline void readHGRHeader(std::ifstream& file, HyperedgeID& num_hyperedge
   hypergraph_type = static_cast<HypergraphType>(i);
 }
 
-static inline void readHypergraphFile(const std::string& filename, HypernodeID& num_hypernodes,
-                                      HyperedgeID& num_hyperedges,
-                                      HyperedgeIndexVector& index_vector,
-                                      HyperedgeVector& edge_vector,
-                                      HyperedgeWeightVector* hyperedge_weights = nullptr,
-                                      HypernodeWeightVector* hypernode_weights = nullptr) {
-  ASSERT(!filename.empty(), "No filename for hypergraph file specified");
-  HypergraphType hypergraph_type = HypergraphType::Unweighted;
-  std::ifstream file(filename);
-  if (file) {
-    readHGRHeader(file, num_hyperedges, num_hypernodes, hypergraph_type);
-    ASSERT(hypergraph_type == HypergraphType::Unweighted ||
-           hypergraph_type == HypergraphType::EdgeWeights ||
-           hypergraph_type == HypergraphType::NodeWeights ||
-           hypergraph_type == HypergraphType::EdgeAndNodeWeights,
-           "Hypergraph in file has wrong type");
-
-    bool has_hyperedge_weights = hypergraph_type == HypergraphType::EdgeWeights ||
-                                 hypergraph_type == HypergraphType::EdgeAndNodeWeights ?
-                                 true : false;
-    bool has_hypernode_weights = hypergraph_type == HypergraphType::NodeWeights ||
-                                 hypergraph_type == HypergraphType::EdgeAndNodeWeights ?
-                                 true : false;
-
-    index_vector.reserve(static_cast<size_t>(num_hyperedges) +  /*sentinel*/ 1);
-    index_vector.push_back(edge_vector.size());
+namespace internal {
+static inline IOStatus parseHGRHeader(LineScanner& scanner, HyperedgeID& num_hyperedges,
+                                      HypernodeID& num_hypernodes,
+                                      HypergraphType& hypergraph_type) {
+  scanner.skipCommentLines();
+  if (!scanner.readInteger(num_hyperedges) || !scanner.readInteger(num_hypernodes)) {
+    return parseError(scanner, "Invalid header");
+  }
+  int type = 0;
+  if (!scanner.atLineEnd() && !scanner.readInteger(type)) {
+    return parseError(scanner, "Invalid hypergraph type in header");
+  }
+  hypergraph_type = static_cast<HypergraphType>(type);
+  if (hypergraph_type != HypergraphType::Unweighted &&
+      hypergraph_type != HypergraphType::EdgeWeights &&
+      hypergraph_type != HypergraphType::NodeWeights &&
+      hypergraph_type != HypergraphType::EdgeAndNodeWeights) {
+    return parseError(scanner, "Hypergraph in file has wrong type " + std::to_string(type));
+  }
+  scanner.skipLine();
+  return IOStatus();
+}
 
-    std::string line;
-    for (HyperedgeID i = 0; i < num_hyperedges; ++i) {
-      std::getline(file, line);
-      std::istringstream line_stream(line);
-      if (line_stream.peek() == EOF) {
-        std::cerr << "Error: Hyperedge " << i << " is empty" << std::endl;
-        exit(1);
-      }
+// Parses the line of hyperedge he and appends its pins to pins.
+static inline IOStatus parseHyperedge(LineScanner& scanner, const HyperedgeID he,
+                                      const HypernodeID num_hypernodes,
+                                      const bool has_hyperedge_weight,
+                                      HyperedgeWeight& edge_weight, HyperedgeVector& pins) {
+  if (has_hyperedge_weight) {
+    if (scanner.atLineEnd()) {
+      return parseError(scanner, "Hyperedge " + std::to_string(he) + " is empty");
+    } else if (!scanner.readInteger(edge_weight)) {
+      return parseError(scanner, "Invalid weight of hyperedge " + std::to_string(he));
+    }
+  }
+  const size_t num_pins_before = pins.size();
+  while (!scanner.atLineEnd()) {
+    HypernodeID pin = 0;
+    if (!scanner.readInteger(pin) || pin == 0 || pin > num_hypernodes) {
+      return parseError(scanner, "Invalid pin of hyperedge " + std::to_string(he));
+    }
+    // Hypernode IDs start from 0
+    pins.push_back(pin - 1);
+  }
+  if (pins.size() == num_pins_before) {
+    return parseError(scanner, "Hyperedge " + std::to_string(he) + " is empty");
+  }
+  return IOStatus();
+}
 
-      if (has_hyperedge_weights) {
-        HyperedgeWeight edge_weight;
-        line_stream >> edge_weight;
-        if (hyperedge_weights == nullptr) {
-          LOG << "****** ignoring hyperedge weights ******";
-        } else {
-          ASSERT(hyperedge_weights != nullptr, "Hypergraph has hyperedge weights");
-          hyperedge_weights->push_back(edge_weight);
+static inline IOStatus parseHypernodeWeight(LineScanner& scanner, const HypernodeID hn,
+                                            HypernodeWeight& node_weight) {
+  if (scanner.atEnd() || !scanner.readInteger(node_weight)) {
+    return parseError(scanner, "Invalid weight of hypernode " + std::to_string(hn));
+  }
+  return IOStatus();
+}
+
+struct HGRBody {
+  HypernodeID num_hypernodes;
+  HyperedgeID num_hyperedges;
+  bool has_hyperedge_weights;
+  bool has_hypernode_weights;
+};
+
+// Parses the hyperedge and hypernode weight sections line by line. The input
+// can be passed in several pieces, as long as no line is split between them.
+class HGRBodyParser {
+ public:
+  HGRBodyParser(const HGRBody& body, HyperedgeIndexVector& index_vector,
+                HyperedgeVector& edge_vector, HyperedgeWeightVector* hyperedge_weights,
+                HypernodeWeightVector* hypernode_weights) :
+    _body(body),
+    _index_vector(index_vector),
+    _edge_vector(edge_vector),
+    _hyperedge_weights(body.has_hyperedge_weights ? hyperedge_weights : nullptr),
+    _hypernode_weights(body.has_hypernode_weights ? hypernode_weights : nullptr),
+    _num_lines(static_cast<size_t>(body.num_hyperedges) +
+               (_hypernode_weights != nullptr ? body.num_hypernodes : 0)),
+    _next_line(0) { }
+
+  HGRBodyParser(const HGRBodyParser&) = delete;
+  HGRBodyParser& operator= (const HGRBodyParser&) = delete;
+
+  // Parses lines until the end of the scanner or until the body is complete.
+  IOStatus parse(LineScanner& scanner) {
+    while (_next_line < _num_lines) {
+      scanner.skipCommentLines();
+      if (scanner.atEnd()) {
+        return IOStatus();
+      }
+      IOStatus status;
+      if (_next_line < _body.num_hyperedges) {
+        const HyperedgeID he = static_cast<HyperedgeID>(_next_line);
+        HyperedgeWeight edge_weight = 1;
+        status = parseHyperedge(scanner, he, _body.num_hypernodes,
+                                _body.has_hyperedge_weights, edge_weight, _edge_vector);
+        if (status.ok()) {
+          if (_hyperedge_weights != nullptr) {
+            _hyperedge_weights->push_back(edge_weight);
+          }
+          _index_vector.push_back(_edge_vector.size());
+        }
+      } else {
+        const HypernodeID hn = static_cast<HypernodeID>(_next_line - _body.num_hyperedges);
+        HypernodeWeight node_weight = 0;
+        status = parseHypernodeWeight(scanner, hn, node_weight);
+        if (status.ok()) {
+          _hypernode_weights->push_back(node_weight);
         }
       }
-      HypernodeID pin;
-      while (line_stream >> pin) {
-        // Hypernode IDs start from 0
-        --pin;
-        ASSERT(pin < num_hypernodes, "Invalid hypernode ID");
-        edge_vector.push_back(pin);
+      if (!status.ok()) {
+        return status;
       }
-      index_vector.push_back(edge_vector.size());
+      scanner.skipLine();
+      ++_next_line;
     }
+    return IOStatus();
+  }
 
-    if (has_hypernode_weights) {
-      if (hypernode_weights == nullptr) {
-        LOG << " ****** ignoring hypernode weights ******";
-      } else {
-        ASSERT(hypernode_weights != nullptr, "Hypergraph has hypernode weights");
-        for (HypernodeID i = 0; i < num_hypernodes; ++i) {
-          std::getline(file, line);
-          std::istringstream line_stream(line);
-          HypernodeWeight node_weight;
-          line_stream >> node_weight;
-          hypernode_weights->push_back(node_weight);
+  bool isComplete() const {
+    return _next_line == _num_lines;
+  }
+
+  // Reports missing lines, if the input ended at the position of scanner.
+  IOStatus finish(const LineScanner& scanner) const {
+    if (_next_line < _body.num_hyperedges) {
+      return parseError(scanner, "File ends after " + std::to_string(_next_line) + " of "
+                        + std::to_string(_body.num_hyperedges) + " hyperedges");
+    } else if (_next_line < _num_lines) {
+      return parseError(scanner, "Invalid weight of hypernode "
+                        + std::to_string(_next_line - _body.num_hyperedges));
+    }
+    return IOStatus();
+  }
+
+ private:
+  const HGRBody _body;
+  HyperedgeIndexVector& _index_vector;
+  HyperedgeVector& _edge_vector;
+  HyperedgeWeightVector* _hyperedge_weights;
+  HypernodeWeightVector* _hypernode_weights;
+  const size_t _num_lines;
+  size_t _next_line;
+};
+
+static inline HGRBody makeHGRBody(const HypergraphType hypergraph_type,
+                                  const HypernodeID num_hypernodes,
+                                  const HyperedgeID num_hyperedges,
+                                  const HyperedgeWeightVector* hyperedge_weights,
+                                  const HypernodeWeightVector* hypernode_weights) {
+  HGRBody body;
+  body.num_hypernodes = num_hypernodes;
+  body.num_hyperedges = num_hyperedges;
+  body.has_hyperedge_weights = hypergraph_type == HypergraphType::EdgeWeights ||
+                               hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+  body.has_hypernode_weights = hypergraph_type == HypergraphType::NodeWeights ||
+                               hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+  if (body.has_hyperedge_weights && hyperedge_weights == nullptr) {
+    LOG << "****** ignoring hyperedge weights ******";
+  }
+  if (body.has_hypernode_weights && hypernode_weights == nullptr) {
+    LOG << " ****** ignoring hypernode weights ******";
+  }
+  return body;
+}
+
+static inline void reserveHGRBody(const HGRBody& body, HyperedgeIndexVector& index_vector,
+                                  HyperedgeVector& edge_vector,
+                                  HyperedgeWeightVector* hyperedge_weights,
+                                  HypernodeWeightVector* hypernode_weights) {
+  index_vector.reserve(index_vector.size() + static_cast<size_t>(body.num_hyperedges) +
+                       /*sentinel*/ 1);
+  index_vector.push_back(edge_vector.size());
+  if (body.has_hyperedge_weights && hyperedge_weights != nullptr) {
+    hyperedge_weights->reserve(hyperedge_weights->size() + body.num_hyperedges);
+  }
+  if (body.has_hypernode_weights && hypernode_weights != nullptr) {
+    hypernode_weights->reserve(hypernode_weights->size() + body.num_hypernodes);
+  }
+}
+
+// Parses the header and the body of an hMetis file via parseLines.
+class HGRParser {
+ public:
+  explicit HGRParser(const ParserOutput& output) :
+    _output(output),
+    _body_parser() { }
+
+  HGRParser(const HGRParser&) = delete;
+  HGRParser& operator= (const HGRParser&) = delete;
+
+  IOStatus parse(LineScanner& scanner) {
+    if (_body_parser == nullptr) {
+      scanner.skipCommentLines();
+      if (scanner.atEnd()) {
+        return IOStatus();
+      }
+      HypergraphType hypergraph_type = HypergraphType::Unweighted;
+      const IOStatus status = parseHGRHeader(scanner, _output.num_hyperedges,
+                                             _output.num_hypernodes, hypergraph_type);
+      if (!status.ok()) {
+        return status;
+      }
+      const HGRBody body = makeHGRBody(hypergraph_type, _output.num_hypernodes,
+                                       _output.num_hyperedges, _output.hyperedge_weights,
+                                       _output.hypernode_weights);
+      reserveHGRBody(body, _output.index_vector, _output.edge_vector,
+                     _output.hyperedge_weights, _output.hypernode_weights);
+      _body_parser = std::make_unique<HGRBodyParser>(body, _output.index_vector,
+                                                     _output.edge_vector,
+                                                     _output.hyperedge_weights,
+                                                     _output.hypernode_weights);
+    }
+    return _body_parser->parse(scanner);
+  }
+
+  bool isComplete() const {
+    return _body_parser != nullptr && _body_parser->isComplete();
+  }
+
+  IOStatus finish(const LineScanner& scanner) const {
+    if (_body_parser == nullptr) {
+      LineScanner end_scanner(scanner);
+      HypergraphType hypergraph_type = HypergraphType::Unweighted;
+      return parseHGRHeader(end_scanner, _output.num_hyperedges, _output.num_hypernodes,
+                            hypergraph_type);
+    }
+    return _body_parser->finish(scanner);
+  }
+
+ private:
+  ParserOutput _output;
+  std::unique_ptr<HGRBodyParser> _body_parser;
+};
+
+template <typename F>
+static inline void parallelFor(const size_t num_tasks, const F& f) {
+  std::vector<std::thread> threads;
+  threads.reserve(num_tasks);
+  for (size_t task = 1; task < num_tasks; ++task) {
+    // exceptions cannot leave a thread anyway
+    threads.emplace_back([&f](const size_t t) noexcept {
+        f(t);
+      }, task);
+  }
+  f(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+// Parses the body in parallel: The body is split into chunks at line boundaries.
+// In a first pass, all threads count the lines of their chunk, which determines
+// the hyperedge or hypernode each line belongs to. Afterwards, each thread parses
+// its lines into local buffers, which are then concatenated in chunk order.
+static inline IOStatus parseHGRBodyInParallel(const LineScanner& scanner, const char* end,
+                                              const size_t num_chunks, const HGRBody& body,
+                                              HyperedgeIndexVector& index_vector,
+                                              HyperedgeVector& edge_vector,
+                                              HyperedgeWeightVector* hyperedge_weights,
+                                              HypernodeWeightVector* hypernode_weights) {
+  struct Chunk {
+    Chunk() :
+      begin(nullptr),
+      end(nullptr),
+      first_line(0),
+      num_lines(0),
+      first_data_line(0),
+      num_data_lines(0),
+      edge_ends(),
+      pins(),
+      status() { }
+
+    Chunk(const Chunk&) = delete;
+    Chunk& operator= (const Chunk&) = delete;
+
+    const char* begin;
+    const char* end;
+    size_t first_line;
+    size_t num_lines;
+    size_t first_data_line;
+    size_t num_data_lines;
+    std::vector<size_t> edge_ends;
+    HyperedgeVector pins;
+    IOStatus status;
+  };
+
+  const char* body_begin = scanner.position();
+  const size_t body_size = end - body_begin;
+  std::vector<Chunk> chunks(num_chunks);
+  const char* chunk_begin = body_begin;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const char* chunk_end = end;
+    if (i + 1 < num_chunks) {
+      chunk_end = std::max(chunk_begin, body_begin + (i + 1) * body_size / num_chunks);
+      const char* newline = static_cast<const char*>(std::memchr(chunk_end, '\n',
+                                                                 end - chunk_end));
+      chunk_end = newline != nullptr ? newline + 1 : end;
+    }
+    chunks[i].begin = chunk_begin;
+    chunks[i].end = chunk_end;
+    chunk_begin = chunk_end;
+  }
+
+  parallelFor(num_chunks, [&](const size_t i) {
+      Chunk& chunk = chunks[i];
+      chunk.num_lines = 0;
+      chunk.num_data_lines = 0;
+      for (const char* pos = chunk.begin; pos != chunk.end; ) {
+        chunk.num_data_lines += *pos != '%';
+        ++chunk.num_lines;
+        const char* newline = static_cast<const char*>(std::memchr(pos, '\n', chunk.end - pos));
+        pos = newline != nullptr ? newline + 1 : chunk.end;
+      }
+    });
+
+  size_t line = scanner.line();
+  size_t data_line = 0;
+  for (Chunk& chunk : chunks) {
+    chunk.first_line = line;
+    chunk.first_data_line = data_line;
+    line += chunk.num_lines;
+    data_line += chunk.num_data_lines;
+  }
+  const bool read_hypernode_weights = body.has_hypernode_weights && hypernode_weights != nullptr;
+  const size_t num_hypernode_weights = read_hypernode_weights ? body.num_hypernodes : 0;
+
+  const size_t first_edge_weight = hyperedge_weights != nullptr ? hyperedge_weights->size() : 0;
+  if (body.has_hyperedge_weights && hyperedge_weights != nullptr) {
+    hyperedge_weights->resize(first_edge_weight + body.num_hyperedges);
+  }
+  const size_t first_node_weight = hypernode_weights != nullptr ? hypernode_weights->size() : 0;
+  if (read_hypernode_weights) {
+    hypernode_weights->resize(first_node_weight + body.num_hypernodes);
+  }
+
+  parallelFor(num_chunks, [&](const size_t i) {
+      Chunk& chunk = chunks[i];
+      LineScanner chunk_scanner(chunk.begin, chunk.end, chunk.first_line);
+      for (size_t data = chunk.first_data_line;
+           data < static_cast<size_t>(body.num_hyperedges) + num_hypernode_weights; ++data) {
+        chunk_scanner.skipCommentLines();
+        if (chunk_scanner.atEnd()) {
+          break;
+        }
+        if (data < body.num_hyperedges) {
+          const HyperedgeID he = static_cast<HyperedgeID>(data);
+          HyperedgeWeight edge_weight = 1;
+          chunk.status = parseHyperedge(chunk_scanner, he, body.num_hypernodes,
+                                        body.has_hyperedge_weights, edge_weight, chunk.pins);
+          if (body.has_hyperedge_weights && hyperedge_weights != nullptr) {
+            (*hyperedge_weights)[first_edge_weight + he] = edge_weight;
+          }
+          chunk.edge_ends.push_back(chunk.pins.size());
+        } else {
+          const HypernodeID hn = static_cast<HypernodeID>(data - body.num_hyperedges);
+          chunk.status = parseHypernodeWeight(chunk_scanner, hn,
+                                              (*hypernode_weights)[first_node_weight + hn]);
+        }
+        if (!chunk.status.ok()) {
+          break;
         }
+        chunk_scanner.skipLine();
       }
+    });
+
+  // Report the first error in file order
+  for (const Chunk& chunk : chunks) {
+    if (!chunk.status.ok()) {
+      return chunk.status;
     }
-    file.close();
-  } else {
-    std::cerr << "Error: File not found: " << std::endl;
   }
+  if (data_line < body.num_hyperedges) {
+    LineScanner end_scanner(end, end, line);
+    return parseError(end_scanner, "File ends after " + std::to_string(data_line) + " of "
+                      + std::to_string(body.num_hyperedges) + " hyperedges");
+  }
+  if (data_line < static_cast<size_t>(body.num_hyperedges) + num_hypernode_weights) {
+    const HypernodeID hn = static_cast<HypernodeID>(data_line - body.num_hyperedges);
+    LineScanner end_scanner(end, end, line);
+    return parseError(end_scanner, "Invalid weight of hypernode " + std::to_string(hn));
+  }
+
+  // Concatenate the pins of all chunks
+  std::vector<size_t> first_edge(num_chunks + 1, index_vector.size());
+  std::vector<size_t> first_pin(num_chunks + 1, edge_vector.size());
+  for (size_t i = 0; i < num_chunks; ++i) {
+    first_edge[i + 1] = first_edge[i] + chunks[i].edge_ends.size();
+    first_pin[i + 1] = first_pin[i] + chunks[i].pins.size();
+  }
+  index_vector.resize(first_edge[num_chunks]);
+  edge_vector.resize(first_pin[num_chunks]);
+  parallelFor(num_chunks, [&](const size_t i) {
+      const Chunk& chunk = chunks[i];
+      for (size_t j = 0; j < chunk.edge_ends.size(); ++j) {
+        index_vector[first_edge[i] + j] = first_pin[i] + chunk.edge_ends[j];
+      }
+      std::copy(chunk.pins.begin(), chunk.pins.end(), edge_vector.begin() + first_pin[i]);
+    });
+  return IOStatus();
+}
+}  // namespace internal
+
+// Parses a hypergraph in hMetis format from a memory mapped file.
+// In contrast to readHypergraphFile, errors are reported to the caller.
+// If num_threads > 1, files are split into chunks of at least min_chunk_size
+// bytes, which are parsed in parallel. Gzip compressed files are decompressed
+// on a separate thread while parsing.
+static inline IOStatus parseHypergraphFile(const std::string& filename,
+                                           HypernodeID& num_hypernodes,
+                                           HyperedgeID& num_hyperedges,
+                                           HyperedgeIndexVector& index_vector,
+                                           HyperedgeVector& edge_vector,
+                                           HyperedgeWeightVector* hyperedge_weights = nullptr,
+                                           HypernodeWeightVector* hypernode_weights = nullptr,
+                                           const size_t num_threads = 1,
+                                           const size_t min_chunk_size = 4 * 1024 * 1024) {
+  ASSERT(!filename.empty(), "No filename for hypergraph file specified");
+  if (isGzipFile(filename)) {
+    internal::HGRParser parser({ num_hypernodes, num_hyperedges, index_vector, edge_vector,
+                                 hyperedge_weights, hypernode_weights });
+    return internal::parseLines(filename, parser);
+  }
+
+  MemoryMappedFile file;
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+
+  LineScanner scanner(file.begin(), file.end());
+  HypergraphType hypergraph_type = HypergraphType::Unweighted;
+  status = internal::parseHGRHeader(scanner, num_hyperedges, num_hypernodes, hypergraph_type);
+  if (!status.ok()) {
+    return status;
+  }
+
+  const internal::HGRBody body = internal::makeHGRBody(hypergraph_type, num_hypernodes,
+                                                       num_hyperedges, hyperedge_weights,
+                                                       hypernode_weights);
+  const size_t num_chunks = std::min(std::max(num_threads, static_cast<size_t>(1)),
+                                     file.size() / std::max(min_chunk_size,
+                                                            static_cast<size_t>(1)) + 1);
+  if (num_chunks > 1) {
+    index_vector.reserve(index_vector.size() + static_cast<size_t>(num_hyperedges) +
+                         /*sentinel*/ 1);
+    index_vector.push_back(edge_vector.size());
+    return internal::parseHGRBodyInParallel(scanner, file.end(), num_chunks, body, index_vector,
+                                            edge_vector, hyperedge_weights, hypernode_weights);
+  }
+  internal::reserveHGRBody(body, index_vector, edge_vector, hyperedge_weights, hypernode_weights);
+  internal::HGRBodyParser parser(body, index_vector, edge_vector, hyperedge_weights,
+                                 hypernode_weights);
+  status = parser.parse(scanner);
+  if (!status.ok()) {
+    return status;
+  }
+  return parser.finish(scanner);
+}
+
+static inline void readHypergraphFile(const std::string& filename, HypernodeID& num_hypernodes,
+                                      HyperedgeID& num_hyperedges,
+                                      HyperedgeIndexVector& index_vector,
+                                      HyperedgeVector& edge_vector,
+                                      HyperedgeWeightVector* hyperedge_weights = nullptr,
+                                      HypernodeWeightVector* hypernode_weights = nullptr,
+                                      const size_t num_threads = 1) {
+  const IOStatus status = parseHypergraphFile(filename, num_hypernodes, num_hyperedges,
+                                              index_vector, edge_vector,
+                                              hyperedge_weights, hypernode_weights,
+                                              num_threads);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    exit(1);
+  }
+}
+
+// Parses a hypergraph file in hMetis, PaToH, MatrixMarket or edge list format.
+// If format is InputFormat::automatic, the format is determined via detectInputFormat.
+static inline IOStatus parseInputFile(const std::string& filename, InputFormat format,
+                                      HypernodeID& num_hypernodes,
+                                      HyperedgeID& num_hyperedges,
+                                      HyperedgeIndexVector& index_vector,
+                                      HyperedgeVector& edge_vector,
+                                      HyperedgeWeightVector* hyperedge_weights = nullptr,
+                                      HypernodeWeightVector* hypernode_weights = nullptr,
+                                      const size_t num_threads = 1) {
+  if (format == InputFormat::automatic) {
+    format = detectInputFormat(filename);
+  }
+  if (format == InputFormat::hmetis) {
+    return parseHypergraphFile(filename, num_hypernodes, num_hyperedges, index_vector,
+                               edge_vector, hyperedge_weights, hypernode_weights, num_threads);
+  }
+  return parseNonHMetisFile(filename, format, num_hypernodes, num_hyperedges, index_vector,
+                            edge_vector, hyperedge_weights, hypernode_weights);
 }
 
 static inline Hypergraph createHypergraphFromFile(const std::string& filename,
-                                                  const PartitionID num_parts) {
+                                                  const PartitionID num_parts,
+                                                  const size_t num_threads = 1,
+                                                  const InputFormat format =
+                                                    InputFormat::automatic) {
+  if (isBinaryHypergraphFile(filename)) {
+    Hypergraph hypergraph;
+    const IOStatus status = readBinaryHypergraphFile(filename, num_parts, hypergraph);
+    if (!status.ok()) {
+      std::cerr << "Error: " << status.message() << std::endl;
+      exit(1);
+    }
+    return hypergraph;
+  }
+
   HypernodeID num_hypernodes;
   HyperedgeID num_hyperedges;
   HyperedgeIndexVector index_vector;
   HyperedgeVector edge_vector;
   HypernodeWeightVector hypernode_weights;
   HyperedgeWeightVector hyperedge_weights;
-  readHypergraphFile(filename, num_hypernodes, num_hyperedges,
-                     index_vector, edge_vector, &hyperedge_weights, &hypernode_weights);
+  const IOStatus status = parseInputFile(filename, format, num_hypernodes, num_hyperedges,
+                                         index_vector, edge_vector, &hyperedge_weights,
+                                         &hypernode_weights, num_threads);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    exit(1);
+  }
   return Hypergraph(num_hypernodes, num_hyperedges, index_vector, edge_vector,
                     num_parts, &hyperedge_weights, &hypernode_weights);
 }
 
 
-static inline void writeHypernodeWeights(std::ofstream& out_stream, const Hypergraph& hypergraph) {
+static inline void writeHypernodeWeights(BufferedWriter& out_stream, const Hypergraph& hypergraph) {
   for (const HypernodeID& hn : hypergraph.nodes()) {
-    out_stream << hypergraph.nodeWeight(hn) << std::endl;
+    out_stream << hypergraph.nodeWeight(hn) << '\n';
   }
 }
 
-static inline void writeHGRHeader(std::ofstream& out_stream, const Hypergraph& hypergraph) {
+static inline void writeHGRHeader(BufferedWriter& out_stream, const Hypergraph& hypergraph) {
   out_stream << hypergraph.initialNumEdges() << " " << hypergraph.initialNumNodes() << " ";
   if (hypergraph.type() != HypergraphType::Unweighted) {
     out_stream << static_cast<int>(hypergraph.type());
   }
-  out_stream << std::endl;
+  out_stream << '\n';
+}
+
+static inline void writeHGRLine(BufferedWriter& out_stream, const Hypergraph& hypergraph,
+                                const HyperedgeID he) {
+  if (hypergraph.type() == HypergraphType::EdgeWeights ||
+      hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
+    out_stream << hypergraph.edgeWeight(he) << " ";
+  }
+  for (const HypernodeID& pin : hypergraph.pins(he)) {
+    out_stream << pin + 1 << " ";
+  }
+  out_stream << '\n';
+}
+
+// Number of bytes writeHGRLine writes for hyperedge he.
+static inline size_t hgrLineSize(const Hypergraph& hypergraph, const HyperedgeID he) {
+  size_t size = 1;
+  if (hypergraph.type() == HypergraphType::EdgeWeights ||
+      hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
+    size += BufferedWriter::numCharacters(hypergraph.edgeWeight(he)) + 1;
+  }
+  for (const HypernodeID& pin : hypergraph.pins(he)) {
+    size += BufferedWriter::numCharacters(pin + 1) + 1;
+  }
+  return size;
 }
 
-static inline void writeHypergraphFile(const Hypergraph& hypergraph, const std::string& filename) {
+// Writes the hyperedges and hypernode weights in parallel: The lines of the
+// file are split into num_chunks ranges. A first pass determines the number
+// of bytes of each range. Afterwards, each thread formats its range into its
+// own buffer and writes it to the precomputed offset using pwrite. The first
+// range is written by out_stream, which already contains the header.
+static inline void writeHGRBodyInParallel(BufferedWriter& out_stream, const Hypergraph& hypergraph,
+                                          const size_t num_chunks, const size_t header_size) {
+  const bool write_node_weights = hypergraph.type() == HypergraphType::NodeWeights ||
+                                  hypergraph.type() == HypergraphType::EdgeAndNodeWeights;
+  const size_t num_edges = hypergraph.initialNumEdges();
+  const size_t num_lines = num_edges + (write_node_weights ? hypergraph.initialNumNodes() : 0);
+  const auto chunk_begin = [&](const size_t chunk) {
+                             return num_lines * chunk / num_chunks;
+                           };
+
+  std::vector<uint64_t> offsets(num_chunks + 1, 0);
+  internal::parallelFor(num_chunks, [&](const size_t chunk) {
+      uint64_t size = 0;
+      for (size_t line = chunk_begin(chunk); line < chunk_begin(chunk + 1); ++line) {
+        size += line < num_edges ?
+                hgrLineSize(hypergraph, line) :
+                BufferedWriter::numCharacters(hypergraph.nodeWeight(line - num_edges)) + 1;
+      }
+      offsets[chunk + 1] = size;
+    });
+  offsets[0] = header_size;
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<IOStatus> status(num_chunks);
+  internal::parallelFor(num_chunks, [&](const size_t chunk) {
+      std::unique_ptr<BufferedWriter> region;
+      if (chunk > 0) {
+        region.reset(new BufferedWriter());
+        region->openAt(out_stream, offsets[chunk]);
+      }
+      BufferedWriter& writer = chunk > 0 ? *region : out_stream;
+      for (size_t line = chunk_begin(chunk); line < chunk_begin(chunk + 1); ++line) {
+        if (line < num_edges) {
+          writeHGRLine(writer, hypergraph, line);
+        } else {
+          writer << hypergraph.nodeWeight(line - num_edges) << '\n';
+        }
+      }
+      if (chunk > 0) {
+        status[chunk] = region->close();
+      }
+    });
+  for (const IOStatus& chunk_status : status) {
+    if (!chunk_status.ok()) {
+      std::cerr << "Error: " << chunk_status.message() << std::endl;
+      break;
+    }
+  }
+}
+
+// If num_threads > 1, hypergraphs with at least min_lines_per_chunk lines per
+// thread are written in parallel. The output does not depend on num_threads.
+static inline void writeHypergraphFile(const Hypergraph& hypergraph, const std::string& filename,
+                                       const size_t num_threads = 1,
+                                       const size_t min_lines_per_chunk = 64 * 1024) {
   ASSERT(!filename.empty(), "No filename for hypergraph file specified");
   ALWAYS_ASSERT(!hypergraph.isModified(), "Hypergraph is modified. Reindexing HNs/HEs necessary.");
 
-  std::ofstream out_stream(filename.c_str());
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
   writeHGRHeader(out_stream, hypergraph);
 
-  for (const HyperedgeID& he : hypergraph.edges()) {
-    if (hypergraph.type() == HypergraphType::EdgeWeights ||
-        hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
-      out_stream << hypergraph.edgeWeight(he) << " ";
+  const bool write_node_weights = hypergraph.type() == HypergraphType::NodeWeights ||
+                                  hypergraph.type() == HypergraphType::EdgeAndNodeWeights;
+  const size_t num_lines = hypergraph.initialNumEdges() +
+                           (write_node_weights ? hypergraph.initialNumNodes() : 0);
+  const size_t num_chunks = std::min(std::max(num_threads, static_cast<size_t>(1)),
+                                     std::max(num_lines / std::max(min_lines_per_chunk,
+                                                                   static_cast<size_t>(1)),
+                                              static_cast<size_t>(1)));
+  if (num_chunks > 1) {
+    size_t header_size = BufferedWriter::numCharacters(hypergraph.initialNumEdges()) + 1 +
+                         BufferedWriter::numCharacters(hypergraph.initialNumNodes()) + 1 + 1;
+    if (hypergraph.type() != HypergraphType::Unweighted) {
+      header_size += BufferedWriter::numCharacters(static_cast<int>(hypergraph.type()));
     }
-    for (const HypernodeID& pin : hypergraph.pins(he)) {
-      out_stream << pin + 1 << " ";
+    writeHGRBodyInParallel(out_stream, hypergraph, num_chunks, header_size);
+  } else {
+    for (const HyperedgeID& he : hypergraph.edges()) {
+      writeHGRLine(out_stream, hypergraph, he);
+    }
+    if (write_node_weights) {
+      writeHypernodeWeights(out_stream, hypergraph);
     }
-    out_stream << std::endl;
-  }
-
-  if (hypergraph.type() == HypergraphType::NodeWeights ||
-      hypergraph.type() == HypergraphType::EdgeAndNodeWeights) {
-    writeHypernodeWeights(out_stream, hypergraph);
   }
-  out_stream.close();
+  closeOutputFile(out_stream);
 }
 
 
@@ -184,7 +731,10 @@ static inline void writeHypergraphToGraphMLFile(const Hypergraph& hypergraph,
                                                 const std::string& filename,
                                                 const std::vector<PartitionID>* hn_cluster_ids = nullptr,
                                                 const std::vector<PartitionID>* he_cluster_ids = nullptr) {
-  std::ofstream out_stream(filename.c_str());
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
 
   out_stream << R"(<?xml version="1.0" encoding="UTF-8" standalone="no"?>)"
              << R"( <graphml xmlns="http://graphml.graphdrawing.org/xmlns")"
@@ -196,50 +746,50 @@ static inline void writeHypergraphToGraphMLFile(const Hypergraph& hypergraph,
              << R"( xmlns:yed="http://www.yworks.com/xml/yed/3")"
              << R"( xsi:schemaLocation="http://graphml.graphdrawing.org/xmlns)"
              << R"(http://www.yworks.com/xml/schema/graphml/1.1/ygraphml.xsd">)"
-             << std::endl;
-
-  out_stream << R"(<key id="d0" for="node" attr.name="weight" attr.type="double"/>)" << std::endl;
-  out_stream << R"(<key id="d1" for="node" attr.name="part" attr.type="int"/>)" << std::endl;
-  out_stream << R"(<key id="d2" for="node" attr.name="iscutedge" attr.type="int"/>)" << std::endl;
-  out_stream << R"(<key id="d7" for="node" attr.name="modclass" attr.type="int"/>)" << std::endl;
-  out_stream << R"(<key id="d8" for="node" attr.name="color" attr.type="string"/>)" << std::endl;
-  out_stream << R"(<graph id="G" edgedefault="undirected">)" << std::endl;
+             << '\n';
+
+  out_stream << R"(<key id="d0" for="node" attr.name="weight" attr.type="double"/>)" << '\n';
+  out_stream << R"(<key id="d1" for="node" attr.name="part" attr.type="int"/>)" << '\n';
+  out_stream << R"(<key id="d2" for="node" attr.name="iscutedge" attr.type="int"/>)" << '\n';
+  out_stream << R"(<key id="d7" for="node" attr.name="modclass" attr.type="int"/>)" << '\n';
+  out_stream << R"(<key id="d8" for="node" attr.name="color" attr.type="string"/>)" << '\n';
+  out_stream << R"(<graph id="G" edgedefault="undirected">)" << '\n';
   for (const HypernodeID& hn : hypergraph.nodes()) {
-    out_stream << R"(<node id="n)" << hn << R"(">)" << std::endl;
-    out_stream << R"(<data key="d0">)" << hypergraph.nodeWeight(hn) << "</data>" << std::endl;
+    out_stream << R"(<node id="n)" << hn << R"(">)" << '\n';
+    out_stream << R"(<data key="d0">)" << hypergraph.nodeWeight(hn) << "</data>" << '\n';
     if (hn_cluster_ids != nullptr) {
-      out_stream << R"(<data key="d7">)" << (*hn_cluster_ids)[hn] << "</data>" << std::endl;
+      out_stream << R"(<data key="d7">)" << (*hn_cluster_ids)[hn] << "</data>" << '\n';
     } else {
-      out_stream << R"(<data key="d1">)" << hypergraph.partID(hn) << "</data>" << std::endl;
+      out_stream << R"(<data key="d1">)" << hypergraph.partID(hn) << "</data>" << '\n';
     }
 
-    out_stream << R"(<data key="d2">)" << 42 << "</data>" << std::endl;
-    out_stream << R"(<data key="d8">)" << "blue" << "</data>" << std::endl;
-    out_stream << "</node>" << std::endl;
+    out_stream << R"(<data key="d2">)" << 42 << "</data>" << '\n';
+    out_stream << R"(<data key="d8">)" << "blue" << "</data>" << '\n';
+    out_stream << "</node>" << '\n';
   }
 
   HyperedgeID edge_id = 0;
   for (const HyperedgeID& he : hypergraph.edges()) {
     // const HyperedgeID he_id = hypergraph.initialNumNodes() + he;
-    out_stream << R"(<node id="h)" << he << R"(">)" << std::endl;
-    out_stream << R"(<data key="d0">)" << hypergraph.edgeWeight(he) << "</data>" << std::endl;
+    out_stream << R"(<node id="h)" << he << R"(">)" << '\n';
+    out_stream << R"(<data key="d0">)" << hypergraph.edgeWeight(he) << "</data>" << '\n';
     if (he_cluster_ids != nullptr) {
-      out_stream << R"(<data key="d7">)" << (*he_cluster_ids)[he] << "</data>" << std::endl;
+      out_stream << R"(<data key="d7">)" << (*he_cluster_ids)[he] << "</data>" << '\n';
     } else {
-      out_stream << R"(<data key="d1">)" << -1 << "</data>" << std::endl;
+      out_stream << R"(<data key="d1">)" << -1 << "</data>" << '\n';
     }
-    out_stream << R"(<data key="d2">)" << (hypergraph.connectivity(he) > 1) << "</data>" << std::endl;
-    out_stream << R"(<data key="d8">)" << "red" << "</data>" << std::endl;
-    out_stream << "</node>" << std::endl;
+    out_stream << R"(<data key="d2">)" << (hypergraph.connectivity(he) > 1) << "</data>" << '\n';
+    out_stream << R"(<data key="d8">)" << "red" << "</data>" << '\n';
+    out_stream << "</node>" << '\n';
     for (const HypernodeID& pin : hypergraph.pins(he)) {
       out_stream << R"(<edge id="e)" << edge_id++ << R"(" source="n)" << pin << R"(" target="h)"
-                 << he << R"("/>)" << std::endl;
+                 << he << R"("/>)" << '\n';
     }
   }
 
-  out_stream << "</graph>" << std::endl;
-  out_stream << "</graphml>" << std::endl;
-  out_stream.close();
+  out_stream << "</graph>" << '\n';
+  out_stream << "</graphml>" << '\n';
+  closeOutputFile(out_stream);
 }
 
 
@@ -247,12 +797,15 @@ static inline void writeHypergraphForhMetisPartitioning(const Hypergraph& hyperg
                                                         const std::string& filename,
                                                         const Mapping& mapping) {
   ASSERT(!filename.empty(), "No filename for hMetis initial partitioning file specified");
-  std::ofstream out_stream(filename.c_str());
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
 
   // coarse graphs always have edge and node weights, even if graph wasn't coarsend
   out_stream << hypergraph.currentNumEdges() << " " << hypergraph.currentNumNodes() << " ";
   out_stream << static_cast<int>(HypergraphType::EdgeAndNodeWeights);
-  out_stream << std::endl;
+  out_stream << '\n';
 
   for (const HyperedgeID& he : hypergraph.edges()) {
     out_stream << hypergraph.edgeWeight(he) << " ";
@@ -260,21 +813,24 @@ static inline void writeHypergraphForhMetisPartitioning(const Hypergraph& hyperg
       ASSERT(mapping.find(pin) != mapping.end(), "No mapping found for pin " << pin);
       out_stream << mapping.find(pin)->second + 1 << " ";
     }
-    out_stream << std::endl;
+    out_stream << '\n';
   }
 
   writeHypernodeWeights(out_stream, hypergraph);
-  out_stream.close();
+  closeOutputFile(out_stream);
 }
 
 static inline void writeHypergraphForPaToHPartitioning(const Hypergraph& hypergraph,
                                                        const std::string& filename,
                                                        const Mapping& mapping) {
   ASSERT(!filename.empty(), "No filename for PaToH initial partitioning file specified");
-  std::ofstream out_stream(filename.c_str());
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
   out_stream << 1;                     // 1-based indexing
   out_stream << " " << hypergraph.currentNumNodes() << " " << hypergraph.currentNumEdges() << " " << hypergraph.currentNumPins();
-  out_stream << " " << 3 << std::endl;  // weighting scheme: both edge and node weights
+  out_stream << " " << 3 << '\n';  // weighting scheme: both edge and node weights
 
   for (const HyperedgeID& he : hypergraph.edges()) {
     out_stream << hypergraph.edgeWeight(he) << " ";
@@ -282,23 +838,26 @@ static inline void writeHypergraphForPaToHPartitioning(const Hypergraph& hypergr
       ASSERT(mapping.find(pin) != mapping.end(), "No mapping found for pin " << pin);
       out_stream << mapping.find(pin)->second + 1 << " ";
     }
-    out_stream << std::endl;
+    out_stream << '\n';
   }
 
   for (const HypernodeID& hn : hypergraph.nodes()) {
     out_stream << hypergraph.nodeWeight(hn) << " ";
   }
-  out_stream << std::endl;
-  out_stream.close();
+  out_stream << '\n';
+  closeOutputFile(out_stream);
 }
 
 static inline void writeHypergraphForPaToHPartitioning(const Hypergraph& hypergraph,
                                                        const std::string& filename) {
   ASSERT(!filename.empty(), "No filename for PaToH initial partitioning file specified");
-  std::ofstream out_stream(filename.c_str());
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
   out_stream << 0;                     // 0-based indexing
   out_stream << " " << hypergraph.currentNumNodes() << " " << hypergraph.currentNumEdges() << " " << hypergraph.currentNumPins();
-  out_stream << " " << 3 << std::endl;  // weighting scheme: both edge and node weights
+  out_stream << " " << 3 << '\n';  // weighting scheme: both edge and node weights
 
   for (const HyperedgeID& he : hypergraph.edges()) {
     out_stream << hypergraph.edgeWeight(he) << " ";
@@ -306,39 +865,98 @@ static inline void writeHypergraphForPaToHPartitioning(const Hypergraph& hypergr
       // ASSERT(mapping.find(pin) != mapping.end(), "No mapping found for pin " << pin);
       out_stream << pin << " ";
     }
-    out_stream << std::endl;
+    out_stream << '\n';
   }
 
   for (const HypernodeID& hn : hypergraph.nodes()) {
     out_stream << hypergraph.nodeWeight(hn) << " ";
   }
-  out_stream << std::endl;
-  out_stream.close();
+  out_stream << '\n';
+  closeOutputFile(out_stream);
 }
 
 
-static inline void readPartitionFile(const std::string& filename, std::vector<PartitionID>& partition) {
+// Reads a partition in text format (one block ID per line) or in binary format.
+static inline IOStatus parsePartitionFile(const std::string& filename,
+                                          std::vector<PartitionID>& partition) {
   ASSERT(!filename.empty(), "No filename for partition file specified");
+  if (isBinaryPartitionFile(filename)) {
+    return readBinaryPartitionFile(filename, partition);
+  }
+
+  MemoryMappedFile file;
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+  LineScanner scanner(file.begin(), file.end());
+  while (!scanner.atEnd()) {
+    if (scanner.atLineEnd()) {
+      scanner.skipLine();
+      continue;
+    }
+    PartitionID part = 0;
+    if (!scanner.readInteger(part)) {
+      return internal::parseError(scanner, "Invalid block ID of hypernode "
+                                  + std::to_string(partition.size()));
+    }
+    partition.push_back(part);
+  }
+  return IOStatus();
+}
+
+static inline void readPartitionFile(const std::string& filename, std::vector<PartitionID>& partition) {
   ASSERT(partition.empty(), "Partition vector is not empty");
-  std::ifstream file(filename);
-  if (file) {
-    int part;
-    while (file >> part) {
-      partition.push_back(part);
+  const IOStatus status = parsePartitionFile(filename, partition);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+  }
+}
+
+// Assigns the hypernodes to the blocks given in a partition file, e.g., the
+// partition of a previous run that is to be improved. The file has to contain
+// a block ID in [0, k) for each hypernode.
+static inline IOStatus applyPartitionFile(const std::string& filename, Hypergraph& hypergraph) {
+  std::vector<PartitionID> partition;
+  const IOStatus status = parsePartitionFile(filename, partition);
+  if (!status.ok()) {
+    return status;
+  }
+  if (partition.size() != hypergraph.initialNumNodes()) {
+    return IOStatus::error(filename + " contains " + std::to_string(partition.size())
+                           + " block IDs, but the hypergraph has "
+                           + std::to_string(hypergraph.initialNumNodes()) + " hypernodes");
+  }
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    if (partition[hn] < 0 || partition[hn] >= hypergraph.k()) {
+      return IOStatus::error("Invalid block ID " + std::to_string(partition[hn])
+                             + " of hypernode " + std::to_string(hn) + " in " + filename);
     }
-    file.close();
-  } else {
-    std::cerr << "Error: File not found: " << std::endl;
   }
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, partition[hn]);
+  }
+  return IOStatus();
 }
 
-static inline void writePartitionFile(const Hypergraph& hypergraph, const std::string& filename) {
+static inline void writePartitionFile(const Hypergraph& hypergraph, const std::string& filename,
+                                      const bool binary = false) {
   ASSERT(!filename.empty(), "No filename for partition file specified");
-  std::ofstream out_stream(filename.c_str());
+  if (binary) {
+    const IOStatus status = writeBinaryPartitionFile(hypergraph, filename);
+    if (!status.ok()) {
+      std::cerr << "Error: " << status.message() << std::endl;
+    }
+    return;
+  }
+  BufferedWriter out_stream;
+  if (!openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
   for (const HypernodeID& hn : hypergraph.nodes()) {
-    out_stream << hypergraph.partID(hn) << std::endl;
+    out_stream << hypergraph.partID(hn) << '\n';
   }
-  out_stream.close();
+  closeOutputFile(out_stream);
 }
 }  // namespace io
 }  // namespace kahypar
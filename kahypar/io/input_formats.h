@@ -0,0 +1,630 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/gzip_file_reader.h"
+#include "kahypar/io/line_scanner.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/context_enum_classes.h"
+
+namespace kahypar {
+namespace io {
+namespace internal {
+static inline IOStatus parseError(const LineScanner& scanner, const std::string& message) {
+  return IOStatus::error(message + " (line " + std::to_string(scanner.line()) + ")");
+}
+
+// Feeds the lines of a (possibly gzip compressed) file to a parser, which
+// provides parse(LineScanner&), isComplete() and finish(const LineScanner&).
+// Compressed files are passed to the parser in several pieces, but lines
+// are never split between two pieces.
+template <typename Parser>
+static inline IOStatus parseLines(const std::string& filename, Parser& parser) {
+  if (isGzipFile(filename)) {
+#ifdef KAHYPAR_USE_ZLIB
+    GzipLineBlockReader reader;
+    IOStatus status = reader.open(filename);
+    if (!status.ok()) {
+      return status;
+    }
+    size_t line = 1;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    while (!parser.isComplete() && reader.next(begin, end)) {
+      LineScanner scanner(begin, end, line);
+      status = parser.parse(scanner);
+      if (!status.ok()) {
+        return status;
+      }
+      line = scanner.line();
+    }
+    if (!reader.status().ok()) {
+      return reader.status();
+    }
+    return parser.finish(LineScanner(end, end, line));
+#else
+    return zlibUnavailable(filename);
+#endif
+  }
+
+  MemoryMappedFile file;
+  IOStatus status = file.open(filename);
+  if (!status.ok()) {
+    return status;
+  }
+  LineScanner scanner(file.begin(), file.end());
+  status = parser.parse(scanner);
+  if (!status.ok()) {
+    return status;
+  }
+  return parser.finish(scanner);
+}
+
+// The hypergraph in the index_vector/edge_vector representation used by hMetis.
+struct ParserOutput {
+  HypernodeID& num_hypernodes;
+  HyperedgeID& num_hyperedges;
+  HyperedgeIndexVector& index_vector;
+  HyperedgeVector& edge_vector;
+  HyperedgeWeightVector* hyperedge_weights;
+  HypernodeWeightVector* hypernode_weights;
+};
+
+static inline std::string toLower(std::string token) {
+  std::transform(token.begin(), token.end(), token.begin(),
+                 [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+      });
+  return token;
+}
+
+static inline bool isCommentCharacter(const char c) {
+  return c == '%' || c == '#';
+}
+
+// Parses the PaToH format: A header line 'base #cells #nets #pins [scheme [#constraints]]'
+// is followed by one line per net (starting with the net cost, if nets are weighted)
+// and the cell weights, if cells are weighted. Cells are hypernodes, nets are hyperedges.
+class PaToHParser {
+ private:
+  enum class State : uint8_t {
+    header,
+    nets,
+    cell_weights,
+    done
+  };
+
+ public:
+  explicit PaToHParser(const ParserOutput& output) :
+    _output(output),
+    _state(State::header),
+    _base(0),
+    _num_pins(0),
+    _has_net_costs(false),
+    _read_cell_weights(false),
+    _next(0) { }
+
+  PaToHParser(const PaToHParser&) = delete;
+  PaToHParser& operator= (const PaToHParser&) = delete;
+
+  IOStatus parse(LineScanner& scanner) {
+    while (_state != State::done) {
+      scanner.skipCommentLines();
+      if (scanner.atEnd()) {
+        return IOStatus();
+      }
+      IOStatus status;
+      switch (_state) {
+        case State::header:
+          status = parseHeader(scanner);
+          break;
+        case State::nets:
+          status = parseNet(scanner);
+          break;
+        case State::cell_weights:
+          status = parseCellWeights(scanner);
+          break;
+        case State::done:
+          break;
+      }
+      if (!status.ok()) {
+        return status;
+      }
+      scanner.skipLine();
+    }
+    return IOStatus();
+  }
+
+  bool isComplete() const {
+    return _state == State::done;
+  }
+
+  IOStatus finish(const LineScanner& scanner) const {
+    switch (_state) {
+      case State::header:
+        return parseError(scanner, "Invalid header");
+      case State::nets:
+        return parseError(scanner, "File ends after " + std::to_string(_next) + " of "
+                          + std::to_string(_output.num_hyperedges) + " nets");
+      case State::cell_weights:
+        return parseError(scanner, "File ends after " + std::to_string(_next) + " of "
+                          + std::to_string(_output.num_hypernodes) + " cell weights");
+      case State::done:
+        break;
+    }
+    return IOStatus();
+  }
+
+ private:
+  IOStatus parseHeader(LineScanner& scanner) {
+    if (!scanner.readInteger(_base) || !scanner.readInteger(_output.num_hypernodes) ||
+        !scanner.readInteger(_output.num_hyperedges) || !scanner.readInteger(_num_pins)) {
+      return parseError(scanner, "Invalid header");
+    }
+    int scheme = 0;
+    int num_constraints = 1;
+    if ((!scanner.atLineEnd() && !scanner.readInteger(scheme)) ||
+        (!scanner.atLineEnd() && !scanner.readInteger(num_constraints))) {
+      return parseError(scanner, "Invalid header");
+    } else if (_base != 0 && _base != 1) {
+      return parseError(scanner, "Invalid index base " + std::to_string(_base));
+    } else if (scheme < 0 || scheme > 3) {
+      return parseError(scanner, "Invalid weighting scheme " + std::to_string(scheme));
+    } else if (num_constraints != 1) {
+      return parseError(scanner, "Multi-constraint PaToH files are not supported");
+    }
+    _has_net_costs = scheme == 2 || scheme == 3;
+    _read_cell_weights = (scheme == 1 || scheme == 3) && _output.hypernode_weights != nullptr;
+    if (_has_net_costs && _output.hyperedge_weights == nullptr) {
+      LOG << "****** ignoring hyperedge weights ******";
+    }
+
+    _output.index_vector.reserve(_output.index_vector.size() + _output.num_hyperedges + 1);
+    _output.index_vector.push_back(_output.edge_vector.size());
+    _output.edge_vector.reserve(_output.edge_vector.size() + _num_pins);
+    _next = 0;
+    _state = State::nets;
+    return _output.num_hyperedges == 0 ? finishNets(scanner) : IOStatus();
+  }
+
+  IOStatus parseNet(LineScanner& scanner) {
+    const std::string net = std::to_string(_next);
+    if (_has_net_costs) {
+      HyperedgeWeight cost = 0;
+      if (scanner.atLineEnd()) {
+        return parseError(scanner, "Net " + net + " is empty");
+      } else if (!scanner.readInteger(cost)) {
+        return parseError(scanner, "Invalid cost of net " + net);
+      }
+      if (_output.hyperedge_weights != nullptr) {
+        _output.hyperedge_weights->push_back(cost);
+      }
+    }
+    const size_t num_pins_before = _output.edge_vector.size();
+    while (!scanner.atLineEnd()) {
+      uint64_t pin = 0;
+      if (!scanner.readInteger(pin) || pin < _base ||
+          pin - _base >= _output.num_hypernodes) {
+        return parseError(scanner, "Invalid pin of net " + net);
+      }
+      _output.edge_vector.push_back(static_cast<HypernodeID>(pin - _base));
+    }
+    if (_output.edge_vector.size() == num_pins_before) {
+      return parseError(scanner, "Net " + net + " is empty");
+    }
+    _output.index_vector.push_back(_output.edge_vector.size());
+    ++_next;
+    return _next == _output.num_hyperedges ? finishNets(scanner) : IOStatus();
+  }
+
+  IOStatus finishNets(const LineScanner& scanner) {
+    const size_t num_pins = _output.index_vector.back() -
+                            _output.index_vector[_output.index_vector.size() -
+                                                 _output.num_hyperedges - 1];
+    if (num_pins != _num_pins) {
+      return parseError(scanner, "Header specifies " + std::to_string(_num_pins)
+                        + " pins, but nets contain " + std::to_string(num_pins));
+    }
+    _next = 0;
+    _state = _read_cell_weights && _output.num_hypernodes > 0 ? State::cell_weights : State::done;
+    if (_read_cell_weights) {
+      _output.hypernode_weights->reserve(_output.hypernode_weights->size() +
+                                         _output.num_hypernodes);
+    }
+    return IOStatus();
+  }
+
+  // Cell weights can be distributed arbitrarily over several lines.
+  IOStatus parseCellWeights(LineScanner& scanner) {
+    while (!scanner.atLineEnd() && _next < _output.num_hypernodes) {
+      HypernodeWeight weight = 0;
+      if (!scanner.readInteger(weight)) {
+        return parseError(scanner, "Invalid weight of cell " + std::to_string(_next));
+      }
+      _output.hypernode_weights->push_back(weight);
+      ++_next;
+    }
+    if (_next == _output.num_hypernodes) {
+      _state = State::done;
+    }
+    return IOStatus();
+  }
+
+  ParserOutput _output;
+  State _state;
+  uint64_t _base;
+  uint64_t _num_pins;
+  bool _has_net_costs;
+  bool _read_cell_weights;
+  size_t _next;
+};
+
+// Parses coordinate matrices in MatrixMarket format. In the row-net model,
+// each row is a hyperedge containing the columns of its nonzeros as pins.
+// In the column-net model, columns are hyperedges and rows are hypernodes.
+// Values are ignored, symmetric matrices are expanded and empty nets are
+// removed.
+class MatrixMarketParser {
+ private:
+  enum class State : uint8_t {
+    banner,
+    size,
+    entries,
+    done
+  };
+
+ public:
+  MatrixMarketParser(const ParserOutput& output, const bool column_net) :
+    _output(output),
+    _column_net(column_net),
+    _state(State::banner),
+    _symmetric(false),
+    _num_rows(0),
+    _num_columns(0),
+    _num_entries(0),
+    _next(0),
+    _nets(),
+    _pins() { }
+
+  MatrixMarketParser(const MatrixMarketParser&) = delete;
+  MatrixMarketParser& operator= (const MatrixMarketParser&) = delete;
+
+  IOStatus parse(LineScanner& scanner) {
+    while (_state != State::done && !scanner.atEnd()) {
+      IOStatus status;
+      if (_state == State::banner) {
+        status = parseBanner(scanner);
+      } else {
+        scanner.skipCommentLines();
+        if (scanner.atEnd()) {
+          break;
+        }
+        status = _state == State::size ? parseSize(scanner) : parseEntry(scanner);
+      }
+      if (!status.ok()) {
+        return status;
+      }
+      scanner.skipLine();
+    }
+    return IOStatus();
+  }
+
+  bool isComplete() const {
+    return _state == State::done;
+  }
+
+  IOStatus finish(const LineScanner& scanner) {
+    switch (_state) {
+      case State::banner:
+        return parseError(scanner, "Missing MatrixMarket banner");
+      case State::size:
+        return parseError(scanner, "Missing size line");
+      case State::entries:
+        return parseError(scanner, "File ends after " + std::to_string(_next) + " of "
+                          + std::to_string(_num_entries) + " entries");
+      case State::done:
+        break;
+    }
+
+    const size_t num_nets = _column_net ? _num_columns : _num_rows;
+    std::vector<size_t> net_offsets(num_nets + 1, 0);
+    for (const HyperedgeID net : _nets) {
+      ++net_offsets[net + 1];
+    }
+    size_t num_empty_nets = 0;
+    for (size_t net = 0; net < num_nets; ++net) {
+      num_empty_nets += net_offsets[net + 1] == 0;
+      net_offsets[net + 1] += net_offsets[net];
+    }
+    if (num_empty_nets > 0) {
+      LOG << "WARNING: matrix contains" << num_empty_nets << "empty hyperedges, which are removed";
+    }
+
+    const size_t first_pin = _output.edge_vector.size();
+    _output.edge_vector.resize(first_pin + _pins.size());
+    std::vector<size_t> position(net_offsets.begin(), net_offsets.end() - 1);
+    for (size_t i = 0; i < _pins.size(); ++i) {
+      _output.edge_vector[first_pin + position[_nets[i]]++] = _pins[i];
+    }
+    _output.index_vector.reserve(_output.index_vector.size() + num_nets - num_empty_nets + 1);
+    _output.index_vector.push_back(first_pin);
+    for (size_t net = 0; net < num_nets; ++net) {
+      if (net_offsets[net + 1] != net_offsets[net]) {
+        _output.index_vector.push_back(first_pin + net_offsets[net + 1]);
+      }
+    }
+    _output.num_hyperedges = static_cast<HyperedgeID>(num_nets - num_empty_nets);
+    _output.num_hypernodes = _column_net ? _num_rows : _num_columns;
+    return IOStatus();
+  }
+
+ private:
+  IOStatus parseBanner(LineScanner& scanner) {
+    if (scanner.readToken() != "%%MatrixMarket") {
+      return parseError(scanner, "Missing MatrixMarket banner");
+    }
+    const std::string object = toLower(scanner.readToken());
+    const std::string format = toLower(scanner.readToken());
+    const std::string field = toLower(scanner.readToken());
+    const std::string symmetry = toLower(scanner.readToken());
+    if (object != "matrix") {
+      return parseError(scanner, "Unsupported MatrixMarket object " + object);
+    } else if (format != "coordinate") {
+      return parseError(scanner, "Only coordinate matrices are supported");
+    } else if (field != "real" && field != "integer" && field != "pattern" &&
+               field != "complex") {
+      return parseError(scanner, "Unsupported MatrixMarket field " + field);
+    } else if (symmetry != "general" && symmetry != "symmetric" &&
+               symmetry != "skew-symmetric" && symmetry != "hermitian") {
+      return parseError(scanner, "Unsupported MatrixMarket symmetry " + symmetry);
+    }
+    _symmetric = symmetry != "general";
+    _state = State::size;
+    return IOStatus();
+  }
+
+  IOStatus parseSize(LineScanner& scanner) {
+    if (!scanner.readInteger(_num_rows) || !scanner.readInteger(_num_columns) ||
+        !scanner.readInteger(_num_entries)) {
+      return parseError(scanner, "Invalid size line");
+    } else if ((_column_net ? _num_rows : _num_columns) == 0) {
+      return parseError(scanner, "Matrix has no " + std::string(_column_net ? "rows" : "columns"));
+    }
+    _nets.reserve(_num_entries);
+    _pins.reserve(_num_entries);
+    _state = _num_entries == 0 ? State::done : State::entries;
+    return IOStatus();
+  }
+
+  IOStatus parseEntry(LineScanner& scanner) {
+    uint32_t row = 0;
+    uint32_t column = 0;
+    if (!scanner.readInteger(row) || row == 0 || row > _num_rows) {
+      return parseError(scanner, "Invalid row index of entry " + std::to_string(_next));
+    } else if (!scanner.readInteger(column) || column == 0 || column > _num_columns) {
+      return parseError(scanner, "Invalid column index of entry " + std::to_string(_next));
+    }
+    // indices start at 1
+    addEntry(row - 1, column - 1);
+    if (_symmetric && row != column) {
+      addEntry(column - 1, row - 1);
+    }
+    if (++_next == _num_entries) {
+      _state = State::done;
+    }
+    return IOStatus();
+  }
+
+  void addEntry(const uint32_t row, const uint32_t column) {
+    _nets.push_back(_column_net ? column : row);
+    _pins.push_back(_column_net ? row : column);
+  }
+
+  ParserOutput _output;
+  const bool _column_net;
+  State _state;
+  bool _symmetric;
+  uint32_t _num_rows;
+  uint32_t _num_columns;
+  uint64_t _num_entries;
+  uint64_t _next;
+  std::vector<HyperedgeID> _nets;
+  std::vector<HypernodeID> _pins;
+};
+
+// Parses a graph given as list of edges 'u v [weight]' with 0-based vertex
+// IDs. Each edge becomes a hyperedge of size two, self loops are ignored.
+// Lines starting with '#' or '%' are comments.
+class EdgeListParser {
+ public:
+  explicit EdgeListParser(const ParserOutput& output) :
+    _output(output),
+    _num_edges(0),
+    _num_self_loops(0),
+    _max_vertex(0),
+    _has_weights(false) {
+    _output.index_vector.push_back(_output.edge_vector.size());
+  }
+
+  EdgeListParser(const EdgeListParser&) = delete;
+  EdgeListParser& operator= (const EdgeListParser&) = delete;
+
+  IOStatus parse(LineScanner& scanner) {
+    while (!scanner.atEnd()) {
+      if (isCommentCharacter(scanner.current()) || scanner.atLineEnd()) {
+        scanner.skipLine();
+        continue;
+      }
+      const std::string edge = std::to_string(_num_edges + _num_self_loops);
+      HypernodeID u = 0;
+      HypernodeID v = 0;
+      if (!scanner.readInteger(u) || !scanner.readInteger(v) ||
+          u == std::numeric_limits<HypernodeID>::max() ||
+          v == std::numeric_limits<HypernodeID>::max()) {
+        return parseError(scanner, "Invalid vertex of edge " + edge);
+      }
+      if (_num_edges + _num_self_loops == 0) {
+        _has_weights = !scanner.atLineEnd();
+        if (_has_weights && _output.hyperedge_weights == nullptr) {
+          LOG << "****** ignoring hyperedge weights ******";
+        }
+      }
+      HyperedgeWeight weight = 1;
+      if (_has_weights && (scanner.atLineEnd() || !scanner.readInteger(weight))) {
+        return parseError(scanner, "Invalid weight of edge " + edge);
+      }
+      scanner.skipLine();
+
+      if (u == v) {
+        ++_num_self_loops;
+        continue;
+      }
+      _output.edge_vector.push_back(u);
+      _output.edge_vector.push_back(v);
+      _output.index_vector.push_back(_output.edge_vector.size());
+      if (_has_weights && _output.hyperedge_weights != nullptr) {
+        _output.hyperedge_weights->push_back(weight);
+      }
+      _max_vertex = std::max({ _max_vertex, u, v });
+      ++_num_edges;
+    }
+    return IOStatus();
+  }
+
+  bool isComplete() const {
+    return false;
+  }
+
+  IOStatus finish(const LineScanner& scanner) {
+    if (_num_edges == 0) {
+      return parseError(scanner, "Edge list contains no edges");
+    }
+    if (_num_self_loops > 0) {
+      LOG << "****** ignoring" << _num_self_loops << "self loops ******";
+    }
+    _output.num_hypernodes = _max_vertex + 1;
+    _output.num_hyperedges = static_cast<HyperedgeID>(_num_edges);
+    return IOStatus();
+  }
+
+ private:
+  ParserOutput _output;
+  size_t _num_edges;
+  size_t _num_self_loops;
+  HypernodeID _max_vertex;
+  bool _has_weights;
+};
+
+static inline std::string readFilePrefix(const std::string& filename, const size_t max_size) {
+  std::string prefix(max_size, '\0');
+  size_t size = 0;
+  if (isGzipFile(filename)) {
+#ifdef KAHYPAR_USE_ZLIB
+    gzFile file = gzopen(filename.c_str(), "rb");
+    if (file != nullptr) {
+      const int bytes_read = gzread(file, &prefix[0], static_cast<unsigned>(max_size));
+      size = bytes_read > 0 ? bytes_read : 0;
+      gzclose(file);
+    }
+#endif
+  } else {
+    std::ifstream file(filename, std::ios::binary);
+    file.read(&prefix[0], max_size);
+    size = file.gcount();
+  }
+  prefix.resize(size);
+  return prefix;
+}
+}  // namespace internal
+
+// Determines the format of a hypergraph file. Edge lists are recognized by
+// their extension (.edgelist, .edges or .el), MatrixMarket files by their
+// banner. Otherwise, a header line with at least four entries indicates the
+// PaToH format and all remaining files are treated as hMetis files.
+static inline InputFormat detectInputFormat(const std::string& filename) {
+  std::string name = filename;
+  if (name.size() > 3 && name.compare(name.size() - 3, 3, ".gz") == 0) {
+    name.resize(name.size() - 3);
+  }
+  const std::string extension = name.find_last_of('.') != std::string::npos ?
+                                name.substr(name.find_last_of('.') + 1) : "";
+  if (extension == "edgelist" || extension == "edges" || extension == "el") {
+    return InputFormat::edge_list;
+  }
+
+  const std::string prefix = internal::readFilePrefix(filename, 64 * 1024);
+  if (prefix.compare(0, 14, "%%MatrixMarket") == 0) {
+    return InputFormat::mtx_row_net;
+  }
+  LineScanner scanner(prefix.data(), prefix.data() + prefix.size());
+  scanner.skipCommentLines();
+  size_t num_tokens = 0;
+  while (!scanner.atLineEnd()) {
+    scanner.readToken();
+    ++num_tokens;
+  }
+  return num_tokens >= 4 ? InputFormat::patoh : InputFormat::hmetis;
+}
+
+// Parses hypergraphs in PaToH, MatrixMarket or edge list format into the
+// index_vector/edge_vector representation used by hMetis.
+static inline IOStatus parseNonHMetisFile(const std::string& filename, const InputFormat format,
+                                          HypernodeID& num_hypernodes,
+                                          HyperedgeID& num_hyperedges,
+                                          HyperedgeIndexVector& index_vector,
+                                          HyperedgeVector& edge_vector,
+                                          HyperedgeWeightVector* hyperedge_weights,
+                                          HypernodeWeightVector* hypernode_weights) {
+  const internal::ParserOutput output { num_hypernodes, num_hyperedges, index_vector,
+                                        edge_vector, hyperedge_weights, hypernode_weights };
+  switch (format) {
+    case InputFormat::patoh: {
+        internal::PaToHParser parser(output);
+        return internal::parseLines(filename, parser);
+      }
+    case InputFormat::mtx_row_net:
+    case InputFormat::mtx_column_net: {
+        internal::MatrixMarketParser parser(output, format == InputFormat::mtx_column_net);
+        return internal::parseLines(filename, parser);
+      }
+    case InputFormat::edge_list: {
+        internal::EdgeListParser parser(output);
+        return internal::parseLines(filename, parser);
+      }
+    case InputFormat::automatic:
+    case InputFormat::hmetis:
+      break;
+  }
+  return IOStatus::error("Input format " + std::to_string(static_cast<int>(format))
+                         + " is not handled by parseNonHMetisFile");
+}
+}  // namespace io
+}  // namespace kahypar
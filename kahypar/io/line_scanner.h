@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace io {
+// Scanner for line-based text formats operating directly on a character
+// buffer (e.g. a memory mapped file). Integers are parsed without streams
+// and without locale support, which is much faster than std::istringstream.
+class LineScanner {
+ public:
+  LineScanner(const char* begin, const char* end, const size_t first_line = 1) :
+    _pos(begin),
+    _end(end),
+    _line(first_line) { }
+
+  LineScanner(const LineScanner&) = default;
+  LineScanner& operator= (const LineScanner&) = default;
+
+  LineScanner(LineScanner&&) = default;
+  LineScanner& operator= (LineScanner&&) = default;
+
+  ~LineScanner() = default;
+
+  bool atEnd() const {
+    return _pos == _end;
+  }
+
+  // Number of the line the scanner currently points to (starting at 1).
+  size_t line() const {
+    return _line;
+  }
+
+  const char* position() const {
+    return _pos;
+  }
+
+  // Skips blanks and returns true if there is no further token in the current line.
+  bool atLineEnd() {
+    skipBlanks();
+    return _pos == _end || *_pos == '\n';
+  }
+
+  // Returns the current character or '\0' if the end of the buffer is reached.
+  char current() const {
+    return _pos != _end ? *_pos : '\0';
+  }
+
+  void skipLine() {
+    const char* newline = static_cast<const char*>(std::memchr(_pos, '\n', _end - _pos));
+    _pos = newline != nullptr ? newline + 1 : _end;
+    ++_line;
+  }
+
+  // Skips all lines starting with the comment character.
+  void skipCommentLines(const char comment = '%') {
+    while (_pos != _end && *_pos == comment) {
+      skipLine();
+    }
+  }
+
+  // Reads the next blank separated token of the current line.
+  std::string readToken() {
+    skipBlanks();
+    const char* start = _pos;
+    while (!isTokenEnd()) {
+      ++_pos;
+    }
+    return std::string(start, _pos);
+  }
+
+  // Reads the next token of the current line as integer. Returns false if
+  // the token is not a valid integer or does not fit into T.
+  template <typename T>
+  bool readInteger(T& value) {
+    skipBlanks();
+    bool negative = false;
+    if (std::is_signed<T>::value && _pos != _end && *_pos == '-') {
+      negative = true;
+      ++_pos;
+    }
+    uint64_t result = 0;
+    const char* start = _pos;
+    unsigned digit = 0;
+    while (_pos != _end && (digit = static_cast<unsigned char>(*_pos) - '0') <= 9) {
+      result = 10 * result + digit;
+      ++_pos;
+    }
+    const size_t num_digits = _pos - start;
+    if (num_digits == 0 || num_digits > 18 || !isTokenEnd()) {
+      return false;
+    }
+    if (negative) {
+      if (result > static_cast<uint64_t>(std::numeric_limits<T>::max()) + 1) {
+        return false;
+      }
+      value = static_cast<T>(-static_cast<int64_t>(result));
+    } else {
+      if (result > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+        return false;
+      }
+      value = static_cast<T>(result);
+    }
+    return true;
+  }
+
+ private:
+  static bool isBlank(const char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  bool isTokenEnd() const {
+    return _pos == _end || isBlank(*_pos) || *_pos == '\n';
+  }
+
+  void skipBlanks() {
+    while (_pos != _end && isBlank(*_pos)) {
+      ++_pos;
+    }
+  }
+
+  const char* _pos;
+  const char* _end;
+  size_t _line;
+};
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace kahypar {
+namespace io {
+// Result of an IO operation. Instead of terminating the program, readers
+// report errors via an IOStatus, which allows library users to handle them.
+class IOStatus {
+ public:
+  IOStatus() :
+    _message() { }
+
+  static IOStatus error(const std::string& message) {
+    return IOStatus(message);
+  }
+
+  bool ok() const {
+    return _message.empty();
+  }
+
+  const std::string & message() const {
+    return _message;
+  }
+
+ private:
+  explicit IOStatus(const std::string& message) :
+    _message(message.empty() ? "Unknown error" : message) { }
+
+  std::string _message;
+};
+
+// Read-only memory mapping of a whole file.
+class MemoryMappedFile {
+ public:
+  MemoryMappedFile() :
+    _data(nullptr),
+    _size(0) { }
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator= (const MemoryMappedFile&) = delete;
+
+  MemoryMappedFile(MemoryMappedFile&& other) :
+    _data(other._data),
+    _size(other._size) {
+    other._data = nullptr;
+    other._size = 0;
+  }
+
+  MemoryMappedFile& operator= (MemoryMappedFile&& other) {
+    std::swap(_data, other._data);
+    std::swap(_size, other._size);
+    return *this;
+  }
+
+  ~MemoryMappedFile() {
+    unmap();
+  }
+
+  IOStatus open(const std::string& filename) {
+    unmap();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return IOStatus::error("Could not open file " + filename + ": " + std::strerror(errno));
+    }
+    struct stat file_info;
+    if (fstat(fd, &file_info) == -1) {
+      const int error = errno;
+      close(fd);
+      return IOStatus::error("Could not stat file " + filename + ": " + std::strerror(error));
+    }
+    _size = static_cast<size_t>(file_info.st_size);
+    if (_size > 0) {
+      void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        const int error = errno;
+        close(fd);
+        _size = 0;
+        return IOStatus::error("Could not map file " + filename + ": " + std::strerror(error));
+      }
+      _data = static_cast<const char*>(data);
+      madvise(data, _size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    return IOStatus();
+  }
+
+  const char* begin() const {
+    return _data;
+  }
+
+  const char* end() const {
+    return _data + _size;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  void unmap() {
+    if (_data != nullptr) {
+      munmap(const_cast<char*>(_data), _size);
+      _data = nullptr;
+      _size = 0;
+    }
+  }
+
+  const char* _data;
+  size_t _size;
+};
+}  // namespace io
+}  // namespace kahypar
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/git_revision.h"
 #include "kahypar/partition/context.h"
@@ -278,6 +279,12 @@ inline void printPartitioningStatistics() {
   LOG << "removedSingleNodeHEWeight: Total weight of HEs that were removed because they contained only 1 HN.\n"
       << "This sum includes the weight of previously removed parallel HEs, because we sum over the edge weights";
   // LOG << Stats::instance().toConsoleString();
+  const ds::ScratchBufferPoolStats& pool_stats = ds::scratchBufferPoolStats();
+  LOG << "scratchBufferAcquisitions:" << pool_stats.acquisitions
+      << "reuses:" << pool_stats.reuses
+      << "allocations:" << pool_stats.allocations
+      << "reallocations:" << pool_stats.reallocations
+      << "maxInUse:" << pool_stats.max_in_use;
 }
 
 inline void printConnectivityStats(const std::vector<PartitionID>& connectivity_stats) {
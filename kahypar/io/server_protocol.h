@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/io/unix_socket.h"
+
+namespace kahypar {
+namespace io {
+// Line-based protocol of KaHyParServer. Each connection carries one request:
+//   LOAD <name> <hypergraph file>
+//   UNLOAD <name>
+//   PARTITION <name> <k> <epsilon> <seed> <preset.ini> [<warm start partition file>]
+//   SHUTDOWN
+// File names are interpreted by the server. The server answers with
+//   ERROR <message>
+// or, for PARTITION, with
+//   OK <number of hypernodes> <cut> <km1> <imbalance> <seconds>
+// followed by the block ID of each hypernode on its own line, and with OK
+// for all other requests.
+enum class ServerCommand : uint8_t {
+  load,
+  unload,
+  partition,
+  shutdown
+};
+
+struct ServerRequest {
+  ServerCommand command = ServerCommand::load;
+  std::string name { };
+  // LOAD only
+  std::string graph_filename { };
+  // PARTITION only
+  PartitionID k = 0;
+  double epsilon = 0.0;
+  int seed = 0;
+  std::string preset { };
+  // empty, if the hypergraph should be partitioned from scratch
+  std::string warm_start_filename { };
+};
+
+struct PartitionResponse {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeWeight cut = 0;
+  HyperedgeWeight km1 = 0;
+  double imbalance = 0.0;
+  double seconds = 0.0;
+};
+
+static inline IOStatus parseServerRequest(const std::string& line, ServerRequest& request) {
+  std::istringstream tokens(line);
+  std::string command;
+  tokens >> command;
+  request = ServerRequest();
+  if (command == "LOAD") {
+    if (!(tokens >> request.name >> request.graph_filename)) {
+      return IOStatus::error("Expected LOAD <name> <hypergraph file>");
+    }
+  } else if (command == "UNLOAD") {
+    request.command = ServerCommand::unload;
+    if (!(tokens >> request.name)) {
+      return IOStatus::error("Expected UNLOAD <name>");
+    }
+  } else if (command == "PARTITION") {
+    request.command = ServerCommand::partition;
+    if (!(tokens >> request.name >> request.k >> request.epsilon >> request.seed >>
+          request.preset)) {
+      return IOStatus::error("Expected PARTITION <name> <k> <epsilon> <seed> <preset> "
+                             "[<warm start partition file>]");
+    }
+    if (request.k < 2 || request.epsilon < 0) {
+      return IOStatus::error("Invalid k or epsilon");
+    }
+    tokens >> request.warm_start_filename;
+  } else if (command == "SHUTDOWN") {
+    request.command = ServerCommand::shutdown;
+  } else {
+    return IOStatus::error("Unknown request '" + command + "'");
+  }
+  std::string trailing;
+  if (tokens >> trailing) {
+    return IOStatus::error("Unexpected token '" + trailing + "'");
+  }
+  return IOStatus();
+}
+
+// Parses the first line of the answer to a PARTITION request.
+static inline IOStatus parsePartitionResponse(const std::string& line,
+                                              PartitionResponse& response) {
+  std::istringstream tokens(line);
+  std::string status;
+  tokens >> status;
+  if (status == "ERROR") {
+    std::string message;
+    std::getline(tokens >> std::ws, message);
+    return IOStatus::error(message);
+  }
+  if (status != "OK" || !(tokens >> response.num_hypernodes >> response.cut >> response.km1 >>
+                          response.imbalance >> response.seconds)) {
+    return IOStatus::error("Invalid response '" + line + "'");
+  }
+  return IOStatus();
+}
+
+// Client side: Sends the request line to the server listening on socket_path
+// and reads the first line of its answer. The block IDs that follow the
+// answer to a PARTITION request are read with readPartition.
+static inline IOStatus sendServerRequest(const std::string& socket_path,
+                                         const std::string& request,
+                                         UnixSocket& connection, std::string& response) {
+  IOStatus status = UnixSocket::connect(socket_path, connection);
+  if (status.ok()) {
+    status = connection.write(request + "\n");
+  }
+  if (status.ok() && !connection.readLine(response)) {
+    status = IOStatus::error("The server closed the connection");
+  }
+  return status;
+}
+
+static inline IOStatus readPartition(UnixSocket& connection, const PartitionResponse& response,
+                                     std::vector<PartitionID>& partition) {
+  partition.clear();
+  std::string line;
+  for (HypernodeID hn = 0; hn < response.num_hypernodes; ++hn) {
+    if (!connection.readLine(line)) {
+      return IOStatus::error("Incomplete partition from server");
+    }
+    std::istringstream block(line);
+    PartitionID part = -1;
+    if (!(block >> part)) {
+      return IOStatus::error("Invalid block ID '" + line + "' from server");
+    }
+    partition.push_back(part);
+  }
+  return IOStatus();
+}
+}  // namespace io
+}  // namespace kahypar
@@ -23,6 +23,7 @@
 #include <array>
 #include <chrono>
 #include <fstream>
+#include <iostream>
 #include <string>
 
 #include "kahypar/definitions.h"
@@ -35,7 +36,8 @@ namespace kahypar {
 namespace io {
 namespace serializer {
 static inline void serialize(const Context& context, const Hypergraph& hypergraph,
-                             const std::chrono::duration<double>& elapsed_seconds) {
+                             const std::chrono::duration<double>& elapsed_seconds,
+                             std::ostream& out = std::cout) {
   const auto& timings = Timer::instance().result();
   std::ostringstream oss;
   oss << "RESULT"
@@ -50,6 +52,7 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
       << " epsilon=" << context.partition.epsilon
       << " seed=" << context.partition.seed
       << " num_v_cycles=" << context.partition.global_search_iterations
+      << " time_limit=" << context.partition.time_limit
       << " he_size_threshold=" << context.partition.hyperedge_size_threshold
       << " total_graph_weight=" << context.partition.total_graph_weight
       << " L_opt0=" << context.partition.perfect_balance_part_weights[0]
@@ -185,7 +188,7 @@ static inline void serialize(const Context& context, const Hypergraph& hypergrap
       << " git=" << STR(KaHyPar_BUILD_VERSION)
       << std::endl;
 
-  std::cout << oss.str() << std::endl;
+  out << oss.str() << std::endl;
 }
 }  // namespace serializer
 }  // namespace io
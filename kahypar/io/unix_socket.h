@@ -0,0 +1,257 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "kahypar/io/memory_mapped_file.h"
+
+namespace kahypar {
+namespace io {
+// Stream socket in the Unix domain with buffered line-wise reading.
+class UnixSocket {
+ public:
+  UnixSocket() :
+    _fd(-1),
+    _buffer(),
+    _buffer_pos(0) { }
+
+  UnixSocket(const UnixSocket&) = delete;
+  UnixSocket& operator= (const UnixSocket&) = delete;
+
+  UnixSocket(UnixSocket&& other) :
+    _fd(other._fd),
+    _buffer(std::move(other._buffer)),
+    _buffer_pos(other._buffer_pos) {
+    other._fd = -1;
+  }
+
+  UnixSocket& operator= (UnixSocket&& other) {
+    std::swap(_fd, other._fd);
+    std::swap(_buffer, other._buffer);
+    std::swap(_buffer_pos, other._buffer_pos);
+    return *this;
+  }
+
+  ~UnixSocket() {
+    if (_fd != -1) {
+      close(_fd);
+    }
+  }
+
+  // Replaces a stale socket file of a previous server. Fails if the path
+  // is not a socket or if another server still listens on it.
+  static IOStatus listen(const std::string& path, UnixSocket& socket) {
+    sockaddr_un address;
+    IOStatus status = makeAddress(path, address);
+    if (!status.ok()) {
+      return status;
+    }
+    status = removeStaleSocket(path, address);
+    if (!status.ok()) {
+      return status;
+    }
+    status = socket.create();
+    if (!status.ok()) {
+      return status;
+    }
+    if (bind(socket._fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1 ||
+        ::listen(socket._fd, SOMAXCONN) == -1) {
+      return IOStatus::error("Could not listen on " + path + ": " + std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  static IOStatus connect(const std::string& path, UnixSocket& socket) {
+    sockaddr_un address;
+    IOStatus status = makeAddress(path, address);
+    if (!status.ok()) {
+      return status;
+    }
+    status = socket.create();
+    if (!status.ok()) {
+      return status;
+    }
+    if (::connect(socket._fd, reinterpret_cast<const sockaddr*>(&address),
+                  sizeof(address)) == -1) {
+      return IOStatus::error("Could not connect to " + path + ": " + std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  // Fails once the socket was shut down.
+  IOStatus accept(UnixSocket& connection) const {
+    int fd = -1;
+    do {
+      fd = ::accept(_fd, nullptr, nullptr);
+    } while (fd == -1 && errno == EINTR);
+    if (fd == -1) {
+      return IOStatus::error(std::string("Could not accept connection: ") + std::strerror(errno));
+    }
+    connection = UnixSocket(fd);
+    return IOStatus();
+  }
+
+  // Wakes up threads that are blocked in accept or read.
+  void shutdown() {
+    ::shutdown(_fd, SHUT_RDWR);
+  }
+
+  // Reads and writes that do not make progress for the given time fail.
+  IOStatus setTimeout(const double seconds) {
+    timeval timeout;
+    timeout.tv_sec = static_cast<time_t>(seconds);
+    timeout.tv_usec = static_cast<suseconds_t>((seconds - timeout.tv_sec) * 1000000);
+    if (setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == -1 ||
+        setsockopt(_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == -1) {
+      return IOStatus::error(std::string("Could not set socket timeout: ") +
+                             std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  // Reads the next line without the line break. Returns false at the end of
+  // the stream, unless an unterminated last line remains. Also returns false
+  // if reading fails, e.g., after a timeout, or if the line is longer than
+  // max_length.
+  bool readLine(std::string& line,
+                const size_t max_length = std::numeric_limits<size_t>::max()) {
+    line.clear();
+    while (true) {
+      const size_t line_end = _buffer.find('\n', _buffer_pos);
+      if (line_end != std::string::npos) {
+        if (line_end - _buffer_pos > max_length) {
+          return false;
+        }
+        line.assign(_buffer, _buffer_pos, line_end - _buffer_pos);
+        _buffer_pos = line_end + 1;
+        return true;
+      }
+      _buffer.erase(0, _buffer_pos);
+      _buffer_pos = 0;
+      if (_buffer.size() > max_length) {
+        return false;
+      }
+      char chunk[4096];
+      ssize_t num_bytes = 0;
+      do {
+        num_bytes = read(_fd, chunk, sizeof(chunk));
+      } while (num_bytes == -1 && errno == EINTR);
+      if (num_bytes == -1) {
+        return false;
+      }
+      if (num_bytes == 0) {
+        line.swap(_buffer);
+        _buffer.clear();
+        return !line.empty() && line.size() <= max_length;
+      }
+      _buffer.append(chunk, num_bytes);
+    }
+  }
+
+  // A peer that already closed the connection does not raise SIGPIPE.
+  IOStatus write(const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+      const ssize_t num_bytes = send(_fd, data.data() + written, data.size() - written,
+                                     MSG_NOSIGNAL);
+      if (num_bytes == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return IOStatus::error(std::string("Could not write to socket: ") + std::strerror(errno));
+      }
+      written += num_bytes;
+    }
+    return IOStatus();
+  }
+
+ private:
+  explicit UnixSocket(const int fd) :
+    _fd(fd),
+    _buffer(),
+    _buffer_pos(0) { }
+
+  static IOStatus makeAddress(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+      return IOStatus::error("Invalid socket path '" + path + "'");
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    return IOStatus();
+  }
+
+  // A socket file is stale if nobody accepts connections on it anymore.
+  static IOStatus removeStaleSocket(const std::string& path, const sockaddr_un& address) {
+    struct stat file_status;
+    if (lstat(path.c_str(), &file_status) == -1) {
+      if (errno == ENOENT) {
+        return IOStatus();
+      }
+      return IOStatus::error("Could not access " + path + ": " + std::strerror(errno));
+    }
+    if (!S_ISSOCK(file_status.st_mode)) {
+      return IOStatus::error(path + " exists and is not a socket");
+    }
+    UnixSocket probe;
+    IOStatus status = probe.create();
+    if (!status.ok()) {
+      return status;
+    }
+    if (::connect(probe._fd, reinterpret_cast<const sockaddr*>(&address),
+                  sizeof(address)) == 0) {
+      return IOStatus::error("Another server is listening on " + path);
+    }
+    if (errno != ECONNREFUSED) {
+      return IOStatus::error("Could not check socket " + path + ": " + std::strerror(errno));
+    }
+    if (unlink(path.c_str()) == -1) {
+      return IOStatus::error("Could not remove stale socket " + path + ": " +
+                             std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  IOStatus create() {
+    _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_fd == -1) {
+      return IOStatus::error(std::string("Could not create socket: ") + std::strerror(errno));
+    }
+    return IOStatus();
+  }
+
+  int _fd;
+  std::string _buffer;
+  size_t _buffer_pos;
+};
+}  // namespace io
+}  // namespace kahypar
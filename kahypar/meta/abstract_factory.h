@@ -66,6 +66,8 @@ class Factory {
     std::exit(-1);
   }
 
+  // Registration happens during static initialization. Afterwards, the
+  // instance is only read and can be shared by concurrent partitioners.
   static Factory & getInstance() {
     static Factory _factory_instance;
     return _factory_instance;
@@ -53,6 +53,8 @@ class PolicyRegistry {
     return _policies.emplace(
       static_cast<UnderlyingIDType>(name), PolicyBasePtr(policy)).second;
   }
+  // Registration happens during static initialization. Afterwards, the
+  // instance is only read and can be shared by concurrent partitioners.
   static PolicyRegistry & getInstance() {
     static PolicyRegistry instance;
     return instance;
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <stack>
 #include <string>
@@ -34,6 +35,7 @@
 #include "kahypar/partition/coarsening/hypergraph_pruner.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/partition/progress.h"
 #include "kahypar/partition/refinement/i_refiner.h"
 
 namespace kahypar {
@@ -53,7 +55,9 @@ class CoarsenerBase {
     _context(context),
     _history(),
     _max_hn_weights(),
-    _hypergraph_pruner(_hg.initialNumNodes()) {
+    _hypergraph_pruner(_hg.initialNumNodes()),
+    _calls_since_time_check(kTimeBudgetCheckInterval - 1),
+    _time_budget_exhausted(false) {
     _history.reserve(_hg.initialNumNodes());
     _max_hn_weights.reserve(_hg.initialNumNodes());
     _max_hn_weights.emplace_back(CurrentMaxNodeWeight { _hg.initialNumNodes(),
@@ -69,6 +73,20 @@ class CoarsenerBase {
   CoarsenerBase& operator= (CoarsenerBase&&) = delete;
 
  protected:
+  // Reading the clock after each contraction would be wasteful. This also
+  // applies to the throttling of progress reports.
+  static constexpr size_t kTimeBudgetCheckInterval = 256;
+
+  // Checks Context::timeBudgetExhausted on the first and then on every
+  // kTimeBudgetCheckInterval-th call. Once exhausted, the budget stays exhausted.
+  bool timeBudgetExhausted() {
+    if (!_time_budget_exhausted && ++_calls_since_time_check == kTimeBudgetCheckInterval) {
+      _calls_since_time_check = 0;
+      _time_budget_exhausted = _context.timeBudgetExhausted();
+    }
+    return _time_budget_exhausted;
+  }
+
   void performContraction(const HypernodeID rep_node, const HypernodeID contracted_node) {
     _history.emplace_back(_hg.contract(rep_node, contracted_node));
     if (_hg.nodeWeight(rep_node) > _max_hn_weights.back().max_weight) {
@@ -77,6 +95,32 @@ class CoarsenerBase {
     }
     removeSingleNodeHyperedges();
     removeParallelHyperedges();
+    if (_history.size() % kTimeBudgetCheckInterval == 0 && progress::isDue(_context)) {
+      progress::report(_context, ProgressPhase::coarsening, _hg.currentNumNodes());
+    }
+  }
+
+  size_t replayHistory(const std::vector<CoarseningMemento>& history, const HypernodeID limit) {
+    size_t num_replayed = 0;
+    for (const CoarseningMemento& memento : history) {
+      const HypernodeID u = memento.contraction_memento.u;
+      const HypernodeID v = memento.contraction_memento.v;
+      if (_hg.currentNumNodes() <= limit || u >= _hg.initialNumNodes() ||
+          v >= _hg.initialNumNodes() || u == v || !_hg.nodeIsEnabled(u) ||
+          !_hg.nodeIsEnabled(v) ||
+          _hg.nodeWeight(u) + _hg.nodeWeight(v) > _context.coarsening.max_allowed_node_weight) {
+        break;
+      }
+      performContraction(u, v);
+      ASSERT(_history.back().contraction_memento.u_first_entry ==
+             memento.contraction_memento.u_first_entry &&
+             _history.back().contraction_memento.u_size == memento.contraction_memento.u_size &&
+             _history.back().one_pin_hes_size == memento.one_pin_hes_size &&
+             _history.back().parallel_hes_size == memento.parallel_hes_size,
+             "Replayed contraction differs from stored history:" << V(u) << V(v));
+      ++num_replayed;
+    }
+    return num_replayed;
   }
 
   void removeSingleNodeHyperedges() {
@@ -117,9 +161,23 @@ class CoarsenerBase {
 #endif
   }
 
+  // Uncoarsening is behind schedule if the remaining uncontractions are not
+  // expected to finish within the time limit at the pace of the previous ones.
+  bool behindSchedule(const HighResClockTimepoint& uncoarsening_start, const size_t num_done,
+                      const size_t num_remaining) const {
+    if (_context.partition.time_limit <= 0 || num_done == 0) {
+      return false;
+    }
+    const double seconds_per_uncontraction = std::chrono::duration<double>(
+      std::chrono::high_resolution_clock::now() - uncoarsening_start).count() / num_done;
+    return seconds_per_uncontraction * num_remaining >
+           _context.partition.time_limit - _context.elapsedSeconds();
+  }
+
   void performLocalSearch(IRefiner& refiner, std::vector<HypernodeID>& refinement_nodes,
                           Metrics& current_metrics,
-                          const UncontractionGainChanges& changes) {
+                          const UncontractionGainChanges& changes,
+                          const int max_iterations) {
     ASSERT(changes.representative.size() != 0, "0");
     ASSERT(changes.contraction_partner.size() != 0, "0");
     bool improvement_found = performLocalSearchIteration(refiner, refinement_nodes, changes,
@@ -129,7 +187,7 @@ class CoarsenerBase {
     no_changes.contraction_partner.push_back(0);
 
     int iteration = 1;
-    while ((iteration < _context.local_search.iterations_per_level) && improvement_found) {
+    while ((iteration < max_iterations) && improvement_found && !timeBudgetExhausted()) {
       improvement_found = performLocalSearchIteration(refiner, refinement_nodes, no_changes,
                                                       current_metrics);
       ++iteration;
@@ -170,5 +228,7 @@ class CoarsenerBase {
   std::vector<CoarseningMemento> _history;
   std::vector<CurrentMaxNodeWeight> _max_hn_weights;
   HypergraphPruner _hypergraph_pruner;
+  size_t _calls_since_time_check;
+  bool _time_budget_exhausted;
 };
 }  // namespace kahypar
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/coarsening_memento.h"
+#include "kahypar/partition/context.h"
+
+namespace kahypar {
+// Everything needed to restore the coarsening phase of a previous run: the
+// communities computed during preprocessing, the sequence of contractions
+// and the state of the random number generator after coarsening. Since the
+// pruning of single-node and parallel nets is deterministic, it is redone
+// while replaying the contractions.
+struct CoarseningHierarchy {
+  uint64_t hypergraph_fingerprint = 0;
+  // coarsening-relevant parameters that do not depend on k
+  std::string configuration { };
+  HypernodeID contraction_limit = 0;
+  HypernodeWeight max_allowed_node_weight = 0;
+  std::vector<ClusterID> communities { };
+  std::vector<CoarseningMemento> history { };
+  std::string random_state { };
+};
+
+static inline uint64_t hypergraphFingerprint(const Hypergraph& hypergraph) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto update = [&hash](const uint64_t value) {
+                  hash = (hash ^ value) * 0x100000001b3ULL;
+                };
+  update(hypergraph.initialNumNodes());
+  update(hypergraph.initialNumEdges());
+  for (const HyperedgeID& he : hypergraph.edges()) {
+    update(he);
+    update(hypergraph.edgeWeight(he));
+    for (const HypernodeID& pin : hypergraph.pins(he)) {
+      update(pin);
+    }
+  }
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    update(hypergraph.nodeWeight(hn));
+  }
+  return hash;
+}
+
+// The contraction limit and the maximum node weight depend on k and are
+// checked separately when the hierarchy is replayed.
+static inline std::string coarseningConfiguration(const Context& context) {
+  std::ostringstream configuration;
+  configuration << context.coarsening.algorithm << ' '
+                << context.coarsening.rating.rating_function << ' '
+                << context.coarsening.rating.community_policy << ' '
+                << context.coarsening.rating.heavy_node_penalty_policy << ' '
+                << context.coarsening.rating.acceptance_policy << ' '
+                << context.partition.seed << ' '
+                << context.preprocessing.enable_community_detection;
+  if (context.preprocessing.enable_community_detection) {
+    configuration << ' ' << context.preprocessing.community_detection.edge_weight << ' '
+                  << context.preprocessing.community_detection.max_pass_iterations << ' '
+                  << context.preprocessing.community_detection.min_eps_improvement;
+  }
+  return configuration.str();
+}
+}  // namespace kahypar
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "kahypar/definitions.h"
 #include "kahypar/partition/coarsening/i_coarsener.h"
@@ -40,5 +41,12 @@ class DoNothingCoarsener final : public ICoarsener {
  private:
   void coarsenImpl(const HypernodeID) override { }
   bool uncoarsenImpl(IRefiner&) override { return false; }
+  size_t replayImpl(const std::vector<CoarseningMemento>&, const HypernodeID) override {
+    return 0;
+  }
+  const std::vector<CoarseningMemento> & historyImpl() const override {
+    static const std::vector<CoarseningMemento> empty_history;
+    return empty_history;
+  }
 };
 }  // namespace kahypar
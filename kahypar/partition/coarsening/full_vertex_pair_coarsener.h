@@ -84,7 +84,7 @@ class FullVertexPairCoarsener final : public ICoarsener,
     // PQ because they are heavier than allowed.
     ds::FastResetFlagArray<> invalid_hypernodes(_hg.initialNumNodes());
 
-    while (!_pq.empty() && _hg.currentNumNodes() > limit) {
+    while (!_pq.empty() && _hg.currentNumNodes() > limit && !Base::timeBudgetExhausted()) {
       const HypernodeID rep_node = _pq.top();
       const HypernodeID contracted_node = _target[rep_node];
       DBG << "Contracting: (" << rep_node << ","
@@ -120,6 +120,15 @@ class FullVertexPairCoarsener final : public ICoarsener,
     return doUncoarsen(refiner);
   }
 
+  size_t replayImpl(const std::vector<CoarseningMemento>& history,
+                    const HypernodeID limit) override final {
+    return Base::replayHistory(history, limit);
+  }
+
+  const std::vector<CoarseningMemento> & historyImpl() const override final {
+    return _history;
+  }
+
   void reRateAffectedHypernodes(const HypernodeID rep_node,
                                 ds::FastResetFlagArray<>& rerated_hypernodes,
                                 ds::FastResetFlagArray<>& invalid_hypernodes) {
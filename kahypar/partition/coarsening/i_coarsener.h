@@ -21,9 +21,11 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "kahypar/definitions.h"
 #include "kahypar/macros.h"
+#include "kahypar/partition/coarsening/coarsening_memento.h"
 
 namespace kahypar {
 class IRefiner;
@@ -43,6 +45,17 @@ class ICoarsener {
     return uncoarsenImpl(refiner);
   }
 
+  // Performs the contractions of a previously stored history (in order) until
+  // the limit is reached or a contraction would violate the current maximum
+  // node weight. Returns the number of replayed contractions.
+  size_t replay(const std::vector<CoarseningMemento>& history, const HypernodeID limit) {
+    return replayImpl(history, limit);
+  }
+
+  const std::vector<CoarseningMemento> & history() const {
+    return historyImpl();
+  }
+
   virtual ~ICoarsener() = default;
 
  protected:
@@ -51,5 +64,8 @@ class ICoarsener {
  private:
   virtual void coarsenImpl(HypernodeID limit) = 0;
   virtual bool uncoarsenImpl(IRefiner& refiner) = 0;
+  virtual size_t replayImpl(const std::vector<CoarseningMemento>& history,
+                            HypernodeID limit) = 0;
+  virtual const std::vector<CoarseningMemento> & historyImpl() const = 0;
 };
 }  // namespace kahypar
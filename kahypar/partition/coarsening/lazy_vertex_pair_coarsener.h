@@ -78,7 +78,7 @@ class LazyVertexPairCoarsener final : public ICoarsener,
 
     rateAllHypernodes(_rater, _target);
 
-    while (!_pq.empty() && _hg.currentNumNodes() > limit) {
+    while (!_pq.empty() && _hg.currentNumNodes() > limit && !Base::timeBudgetExhausted()) {
       const HypernodeID rep_node = _pq.top();
 
       if (_outdated_rating[rep_node]) {
@@ -116,6 +116,15 @@ class LazyVertexPairCoarsener final : public ICoarsener,
     return Base::doUncoarsen(refiner);
   }
 
+  size_t replayImpl(const std::vector<CoarseningMemento>& history,
+                    const HypernodeID limit) override final {
+    return Base::replayHistory(history, limit);
+  }
+
+  const std::vector<CoarseningMemento> & historyImpl() const override final {
+    return _history;
+  }
+
   void invalidateAffectedHypernodes(const HypernodeID rep_node) {
     for (const HyperedgeID& he : _hg.incidentEdges(rep_node)) {
       for (const HypernodeID& pin : _hg.pins(he)) {
@@ -74,7 +74,7 @@ class MLCoarsener final : public ICoarsener,
     int pass_nr = 0;
     std::vector<HypernodeID> current_hns;
 
-    while (_hg.currentNumNodes() > limit) {
+    while (_hg.currentNumNodes() > limit && !Base::timeBudgetExhausted()) {
       DBG << V(pass_nr);
       DBG << V(_hg.currentNumNodes());
       DBG << V(_hg.currentNumEdges());
@@ -107,7 +107,7 @@ class MLCoarsener final : public ICoarsener,
             // }
           }
 
-          if (_hg.currentNumNodes() <= limit) {
+          if (_hg.currentNumNodes() <= limit || Base::timeBudgetExhausted()) {
             break;
           }
         }
@@ -125,6 +125,15 @@ class MLCoarsener final : public ICoarsener,
     return doUncoarsen(refiner);
   }
 
+  size_t replayImpl(const std::vector<CoarseningMemento>& history,
+                    const HypernodeID limit) override final {
+    return Base::replayHistory(history, limit);
+  }
+
+  const std::vector<CoarseningMemento> & historyImpl() const override final {
+    return _history;
+  }
+
   using Base::_pq;
   using Base::_hg;
   using Base::_context;
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
 #include <stack>
 #include <unordered_map>
@@ -28,17 +29,25 @@
 #include <vector>
 
 #include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/d_ary_heap.h"
 #include "kahypar/definitions.h"
 #include "kahypar/meta/int_to_type.h"
 #include "kahypar/partition/coarsening/coarsener_base.h"
 #include "kahypar/partition/coarsening/vertex_pair_rater.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/partition/progress.h"
 #include "kahypar/partition/refinement/i_refiner.h"
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
-template <class PrioQueue = ds::BinaryMaxHeap<HypernodeID, RatingType> >
+#ifdef USE_DARY_HEAP
+using CoarseningPQ = ds::DAryMaxHeap<HypernodeID, RatingType, 4>;
+#else
+using CoarseningPQ = ds::BinaryMaxHeap<HypernodeID, RatingType>;
+#endif
+
+template <class PrioQueue = CoarseningPQ>
 class VertexPairCoarsenerBase : public CoarsenerBase {
  private:
   static constexpr bool debug = false;
@@ -47,6 +56,8 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
   using CoarsenerBase::performLocalSearch;
   using CoarsenerBase::initializeRefiner;
   using CoarsenerBase::performContraction;
+  using CoarsenerBase::timeBudgetExhausted;
+  using CoarsenerBase::behindSchedule;
 
  public:
   VertexPairCoarsenerBase(Hypergraph& hypergraph, const Context& context,
@@ -92,6 +103,13 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
     UncontractionGainChanges changes;
     changes.representative.push_back(0);
     changes.contraction_partner.push_back(0);
+
+    // If the time budget is exhausted, the remaining levels are only projected.
+    // If uncoarsening is behind schedule, refinement is restricted to a single
+    // local search iteration per level.
+    const HighResClockTimepoint uncoarsening_start = std::chrono::high_resolution_clock::now();
+    const size_t num_uncontractions = _history.size();
+    bool behind_schedule = false;
     while (!_history.empty()) {
       restoreParallelHyperedges();
       restoreSingleNodeHyperedges();
@@ -114,7 +132,18 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
         _hg.uncontract(_history.back().contraction_memento);
       }
 
-      performLocalSearch(refiner, refinement_nodes, current_metrics, changes);
+      const size_t num_done = num_uncontractions - _history.size();
+      if (!timeBudgetExhausted()) {
+        if (num_done % kTimeBudgetCheckInterval == 0) {
+          behind_schedule = behindSchedule(uncoarsening_start, num_done, _history.size());
+        }
+        performLocalSearch(refiner, refinement_nodes, current_metrics, changes,
+                           behind_schedule ? 1 : _context.local_search.iterations_per_level);
+      }
+      if (num_done % kTimeBudgetCheckInterval == 0 && progress::isDue(_context)) {
+        progress::report(_context, ProgressPhase::uncoarsening, _hg.currentNumNodes(),
+                         current_metrics);
+      }
       changes.representative[0] = 0;
       changes.contraction_partner[0] = 0;
       _history.pop_back();
@@ -154,7 +154,7 @@ class VertexPairRater {
 
   Hypergraph& _hg;
   const Context& _context;
-  ds::SparseMap<HypernodeID, RatingType> _tmp_ratings;
+  ds::DynamicSparseMap<HypernodeID, RatingType> _tmp_ratings;
   ds::FastResetFlagArray<> _already_matched;
 };
 }  // namespace kahypar
@@ -22,7 +22,9 @@
 
 #include <array>
 #include <cctype>
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -135,6 +137,8 @@ struct CoarseningParameters {
   RatingParameters rating = { };
   HypernodeID contraction_limit_multiplier = std::numeric_limits<HypernodeID>::max();
   double max_allowed_weight_multiplier = std::numeric_limits<double>::max();
+  // File used to store and reuse the coarsening hierarchy (empty = disabled)
+  std::string hierarchy_file { };
 
   // Those will be determined dynamically
   HypernodeWeight max_allowed_node_weight = 0;
@@ -169,7 +173,11 @@ inline std::ostream& operator<< (std::ostream& str, const CoarseningParameters&
   } else {
     str << params.contraction_limit;
   }
-  str << std::endl << params.rating;
+  str << std::endl;
+  if (!params.hierarchy_file.empty()) {
+    str << "  hierarchy file:                     " << params.hierarchy_file << std::endl;
+  }
+  str << params.rating;
   return str;
 }
 
@@ -257,9 +265,25 @@ inline std::ostream& operator<< (std::ostream& str, const InitialPartitioningPar
   return str;
 }
 
+// Passed to PartitioningParameters::progress. Cut, km1 and imbalance refer to
+// the current partition and are 0 as long as no partition exists. Within
+// uncoarsening, they are the values maintained by the refiner.
+struct ProgressReport {
+  ProgressPhase phase = ProgressPhase::preprocessing;
+  uint32_t v_cycle = 0;
+  HypernodeID num_nodes = 0;
+  HyperedgeWeight cut = 0;
+  HyperedgeWeight km1 = 0;
+  double imbalance = 0.0;
+  double elapsed_seconds = 0.0;
+};
+
+class ProgressReporter;
+
 struct PartitioningParameters {
   Mode mode = Mode::UNDEFINED;
   Objective objective = Objective::UNDEFINED;
+  InputFormat input_format = InputFormat::automatic;
   double epsilon = std::numeric_limits<double>::max();
   PartitionID k = std::numeric_limits<PartitionID>::max();
   PartitionID rb_lower_k = std::numeric_limits<PartitionID>::max();
@@ -279,14 +303,39 @@ struct PartitioningParameters {
   bool verbose_output = false;
   bool quiet_mode = false;
   bool sp_process_output = false;
+  bool binary_partition_output = false;
 
   std::string graph_filename { };
   std::string graph_partition_filename { };
+  // If not empty, KaHyPar computes a partition for each of these k.
+  std::vector<PartitionID> k_sweep { };
+  // If not empty, this partition is improved instead of partitioning from scratch.
+  std::string input_partition_filename { };
+
+  // Wall-clock budget in seconds (0 = unlimited). It is measured from
+  // start_time, which is set at the beginning of Partitioner::partition.
+  double time_limit = 0.0;
+  // Memory budget in MB (0 = unlimited). If set, leaner data structures are
+  // selected until the estimated footprint fits (see memory_limit.h).
+  size_t memory_limit = 0;
+  HighResClockTimepoint start_time { };
+  // Is polled together with the time limit. If it returns true, the run
+  // stops as if the time limit was exceeded.
+  std::function<bool()> cancel { };
+
+  // Is called at every phase boundary and, at most every progress_interval
+  // seconds, during coarsening and uncoarsening.
+  std::function<void(const ProgressReport&)> progress { };
+  double progress_interval = 1.0;
+  // Owned by the Partitioner of the current run and only set during a run
+  // (see progress.h).
+  ProgressReporter* progress_reporter = nullptr;
 };
 
 inline std::ostream& operator<< (std::ostream& str, const PartitioningParameters& params) {
   str << "Partitioning Parameters:" << std::endl;
   str << "  Hypergraph:                         " << params.graph_filename << std::endl;
+  str << "  Input Format:                       " << params.input_format << std::endl;
   str << "  Partition File:                     " << params.graph_partition_filename << std::endl;
   str << "  Mode:                               " << params.mode << std::endl;
   str << "  Objective:                          " << params.objective << std::endl;
@@ -295,6 +344,12 @@ inline std::ostream& operator<< (std::ostream& str, const PartitioningParameters
   str << "  seed:                               " << params.seed << std::endl;
   str << "  # V-cycles:                         " << params.global_search_iterations << std::endl;
   str << "  hyperedge size threshold:           " << params.hyperedge_size_threshold << std::endl;
+  if (params.time_limit > 0) {
+    str << "  time limit:                         " << params.time_limit << "s" << std::endl;
+  }
+  if (params.memory_limit > 0) {
+    str << "  memory limit:                       " << params.memory_limit << " MB" << std::endl;
+  }
   str << "  total hypergraph weight:            " << params.total_graph_weight << std::endl;
   str << "  L_opt0:                             " << params.perfect_balance_part_weights[0]
       << std::endl;
@@ -333,6 +388,19 @@ class Context {
   bool isMainRecursiveBisection() const {
     return partition.mode == Mode::recursive_bisection && type == ContextType::main;
   }
+
+  double elapsedSeconds() const {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() -
+                                         partition.start_time).count();
+  }
+
+  // True once the time limit is exceeded or the run was cancelled. All
+  // phases then finish as fast as possible with the best partition found
+  // so far.
+  bool timeBudgetExhausted() const {
+    return (partition.time_limit > 0 && elapsedSeconds() >= partition.time_limit) ||
+           (partition.cancel && partition.cancel());
+  }
 };
 
 inline std::ostream& operator<< (std::ostream& str, const Context& context) {
@@ -389,6 +457,40 @@ void checkDirectKwayMode(RefinementAlgorithm& algo) {
   }
 }
 
+// Non-interactive counterpart of sanityCheck for embedding applications. It
+// neither asserts nor asks to change the local search algorithm, but rejects
+// the contexts that sanityCheck does not accept unchanged (except for the
+// advice to use twoway_fm in recursive bisection mode).
+static inline bool isValidContext(const Context& context, std::string& error) {
+  if (context.partition.mode == Mode::UNDEFINED) {
+    error = "partitioning mode is not set";
+  } else if (context.partition.objective == Objective::UNDEFINED) {
+    error = "objective is not set";
+  } else if (context.partition.mode == Mode::recursive_bisection &&
+             context.initial_partitioning.mode != Mode::direct_kway) {
+    error = "recursive bisection requires direct k-way initial partitioning";
+  } else if (context.partition.mode == Mode::recursive_bisection &&
+             context.initial_partitioning.technique != InitialPartitioningTechnique::flat) {
+    error = "recursive bisection requires flat initial partitioning";
+  } else if (context.partition.mode == Mode::direct_kway &&
+             context.initial_partitioning.mode == Mode::direct_kway &&
+             context.initial_partitioning.technique != InitialPartitioningTechnique::flat) {
+    error = "direct k-way initial partitioning has to be flat in direct k-way mode";
+  } else if (context.partition.mode == Mode::direct_kway &&
+             context.local_search.algorithm == RefinementAlgorithm::twoway_fm &&
+             context.partition.k > 2) {
+    error = "twoway_fm cannot refine direct k-way partitions with k > 2";
+  } else if (context.partition.mode == Mode::direct_kway &&
+             context.initial_partitioning.mode == Mode::direct_kway &&
+             context.initial_partitioning.local_search.algorithm ==
+             RefinementAlgorithm::twoway_fm && context.partition.k > 2) {
+    error = "twoway_fm cannot refine direct k-way initial partitions with k > 2";
+  } else {
+    return true;
+  }
+  return false;
+}
+
 static inline void sanityCheck(Context& context) {
   switch (context.partition.mode) {
     case Mode::recursive_bisection:
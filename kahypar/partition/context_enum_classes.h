@@ -21,6 +21,7 @@
 #pragma once
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
 namespace kahypar {
@@ -120,7 +121,51 @@ enum class Objective : uint8_t {
   UNDEFINED
 };
 
-std::ostream& operator<< (std::ostream& os, const Mode& mode) {
+enum class InputFormat : uint8_t {
+  automatic,
+  hmetis,
+  patoh,
+  mtx_row_net,
+  mtx_column_net,
+  edge_list
+};
+
+enum class ProgressPhase : uint8_t {
+  preprocessing,
+  coarsening,
+  initial_partitioning,
+  uncoarsening,
+  v_cycle,
+  finished
+};
+
+inline std::ostream& operator<< (std::ostream& os, const ProgressPhase& phase) {
+  switch (phase) {
+    case ProgressPhase::preprocessing: return os << "preprocessing";
+    case ProgressPhase::coarsening: return os << "coarsening";
+    case ProgressPhase::initial_partitioning: return os << "initial_partitioning";
+    case ProgressPhase::uncoarsening: return os << "uncoarsening";
+    case ProgressPhase::v_cycle: return os << "v_cycle";
+    case ProgressPhase::finished: return os << "finished";
+      // omit default case to trigger compiler warning for missing cases
+  }
+  return os << static_cast<uint8_t>(phase);
+}
+
+inline std::ostream& operator<< (std::ostream& os, const InputFormat& format) {
+  switch (format) {
+    case InputFormat::automatic: return os << "auto";
+    case InputFormat::hmetis: return os << "hmetis";
+    case InputFormat::patoh: return os << "patoh";
+    case InputFormat::mtx_row_net: return os << "mtx-row-net";
+    case InputFormat::mtx_column_net: return os << "mtx-column-net";
+    case InputFormat::edge_list: return os << "edgelist";
+      // omit default case to trigger compiler warning for missing cases
+  }
+  return os << static_cast<uint8_t>(format);
+}
+
+inline std::ostream& operator<< (std::ostream& os, const Mode& mode) {
   switch (mode) {
     case Mode::recursive_bisection: return os << "recursive";
     case Mode::direct_kway: return os << "direct";
@@ -130,7 +175,7 @@ std::ostream& operator<< (std::ostream& os, const Mode& mode) {
   return os << static_cast<uint8_t>(mode);
 }
 
-std::ostream& operator<< (std::ostream& os, const ContextType& type) {
+inline std::ostream& operator<< (std::ostream& os, const ContextType& type) {
   if (type == ContextType::main) {
     return os << "main";
   } else {
@@ -139,7 +184,7 @@ std::ostream& operator<< (std::ostream& os, const ContextType& type) {
   return os << static_cast<uint8_t>(type);
 }
 
-std::ostream& operator<< (std::ostream& os, const CommunityPolicy& comm_policy) {
+inline std::ostream& operator<< (std::ostream& os, const CommunityPolicy& comm_policy) {
   switch (comm_policy) {
     case CommunityPolicy::use_communities: return os << "true";
     case CommunityPolicy::ignore_communities: return os << "false";
@@ -149,7 +194,7 @@ std::ostream& operator<< (std::ostream& os, const CommunityPolicy& comm_policy)
   return os << static_cast<uint8_t>(comm_policy);
 }
 
-std::ostream& operator<< (std::ostream& os, const HeavyNodePenaltyPolicy& heavy_hn_policy) {
+inline std::ostream& operator<< (std::ostream& os, const HeavyNodePenaltyPolicy& heavy_hn_policy) {
   switch (heavy_hn_policy) {
     case HeavyNodePenaltyPolicy::multiplicative_penalty: return os << "multiplicative";
     case HeavyNodePenaltyPolicy::no_penalty: return os << "no_penalty";
@@ -159,7 +204,7 @@ std::ostream& operator<< (std::ostream& os, const HeavyNodePenaltyPolicy& heavy_
   return os << static_cast<uint8_t>(heavy_hn_policy);
 }
 
-std::ostream& operator<< (std::ostream& os, const AcceptancePolicy& acceptance_policy) {
+inline std::ostream& operator<< (std::ostream& os, const AcceptancePolicy& acceptance_policy) {
   switch (acceptance_policy) {
     case AcceptancePolicy::best: return os << "best";
     case AcceptancePolicy::best_prefer_unmatched: return os << "best_prefer_unmatched";
@@ -169,7 +214,7 @@ std::ostream& operator<< (std::ostream& os, const AcceptancePolicy& acceptance_p
   return os << static_cast<uint8_t>(acceptance_policy);
 }
 
-std::ostream& operator<< (std::ostream& os, const RatingFunction& func) {
+inline std::ostream& operator<< (std::ostream& os, const RatingFunction& func) {
   switch (func) {
     case RatingFunction::heavy_edge: return os << "heavy_edge";
     case RatingFunction::edge_frequency: return os << "edge_frequency";
@@ -179,7 +224,7 @@ std::ostream& operator<< (std::ostream& os, const RatingFunction& func) {
   return os << static_cast<uint8_t>(func);
 }
 
-std::ostream& operator<< (std::ostream& os, const Objective& objective) {
+inline std::ostream& operator<< (std::ostream& os, const Objective& objective) {
   switch (objective) {
     case Objective::cut: return os << "cut";
     case Objective::km1: return os << "km1";
@@ -189,7 +234,7 @@ std::ostream& operator<< (std::ostream& os, const Objective& objective) {
   return os << static_cast<uint8_t>(objective);
 }
 
-std::ostream& operator<< (std::ostream& os, const InitialPartitioningTechnique& technique) {
+inline std::ostream& operator<< (std::ostream& os, const InitialPartitioningTechnique& technique) {
   switch (technique) {
     case InitialPartitioningTechnique::flat: return os << "flat";
     case InitialPartitioningTechnique::multilevel: return os << "multilevel";
@@ -199,7 +244,7 @@ std::ostream& operator<< (std::ostream& os, const InitialPartitioningTechnique&
   return os << static_cast<uint8_t>(technique);
 }
 
-std::ostream& operator<< (std::ostream& os, const CoarseningAlgorithm& algo) {
+inline std::ostream& operator<< (std::ostream& os, const CoarseningAlgorithm& algo) {
   switch (algo) {
     case CoarseningAlgorithm::heavy_full: return os << "heavy_full";
     case CoarseningAlgorithm::heavy_lazy: return os << "heavy_lazy";
@@ -211,7 +256,7 @@ std::ostream& operator<< (std::ostream& os, const CoarseningAlgorithm& algo) {
   return os << static_cast<uint8_t>(algo);
 }
 
-std::ostream& operator<< (std::ostream& os, const RefinementAlgorithm& algo) {
+inline std::ostream& operator<< (std::ostream& os, const RefinementAlgorithm& algo) {
   switch (algo) {
     case RefinementAlgorithm::twoway_fm: return os << "twoway_fm";
     case RefinementAlgorithm::kway_fm: return os << "kway_fm";
@@ -225,7 +270,7 @@ std::ostream& operator<< (std::ostream& os, const RefinementAlgorithm& algo) {
   return os << static_cast<uint8_t>(algo);
 }
 
-std::ostream& operator<< (std::ostream& os, const InitialPartitionerAlgorithm& algo) {
+inline std::ostream& operator<< (std::ostream& os, const InitialPartitionerAlgorithm& algo) {
   switch (algo) {
     case InitialPartitionerAlgorithm::greedy_sequential: return os << "greedy_sequential";
     case InitialPartitionerAlgorithm::greedy_global: return os << "greedy_global";
@@ -246,7 +291,7 @@ std::ostream& operator<< (std::ostream& os, const InitialPartitionerAlgorithm& a
   return os << static_cast<uint8_t>(algo);
 }
 
-std::ostream& operator<< (std::ostream& os, const LouvainEdgeWeight& weight) {
+inline std::ostream& operator<< (std::ostream& os, const LouvainEdgeWeight& weight) {
   switch (weight) {
     case LouvainEdgeWeight::hybrid: return os << "hybrid";
     case LouvainEdgeWeight::uniform: return os << "uniform";
@@ -258,7 +303,7 @@ std::ostream& operator<< (std::ostream& os, const LouvainEdgeWeight& weight) {
   return os << static_cast<uint8_t>(weight);
 }
 
-std::ostream& operator<< (std::ostream& os, const RefinementStoppingRule& rule) {
+inline std::ostream& operator<< (std::ostream& os, const RefinementStoppingRule& rule) {
   switch (rule) {
     case RefinementStoppingRule::simple: return os << "simple";
     case RefinementStoppingRule::adaptive_opt: return os << "adaptive_opt";
@@ -274,8 +319,7 @@ static AcceptancePolicy acceptanceCriterionFromString(const std::string& crit) {
   } else if (crit == "best_prefer_unmatched") {
     return AcceptancePolicy::best_prefer_unmatched;
   }
-  std::cout << "No valid acceptance criterion for rating." << std::endl;
-  exit(0);
+  throw std::invalid_argument("No valid acceptance criterion for rating: " + crit);
 }
 
 
@@ -285,9 +329,7 @@ static HeavyNodePenaltyPolicy heavyNodePenaltyFromString(const std::string& pena
   } else if (penalty == "no_penalty") {
     return HeavyNodePenaltyPolicy::no_penalty;
   }
-  std::cout << "No valid edge penalty policy for rating." << std::endl;
-  exit(0);
-  return HeavyNodePenaltyPolicy::multiplicative_penalty;
+  throw std::invalid_argument("No valid edge penalty policy for rating: " + penalty);
 }
 
 static RatingFunction ratingFunctionFromString(const std::string& function) {
@@ -296,9 +338,7 @@ static RatingFunction ratingFunctionFromString(const std::string& function) {
   } else if (function == "edge_frequency") {
     return RatingFunction::edge_frequency;
   }
-  std::cout << "No valid rating function for rating." << std::endl;
-  exit(0);
-  return RatingFunction::heavy_edge;
+  throw std::invalid_argument("No valid rating function for rating: " + function);
 }
 
 static RefinementStoppingRule stoppingRuleFromString(const std::string& rule) {
@@ -307,9 +347,7 @@ static RefinementStoppingRule stoppingRuleFromString(const std::string& rule) {
   } else if (rule == "adaptive_opt") {
     return RefinementStoppingRule::adaptive_opt;
   }
-  std::cout << "No valid stopping rule for FM." << std::endl;
-  exit(0);
-  return RefinementStoppingRule::simple;
+  throw std::invalid_argument("No valid stopping rule for FM: " + rule);
 }
 
 static CoarseningAlgorithm coarseningAlgorithmFromString(const std::string& type) {
@@ -320,9 +358,7 @@ static CoarseningAlgorithm coarseningAlgorithmFromString(const std::string& type
   } else if (type == "ml_style") {
     return CoarseningAlgorithm::ml_style;
   }
-  std::cout << "Illegal option:" << type << std::endl;
-  exit(0);
-  return CoarseningAlgorithm::heavy_lazy;
+  throw std::invalid_argument("Illegal option: " + type);
 }
 
 static RefinementAlgorithm refinementAlgorithmFromString(const std::string& type) {
@@ -337,9 +373,7 @@ static RefinementAlgorithm refinementAlgorithmFromString(const std::string& type
   } else if (type == "sclap") {
     return RefinementAlgorithm::label_propagation;
   }
-  std::cout << "Illegal option:" << type << std::endl;
-  exit(0);
-  return RefinementAlgorithm::kway_fm;
+  throw std::invalid_argument("Illegal option: " + type);
 }
 
 static InitialPartitionerAlgorithm initialPartitioningAlgorithmFromString(const std::string& mode) {
@@ -370,9 +404,7 @@ static InitialPartitionerAlgorithm initialPartitioningAlgorithmFromString(const
   } else if (mode == "pool") {
     return InitialPartitionerAlgorithm::pool;
   }
-  std::cout << "Illegal option:" << mode << std::endl;
-  exit(0);
-  return InitialPartitionerAlgorithm::greedy_global;
+  throw std::invalid_argument("Illegal option: " + mode);
 }
 
 static InitialPartitioningTechnique inititalPartitioningTechniqueFromString(const std::string& technique) {
@@ -381,9 +413,7 @@ static InitialPartitioningTechnique inititalPartitioningTechniqueFromString(cons
   } else if (technique == "multi") {
     return InitialPartitioningTechnique::multilevel;
   }
-  std::cout << "Illegal option:" << technique << std::endl;
-  exit(0);
-  return InitialPartitioningTechnique::multilevel;
+  throw std::invalid_argument("Illegal option: " + technique);
 }
 
 static LouvainEdgeWeight edgeWeightFromString(const std::string& type) {
@@ -396,9 +426,33 @@ static LouvainEdgeWeight edgeWeightFromString(const std::string& type) {
   } else if (type == "degree") {
     return LouvainEdgeWeight::degree;
   }
-  std::cout << "Illegal option:" << type << std::endl;
-  exit(0);
-  return LouvainEdgeWeight::uniform;
+  throw std::invalid_argument("Illegal option: " + type);
+}
+
+static InputFormat inputFormatFromString(const std::string& format) {
+  if (format == "auto") {
+    return InputFormat::automatic;
+  } else if (format == "hmetis") {
+    return InputFormat::hmetis;
+  } else if (format == "patoh") {
+    return InputFormat::patoh;
+  } else if (format == "mtx-row-net") {
+    return InputFormat::mtx_row_net;
+  } else if (format == "mtx-column-net") {
+    return InputFormat::mtx_column_net;
+  } else if (format == "edgelist") {
+    return InputFormat::edge_list;
+  }
+  throw std::invalid_argument("Illegal option: " + format);
+}
+
+static Objective objectiveFromString(const std::string& objective) {
+  if (objective == "cut") {
+    return Objective::cut;
+  } else if (objective == "km1") {
+    return Objective::km1;
+  }
+  throw std::invalid_argument("Illegal option: " + objective);
 }
 
 static Mode modeFromString(const std::string& mode) {
@@ -407,8 +461,6 @@ static Mode modeFromString(const std::string& mode) {
   } else if (mode == "direct") {
     return Mode::direct_kway;
   }
-  std::cout << "Illegal option:" << mode << std::endl;
-  exit(0);
-  return Mode::direct_kway;
+  throw std::invalid_argument("Illegal option: " + mode);
 }
 }  // namespace kahypar
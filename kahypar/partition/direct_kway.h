@@ -20,15 +20,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 
 #include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
 #include "kahypar/partition/coarsening/hypergraph_pruner.h"
 #include "kahypar/partition/coarsening/i_coarsener.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/factories.h"
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/multilevel.h"
+#include "kahypar/partition/progress.h"
 #include "kahypar/partition/refinement/i_refiner.h"
 
 namespace kahypar {
@@ -49,6 +52,9 @@ static inline bool partitionVCycle(Hypergraph& hypergraph, ICoarsener& coarsener
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
   Timer::instance().add(context, Timepoint::v_cycle_coarsening,
                         std::chrono::duration<double>(end - start).count());
+  if (progress::isEnabled(context)) {
+    progress::report(context, ProgressPhase::coarsening, hypergraph.currentNumNodes());
+  }
 
   if (context.partition.verbose_output && context.type == ContextType::main) {
     io::printHypergraphInfo(hypergraph, "Coarsened Hypergraph");
@@ -63,32 +69,34 @@ static inline bool partitionVCycle(Hypergraph& hypergraph, ICoarsener& coarsener
   end = std::chrono::high_resolution_clock::now();
   Timer::instance().add(context, Timepoint::v_cycle_local_search,
                         std::chrono::duration<double>(end - start).count());
+  if (progress::isEnabled(context)) {
+    progress::report(context, ProgressPhase::v_cycle, hypergraph);
+  }
 
   io::printLocalSearchResults(context, hypergraph);
   return improved_quality;
 }
 
 
-static inline void partition(Hypergraph& hypergraph, const Context& context) {
-  std::unique_ptr<ICoarsener> coarsener(
-    CoarsenerFactory::getInstance().createObject(
-      context.coarsening.algorithm, hypergraph, context,
-      hypergraph.weightOfHeaviestNode()));
-
-  std::unique_ptr<IRefiner> refiner(
-    RefinerFactory::getInstance().createObject(
-      context.local_search.algorithm, hypergraph, context));
-
-  multilevel::partition(hypergraph, *coarsener, *refiner, context);
-
+// Performs up to num_vcycles V-cycles. Global search stops early if a
+// V-cycle does not improve the partition.
+static inline void performVCycles(Hypergraph& hypergraph, ICoarsener& coarsener,
+                                  IRefiner& refiner, const Context& context,
+                                  const uint32_t num_vcycles) {
 #ifndef NDEBUG
   HyperedgeWeight initial_cut = std::numeric_limits<HyperedgeWeight>::max();
   HyperedgeWeight initial_km1 = std::numeric_limits<HyperedgeWeight>::max();
 #endif
 
-  for (uint32_t vcycle = 1; vcycle <= context.partition.global_search_iterations; ++vcycle) {
+  for (uint32_t vcycle = 1; vcycle <= num_vcycles; ++vcycle) {
+    if (context.timeBudgetExhausted()) {
+      if (!context.partition.quiet_mode) {
+        LOG << "Time limit reached before V-cycle" << vcycle << ". Stopping global search.";
+      }
+      break;
+    }
     context.partition.current_v_cycle = vcycle;
-    const bool improved_quality = partitionVCycle(hypergraph, *coarsener, *refiner, context);
+    const bool improved_quality = partitionVCycle(hypergraph, coarsener, refiner, context);
 
     if (!improved_quality) {
       LOG << "No improvement in V-cycle" << vcycle << ". Stopping global search.";
@@ -105,5 +113,39 @@ static inline void partition(Hypergraph& hypergraph, const Context& context) {
 #endif
   }
 }
+
+static inline void partition(Hypergraph& hypergraph, const Context& context,
+                             CoarseningHierarchy* hierarchy = nullptr) {
+  std::unique_ptr<ICoarsener> coarsener(
+    CoarsenerFactory::getInstance().createObject(
+      context.coarsening.algorithm, hypergraph, context,
+      hypergraph.weightOfHeaviestNode()));
+
+  std::unique_ptr<IRefiner> refiner(
+    RefinerFactory::getInstance().createObject(
+      context.local_search.algorithm, hypergraph, context));
+
+  multilevel::partition(hypergraph, *coarsener, *refiner, context, hierarchy);
+  performVCycles(hypergraph, *coarsener, *refiner, context,
+                 context.partition.global_search_iterations);
+}
+
+// Improves the partition that is already assigned to all hypernodes. V-cycles
+// only contract hypernodes of the same block and refine the projected
+// partition, so hypernodes only move if this improves the objective. At least
+// one V-cycle is performed, even if the context does not use global search.
+static inline void improve(Hypergraph& hypergraph, const Context& context) {
+  std::unique_ptr<ICoarsener> coarsener(
+    CoarsenerFactory::getInstance().createObject(
+      context.coarsening.algorithm, hypergraph, context,
+      hypergraph.weightOfHeaviestNode()));
+
+  std::unique_ptr<IRefiner> refiner(
+    RefinerFactory::getInstance().createObject(
+      context.local_search.algorithm, hypergraph, context));
+
+  performVCycles(hypergraph, *coarsener, *refiner, context,
+                 std::max(context.partition.global_search_iterations, 1U));
+}
 }  // namespace direct_kway
 }  // namespace kahypar
@@ -191,8 +191,9 @@ static inline void partition(Hypergraph& hg, const Context& context) {
       best_imbalance = imbalance;
     }
     init_alpha -= 0.1;
+    // Once the time budget is exhausted, the most balanced partition so far is kept.
   } while (metrics::imbalance(*extracted_init_hypergraph.first, context)
-           > context.partition.epsilon && init_alpha > 0.0);
+           > context.partition.epsilon && init_alpha > 0.0 && !context.timeBudgetExhausted());
 
   ASSERT([&]() {
         for (const HypernodeID& hn : hg.nodes()) {
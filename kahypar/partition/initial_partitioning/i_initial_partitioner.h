@@ -23,6 +23,7 @@
 #include <limits>
 #include <vector>
 
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/metrics.h"
 
@@ -37,7 +38,9 @@ class IInitialPartitioner {
 
   void partition(Hypergraph& hg, const Context& context) {
     HyperedgeWeight best_cut = std::numeric_limits<HyperedgeWeight>::max();
-    std::vector<PartitionID> best_partition(hg.initialNumNodes(), 0);
+    auto best_partition_buffer =
+      ds::ScratchBufferPool<std::vector<PartitionID> >::local().acquire(hg.initialNumNodes());
+    std::vector<PartitionID>& best_partition = *best_partition_buffer;
     for (uint32_t i = 0; i < context.initial_partitioning.nruns; ++i) {
       // hg.resetPartitioning() is called in partitionImpl
       partitionImpl();
@@ -48,6 +51,9 @@ class IInitialPartitioner {
           best_partition[hn] = hg.partID(hn);
         }
       }
+      if (context.timeBudgetExhausted()) {
+        break;
+      }
     }
     hg.resetPartitioning();
     for (const HypernodeID& hn : hg.nodes()) {
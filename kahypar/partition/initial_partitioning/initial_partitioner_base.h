@@ -156,7 +156,7 @@ class InitialPartitionerBase {
 #endif
         ++iteration;
       } while (iteration < _context.initial_partitioning.local_search.iterations_per_level &&
-               improvement_found);
+               improvement_found && !_context.timeBudgetExhausted());
     }
   }
 
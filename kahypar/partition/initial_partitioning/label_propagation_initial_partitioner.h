@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/meta/mandatory.h"
 #include "kahypar/partition/initial_partitioning/i_initial_partitioner.h"
@@ -107,7 +108,7 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner,
 
       int unvisited_pos = nodes.size();
       while (unvisited_pos != 0) {
-        int pos = std::rand() % unvisited_pos;
+        int pos = Randomize::instance().getRandomInt(0, unvisited_pos - 1);
         std::swap(nodes[pos], nodes[unvisited_pos - 1]);
         HypernodeID v = nodes[--unvisited_pos];
 
@@ -237,8 +238,9 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner,
         _tmp_scores[target_part] -= internal_weight;
 
         ASSERT([&]() {
-            ds::FastResetFlagArray<> bv(_hg.initialNumNodes());
-            Gain gain = GainComputation::calculateGain(_hg, hn, target_part, bv);
+            auto bv = ds::ScratchBufferPool<ds::FastResetFlagArray<> >::local().acquire(
+              _hg.initialNumNodes());
+            Gain gain = GainComputation::calculateGain(_hg, hn, target_part, *bv);
             if (_tmp_scores[target_part] != gain) {
               LOG << V(hn);
               LOG << V(_hg.partID(hn));
@@ -309,8 +311,9 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner,
         _tmp_scores[target_part] -= internal_weight;
 
         ASSERT([&]() {
-            ds::FastResetFlagArray<> bv(_hg.initialNumNodes());
-            Gain gain = GainComputation::calculateGain(_hg, hn, target_part, bv);
+            auto bv = ds::ScratchBufferPool<ds::FastResetFlagArray<> >::local().acquire(
+              _hg.initialNumNodes());
+            Gain gain = GainComputation::calculateGain(_hg, hn, target_part, *bv);
             if (_tmp_scores[target_part] != gain) {
               LOG << V(hn);
               LOG << V(_hg.partID(hn));
@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/partition/factories.h"
 #include "kahypar/partition/initial_partitioning/i_initial_partitioner.h"
@@ -102,7 +103,9 @@ class PoolInitialPartitioner : public IInitialPartitioner,
                                      kInvalidImbalance);
     PartitioningResult max_imbalance(InitialPartitionerAlgorithm::pool, kInvalidCut, -0.1);
 
-    std::vector<PartitionID> best_partition(_hg.initialNumNodes());
+    auto best_partition_buffer =
+      ds::ScratchBufferPool<std::vector<PartitionID> >::local().acquire(_hg.initialNumNodes());
+    std::vector<PartitionID>& best_partition = *best_partition_buffer;
     unsigned int n = _partitioner_pool.size() - 1;
     for (unsigned int i = 0; i <= n; ++i) {
       // If the (n-i)th bit of pool_type is set we execute the corresponding
@@ -149,6 +152,10 @@ class PoolInitialPartitioner : public IInitialPartitioner,
       if (current_imbalance > max_imbalance.imbalance) {
         applyPartitioningResults(max_imbalance, current_cut, current_imbalance, algo);
       }
+      if (_context.timeBudgetExhausted()) {
+        DBG << "Time limit reached: skipping the remaining algorithms";
+        break;
+      }
     }
 
     if (_context.initial_partitioning.verbose_output) {
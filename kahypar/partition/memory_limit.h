@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "kahypar/datastructure/graph.h"
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/refinement/gain_cache_element.h"
+#include "kahypar/partition/refinement/lp_gain_cache.h"
+#include "kahypar/utils/math.h"
+
+namespace kahypar {
+// Estimated peak memory in bytes of the components of a partitioner run.
+// The estimates follow the allocations of the data structures selected by
+// the context and are derived from the number of hypernodes, hyperedges,
+// pins and blocks only.
+struct MemoryEstimate {
+  size_t hypergraph = 0;
+  size_t sparsified_hypergraph = 0;
+  size_t community_detection = 0;
+  size_t coarsening = 0;
+  size_t initial_partitioning = 0;
+  size_t refinement = 0;
+
+  // The sparsified hypergraph is kept during the whole run, while
+  // community detection has finished before coarsening starts.
+  size_t total() const {
+    return hypergraph + sparsified_hypergraph +
+           std::max(community_detection, coarsening + initial_partitioning + refinement);
+  }
+};
+
+namespace memory {
+static constexpr bool debug = false;
+static constexpr size_t kBytesPerMB = 1024 * 1024;
+
+// Hypernodes and hyperedges store offset, size, weight and some bookkeeping.
+// The pins are stored twice (pins of hyperedges and incident nets). Each
+// hyperedge stores its pin count and connectivity set for all k blocks.
+static inline size_t hypergraphMemory(const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges,
+                                      const size_t num_pins, const PartitionID k) {
+  return 32 * (static_cast<size_t>(num_hypernodes) + num_hyperedges) +
+         2 * num_pins * sizeof(HypernodeID) +
+         static_cast<size_t>(num_hypernodes) * sizeof(ClusterID) +
+         static_cast<size_t>(num_hyperedges) * k * sizeof(HypernodeID) +
+         static_cast<size_t>(num_hyperedges) * (2 + 2 * k) * sizeof(PartitionID);
+}
+
+// The Louvain graph contains a node per hypernode and hyperedge and an edge
+// in both directions per pin. The contracted graphs of the hierarchy are at
+// most as large as the first one.
+static inline size_t communityDetectionMemory(const HypernodeID num_hypernodes,
+                                              const HyperedgeID num_hyperedges,
+                                              const size_t num_pins) {
+  return 2 * ((static_cast<size_t>(num_hypernodes) + num_hyperedges) * 6 * sizeof(NodeID) +
+              2 * num_pins * sizeof(ds::Edge));
+}
+
+// Contraction history, rating and pruning data structures.
+static inline size_t coarseningMemory(const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges) {
+  return 48 * static_cast<size_t>(num_hypernodes) + 16 * static_cast<size_t>(num_hyperedges);
+}
+
+// The k-way FM refiners keep a gain cache entry for each pair of hypernode
+// and block and an n-sized heap for each block. Label propagation only needs
+// the gain cache.
+static inline size_t refinementMemory(const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges,
+                                      const PartitionID k,
+                                      const RefinementAlgorithm algorithm) {
+  const size_t n = num_hypernodes;
+  const size_t heap_entry = sizeof(HypernodeID) + sizeof(Gain) + sizeof(size_t);
+  switch (algorithm) {
+    case RefinementAlgorithm::twoway_fm:
+      return n * (sizeof(Gain) + sizeof(HypernodeID)) + 2 * n * heap_entry;
+    case RefinementAlgorithm::kway_fm:
+    case RefinementAlgorithm::kway_fm_maxgain:
+    case RefinementAlgorithm::kway_fm_km1:
+      return n * (CacheElement<Gain>::sizeInBytes(k) + sizeof(PartitionID)) +
+             n * k * heap_entry + static_cast<size_t>(num_hyperedges) * k / 8;
+    case RefinementAlgorithm::label_propagation:
+      return n * (CacheElement<LPGain>::sizeInBytes(k) + sizeof(PartitionID) +
+                  2 * sizeof(uint16_t) + 2 * sizeof(HypernodeID));
+    case RefinementAlgorithm::do_nothing:
+    case RefinementAlgorithm::UNDEFINED:
+      break;
+  }
+  return 0;
+}
+
+// In recursive bisection mode, each bisection works on an extracted copy of
+// (a part of) the hypergraph with k = 2. Initial partitioning works on a
+// copy of the coarsest hypergraph, which has at most contraction_limit
+// hypernodes. Its size is approximated proportionally.
+static inline MemoryEstimate estimate(const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges,
+                                      const size_t num_pins, const bool sparsify,
+                                      const Context& context) {
+  const PartitionID k = context.partition.k;
+  const PartitionID local_k = context.partition.mode == Mode::recursive_bisection ? 2 : k;
+  MemoryEstimate estimate;
+  estimate.hypergraph = hypergraphMemory(num_hypernodes, num_hyperedges, num_pins, k);
+  if (context.partition.mode == Mode::recursive_bisection) {
+    estimate.hypergraph += hypergraphMemory(num_hypernodes, num_hyperedges, num_pins, 2);
+  }
+  if (sparsify) {
+    estimate.sparsified_hypergraph = hypergraphMemory(num_hypernodes, num_hyperedges,
+                                                      num_pins, local_k);
+  }
+  if (context.preprocessing.enable_community_detection) {
+    estimate.community_detection = communityDetectionMemory(num_hypernodes, num_hyperedges,
+                                                            num_pins);
+  }
+  estimate.coarsening = coarseningMemory(num_hypernodes, num_hyperedges);
+  estimate.refinement = refinementMemory(num_hypernodes, num_hyperedges, local_k,
+                                         context.local_search.algorithm);
+  const double coarsest_fraction =
+    std::min(1.0, static_cast<double>(context.coarsening.contraction_limit_multiplier) * local_k /
+             std::max(num_hypernodes, static_cast<HypernodeID>(1)));
+  estimate.initial_partitioning = static_cast<size_t>(
+    coarsest_fraction *
+    (hypergraphMemory(num_hypernodes, num_hyperedges, num_pins, local_k) +
+     refinementMemory(num_hypernodes, num_hyperedges, local_k,
+                      context.initial_partitioning.local_search.algorithm)));
+  return estimate;
+}
+
+// The sparsifier only works on a copy of the hypergraph if the median
+// hyperedge size is large enough (see Partitioner::configurePreprocessing).
+static inline bool sparsifierIsActive(std::vector<HypernodeID>& he_sizes,
+                                      const Context& context) {
+  if (!context.preprocessing.enable_min_hash_sparsifier || he_sizes.empty()) {
+    return false;
+  }
+  std::sort(he_sizes.begin(), he_sizes.end());
+  return math::median(he_sizes) >= context.preprocessing.min_hash_sparsifier.min_median_he_size;
+}
+
+static inline bool sparsifierIsActive(const size_t* hyperedge_offsets,
+                                      const HyperedgeID num_hyperedges,
+                                      const Context& context) {
+  std::vector<HypernodeID> he_sizes;
+  if (context.preprocessing.enable_min_hash_sparsifier) {
+    he_sizes.reserve(num_hyperedges);
+    for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+      he_sizes.push_back(hyperedge_offsets[he + 1] - hyperedge_offsets[he]);
+    }
+  }
+  return sparsifierIsActive(he_sizes, context);
+}
+
+static inline bool sparsifierIsActive(const HyperedgeIndexVector& index_vector,
+                                      const Context& context) {
+  if (index_vector.size() <= 1) {
+    return false;
+  }
+  return sparsifierIsActive(index_vector.data(), index_vector.size() - 1, context);
+}
+
+static inline bool sparsifierIsActive(const Hypergraph& hypergraph, const Context& context) {
+  std::vector<HypernodeID> he_sizes;
+  if (context.preprocessing.enable_min_hash_sparsifier) {
+    he_sizes.reserve(hypergraph.currentNumEdges());
+    for (const HyperedgeID& he : hypergraph.edges()) {
+      he_sizes.push_back(hypergraph.edgeSize(he));
+    }
+  }
+  return sparsifierIsActive(he_sizes, context);
+}
+
+static inline std::string inMB(const size_t bytes) {
+  return std::to_string((bytes + kBytesPerMB - 1) / kBytesPerMB) + " MB";
+}
+
+// Community detection finishes before coarsening starts, so disabling it only
+// helps if the Louvain graph determines the peak.
+static inline bool communityDetectionIsPeak(const MemoryEstimate& estimate,
+                                            const Context& context) {
+  return context.preprocessing.enable_community_detection &&
+         estimate.community_detection >
+         estimate.coarsening + estimate.initial_partitioning + estimate.refinement;
+}
+
+// Switches to leaner configurations until the estimate fits into the memory
+// limit: First, the hypergraph is not sparsified, then, for the cut
+// objective, label propagation replaces k-way FM and community detection is
+// disabled whenever it determines the peak. The km1 refiner has no leaner
+// replacement, because label propagation does not maintain the km1 metric.
+// Returns false if even the leanest configuration exceeds the limit.
+static inline bool fitIntoMemoryLimit(const HypernodeID num_hypernodes,
+                                      const HyperedgeID num_hyperedges,
+                                      const size_t num_pins, bool sparsify,
+                                      Context& context, MemoryEstimate& estimate) {
+  ASSERT(context.partition.memory_limit > 0);
+  const size_t limit = context.partition.memory_limit * kBytesPerMB;
+  const auto fits = [&]() {
+                      estimate = memory::estimate(num_hypernodes, num_hyperedges, num_pins,
+                                                  sparsify, context);
+                      DBG << V(estimate.total()) << V(limit);
+                      return estimate.total() <= limit;
+                    };
+  const auto report = [&](const std::string& change) {
+                        if (!context.partition.quiet_mode) {
+                          LOG << "Memory limit of" << inMB(limit) << "exceeded by estimate of"
+                              << inMB(estimate.total()) << "->" << change;
+                        }
+                      };
+
+  const auto disable_community_detection = [&]() {
+                                             report("disabling community detection");
+                                             context.preprocessing.enable_community_detection =
+                                               false;
+                                             return fits();
+                                           };
+
+  if (fits()) {
+    return true;
+  }
+  if (sparsify) {
+    report("disabling the min-hash sparsifier");
+    sparsify = false;
+    context.preprocessing.enable_min_hash_sparsifier = false;
+    if (fits()) {
+      return true;
+    }
+  }
+  if (communityDetectionIsPeak(estimate, context) && disable_community_detection()) {
+    return true;
+  }
+  if (context.partition.objective == Objective::cut &&
+      context.partition.mode == Mode::direct_kway &&
+      (context.local_search.algorithm == RefinementAlgorithm::kway_fm ||
+       context.local_search.algorithm == RefinementAlgorithm::kway_fm_maxgain)) {
+    report("using label propagation instead of k-way FM refinement");
+    context.local_search.algorithm = RefinementAlgorithm::label_propagation;
+    if (fits()) {
+      return true;
+    }
+  }
+  return communityDetectionIsPeak(estimate, context) && disable_community_detection();
+}
+
+static inline std::string describe(const MemoryEstimate& estimate) {
+  return "hypergraph " + inMB(estimate.hypergraph) +
+         ", sparsified hypergraph " + inMB(estimate.sparsified_hypergraph) +
+         ", community detection " + inMB(estimate.community_detection) +
+         ", coarsening " + inMB(estimate.coarsening) +
+         ", initial partitioning " + inMB(estimate.initial_partitioning) +
+         ", refinement " + inMB(estimate.refinement);
+}
+}  // namespace memory
+}  // namespace kahypar
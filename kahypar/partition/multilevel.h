@@ -20,30 +20,84 @@
 
 #pragma once
 
+#include <vector>
+
 #include "kahypar/definitions.h"
+#include "kahypar/io/coarsening_hierarchy_io.h"
 #include "kahypar/io/hypergraph_io.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
 #include "kahypar/partition/coarsening/i_coarsener.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/initial_partition.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/partition/progress.h"
 #include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/utils/randomize.h"
 #include "kahypar/utils/timer.h"
 
 namespace kahypar {
 namespace multilevel {
 static constexpr bool debug = false;
 
+// Replays the stored contractions as far as they are valid for the current
+// contraction limit and maximum node weight. If the hierarchy is replayed
+// completely with the parameters that created it, the random generator is
+// restored as well, i.e., the run continues exactly as the original one.
+// Otherwise, coarsening continues from the replayed state and a hierarchy
+// that got extended is written back to the file (if any).
+static inline void coarsen(Hypergraph& hypergraph, ICoarsener& coarsener,
+                           CoarseningHierarchy& hierarchy, const Context& context) {
+  const size_t num_stored = hierarchy.history.size();
+  const size_t num_replayed = coarsener.replay(hierarchy.history,
+                                               context.coarsening.contraction_limit);
+  if (context.partition.verbose_output && num_stored > 0) {
+    LOG << "Replayed" << num_replayed << "of" << num_stored << "stored contractions";
+  }
+  if (num_stored > 0 && num_replayed == num_stored &&
+      hierarchy.contraction_limit == context.coarsening.contraction_limit &&
+      hierarchy.max_allowed_node_weight == context.coarsening.max_allowed_node_weight &&
+      Randomize::instance().setState(hierarchy.random_state)) {
+    return;
+  }
+
+  coarsener.coarsen(context.coarsening.contraction_limit);
+  if (coarsener.history().size() > num_stored) {
+    std::vector<CoarseningMemento>(coarsener.history()).swap(hierarchy.history);
+    hierarchy.contraction_limit = context.coarsening.contraction_limit;
+    hierarchy.max_allowed_node_weight = context.coarsening.max_allowed_node_weight;
+    hierarchy.random_state = Randomize::instance().state();
+    if (context.preprocessing.enable_community_detection) {
+      hierarchy.communities = hypergraph.communities();
+    }
+    if (!context.coarsening.hierarchy_file.empty()) {
+      const io::IOStatus status = io::writeCoarseningHierarchyFile(
+        hierarchy, context.coarsening.hierarchy_file);
+      if (!status.ok()) {
+        LOG << "Warning: could not store coarsening hierarchy:" << status.message();
+      }
+    }
+  }
+}
+
 static inline void partition(Hypergraph& hypergraph,
                              ICoarsener& coarsener,
                              IRefiner& refiner,
-                             const Context& context) {
+                             const Context& context,
+                             CoarseningHierarchy* hierarchy = nullptr) {
   io::printCoarseningBanner(context);
 
   HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
-  coarsener.coarsen(context.coarsening.contraction_limit);
+  if (hierarchy != nullptr) {
+    coarsen(hypergraph, coarsener, *hierarchy, context);
+  } else {
+    coarsener.coarsen(context.coarsening.contraction_limit);
+  }
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
   Timer::instance().add(context, Timepoint::coarsening,
                         std::chrono::duration<double>(end - start).count());
+  if (progress::isEnabled(context)) {
+    progress::report(context, ProgressPhase::coarsening, hypergraph.currentNumNodes());
+  }
 
   if (context.partition.verbose_output && context.type == ContextType::main) {
     io::printHypergraphInfo(hypergraph, "Coarsened Hypergraph");
@@ -56,6 +110,9 @@ static inline void partition(Hypergraph& hypergraph,
                         std::chrono::duration<double>(end - start).count());
 
   hypergraph.initializeNumCutHyperedges();
+  if (progress::isEnabled(context)) {
+    progress::report(context, ProgressPhase::initial_partitioning, hypergraph);
+  }
   if (context.partition.verbose_output && context.type == ContextType::main) {
     LOG << "Initial Partitioning Result:";
     LOG << "Initial" << context.partition.objective << "      ="
@@ -78,6 +135,9 @@ static inline void partition(Hypergraph& hypergraph,
   end = std::chrono::high_resolution_clock::now();
   Timer::instance().add(context, Timepoint::local_search,
                         std::chrono::duration<double>(end - start).count());
+  if (progress::isEnabled(context)) {
+    progress::report(context, ProgressPhase::uncoarsening, hypergraph);
+  }
 
   io::printLocalSearchResults(context, hypergraph);
 }
@@ -21,14 +21,19 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest_prod.h"
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/coarsening_hierarchy_io.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/io/partitioning_output.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
 #include "kahypar/partition/coarsening/hypergraph_pruner.h"
 #include "kahypar/partition/context.h"
 #include "kahypar/partition/direct_kway.h"
@@ -37,7 +42,9 @@
 #include "kahypar/partition/preprocessing/louvain.h"
 #include "kahypar/partition/preprocessing/min_hash_sparsifier.h"
 #include "kahypar/partition/preprocessing/single_node_hyperedge_remover.h"
+#include "kahypar/partition/progress.h"
 #include "kahypar/partition/recursive_bisection.h"
+#include "kahypar/partition/repartitioning.h"
 
 namespace kahypar {
 // Workaround for bug in gtest
@@ -53,7 +60,8 @@ class APartitionedHypergraph;
 
 
 namespace partition {
-static inline void partition(Hypergraph& hypergraph, const Context& context) {
+static inline void partition(Hypergraph& hypergraph, const Context& context,
+                             CoarseningHierarchy* hierarchy) {
   ASSERT([&]() {
         if (context.partition.mode != Mode::recursive_bisection &&
             context.preprocessing.enable_community_detection) {
@@ -70,13 +78,17 @@ static inline void partition(Hypergraph& hypergraph, const Context& context) {
       recursive_bisection::partition(hypergraph, context);
       break;
     case Mode::direct_kway:
-      direct_kway::partition(hypergraph, context);
+      direct_kway::partition(hypergraph, context, hierarchy);
       break;
     case Mode::UNDEFINED:
       LOG << "Partitioning Mode undefined!";
       std::exit(-1);
   }
 }
+
+static inline void partition(Hypergraph& hypergraph, const Context& context) {
+  partition(hypergraph, context, nullptr);
+}
 }  // namespace partition
 
 class Partitioner {
@@ -86,7 +98,8 @@ class Partitioner {
  public:
   Partitioner() :
     _single_node_he_remover(),
-    _pin_sparsifier() { }
+    _pin_sparsifier(),
+    _progress_reporter() { }
 
   Partitioner(const Partitioner&) = delete;
   Partitioner& operator= (const Partitioner&) = delete;
@@ -98,6 +111,25 @@ class Partitioner {
 
   inline void partition(Hypergraph& hypergraph, Context& context);
 
+  // Shares the coarsening hierarchy with later calls for the same hypergraph,
+  // e.g. for several values of k. Since a larger k stops coarsening earlier
+  // and allows lighter nodes only, calls with decreasing k replay the complete
+  // hierarchy of the previous call and extend it. Only used in direct k-way mode.
+  inline void partition(Hypergraph& hypergraph, Context& context,
+                        CoarseningHierarchy& hierarchy);
+
+  // Improves the partition that is already assigned to all hypernodes, e.g.,
+  // the partition of a previous design iteration, instead of partitioning
+  // from scratch. Only supported in direct k-way mode.
+  inline void improve(Hypergraph& hypergraph, Context& context);
+
+  // Updates the partition of a previous design iteration after an edit of the
+  // hypergraph: Unassigned hypernodes are assigned greedily and local search
+  // starts only at these and at the changed hypernodes (see repartitioning.h).
+  // Only supported in direct k-way mode.
+  inline void repartition(Hypergraph& hypergraph, Context& context,
+                          const std::vector<HypernodeID>& changed_hypernodes);
+
  private:
   FRIEND_TEST(APartitionerWithHyperedgeSizeThreshold, RemovesHyperedgesExceedingThreshold);
   FRIEND_TEST(APartitionerWithHyperedgeSizeThreshold, RestoresHyperedgesExceedingThreshold);
@@ -118,15 +150,24 @@ class Partitioner {
   friend class io::APartitionOfAHypergraph_IsCorrectlyWrittenToFile_Test;
   friend class metrics::APartitionedHypergraph;
 
+  inline void partitionImpl(Hypergraph& hypergraph, Context& context,
+                            CoarseningHierarchy* hierarchy);
+
   static inline void setupContext(const Hypergraph& hypergraph, Context& context);
 
   static inline void configurePreprocessing(const Hypergraph& hypergraph, Context& context);
 
   inline void sanitize(Hypergraph& hypergraph, const Context& context);
 
+  static inline bool useCoarseningHierarchy(const Context& context);
+  static inline void loadCoarseningHierarchy(const Hypergraph& hypergraph, const Context& context,
+                                             CoarseningHierarchy& hierarchy);
+
   inline void preprocess(Hypergraph& hypergraph, const Context& context);
+  inline void preprocess(Hypergraph& hypergraph, const Context& context,
+                         CoarseningHierarchy& hierarchy);
   inline void preprocess(Hypergraph& hypergraph, Hypergraph& sparse_hypergraph,
-                         const Context& context);
+                         const Context& context, CoarseningHierarchy* hierarchy = nullptr);
 
   inline void postprocess(Hypergraph& hypergraph);
   inline void postprocess(Hypergraph& hypergraph, Hypergraph& sparse_hypergraph,
@@ -134,6 +175,7 @@ class Partitioner {
 
   SingleNodeHyperedgeRemover _single_node_he_remover;
   MinHashSparsifier _pin_sparsifier;
+  ProgressReporter _progress_reporter;
 };
 
 inline void Partitioner::configurePreprocessing(const Hypergraph& hypergraph,
@@ -199,6 +241,51 @@ inline void Partitioner::sanitize(Hypergraph& hypergraph, const Context& context
   }
 }
 
+inline bool Partitioner::useCoarseningHierarchy(const Context& context) {
+  if (context.coarsening.hierarchy_file.empty()) {
+    return false;
+  }
+  if (context.partition.mode != Mode::direct_kway) {
+    LOG << "Warning: coarsening hierarchies are only supported in direct k-way mode."
+        << "Ignoring" << context.coarsening.hierarchy_file;
+    return false;
+  }
+  return true;
+}
+
+// A stored hierarchy is only used if it belongs to the same (possibly
+// sparsified) hypergraph and coarsening parameters. Otherwise, the hierarchy is recomputed and replaces
+// the stored one. A hierarchy kept in memory from a previous call takes precedence over the file.
+inline void Partitioner::loadCoarseningHierarchy(const Hypergraph& hypergraph,
+                                                 const Context& context,
+                                                 CoarseningHierarchy& hierarchy) {
+  const uint64_t fingerprint = hypergraphFingerprint(hypergraph);
+  const std::string configuration = coarseningConfiguration(context);
+  if (!hierarchy.history.empty() && hierarchy.hypergraph_fingerprint == fingerprint &&
+      hierarchy.configuration == configuration) {
+    return;
+  }
+  hierarchy = CoarseningHierarchy();
+  hierarchy.hypergraph_fingerprint = fingerprint;
+  hierarchy.configuration = configuration;
+  if (context.coarsening.hierarchy_file.empty() ||
+      !std::ifstream(context.coarsening.hierarchy_file)) {
+    return;
+  }
+  CoarseningHierarchy stored_hierarchy;
+  const io::IOStatus status = io::readCoarseningHierarchyFile(context.coarsening.hierarchy_file,
+                                                              stored_hierarchy);
+  if (!status.ok()) {
+    LOG << "Warning: ignoring coarsening hierarchy:" << status.message();
+  } else if (stored_hierarchy.hypergraph_fingerprint != hierarchy.hypergraph_fingerprint ||
+             stored_hierarchy.configuration != hierarchy.configuration) {
+    LOG << "Warning: ignoring coarsening hierarchy" << context.coarsening.hierarchy_file
+        << "(computed for a different hypergraph or coarsening parameters)";
+  } else {
+    std::swap(hierarchy, stored_hierarchy);
+  }
+}
+
 inline void Partitioner::preprocess(Hypergraph& hypergraph, const Context& context) {
   // In recursive bisection mode, we perform community detection before each
   // bisection. Therefore the 'top-level' preprocessing is disabled in this case.
@@ -208,8 +295,20 @@ inline void Partitioner::preprocess(Hypergraph& hypergraph, const Context& conte
   }
 }
 
+// Communities stored with a coarsening hierarchy replace community detection.
+inline void Partitioner::preprocess(Hypergraph& hypergraph, const Context& context,
+                                    CoarseningHierarchy& hierarchy) {
+  loadCoarseningHierarchy(hypergraph, context, hierarchy);
+  if (context.preprocessing.enable_community_detection && !hierarchy.history.empty() &&
+      hierarchy.communities.size() == hypergraph.initialNumNodes()) {
+    hypergraph.setCommunities(std::vector<ClusterID>(hierarchy.communities));
+  } else {
+    preprocess(hypergraph, context);
+  }
+}
+
 inline void Partitioner::preprocess(Hypergraph& hypergraph, Hypergraph& sparse_hypergraph,
-                                    const Context& context) {
+                                    const Context& context, CoarseningHierarchy* hierarchy) {
   ASSERT(context.preprocessing.enable_min_hash_sparsifier);
 
   const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
@@ -225,7 +324,11 @@ inline void Partitioner::preprocess(Hypergraph& hypergraph, Hypergraph& sparse_h
     LOG << "After sparsification:";
     kahypar::io::printHypergraphInfo(sparse_hypergraph, "sparsified hypergraph");
   }
-  preprocess(sparse_hypergraph, context);
+  if (hierarchy != nullptr) {
+    preprocess(sparse_hypergraph, context, *hierarchy);
+  } else {
+    preprocess(sparse_hypergraph, context);
+  }
 }
 
 inline void Partitioner::postprocess(Hypergraph& hypergraph) {
@@ -247,6 +350,21 @@ inline void Partitioner::postprocess(Hypergraph& hypergraph, Hypergraph& sparse_
 }
 
 inline void Partitioner::partition(Hypergraph& hypergraph, Context& context) {
+  CoarseningHierarchy hierarchy;
+  partitionImpl(hypergraph, context, useCoarseningHierarchy(context) ? &hierarchy : nullptr);
+}
+
+inline void Partitioner::partition(Hypergraph& hypergraph, Context& context,
+                                   CoarseningHierarchy& hierarchy) {
+  partitionImpl(hypergraph, context,
+                context.partition.mode == Mode::direct_kway ? &hierarchy : nullptr);
+}
+
+inline void Partitioner::partitionImpl(Hypergraph& hypergraph, Context& context,
+                                       CoarseningHierarchy* stored_hierarchy) {
+  context.partition.start_time = std::chrono::high_resolution_clock::now();
+  _progress_reporter.reset();
+  context.partition.progress_reporter = &_progress_reporter;
   configurePreprocessing(hypergraph, context);
 
   setupContext(hypergraph, context);
@@ -256,13 +374,78 @@ inline void Partitioner::partition(Hypergraph& hypergraph, Context& context) {
 
   if (context.preprocessing.min_hash_sparsifier.is_active) {
     Hypergraph sparseHypergraph;
-    preprocess(hypergraph, sparseHypergraph, context);
-    partition::partition(sparseHypergraph, context);
+    preprocess(hypergraph, sparseHypergraph, context, stored_hierarchy);
+    if (context.partition.progress) {
+      progress::report(context, ProgressPhase::preprocessing, sparseHypergraph.currentNumNodes());
+    }
+    partition::partition(sparseHypergraph, context, stored_hierarchy);
     postprocess(hypergraph, sparseHypergraph, context);
   } else {
-    preprocess(hypergraph, context);
-    partition::partition(hypergraph, context);
+    if (stored_hierarchy != nullptr) {
+      preprocess(hypergraph, context, *stored_hierarchy);
+    } else {
+      preprocess(hypergraph, context);
+    }
+    if (context.partition.progress) {
+      progress::report(context, ProgressPhase::preprocessing, hypergraph.currentNumNodes());
+    }
+    partition::partition(hypergraph, context, stored_hierarchy);
     postprocess(hypergraph);
   }
+  if (context.partition.progress) {
+    progress::report(context, ProgressPhase::finished, hypergraph);
+  }
+  context.partition.progress_reporter = nullptr;
+}
+
+inline void Partitioner::improve(Hypergraph& hypergraph, Context& context) {
+  ASSERT(context.partition.mode == Mode::direct_kway, V(context.partition.mode));
+  ASSERT([&]() {
+        for (const HypernodeID& hn : hypergraph.nodes()) {
+          if (hypergraph.partID(hn) == Hypergraph::kInvalidPartition) {
+            return false;
+          }
+        }
+        return true;
+      } (), "Not all hypernodes are assigned to a block");
+  context.partition.start_time = std::chrono::high_resolution_clock::now();
+  _progress_reporter.reset();
+  context.partition.progress_reporter = &_progress_reporter;
+  configurePreprocessing(hypergraph, context);
+  // The partition is given for the input hypergraph, not for a sparsified one.
+  context.preprocessing.min_hash_sparsifier.is_active = false;
+
+  setupContext(hypergraph, context);
+  io::printInputInformation(context, hypergraph);
+
+  sanitize(hypergraph, context);
+  preprocess(hypergraph, context);
+  if (context.partition.progress) {
+    progress::report(context, ProgressPhase::preprocessing, hypergraph);
+  }
+  direct_kway::improve(hypergraph, context);
+  postprocess(hypergraph);
+  if (context.partition.progress) {
+    progress::report(context, ProgressPhase::finished, hypergraph);
+  }
+  context.partition.progress_reporter = nullptr;
+}
+
+inline void Partitioner::repartition(Hypergraph& hypergraph, Context& context,
+                                     const std::vector<HypernodeID>& changed_hypernodes) {
+  ASSERT(context.partition.mode == Mode::direct_kway, V(context.partition.mode));
+  context.partition.start_time = std::chrono::high_resolution_clock::now();
+  _progress_reporter.reset();
+  context.partition.progress_reporter = &_progress_reporter;
+  setupContext(hypergraph, context);
+  io::printInputInformation(context, hypergraph);
+
+  sanitize(hypergraph, context);
+  repartitioning::repartition(hypergraph, context, changed_hypernodes);
+  postprocess(hypergraph);
+  if (context.partition.progress) {
+    progress::report(context, ProgressPhase::finished, hypergraph);
+  }
+  context.partition.progress_reporter = nullptr;
 }
 }  // namespace kahypar
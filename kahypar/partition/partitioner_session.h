@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/partitioner.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/timer.h"
+
+namespace kahypar {
+// Partitions many hypergraphs one after another, e.g. in a placement loop.
+// Instead of constructing a new hypergraph for each call, the session
+// re-initializes its hypergraph in place, which only allocates memory if the
+// new hypergraph is larger than all previous ones. The partitioner and its
+// pruning buffers are reused as well. Coarseners and refiners are still
+// created per call, but their large arrays, i.e. the heaps of the priority
+// queues and the n * k k-way gain cache, come from the thread-local
+// ScratchBufferPools, just like the temporary buffers of initial
+// partitioning and sparsification.
+class PartitionerSession {
+ public:
+  PartitionerSession() :
+    _hypergraph(),
+    _partitioner() { }
+
+  PartitionerSession(const PartitionerSession&) = delete;
+  PartitionerSession& operator= (const PartitionerSession&) = delete;
+
+  PartitionerSession(PartitionerSession&&) = delete;
+  PartitionerSession& operator= (PartitionerSession&&) = delete;
+
+  ~PartitionerSession() = default;
+
+  // Each thread has its own session, since partitioning is not thread-safe.
+  static PartitionerSession& local() {
+    static thread_local PartitionerSession session;
+    return session;
+  }
+
+  // Replaces the hypergraph of the session. The arrays are only read during
+  // this call (see GenericHypergraph::initialize). Precomputed incident nets,
+  // e.g., of a binary hypergraph file, save the transposition of the pins.
+  Hypergraph& setHypergraph(const HypernodeID num_hypernodes,
+                            const HyperedgeID num_hyperedges,
+                            const size_t* hyperedge_offsets,
+                            const HypernodeID* pins,
+                            const PartitionID k,
+                            const HyperedgeWeight* hyperedge_weights = nullptr,
+                            const HypernodeWeight* hypernode_weights = nullptr,
+                            const size_t* hypernode_offsets = nullptr,
+                            const HyperedgeID* incident_nets = nullptr) {
+    _hypergraph.initialize(num_hypernodes, num_hyperedges, hyperedge_offsets[num_hyperedges],
+                           hyperedge_offsets, pins, k, hyperedge_weights, hypernode_weights,
+                           hypernode_offsets, incident_nets);
+    return _hypergraph;
+  }
+
+  // Partitions the current hypergraph. As for Partitioner::partition, the
+  // k-dependent parameters of the context are set up during the call.
+  // The random number generator and the timer of the calling thread are
+  // reset, so the result only depends on the hypergraph and the context.
+  void partition(Context& context) {
+    Randomize::instance().setSeed(context.partition.seed);
+    Timer::instance().clear();
+    _partitioner.partition(_hypergraph, context);
+  }
+
+  // As above, but shares the coarsening hierarchy with other calls for the
+  // same hypergraph (see Partitioner::partition).
+  void partition(Context& context, CoarseningHierarchy& hierarchy) {
+    Randomize::instance().setSeed(context.partition.seed);
+    Timer::instance().clear();
+    _partitioner.partition(_hypergraph, context, hierarchy);
+  }
+
+  // Improves the partition that the caller assigned to all hypernodes of the
+  // current hypergraph (see Partitioner::improve).
+  void improve(Context& context) {
+    Randomize::instance().setSeed(context.partition.seed);
+    Timer::instance().clear();
+    _partitioner.improve(_hypergraph, context);
+  }
+
+  // Updates the partition that the caller assigned to the current hypergraph
+  // after an edit (see Partitioner::repartition).
+  void repartition(Context& context, const std::vector<HypernodeID>& changed_hypernodes) {
+    Randomize::instance().setSeed(context.partition.seed);
+    Timer::instance().clear();
+    _partitioner.repartition(_hypergraph, context, changed_hypernodes);
+  }
+
+  const Hypergraph& hypergraph() const {
+    return _hypergraph;
+  }
+
+ private:
+  Hypergraph _hypergraph;
+  Partitioner _partitioner;
+};
+}  // namespace kahypar
@@ -28,6 +28,7 @@
 
 #include "kahypar/datastructure/fast_reset_flag_array.h"
 #include "kahypar/datastructure/hash_table.h"
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/utils/hash_vector.h"
 
@@ -115,13 +116,13 @@ class AdaptiveLSHWithConnectedComponents {
                                      clusters, cluster_size,
                                      main_hash_set, hash_num, inactive_clusters);
 
-      std::vector<char> bit_map(clusters.size());
+      auto bit_map = ds::ScratchBufferPool<std::vector<char> >::local().acquire(clusters.size());
       for (const auto& clst : clusters) {
-        bit_map[clst] = 1;
+        (*bit_map)[clst] = 1;
       }
 
       size_t num_cl = 0;
-      for (const auto& bit : bit_map) {
+      for (const auto& bit : *bit_map) {
         if (bit) {
           ++num_cl;
         }
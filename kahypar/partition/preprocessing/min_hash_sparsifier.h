@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "kahypar/datastructure/hash_table.h"
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/partition/preprocessing/adaptive_lsh.h"
 #include "kahypar/partition/preprocessing/policies/min_hash_policy.h"
@@ -129,12 +130,19 @@ class MinHashSparsifier {
     ds::InsertOnlyHashMap<Edge, std::pair<HyperedgeID, HyperedgeWeight>,
                           HashEdge, false> parallel_edges(3 * num_edges);
 
+    HypernodeID max_edge_size = 0;
+    for (const auto& edge_id : hypergraph.edges()) {
+      max_edge_size = std::max(max_edge_size, hypergraph.edgeSize(edge_id));
+    }
+    // reused for all hyperedges to avoid one allocation per hyperedge
+    ds::InsertOnlyHashSet<HypernodeID> new_pins(max_edge_size);
+
     size_t offset = 0;
     size_t removed_edges = 0;
     size_t non_disabled_edge_id = 0;
     for (const auto& edge_id : hypergraph.edges()) {
       auto pins_range = hypergraph.pins(edge_id);
-      ds::InsertOnlyHashSet<HypernodeID> new_pins(pins_range.second - pins_range.first);
+      new_pins.reserve(pins_range.second - pins_range.first);
 
       for (const auto& vertex_id : pins_range) {
         new_pins.insert(_clusters[vertex_id]);
@@ -201,7 +209,9 @@ class MinHashSparsifier {
       return 0;
     }
 
-    std::vector<HypernodeID> new_clusters(_clusters.size());
+    auto new_clusters_buffer =
+      ds::ScratchBufferPool<std::vector<HypernodeID> >::local().acquire(_clusters.size());
+    std::vector<HypernodeID>& new_clusters = *new_clusters_buffer;
 
     for (const auto& clst : _clusters) {
       new_clusters[clst] = 1;
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/metrics.h"
+
+namespace kahypar {
+// Keeps the last report of a run. It is owned by the Partitioner and made
+// available to all phases via Context::partition.progress_reporter.
+class ProgressReporter {
+ public:
+  ProgressReporter() :
+    _last_report() { }
+
+  ProgressReporter(const ProgressReporter&) = delete;
+  ProgressReporter& operator= (const ProgressReporter&) = delete;
+
+  ProgressReporter(ProgressReporter&&) = delete;
+  ProgressReporter& operator= (ProgressReporter&&) = delete;
+
+  ~ProgressReporter() = default;
+
+  void reset() {
+    _last_report = ProgressReport();
+  }
+
+  const ProgressReport& lastReport() const {
+    return _last_report;
+  }
+
+  void report(const Context& context, const ProgressPhase phase,
+              const HypernodeID num_nodes, const Metrics& metrics) {
+    _last_report.phase = phase;
+    _last_report.v_cycle = context.partition.current_v_cycle;
+    _last_report.num_nodes = num_nodes;
+    _last_report.cut = metrics.cut;
+    _last_report.km1 = metrics.km1;
+    _last_report.imbalance = metrics.imbalance;
+    _last_report.elapsed_seconds = context.elapsedSeconds();
+    context.partition.progress(_last_report);
+  }
+
+ private:
+  ProgressReport _last_report;
+};
+
+namespace progress {
+// Only the multilevel cycles of the main context report their phases. Initial
+// partitioning and the bisections of recursive bisection work on other
+// hypergraphs than the one the caller is interested in.
+static inline bool isEnabled(const Context& context) {
+  return context.partition.progress && context.partition.progress_reporter != nullptr &&
+         context.type == ContextType::main && !context.isMainRecursiveBisection();
+}
+
+// Throttles the reports within coarsening and uncoarsening.
+static inline bool isDue(const Context& context) {
+  return isEnabled(context) &&
+         context.elapsedSeconds() -
+         context.partition.progress_reporter->lastReport().elapsed_seconds >=
+         context.partition.progress_interval;
+}
+
+static inline void report(const Context& context, const ProgressPhase phase,
+                          const HypernodeID num_nodes, const Metrics& metrics) {
+  ASSERT(context.partition.progress_reporter != nullptr);
+  context.partition.progress_reporter->report(context, phase, num_nodes, metrics);
+}
+
+// For phases that do not change the partition, e.g., coarsening, which only
+// contracts nodes of the same block.
+static inline void report(const Context& context, const ProgressPhase phase,
+                          const HypernodeID num_nodes) {
+  ASSERT(context.partition.progress_reporter != nullptr);
+  const ProgressReport& last = context.partition.progress_reporter->lastReport();
+  report(context, phase, num_nodes, Metrics { last.cut, last.km1, last.imbalance });
+}
+
+// Evaluates the partition, which takes time linear in the number of pins.
+static inline void report(const Context& context, const ProgressPhase phase,
+                          const Hypergraph& hypergraph) {
+  report(context, phase, hypergraph.currentNumNodes(),
+         Metrics { metrics::hyperedgeCut(hypergraph), metrics::km1(hypergraph),
+                   metrics::imbalance(hypergraph, context) });
+}
+}  // namespace progress
+}  // namespace kahypar
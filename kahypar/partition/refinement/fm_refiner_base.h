@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "kahypar/datastructure/bucket_queue.h"
+#include "kahypar/datastructure/d_ary_heap.h"
 #include "kahypar/datastructure/kway_priority_queue.h"
 #include "kahypar/definitions.h"
 #include "kahypar/partition/context.h"
@@ -67,6 +68,11 @@ class FMRefinerBase {
                                                                          Gain,
                                                                          std::numeric_limits<Gain>
                                                                          > >;
+#elif defined(USE_DARY_HEAP)
+  using KWayRefinementPQ = ds::KWayPriorityQueue<HypernodeID, Gain,
+                                                 std::numeric_limits<Gain>,
+                                                 false,
+                                                 ds::DAryMaxHeap<HypernodeID, Gain, 4> >;
 #else
   using KWayRefinementPQ = ds::KWayPriorityQueue<HypernodeID, Gain,
                                                  std::numeric_limits<Gain> >;
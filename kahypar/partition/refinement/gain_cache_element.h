@@ -26,7 +26,8 @@ namespace kahypar {
 enum class RollbackAction : char {
   do_remove,
   do_add,
-  do_nothing
+  do_nothing,
+  do_update_all_except
 };
 
 struct RollbackElement {
@@ -54,43 +55,27 @@ struct RollbackElement {
 };
 
 // Internal structure for cache entries.
-// For each HN, a cache element contains a flag whether or not
-// the cache entry is active and afterwards the corresponding
-// cache entries. This memory is allocated outside of the structure
-// using a memory arena.
+// For each HN, a cache element stores the parts adjacent to the HN and the
+// corresponding gains. This memory is allocated outside of the structure
+// using a memory arena and consists of three arrays following the header:
+// - the adjacent parts, densely packed in the first _size entries
+// - for each part, the position of the part in the adjacent parts array
+// - the gains, stored at the same positions as the adjacent parts
+// Thus iterating over the adjacent parts and updating their gains only
+// touches the first _size entries of two contiguous arrays.
 template <typename Gain>
 class CacheElement {
  public:
-  struct Element {
-    PartitionID index;
-    Gain gain;
-    Element(const PartitionID idx, const Gain g) :
-      index(idx),
-      gain(g) { }
-
-    Element() :
-      index(kInvalidPart),
-      gain(kNotCached) { }
-
-    friend bool operator== (const Element& lhs, const Element& rhs) {
-      return lhs.index == rhs.index && lhs.gain == rhs.gain;
-    }
-
-    friend bool operator!= (const Element& lhs, const Element& rhs) {
-      return !operator== (lhs, rhs);
-    }
-  };
-
   static constexpr HyperedgeWeight kNotCached = std::numeric_limits<HyperedgeWeight>::max();
   static constexpr PartitionID kInvalidPart = std::numeric_limits<PartitionID>::max();
 
   explicit CacheElement(const PartitionID k) :
     _k(k),
     _size(0) {
-    // static_assert(sizeof(Gain) == sizeof(PartitionID), "Size is not correct");
     for (PartitionID i = 0; i < k; ++i) {
-      new(&_size + i + 1)PartitionID(std::numeric_limits<PartitionID>::max());
-      new(reinterpret_cast<Element*>(&_size + _k + 1) + i)Element();
+      new(dense() + i)PartitionID(kInvalidPart);
+      new(positions() + i)PartitionID(kInvalidPart);
+      new(gains() + i)Gain(kNotCached);
     }
   }
 
@@ -101,115 +86,117 @@ class CacheElement {
 
   ~CacheElement() = default;
 
+  // Size of a cache element including the memory of its arrays
+  static size_t sizeInBytes(const PartitionID k) {
+    return sizeof(CacheElement) + 2 * k * sizeof(PartitionID) + k * sizeof(Gain);
+  }
+
   const PartitionID* begin()  const {
-    return &_size + 1;
+    return dense();
   }
 
   const PartitionID* end() const {
     ASSERT(_size <= _k, V(_size));
-    return &_size + 1 + _size;
+    return dense() + _size;
   }
 
-
   void add(const PartitionID part, const Gain gain) {
     ASSERT(part < _k, V(part));
-    ASSERT((sparse(part).index >= _size || dense(sparse(part).index) != part), V(part));
-    sparse(part).index = _size;
-    sparse(part).gain = gain;
-    dense(_size++) = part;
+    ASSERT(!contains(part), V(part));
+    positions()[part] = _size;
+    dense()[_size] = part;
+    gains()[_size++] = gain;
     ASSERT(_size <= _k, V(_size));
   }
 
-  void addToActiveParts(const PartitionID part) {
-    ASSERT(part < _k, V(part));
-    ASSERT(sparse(part) != Element(), V(part));
-    ASSERT((sparse(part).index >= _size || dense(sparse(part).index) != part), V(part));
-    sparse(part).index = _size;
-    dense(_size++) = part;
-    ASSERT(_size <= _k, V(_size));
-  }
-
-
   void remove(const PartitionID part) {
     ASSERT(part < _k, V(part));
-    const PartitionID index = sparse(part).index;
-    ASSERT(index < _size && dense(index) == part, V(part));
+    const PartitionID index = positions()[part];
+    ASSERT(index < _size && dense()[index] == part, V(part));
     ASSERT(_size > 0, V(_size));
-    const PartitionID e = dense(--_size);
-    ASSERT(_size >= 0, V(_size));
-    dense(index) = e;
-    sparse(e).index = index;
+    const PartitionID last = --_size;
+    const PartitionID e = dense()[last];
+    dense()[index] = e;
+    gains()[index] = gains()[last];
+    positions()[e] = index;
     // This has to be done here in case there is only one element!
-    sparse(part) = Element();
+    positions()[part] = kInvalidPart;
+    dense()[last] = kInvalidPart;
+    gains()[last] = Gain(kNotCached);
   }
 
   Gain gain(const PartitionID part) const {
     ASSERT(part < _k, V(part));
-    return sparse(part).gain;
+    const PartitionID index = positions()[part];
+    return index != kInvalidPart ? gains()[index] : Gain(kNotCached);
   }
 
   void update(const PartitionID part, const Gain delta) {
-    // Since we use these in rollback before adding the corresponding part to dense()
-    // we cannot assert that here.
-    // ASSERT(sparse(part).index < _size && dense(sparse(part).index) == part, V(part));
-    ASSERT(part < _k, V(part));
-    sparse(part).gain += delta;
+    ASSERT(contains(part), V(part));
+    gains()[positions()[part]] += delta;
   }
 
-  void set(const PartitionID part, const Gain gain) {
-    // Since we use these in rollback before adding the corresponding part to dense()
-    // we cannot assert that here.
-    // ASSERT(sparse(part).index < _size && dense(sparse(part).index) == part, V(part));
-    ASSERT(part < _k, V(part));
-    sparse(part).gain = gain;
+  // Adds delta to the gains of all adjacent parts except the given part,
+  // which might also be an invalid part.
+  // Since the gains are stored contiguously, the loop can be vectorized.
+  void updateAllExcept(const PartitionID excluded_part, const Gain delta) {
+    Gain* gain = gains();
+    const PartitionID size = _size;
+    for (PartitionID i = 0; i < size; ++i) {
+      gain[i] += delta;
+    }
+    if (0 <= excluded_part && excluded_part < _k && contains(excluded_part)) {
+      gain[positions()[excluded_part]] -= delta;
+    }
   }
 
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool contains(const PartitionID part) const {
     ASSERT(part < _k, V(part));
     ASSERT([&]() {
-        const PartitionID index = sparse(part).index;
-        if (index < _size && dense(index) == part && gain(part) == Gain(kNotCached)) {
-          LOG << "contained but invalid gain";
-          LOG << V(part);
-          return false;
-        }
-        if ((sparse(part).index >= _size ||
-             dense(sparse(part).index) != part) && gain(part) != Gain(kNotCached)) {
-          LOG << "not contained but gain value present";
+        const PartitionID index = positions()[part];
+        if (index != kInvalidPart && (index >= _size || dense()[index] != part)) {
+          LOG << "position of part is invalid";
           LOG << V(part);
           return false;
         }
         return true;
       } (), "Cache Element Inconsistent");
-    return sparse(part).index != kInvalidPart;
+    return positions()[part] != kInvalidPart;
   }
 
   void clear() {
-    _size = 0;
-    for (PartitionID i = 0; i < _k; ++i) {
-      sparse(i) = Element();
+    for (PartitionID i = 0; i < _size; ++i) {
+      positions()[dense()[i]] = kInvalidPart;
+      dense()[i] = kInvalidPart;
+      gains()[i] = Gain(kNotCached);
     }
+    _size = 0;
   }
 
  private:
-  // To avoid code duplication we implement non-const version in terms of const version
-  PartitionID & dense(const PartitionID part) {
-    return const_cast<PartitionID&>(static_cast<const CacheElement&>(*this).dense(part));
+  // To avoid code duplication we implement non-const versions in terms of const versions
+  PartitionID* dense() {
+    return const_cast<PartitionID*>(static_cast<const CacheElement&>(*this).dense());
   }
 
-  const PartitionID & dense(const PartitionID part) const {
-    ASSERT(part < _k, V(part));
-    return *(&_size + 1 + part);
+  const PartitionID* dense() const {
+    return &_size + 1;
   }
 
-  // To avoid code duplication we implement non-const version in terms of const version
-  Element & sparse(const PartitionID part) {
-    return const_cast<Element&>(static_cast<const CacheElement&>(*this).sparse(part));
+  PartitionID* positions() {
+    return const_cast<PartitionID*>(static_cast<const CacheElement&>(*this).positions());
   }
 
-  const Element & sparse(const PartitionID part) const {
-    ASSERT(part < _k, V(part));
-    return reinterpret_cast<const Element*>(&_size + 1 + _k)[part];
+  const PartitionID* positions() const {
+    return &_size + 1 + _k;
+  }
+
+  Gain* gains() {
+    return const_cast<Gain*>(static_cast<const CacheElement&>(*this).gains());
+  }
+
+  const Gain* gains() const {
+    return reinterpret_cast<const Gain*>(&_size + 1 + 2 * _k);
   }
 
   const PartitionID _k;
@@ -24,6 +24,7 @@
 #include <memory>
 #include <vector>
 
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 #include "kahypar/meta/mandatory.h"
 #include "kahypar/partition/refinement/gain_cache_element.h"
@@ -41,13 +42,14 @@ class KwayGainCache {
  public:
   static constexpr HyperedgeWeight kNotCached = KFMCacheElement::kNotCached;
 
+  // The n * k cache is taken from the scratch buffer pool of the calling thread,
+  // so refiners that are rebuilt in every call reuse its memory.
   KwayGainCache(const HypernodeID num_hns, const PartitionID k) :
     _k(k),
     _num_hns(num_hns),
-    _cache_element_size(sizeof(KFMCacheElement) +
-                        _k * sizeof(typename KFMCacheElement::Element) +
-                        _k * sizeof(PartitionID)),
-    _cache(std::make_unique<Byte[]>(num_hns * _cache_element_size)),
+    _cache_element_size(KFMCacheElement::sizeInBytes(_k)),
+    _cache_buffer(CacheBufferPool::local().acquire(num_hns * _cache_element_size)),
+    _cache(_cache_buffer->data()),
     _deltas() {
     for (HypernodeID hn = 0; hn < _num_hns; ++hn) {
       new(cacheElement(hn))KFMCacheElement(k);
@@ -154,13 +156,27 @@ class KwayGainCache {
     _deltas.emplace_back(hn, part, -delta, RollbackAction::do_nothing);
   }
 
+  // Updates the entries of all parts adjacent to hn except excluded_part.
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void updateExistingEntriesExcept(const HypernodeID hn,
+                                                                   const PartitionID excluded_part,
+                                                                   const Gain delta) {
+    DBGC(hn == hn_to_debug) << "updateExistingEntriesExcept(" << hn << "," << excluded_part
+                            << "," << delta << ")";
+    cacheElement(hn)->updateAllExcept(excluded_part, delta);
+    _deltas.emplace_back(hn, excluded_part, -delta, RollbackAction::do_update_all_except);
+  }
+
 
   void rollbackDelta() {
     for (auto rit = _deltas.crbegin(); rit != _deltas.crend(); ++rit) {
       const HypernodeID hn = rit->hn;
       const PartitionID part = rit->part;
       const Gain delta = rit->delta;
-      if (cacheElement(hn)->contains(part)) {
+      if (rit->action == RollbackAction::do_update_all_except) {
+        // The adjacent parts are the same as at the time of the update,
+        // because all later changes have already been rolled back.
+        cacheElement(hn)->updateAllExcept(part, delta);
+      } else if (cacheElement(hn)->contains(part)) {
         DBGC(hn == hn_to_debug) << "rollback:" << "G[" << hn << "," << part << "]="
                                 << cacheElement(hn)->gain(part) << "+" << delta << "="
                                 << (cacheElement(hn)->gain(part) + delta);
@@ -170,11 +186,10 @@ class KwayGainCache {
           cacheElement(hn)->remove(part);
         }
       } else {
-        DBGC(hn == hn_to_debug) << "rollback: SET" << "set G[" << hn << "," << part << "]=" << delta;
-        cacheElement(hn)->set(part, delta);
-        if (rit->action == RollbackAction::do_add) {
-          cacheElement(hn)->addToActiveParts(part);
-        }
+        DBGC(hn == hn_to_debug) << "rollback: ADD" << "set G[" << hn << "," << part << "]=" << delta;
+        // Only removed entries are not contained when their removal is rolled back.
+        ASSERT(rit->action == RollbackAction::do_add, V(hn) << V(part));
+        cacheElement(hn)->add(part, delta);
       }
     }
     _deltas.clear();
@@ -196,7 +211,7 @@ class KwayGainCache {
 
  private:
   const KFMCacheElement* cacheElement(const HypernodeID hn) const {
-    return reinterpret_cast<KFMCacheElement*>(_cache.get() + hn * _cache_element_size);
+    return reinterpret_cast<KFMCacheElement*>(_cache + hn * _cache_element_size);
   }
 
   // To avoid code duplication we implement non-const version in terms of const version
@@ -206,8 +221,11 @@ class KwayGainCache {
 
   PartitionID _k;
   HypernodeID _num_hns;
+  using CacheBufferPool = ds::ScratchBufferPool<std::vector<Byte> >;
+
   const size_t _cache_element_size;
-  std::unique_ptr<Byte[]> _cache;
+  CacheBufferPool::Handle _cache_buffer;
+  Byte* _cache;
   std::vector<RollbackElement> _deltas;
 };
 
@@ -312,24 +312,24 @@ class KWayKMinusOneRefiner final : public IRefiner,
     const PartitionID source_part = _hg.partID(pin);
     if (source_part == from_part) {
       if (pin_state.two_pins_in_from_part_before) {
-        for (const PartitionID& part : _gain_cache.adjacentParts(pin)) {
-          if (_new_adjacent_part.get(pin) != part) {
-            if (update_pq) {
+        if (update_pq) {
+          for (const PartitionID& part : _gain_cache.adjacentParts(pin)) {
+            if (_new_adjacent_part.get(pin) != part) {
               updatePin(pin, part, he, he_weight);
             }
-            _gain_cache.updateExistingEntry(pin, part, he_weight);
           }
         }
+        _gain_cache.updateExistingEntriesExcept(pin, _new_adjacent_part.get(pin), he_weight);
       }
     } else if (source_part == to_part && pin_state.two_pins_in_to_part_after) {
-      for (const PartitionID& part : _gain_cache.adjacentParts(pin)) {
-        if (_new_adjacent_part.get(pin) != part) {
-          if (update_pq) {
+      if (update_pq) {
+        for (const PartitionID& part : _gain_cache.adjacentParts(pin)) {
+          if (_new_adjacent_part.get(pin) != part) {
             updatePin(pin, part, he, -he_weight);
           }
-          _gain_cache.updateExistingEntry(pin, part, -he_weight);
         }
       }
+      _gain_cache.updateExistingEntriesExcept(pin, _new_adjacent_part.get(pin), -he_weight);
     }
 
     if (pin_state.one_pin_in_from_part_before && _gain_cache.entryExists(pin, from_part)) {
@@ -601,18 +601,11 @@ class KWayKMinusOneRefiner final : public IRefiner,
       ASSERT(!_gain_cache.entryExists(moved_hn, from_part), V(moved_hn) << V(from_part));
       moved_hn_remains_conntected_to_from_part |= pins_in_source_part_after != 0;
 
+      // from_part is not contained in the adjacent parts of moved_hn (see assertion above)
       if (pins_in_source_part_after == 0 && _hg.pinCountInPart(he, to_part) != 1) {
-        for (const PartitionID& part : _gain_cache.adjacentParts(moved_hn)) {
-          if (part != from_part && part != to_part) {
-            _gain_cache.updateExistingEntry(moved_hn, part, -_hg.edgeWeight(he));
-          }
-        }
+        _gain_cache.updateExistingEntriesExcept(moved_hn, to_part, -_hg.edgeWeight(he));
       } else if (pins_in_source_part_after != 0 && _hg.pinCountInPart(he, to_part) == 1) {
-        for (const PartitionID& part : _gain_cache.adjacentParts(moved_hn)) {
-          if (part != from_part && part != to_part) {
-            _gain_cache.updateExistingEntry(moved_hn, part, _hg.edgeWeight(he));
-          }
-        }
+        _gain_cache.updateExistingEntriesExcept(moved_hn, to_part, _hg.edgeWeight(he));
       }
 
       if (fromAndToPartAreUnremovable(he, from_part, to_part)) {
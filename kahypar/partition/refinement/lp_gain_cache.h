@@ -226,7 +226,7 @@ class LPGainCache {
   }
 
   size_t sizeOfCacheElement() const {
-    return sizeof(LPCacheElement) + _k * sizeof(LPCacheElement::Element) + _k * sizeof(PartitionID);
+    return LPCacheElement::sizeInBytes(_k);
   }
 
   PartitionID _k;
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/definitions.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/factories.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/uncontraction_gain_changes.h"
+
+namespace kahypar {
+namespace repartitioning {
+static constexpr bool debug = false;
+
+// Assigns each unassigned hypernode to the block that already contains pins
+// of the heaviest incident hyperedges, i.e., to the block that increases the
+// objective least. Blocks that would become overloaded are only chosen if
+// the hypernode fits into none of the blocks, in which case it is assigned
+// to the lightest one.
+static inline void assignNewHypernodes(Hypergraph& hypergraph, const Context& context,
+                                       const std::vector<HypernodeID>& new_hypernodes) {
+  std::vector<HyperedgeWeight> connection(context.partition.k, 0);
+  for (const HypernodeID& hn : new_hypernodes) {
+    ASSERT(hypergraph.partID(hn) == Hypergraph::kInvalidPartition, V(hn));
+    std::fill(connection.begin(), connection.end(), 0);
+    for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+      for (const PartitionID& part : hypergraph.connectivitySet(he)) {
+        connection[part] += hypergraph.edgeWeight(he);
+      }
+    }
+
+    PartitionID best_part = Hypergraph::kInvalidPartition;
+    PartitionID lightest_part = 0;
+    for (PartitionID part = 0; part < context.partition.k; ++part) {
+      if (hypergraph.partWeight(part) < hypergraph.partWeight(lightest_part)) {
+        lightest_part = part;
+      }
+      if (hypergraph.partWeight(part) + hypergraph.nodeWeight(hn) >
+          context.partition.max_part_weights[0]) {
+        continue;
+      }
+      if (best_part == Hypergraph::kInvalidPartition ||
+          connection[part] > connection[best_part] ||
+          (connection[part] == connection[best_part] &&
+           hypergraph.partWeight(part) < hypergraph.partWeight(best_part))) {
+        best_part = part;
+      }
+    }
+    hypergraph.setNodePart(hn, best_part != Hypergraph::kInvalidPartition ?
+                           best_part : lightest_part);
+    DBG << V(hn) << V(hypergraph.partID(hn));
+  }
+}
+
+// Runs local search that starts at the given hypernodes. As during
+// uncoarsening, the search only spreads to the neighbors of moved hypernodes.
+// Therefore, the work depends on the size of the changed region rather than
+// on the size of the hypergraph. Moves that reduce an infeasible imbalance
+// are accepted as improvements, which restores the balance if the edit
+// overloaded a block.
+static inline void refine(Hypergraph& hypergraph, const Context& context,
+                          std::vector<HypernodeID>& refinement_nodes) {
+  std::unique_ptr<IRefiner> refiner(
+    RefinerFactory::getInstance().createObject(
+      context.local_search.algorithm, hypergraph, context));
+#ifdef USE_BUCKET_QUEUE
+  HyperedgeID max_degree = 0;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    max_degree = std::max(max_degree, hypergraph.nodeDegree(hn));
+  }
+  HyperedgeWeight max_he_weight = 0;
+  for (const HyperedgeID& he : hypergraph.edges()) {
+    max_he_weight = std::max(max_he_weight, hypergraph.edgeWeight(he));
+  }
+  refiner->initialize(static_cast<HyperedgeWeight>(max_degree * max_he_weight));
+#else
+  refiner->initialize(0);
+#endif
+
+  Metrics current_metrics = { metrics::hyperedgeCut(hypergraph),
+                              metrics::km1(hypergraph),
+                              metrics::imbalance(hypergraph, context) };
+  DBG << "before local search:" << V(current_metrics.km1) << V(current_metrics.imbalance);
+
+  UncontractionGainChanges changes;
+  changes.representative.push_back(0);
+  changes.contraction_partner.push_back(0);
+
+  const HypernodeWeight max_hn_weight = hypergraph.weightOfHeaviestNode();
+  bool improvement_found = true;
+  for (int iteration = 0; iteration < context.local_search.iterations_per_level &&
+       improvement_found && !context.timeBudgetExhausted(); ++iteration) {
+    improvement_found = refiner->refine(refinement_nodes,
+                                        { context.partition.max_part_weights[0] + max_hn_weight,
+                                          context.partition.max_part_weights[1] + max_hn_weight },
+                                        changes, current_metrics);
+  }
+  DBG << "after local search:" << V(current_metrics.km1) << V(current_metrics.imbalance);
+}
+
+// Updates a partition after an edit of the hypergraph. All hypernodes that
+// are unassigned are considered new and are assigned greedily. Local search
+// then starts at the new hypernodes and at the changed hypernodes, i.e., at
+// the pins of added, removed or modified hyperedges and at hypernodes whose
+// weight changed.
+static inline void repartition(Hypergraph& hypergraph, const Context& context,
+                               const std::vector<HypernodeID>& changed_hypernodes) {
+  std::vector<HypernodeID> new_hypernodes;
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    if (hypergraph.partID(hn) == Hypergraph::kInvalidPartition) {
+      new_hypernodes.push_back(hn);
+    }
+  }
+  assignNewHypernodes(hypergraph, context, new_hypernodes);
+  hypergraph.initializeNumCutHyperedges();
+
+  // Each hypernode may only be activated once.
+  ds::FastResetFlagArray<> contained(hypergraph.initialNumNodes());
+  std::vector<HypernodeID> refinement_nodes;
+  const auto add_refinement_nodes = [&](const std::vector<HypernodeID>& hypernodes) {
+                                      for (const HypernodeID& hn : hypernodes) {
+                                        if (hypergraph.nodeIsEnabled(hn) && !contained[hn]) {
+                                          contained.set(hn, true);
+                                          refinement_nodes.push_back(hn);
+                                        }
+                                      }
+                                    };
+  add_refinement_nodes(new_hypernodes);
+  add_refinement_nodes(changed_hypernodes);
+  if (!refinement_nodes.empty()) {
+    refine(hypergraph, context, refinement_nodes);
+  }
+}
+}  // namespace repartitioning
+}  // namespace kahypar
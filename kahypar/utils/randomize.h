@@ -24,6 +24,8 @@
 #include <ctime>
 #include <limits>
 #include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
 namespace kahypar {
@@ -34,8 +36,12 @@ class Randomize {
   Randomize& operator= (const Randomize&) = delete;
   Randomize& operator= (Randomize&&) = delete;
 
+  // Each thread has its own generator, so that partitions computed
+  // concurrently on different threads neither interfere with each other
+  // nor depend on the interleaving of the threads. The seed therefore has
+  // to be set on the thread that runs the partitioner.
   static Randomize & instance() {
-    static Randomize instance;
+    static thread_local Randomize instance;
     return instance;
   }
 
@@ -47,9 +53,16 @@ class Randomize {
     return _int_dist(_gen);
   }
 
+  // Distributions may cache values of the previous seed (e.g. the second
+  // value of each pair generated by the normal distribution), so they are
+  // reset as well. Otherwise, a partition would depend on the previous one.
   void setSeed(int seed) {
     _seed = seed;
     _gen.seed(_seed);
+    _bool_dist.reset();
+    _int_dist.reset();
+    _float_dist.reset();
+    _norm_dist.reset();
   }
 
   template <typename T>
@@ -76,6 +89,28 @@ class Randomize {
     return _norm_dist(_gen, std::normal_distribution<float>::param_type(mean, std_dev));
   }
 
+  // Textual representation of the generator state, which allows to continue
+  // a run with exactly the same random decisions via setState().
+  std::string state() const {
+    std::ostringstream state;
+    state << _seed << ' ' << _gen << ' ' << _norm_dist;
+    return state.str();
+  }
+
+  bool setState(const std::string& state) {
+    std::istringstream stream(state);
+    int seed = -1;
+    std::mt19937 gen;
+    std::normal_distribution<float> norm_dist;
+    if (!(stream >> seed >> gen >> norm_dist)) {
+      return false;
+    }
+    _seed = seed;
+    _gen = gen;
+    _norm_dist = norm_dist;
+    return true;
+  }
+
  private:
   Randomize() :
     _seed(-1),
@@ -105,13 +105,16 @@ class Timer {
     _timings.emplace_back(context, timepoint, time);
   }
 
+  // Timings are collected per thread, like the random number generator.
   static Timer & instance() {
-    static Timer instance;
+    static thread_local Timer instance;
     return instance;
   }
 
   void clear() {
     _timings.clear();
+    _result = Result();
+    _evaluated = false;
   }
 
 
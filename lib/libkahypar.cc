@@ -0,0 +1,394 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "include/libkahypar.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/application/command_line_options.h"
+#include "kahypar/definitions.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/partitioner_session.h"
+#include "lib/presets.h"
+
+namespace kahypar {
+namespace lib {
+// A context is only usable after an .ini preset was read into it.
+struct LibraryContext {
+  Context context { };
+  bool configured = false;
+};
+
+static inline LibraryContext* libraryContext(kahypar_context_t* kahypar_context) {
+  return reinterpret_cast<LibraryContext*>(kahypar_context);
+}
+
+static inline const LibraryContext* libraryContext(const kahypar_context_t* kahypar_context) {
+  return reinterpret_cast<const LibraryContext*>(kahypar_context);
+}
+
+// Checks the CSR representation, since the hypergraph itself only asserts
+// its invariants in debug builds.
+static inline bool isValidHypergraph(const HypernodeID num_vertices,
+                                     const HyperedgeID num_hyperedges,
+                                     const size_t* hyperedge_indices,
+                                     const HypernodeID* hyperedges) {
+  if (hyperedge_indices == nullptr || (hyperedges == nullptr && num_hyperedges > 0) ||
+      hyperedge_indices[0] != 0) {
+    return false;
+  }
+  for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+    if (hyperedge_indices[he + 1] <= hyperedge_indices[he]) {
+      return false;
+    }
+    for (size_t i = hyperedge_indices[he]; i < hyperedge_indices[he + 1]; ++i) {
+      if (hyperedges[i] >= num_vertices) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Unlike the command line application, the library must neither exit nor
+// prompt, so invalid contexts are rejected instead of passed to sanityCheck.
+static inline bool configureCall(Context& context, const PartitionID num_blocks,
+                                 const double epsilon) {
+  context.partition.k = num_blocks;
+  context.partition.rb_lower_k = 0;
+  context.partition.rb_upper_k = 0;
+  context.partition.epsilon = epsilon;
+  std::string error;
+  if (!isValidContext(context, error)) {
+    std::cerr << "Error: " << error << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static inline void writeResult(const Hypergraph& hypergraph, const Context& context,
+                               HyperedgeWeight* objective, PartitionID* partition) {
+  *objective = context.partition.objective == Objective::km1 ?
+               metrics::km1(hypergraph) : metrics::hyperedgeCut(hypergraph);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    partition[hn] = hypergraph.partID(hn);
+  }
+}
+
+static inline kahypar_status_t partition(const HypernodeID num_vertices,
+                                         const HyperedgeID num_hyperedges,
+                                         const double epsilon,
+                                         const PartitionID num_blocks,
+                                         const HypernodeWeight* vertex_weights,
+                                         const HyperedgeWeight* hyperedge_weights,
+                                         const size_t* hyperedge_indices,
+                                         const HypernodeID* hyperedges,
+                                         HyperedgeWeight* objective,
+                                         const Context& configured_context,
+                                         PartitionID* partition) {
+  if (num_blocks < 2 || epsilon < 0 || num_vertices < static_cast<HypernodeID>(num_blocks) ||
+      partition == nullptr || objective == nullptr) {
+    return KAHYPAR_INVALID_ARGUMENT;
+  }
+  if (!isValidHypergraph(num_vertices, num_hyperedges, hyperedge_indices, hyperedges)) {
+    return KAHYPAR_INVALID_HYPERGRAPH;
+  }
+
+  // The partitioner stores k-dependent parameters in the context,
+  // so each call works on its own copy.
+  Context context(configured_context);
+  if (!configureCall(context, num_blocks, epsilon)) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+
+  // Repeated calls of the same thread reuse the memory of the previous call.
+  PartitionerSession& session = PartitionerSession::local();
+  const Hypergraph& hypergraph = session.setHypergraph(num_vertices, num_hyperedges,
+                                                       hyperedge_indices, hyperedges, num_blocks,
+                                                       hyperedge_weights, vertex_weights);
+  session.partition(context);
+  writeResult(hypergraph, context, objective, partition);
+  return KAHYPAR_OK;
+}
+
+static inline kahypar_status_t repartition(const HypernodeID num_vertices,
+                                           const HyperedgeID num_hyperedges,
+                                           const double epsilon,
+                                           const PartitionID num_blocks,
+                                           const HypernodeWeight* vertex_weights,
+                                           const HyperedgeWeight* hyperedge_weights,
+                                           const size_t* hyperedge_indices,
+                                           const HypernodeID* hyperedges,
+                                           const size_t num_changed_vertices,
+                                           const HypernodeID* changed_vertices,
+                                           HyperedgeWeight* objective,
+                                           const Context& configured_context,
+                                           PartitionID* partition) {
+  if (configured_context.partition.mode != Mode::direct_kway) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  if (num_blocks < 2 || epsilon < 0 || num_vertices < static_cast<HypernodeID>(num_blocks) ||
+      partition == nullptr || objective == nullptr ||
+      (changed_vertices == nullptr && num_changed_vertices > 0)) {
+    return KAHYPAR_INVALID_ARGUMENT;
+  }
+  for (HypernodeID hn = 0; hn < num_vertices; ++hn) {
+    if (partition[hn] < -1 || partition[hn] >= num_blocks) {
+      return KAHYPAR_INVALID_ARGUMENT;
+    }
+  }
+  for (size_t i = 0; i < num_changed_vertices; ++i) {
+    if (changed_vertices[i] >= num_vertices) {
+      return KAHYPAR_INVALID_ARGUMENT;
+    }
+  }
+  if (!isValidHypergraph(num_vertices, num_hyperedges, hyperedge_indices, hyperedges)) {
+    return KAHYPAR_INVALID_HYPERGRAPH;
+  }
+
+  Context context(configured_context);
+  if (!configureCall(context, num_blocks, epsilon)) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+
+  PartitionerSession& session = PartitionerSession::local();
+  Hypergraph& hypergraph = session.setHypergraph(num_vertices, num_hyperedges,
+                                                 hyperedge_indices, hyperedges, num_blocks,
+                                                 hyperedge_weights, vertex_weights);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    if (partition[hn] != -1) {
+      hypergraph.setNodePart(hn, partition[hn]);
+    }
+  }
+  session.repartition(context, std::vector<HypernodeID>(changed_vertices,
+                                                        changed_vertices + num_changed_vertices));
+  writeResult(hypergraph, context, objective, partition);
+  return KAHYPAR_OK;
+}
+
+// Runs a cut-minimizing preset on hMetis-style input.
+static inline void partitionHMetis(const char* preset, const int nvtxs, const int nhedges,
+                                   const int* vwgts, const int* eptr, const int* eind,
+                                   const int* hewgts, const int nparts, const double epsilon,
+                                   const int* options, int* part, int* edgecut) {
+  *edgecut = -1;
+  if (options != nullptr && options[0] != 0 && options[6] != 0) {
+    std::cerr << "Error: fixed vertices are not supported" << std::endl;
+    return;
+  }
+  if (nvtxs < 0 || nhedges < 0 || eptr == nullptr) {
+    std::cerr << "Error: invalid hypergraph" << std::endl;
+    return;
+  }
+
+  LibraryContext library_context;
+  std::istringstream ini(preset);
+  parseIniToContext(library_context.context, ini);
+  library_context.context.partition.objective = Objective::cut;
+  if (library_context.context.partition.mode == Mode::direct_kway) {
+    // The direct k-way preset optimizes km1, whose refiner does not minimize the cut.
+    library_context.context.local_search.algorithm = RefinementAlgorithm::kway_fm;
+  }
+  library_context.context.partition.quiet_mode = true;
+  if (options != nullptr && options[0] != 0) {
+    library_context.context.partition.seed = options[7];
+  }
+
+  std::vector<size_t> hyperedge_indices(eptr, eptr + nhedges + 1);
+  std::vector<HypernodeID> hyperedges(eind, eind + eptr[nhedges]);
+  std::vector<HypernodeWeight> vertex_weights;
+  if (vwgts != nullptr) {
+    vertex_weights.assign(vwgts, vwgts + nvtxs);
+  }
+
+  HyperedgeWeight cut = 0;
+  const kahypar_status_t status = partition(nvtxs, nhedges, epsilon, nparts,
+                                            vwgts != nullptr ? vertex_weights.data() : nullptr,
+                                            hewgts, hyperedge_indices.data(),
+                                            hyperedges.data(), &cut, library_context.context,
+                                            part);
+  if (status != KAHYPAR_OK) {
+    std::cerr << "Error: invalid hypergraph or partitioning parameters" << std::endl;
+    return;
+  }
+  *edgecut = cut;
+}
+}  // namespace lib
+}  // namespace kahypar
+
+kahypar_context_t* kahypar_context_new() {
+  kahypar::lib::LibraryContext* library_context = new kahypar::lib::LibraryContext();
+  library_context->context.partition.quiet_mode = true;
+  return reinterpret_cast<kahypar_context_t*>(library_context);
+}
+
+void kahypar_context_free(kahypar_context_t* kahypar_context) {
+  delete kahypar::lib::libraryContext(kahypar_context);
+}
+
+kahypar_status_t kahypar_configure_context_from_file(kahypar_context_t* kahypar_context,
+                                                     const char* ini_file_name) {
+  if (kahypar_context == nullptr || ini_file_name == nullptr) {
+    return KAHYPAR_INVALID_ARGUMENT;
+  }
+  std::ifstream ini(ini_file_name);
+  if (!ini) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  kahypar::lib::LibraryContext& library_context = *kahypar::lib::libraryContext(kahypar_context);
+  library_context.configured = false;
+  try {
+    kahypar::parseIniToContext(library_context.context, ini);
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  // k is only known when partitioning, so k-dependent checks are repeated then.
+  kahypar::Context k_independent(library_context.context);
+  k_independent.partition.k = 2;
+  std::string error;
+  if (!kahypar::isValidContext(k_independent, error)) {
+    std::cerr << "Error: " << error << std::endl;
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  library_context.configured = true;
+  return KAHYPAR_OK;
+}
+
+void kahypar_set_seed(kahypar_context_t* kahypar_context, const int seed) {
+  kahypar::lib::libraryContext(kahypar_context)->context.partition.seed = seed;
+}
+
+void kahypar_set_quiet(kahypar_context_t* kahypar_context, const int quiet) {
+  kahypar::lib::libraryContext(kahypar_context)->context.partition.quiet_mode = quiet != 0;
+}
+
+void kahypar_set_time_limit(kahypar_context_t* kahypar_context, const double seconds) {
+  kahypar::lib::libraryContext(kahypar_context)->context.partition.time_limit = seconds;
+}
+
+void kahypar_set_cancel_callback(kahypar_context_t* kahypar_context,
+                                 kahypar_cancel_callback_t callback, void* data) {
+  std::function<bool()>& cancel =
+    kahypar::lib::libraryContext(kahypar_context)->context.partition.cancel;
+  if (callback == nullptr) {
+    cancel = nullptr;
+  } else {
+    cancel = [callback, data]() {
+               return callback(data) != 0;
+             };
+  }
+}
+
+static_assert(static_cast<int>(kahypar::ProgressPhase::finished) == KAHYPAR_PHASE_FINISHED,
+              "kahypar_phase_t has to match kahypar::ProgressPhase");
+
+void kahypar_set_progress_callback(kahypar_context_t* kahypar_context,
+                                   kahypar_progress_callback_t callback, const double interval,
+                                   void* data) {
+  kahypar::PartitioningParameters& params =
+    kahypar::lib::libraryContext(kahypar_context)->context.partition;
+  params.progress_interval = interval;
+  if (callback == nullptr) {
+    params.progress = nullptr;
+  } else {
+    params.progress = [callback, data](const kahypar::ProgressReport& report) {
+                        const kahypar_progress_t progress {
+                          static_cast<kahypar_phase_t>(report.phase), report.v_cycle,
+                          report.num_nodes, report.cut, report.km1, report.imbalance,
+                          report.elapsed_seconds
+                        };
+                        callback(&progress, data);
+                      };
+  }
+}
+
+kahypar_status_t kahypar_partition(const kahypar_hypernode_id_t num_vertices,
+                                   const kahypar_hyperedge_id_t num_hyperedges,
+                                   const double epsilon,
+                                   const kahypar_partition_id_t num_blocks,
+                                   const kahypar_hypernode_weight_t* vertex_weights,
+                                   const kahypar_hyperedge_weight_t* hyperedge_weights,
+                                   const size_t* hyperedge_indices,
+                                   const kahypar_hyperedge_id_t* hyperedges,
+                                   kahypar_hyperedge_weight_t* objective,
+                                   const kahypar_context_t* kahypar_context,
+                                   kahypar_partition_id_t* partition) {
+  if (kahypar_context == nullptr || !kahypar::lib::libraryContext(kahypar_context)->configured) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  return kahypar::lib::partition(num_vertices, num_hyperedges, epsilon, num_blocks,
+                                 vertex_weights, hyperedge_weights, hyperedge_indices,
+                                 hyperedges, objective,
+                                 kahypar::lib::libraryContext(kahypar_context)->context,
+                                 partition);
+}
+
+kahypar_status_t kahypar_repartition(const kahypar_hypernode_id_t num_vertices,
+                                     const kahypar_hyperedge_id_t num_hyperedges,
+                                     const double epsilon,
+                                     const kahypar_partition_id_t num_blocks,
+                                     const kahypar_hypernode_weight_t* vertex_weights,
+                                     const kahypar_hyperedge_weight_t* hyperedge_weights,
+                                     const size_t* hyperedge_indices,
+                                     const kahypar_hyperedge_id_t* hyperedges,
+                                     const size_t num_changed_vertices,
+                                     const kahypar_hypernode_id_t* changed_vertices,
+                                     kahypar_hyperedge_weight_t* objective,
+                                     const kahypar_context_t* kahypar_context,
+                                     kahypar_partition_id_t* partition) {
+  if (kahypar_context == nullptr || !kahypar::lib::libraryContext(kahypar_context)->configured) {
+    return KAHYPAR_INVALID_CONTEXT;
+  }
+  return kahypar::lib::repartition(num_vertices, num_hyperedges, epsilon, num_blocks,
+                                   vertex_weights, hyperedge_weights, hyperedge_indices,
+                                   hyperedges, num_changed_vertices, changed_vertices, objective,
+                                   kahypar::lib::libraryContext(kahypar_context)->context,
+                                   partition);
+}
+
+void HMETIS_PartRecursive(int nvtxs, int nhedges, int* vwgts, int* eptr, int* eind,
+                          int* hewgts, int nparts, int ubfactor, int* options,
+                          int* part, int* edgecut) {
+  // Each of the ceil(log2(nparts)) bisections may assign (50 + ubfactor)%
+  // of the weight to one side.
+  const double epsilon = nparts * std::pow((50.0 + ubfactor) / 100.0,
+                                           std::ceil(std::log2(std::max(nparts, 2)))) - 1.0;
+  kahypar::lib::partitionHMetis(kahypar::lib::kRecursiveBisectionPreset, nvtxs, nhedges, vwgts,
+                                eptr, eind, hewgts, nparts, std::max(epsilon, 0.0), options,
+                                part, edgecut);
+}
+
+void HMETIS_PartKway(int nvtxs, int nhedges, int* vwgts, int* eptr, int* eind,
+                     int* hewgts, int nparts, int ubfactor, int* options,
+                     int* part, int* edgecut) {
+  kahypar::lib::partitionHMetis(kahypar::lib::kDirectKwayPreset, nvtxs, nhedges, vwgts,
+                                eptr, eind, hewgts, nparts, ubfactor / 100.0, options,
+                                part, edgecut);
+}
@@ -20,7 +20,14 @@
 
 #include "gmock/gmock.h"
 
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+
 #include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/d_ary_heap.h"
+#include "kahypar/datastructure/scratch_buffer_pool.h"
 #include "kahypar/definitions.h"
 
 using ::testing::Test;
@@ -29,6 +36,10 @@ namespace kahypar {
 namespace ds {
 using MaxHeapType = BinaryMaxHeap<HypernodeID, HyperedgeWeight>;
 using MinHeapType = BinaryMinHeap<HypernodeID, HyperedgeWeight>;
+using FourAryMaxHeapType = DAryMaxHeap<HypernodeID, HyperedgeWeight, 4>;
+using FourAryMinHeapType = DAryMinHeap<HypernodeID, HyperedgeWeight, 4>;
+using EightAryMaxHeapType = DAryMaxHeap<HypernodeID, HyperedgeWeight, 8>;
+using EightAryMinHeapType = DAryMinHeap<HypernodeID, RatingType, 8>;
 
 template <typename T>
 class AHeap : public Test {
@@ -56,7 +67,9 @@ class AMinHeap : public Test {
   MinHeapType _heap;
 };
 
-typedef ::testing::Types<MaxHeapType, MinHeapType> Implementations;
+typedef ::testing::Types<MaxHeapType, MinHeapType,
+                         FourAryMaxHeapType, FourAryMinHeapType,
+                         EightAryMaxHeapType, EightAryMinHeapType> Implementations;
 
 TYPED_TEST_CASE(AHeap, Implementations);
 
@@ -74,6 +87,59 @@ TYPED_TEST(AHeap, HasSizeOneAfterOneInsertion) {
   ASSERT_EQ(this->_heap.size(), 1);
 }
 
+TYPED_TEST(AHeap, DoesNotContainElementsAfterRemoval) {
+  this->_heap.push(0, 1);
+  this->_heap.push(1, 2);
+  this->_heap.push(2, 3);
+  this->_heap.remove(1);
+  ASSERT_EQ(this->_heap.contains(0), true);
+  ASSERT_EQ(this->_heap.contains(1), false);
+  ASSERT_EQ(this->_heap.contains(2), true);
+  ASSERT_EQ(this->_heap.size(), 2);
+}
+
+TYPED_TEST(AHeap, MaintainsHeapOrderOnRandomOperationSequence) {
+  using KeyType = typename std::decay<decltype(this->_heap.topKey())>::type;
+  using Comparator = typename BinaryHeapTraits<TypeParam>::Comparator;
+  Comparator compare;
+  std::map<HypernodeID, KeyType> contained;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> node_dist(0, 19);
+  std::uniform_int_distribution<int> key_dist(-10, 10);
+  for (int i = 0; i < 5000; ++i) {
+    const HypernodeID hn = node_dist(gen);
+    const KeyType key = key_dist(gen);
+    if (contained.find(hn) == contained.end()) {
+      this->_heap.push(hn, key);
+      contained[hn] = key;
+    } else if (key > 5) {
+      this->_heap.remove(hn);
+      contained.erase(hn);
+    } else if (key < -5) {
+      const HypernodeID top = this->_heap.top();
+      this->_heap.pop();
+      contained.erase(top);
+    } else {
+      this->_heap.updateKey(hn, key);
+      contained[hn] = key;
+    }
+
+    ASSERT_EQ(this->_heap.size(), contained.size());
+    if (!contained.empty()) {
+      const auto best = std::max_element(contained.begin(), contained.end(),
+                                         [&compare](const std::pair<HypernodeID, KeyType>& a,
+                                                    const std::pair<HypernodeID, KeyType>& b) {
+          return compare(a.second, b.second);
+        });
+      ASSERT_EQ(this->_heap.topKey(), best->second);
+      ASSERT_EQ(this->_heap.getKey(this->_heap.top()), best->second);
+    }
+    for (HypernodeID id = 0; id < 20; ++id) {
+      ASSERT_EQ(this->_heap.contains(id), contained.find(id) != contained.end());
+    }
+  }
+}
+
 // Max Heap tests
 
 TEST_F(AMaxHeap, ReturnsTheMaximumElement) {
@@ -401,6 +467,28 @@ TEST_F(AMinHeap, HandlesManySameKeys) {
   ASSERT_EQ(this->_heap.getKey(7), 0);
 }
 
+TYPED_TEST(AHeap, ReusesTheMemoryOfADestroyedHeap) {
+  using HeapType = typename TestFixture::HeapType;
+  {
+    HeapType heap(20);
+    heap.push(3, 42);
+    heap.push(7, 23);
+  }
+  const size_t allocations = scratchBufferPoolStats().allocations;
+  const size_t reuses = scratchBufferPoolStats().reuses;
+
+  HeapType heap(20);
+  ASSERT_EQ(scratchBufferPoolStats().allocations, allocations);
+  ASSERT_GT(scratchBufferPoolStats().reuses, reuses);
+  ASSERT_TRUE(heap.empty());
+  ASSERT_FALSE(heap.contains(3));
+  ASSERT_FALSE(heap.contains(7));
+
+  heap.push(7, 5);
+  ASSERT_EQ(heap.top(), 7);
+  ASSERT_EQ(heap.getKey(7), 5);
+}
+
 TEST_F(AMinHeap, IsSwappable) {
   std::vector<MinHeapType> _pqs;
 
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "kahypar/datastructure/hash_table.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+// All keys end up in the same home position.
+struct CollidingHash {
+  size_t operator() (const HypernodeID&) const {
+    return 7;
+  }
+};
+
+template <typename T>
+class AHashSet : public Test {
+ public:
+  AHashSet() :
+    set(100) { }
+
+  T set;
+};
+
+typedef ::testing::Types<HashSet<HypernodeID>,
+                         InsertOnlyHashSet<HypernodeID>,
+                         HashSet<HypernodeID, CollidingHash>,
+                         InsertOnlyHashSet<HypernodeID, CollidingHash, false> > SetImplementations;
+
+TYPED_TEST_CASE(AHashSet, SetImplementations);
+
+TYPED_TEST(AHashSet, IsEmptyWhenCreated) {
+  ASSERT_THAT(this->set.empty(), Eq(true));
+}
+
+TYPED_TEST(AHashSet, ContainsInsertedElements) {
+  this->set.insert(5);
+  this->set.insert(42);
+  ASSERT_THAT(this->set.contains(5), Eq(true));
+  ASSERT_THAT(this->set.contains(42), Eq(true));
+  ASSERT_THAT(this->set.contains(6), Eq(false));
+  ASSERT_THAT(this->set.size(), Eq(2));
+}
+
+TYPED_TEST(AHashSet, IgnoresDuplicateInsertions) {
+  this->set.insert(5);
+  this->set.insert(5);
+  ASSERT_THAT(this->set.size(), Eq(1));
+}
+
+TYPED_TEST(AHashSet, CanStoreAllKeyValues) {
+  this->set.insert(std::numeric_limits<HypernodeID>::max());
+  this->set.insert(std::numeric_limits<HypernodeID>::max() - 1);
+  this->set.insert(0);
+  ASSERT_THAT(this->set.contains(std::numeric_limits<HypernodeID>::max()), Eq(true));
+  ASSERT_THAT(this->set.contains(std::numeric_limits<HypernodeID>::max() - 1), Eq(true));
+  ASSERT_THAT(this->set.contains(0), Eq(true));
+  ASSERT_THAT(this->set.size(), Eq(3));
+}
+
+TYPED_TEST(AHashSet, IteratesInInsertionOrder) {
+  this->set.insert(23);
+  this->set.insert(3);
+  this->set.insert(12);
+  std::vector<HypernodeID> elements;
+  for (const HypernodeID element : this->set) {
+    elements.push_back(element);
+  }
+  ASSERT_THAT(elements, ElementsAre(23, 3, 12));
+}
+
+TYPED_TEST(AHashSet, IsEmptyAfterClear) {
+  for (HypernodeID i = 0; i < 100; ++i) {
+    this->set.insert(i);
+  }
+  this->set.clear();
+  ASSERT_THAT(this->set.empty(), Eq(true));
+  for (HypernodeID i = 0; i < 100; ++i) {
+    ASSERT_THAT(this->set.contains(i), Eq(false));
+  }
+}
+
+TYPED_TEST(AHashSet, CanBeReusedForSetsOfDifferentSizes) {
+  this->set.reserve(2);
+  this->set.insert(1);
+  this->set.insert(2);
+  this->set.reserve(500);
+  ASSERT_THAT(this->set.empty(), Eq(true));
+  for (HypernodeID i = 0; i < 500; ++i) {
+    this->set.insert(3 * i);
+  }
+  ASSERT_THAT(this->set.size(), Eq(500));
+  this->set.reserve(3);
+  this->set.insert(1);
+  ASSERT_THAT(this->set.contains(1), Eq(true));
+  ASSERT_THAT(this->set.contains(3), Eq(false));
+  ASSERT_THAT(this->set.size(), Eq(1));
+}
+
+TEST(AnErasableHashSet, BehavesLikeStdSetOnRandomOperations) {
+  HashSet<HypernodeID> set(200);
+  std::set<HypernodeID> reference;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<HypernodeID> key_dist(0, 300);
+  for (int i = 0; i < 20000; ++i) {
+    const HypernodeID key = key_dist(gen);
+    if (i % 3 == 0) {
+      set.erase(key);
+      reference.erase(key);
+    } else if (reference.size() < 200) {
+      set.insert(key);
+      reference.insert(key);
+    }
+    ASSERT_THAT(set.contains(key), Eq(reference.count(key) == 1));
+    ASSERT_THAT(set.size(), Eq(reference.size()));
+    if (i % 5000 == 0) {
+      set.clear();
+      reference.clear();
+    }
+  }
+}
+
+// Exposes the positions of deleted slots that the table keeps for clear().
+class InspectableHashSet : public HashSet<HypernodeID, CollidingHash> {
+ public:
+  explicit InspectableHashSet(const uint64_t max_size) :
+    HashSet<HypernodeID, CollidingHash>(max_size) { }
+
+  size_t numDeletedPositions() const {
+    return _deleted_poses.size();
+  }
+};
+
+TEST(AnErasableHashSet, DoesNotAccumulateDeletedPositionsUnderChurn) {
+  InspectableHashSet set(10);
+  set.insert(1);
+  for (HypernodeID i = 0; i < 100000; ++i) {
+    set.insert(2 + i % 5);
+    set.erase(2 + i % 5);
+  }
+  ASSERT_THAT(set.size(), Eq(1));
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_LE(set.numDeletedPositions(), 2 + 2 * ControlGroup::kWidth);
+
+  set.clear();
+  for (HypernodeID key = 0; key < 10; ++key) {
+    ASSERT_FALSE(set.contains(key));
+    set.insert(key);
+  }
+  ASSERT_THAT(set.size(), Eq(10));
+}
+
+TEST(AHashMap, StoresValues) {
+  HashMap<HypernodeID, HyperedgeWeight> map(10);
+  map[3] = 5;
+  map.insert(4, 7);
+  map.insert(std::make_pair(4, 9));
+  ASSERT_THAT(map[3], Eq(5));
+  ASSERT_THAT(map[4], Eq(7));
+  ASSERT_THAT(map.size(), Eq(2));
+}
+
+TEST(AHashMap, DefaultInitializesValuesOfReinsertedKeys) {
+  HashMap<HypernodeID, HyperedgeWeight> map(10);
+  map[3] = 5;
+  map.erase(3);
+  ASSERT_THAT(map.contains(3), Eq(false));
+  ASSERT_THAT(map[3], Eq(0));
+  map[4] = 2;
+  map.clear();
+  ASSERT_THAT(map.contains(4), Eq(false));
+  ASSERT_THAT(map[4], Eq(0));
+}
+
+TEST(AnInsertOnlyHashMap, IteratesOverAllElements) {
+  InsertOnlyHashMap<HypernodeID, HyperedgeWeight> map(10);
+  map[std::numeric_limits<HypernodeID>::max()] = 1;
+  map[2] = 2;
+  map[3] = 3;
+  HyperedgeWeight sum = 0;
+  for (const auto& element : map) {
+    sum += element.second;
+  }
+  ASSERT_THAT(sum, Eq(6));
+}
+}  // namespace ds
+}  // namespace kahypar
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <stack>
 #include <tuple>
+#include <vector>
 
 #include "gmock/gmock.h"
 
@@ -657,6 +658,25 @@ TEST_F(AHypergraph, MaintainsCorrectPartSizesDuringUncontraction) {
   ASSERT_THAT(hypergraph.partSize(0), Eq(4));
 }
 
+TEST_F(AHypergraph, MaintainsCorrectPartSizesDuringContractionOfAPartitionedHypergraph) {
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 0);
+  hypergraph.setNodePart(3, 0);
+  hypergraph.setNodePart(4, 0);
+  hypergraph.setNodePart(2, 1);
+  hypergraph.setNodePart(5, 1);
+  hypergraph.setNodePart(6, 1);
+  hypergraph.initializeNumCutHyperedges();
+
+  Memento memento = hypergraph.contract(0, 1);
+  ASSERT_THAT(hypergraph.partSize(0), Eq(3));
+  ASSERT_THAT(hypergraph.partWeight(0), Eq(4));
+
+  hypergraph.uncontract(memento);
+  ASSERT_THAT(hypergraph.partSize(0), Eq(4));
+  ASSERT_THAT(hypergraph.partWeight(0), Eq(4));
+}
+
 TEST_F(AHypergraph, MaintainsItsTotalWeight) {
   ASSERT_THAT(hypergraph.totalWeight(), Eq(7));
 }
@@ -907,5 +927,30 @@ TEST_F(AHypergraph, SupportsRestoreOfIsolatedHypernodes) {
   ASSERT_THAT(std::find(hypergraph.pins(1).first, hypergraph.pins(1).second, 0) !=
               hypergraph.pins(1).second, Eq(true));
 }
+
+TEST_F(AHypergraph, CanBeReinitializedWithAnotherHypergraph) {
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 1);
+  hypergraph.setNodePart(2, 0);
+  hypergraph.contract(0, 2);
+
+  const std::vector<size_t> offsets { 0, 3, 5 };
+  const std::vector<HypernodeID> pins { 0, 1, 2, 2, 3 };
+  const std::vector<HyperedgeWeight> edge_weights { 3, 4 };
+  const std::vector<HypernodeWeight> node_weights { 1, 2, 3, 4 };
+  hypergraph.initialize(4, 2, pins.size(), offsets.data(), pins.data(), 3,
+                        edge_weights.data(), node_weights.data());
+  const Hypergraph expected(4, 2, pins.size(), offsets.data(), pins.data(), 3,
+                            edge_weights.data(), node_weights.data());
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(expected, hypergraph), Eq(true));
+
+  const HyperedgeIndexVector larger_offsets { 0, 2, 6, 9,  /*sentinel*/ 12 };
+  const HyperedgeVector larger_pins { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 };
+  hypergraph.initialize(7, 4, larger_pins.size(), larger_offsets.data(), larger_pins.data(), 2,
+                        nullptr, nullptr);
+  const Hypergraph larger_expected(7, 4, larger_offsets, larger_pins);
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(larger_expected, hypergraph), Eq(true));
+  ASSERT_THAT(hypergraph.type(), Eq(HypergraphType::Unweighted));
+}
 }  // namespace ds
 }  // namespace kahypar
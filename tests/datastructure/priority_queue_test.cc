@@ -22,6 +22,7 @@
 
 #include "kahypar/datastructure/binary_heap.h"
 #include "kahypar/datastructure/bucket_queue.h"
+#include "kahypar/datastructure/d_ary_heap.h"
 #include "kahypar/definitions.h"
 
 using ::testing::Eq;
@@ -32,6 +33,8 @@ namespace kahypar {
 namespace ds {
 using MaxHeapQueue = BinaryMaxHeap<HypernodeID, HyperedgeWeight>;
 using BucketQueue = EnhancedBucketQueue<HypernodeID, HyperedgeWeight>;
+using FourAryMaxHeapQueue = DAryMaxHeap<HypernodeID, HyperedgeWeight, 4>;
+using EightAryMaxHeapQueue = DAryMaxHeap<HypernodeID, HyperedgeWeight, 8>;
 
 template <typename T>
 class APriorityQueue : public Test {
@@ -43,7 +46,8 @@ class APriorityQueue : public Test {
   T prio_queue;
 };
 
-typedef ::testing::Types<BucketQueue, MaxHeapQueue> Implementations;
+typedef ::testing::Types<BucketQueue, MaxHeapQueue,
+                         FourAryMaxHeapQueue, EightAryMaxHeapQueue> Implementations;
 
 TYPED_TEST_CASE(APriorityQueue, Implementations);
 
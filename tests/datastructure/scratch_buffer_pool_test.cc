@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <thread>
+#include <vector>
+
+#include "kahypar/datastructure/scratch_buffer_pool.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Each;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+TEST(AScratchBufferPool, HandsOutClearedVectors) {
+  ScratchBufferPool<std::vector<HypernodeID> > pool;
+  {
+    auto buffer = pool.acquire(10);
+    ASSERT_THAT(buffer->size(), Eq(10));
+    (*buffer)[3] = 42;
+  }
+  auto buffer = pool.acquire(5);
+  ASSERT_THAT(buffer->size(), Eq(5));
+  ASSERT_THAT(*buffer, Each(Eq(0)));
+}
+
+TEST(AScratchBufferPool, ReusesReleasedBuffers) {
+  ScratchBufferPool<std::vector<HypernodeID> > pool;
+  for (size_t i = 0; i < 10; ++i) {
+    auto buffer = pool.acquire(100);
+  }
+  ASSERT_THAT(pool.numBuffers(), Eq(1));
+  ASSERT_THAT(pool.stats().acquisitions, Eq(10));
+  ASSERT_THAT(pool.stats().allocations, Eq(1));
+  ASSERT_THAT(pool.stats().reuses, Eq(9));
+  ASSERT_THAT(pool.stats().in_use, Eq(0));
+}
+
+TEST(AScratchBufferPool, HandsOutDistinctBuffersToSimultaneousUsers) {
+  ScratchBufferPool<std::vector<HypernodeID> > pool;
+  auto first = pool.acquire(1);
+  auto second = pool.acquire(1);
+  (*first)[0] = 1;
+  (*second)[0] = 2;
+  ASSERT_THAT((*first)[0], Eq(1));
+  ASSERT_THAT(pool.numBuffers(), Eq(2));
+  ASSERT_THAT(pool.stats().max_in_use, Eq(2));
+}
+
+TEST(AScratchBufferPool, ReplacesFixedCapacityBuffersThatAreTooSmall) {
+  ScratchBufferPool<FastResetFlagArray<> > pool;
+  {
+    auto flags = pool.acquire(10);
+    flags->set(5, true);
+  }
+  {
+    auto flags = pool.acquire(5);
+    ASSERT_FALSE((*flags)[5]);
+  }
+  auto flags = pool.acquire(1000);
+  flags->set(999, true);
+  ASSERT_THAT(pool.numBuffers(), Eq(1));
+  ASSERT_THAT(pool.stats().reallocations, Eq(1));
+}
+
+TEST(AScratchBufferPool, ClearsSparseMaps) {
+  ScratchBufferPool<SparseMap<HypernodeID, Gain> > pool;
+  {
+    auto map = pool.acquire(20);
+    (*map)[3] = 5;
+  }
+  auto map = pool.acquire(20);
+  ASSERT_THAT(map->size(), Eq(0));
+  ASSERT_FALSE(map->contains(3));
+}
+
+TEST(AScratchBufferPool, HasOnePoolPerThread) {
+  ScratchBufferPool<std::vector<HypernodeID> >* main_pool =
+    &ScratchBufferPool<std::vector<HypernodeID> >::local();
+  ScratchBufferPool<std::vector<HypernodeID> >* thread_pool = nullptr;
+  std::thread thread([&]() {
+      thread_pool = &ScratchBufferPool<std::vector<HypernodeID> >::local();
+    });
+  thread.join();
+  ASSERT_NE(main_pool, thread_pool);
+  ASSERT_THAT(main_pool, Eq(&ScratchBufferPool<std::vector<HypernodeID> >::local()));
+}
+}  // namespace ds
+}  // namespace kahypar
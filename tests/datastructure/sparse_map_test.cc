@@ -101,5 +101,37 @@ TEST_F(ASparseMap, DoesNotContainElementsAfterItIsCleared) {
   ASSERT_FALSE(sparse_map.contains(1));
   ASSERT_FALSE(sparse_map.contains(3));
 }
+TEST(ADynamicSparseMap, BehavesLikeASparseMap) {
+  SparseMap<HypernodeID, double> sparse_map(1000);
+  DynamicSparseMap<HypernodeID, double> dynamic_map(1000);
+  for (size_t round = 0; round < 3; ++round) {
+    for (HypernodeID i = 0; i < 200 * (round + 1); ++i) {
+      const HypernodeID key = (i * 7919) % 1000;
+      sparse_map[key] += i;
+      dynamic_map[key] += i;
+    }
+    ASSERT_THAT(dynamic_map.size(), Eq(sparse_map.size()));
+    const auto* it = dynamic_map.begin();
+    for (const auto& element : sparse_map) {
+      ASSERT_THAT(it->key, Eq(element.key));
+      ASSERT_THAT(it->value, DoubleEq(element.value));
+      ASSERT_THAT(dynamic_map.get(element.key), DoubleEq(element.value));
+      ++it;
+    }
+    sparse_map.clear();
+    dynamic_map.clear();
+    ASSERT_THAT(dynamic_map.size(), Eq(0));
+    ASSERT_FALSE(dynamic_map.contains(0));
+  }
+}
+
+TEST(ADynamicSparseMap, UsesMemoryProportionalToTouchedKeys) {
+  DynamicSparseMap<HypernodeID, double> dynamic_map(10000000);
+  dynamic_map.add(9999999, 1.0);
+  dynamic_map.add(3, 2.0);
+  ASSERT_THAT(dynamic_map.get(9999999), DoubleEq(1.0));
+  ASSERT_THAT(dynamic_map.get(3), DoubleEq(2.0));
+  ASSERT_LE(dynamic_map.sizeInBytes(), 1024);
+}
 }  // namespace ds
 }  // namespace kahypar
@@ -20,6 +20,9 @@
 
 #include "gmock/gmock.h"
 
+#include <limits>
+#include <vector>
+
 #include "kahypar/datastructure/sparse_set.h"
 #include "kahypar/definitions.h"
 
@@ -48,7 +51,8 @@ class ASparseSetSupportingDeletions : public Test {
 };
 
 typedef ::testing::Types<SparseSet<HypernodeID>,
-                         InsertOnlySparseSet<PartitionID> > Implementations;
+                         InsertOnlySparseSet<PartitionID>,
+                         DynamicSparseSet<HypernodeID> > Implementations;
 
 typedef ::testing::Types<SparseSet<HypernodeID> > ImplementationsWithDeletion;
 
@@ -72,6 +76,58 @@ TEST(AnInsertOnlySparseSet, HandlesThresholdOverflow) {
   ASSERT_FALSE(sparse_set.contains(5));
 }
 
+TEST(ATimestampedIndexTable, HandlesTimestampOverflow) {
+  TimestampedIndexTable<HypernodeID> table(100);
+  table.insert(5);
+  ASSERT_THAT(table.find(5), Eq(0));
+
+  table._timestamp = std::numeric_limits<uint32_t>::max() - 1;
+  table.clear();
+  ASSERT_EQ(table._timestamp, 1);
+  ASSERT_THAT(table.find(5), Eq(TimestampedIndexTable<HypernodeID>::kInvalidIndex));
+  table.insert(7);
+  ASSERT_THAT(table.find(7), Eq(0));
+}
+
+TEST(ATimestampedIndexTable, StaysSmallIfOnlyFewKeysAreUsed) {
+  TimestampedIndexTable<HypernodeID> table(1000000);
+  for (HypernodeID i = 0; i < 10; ++i) {
+    table.insert(i * 100000);
+  }
+  ASSERT_FALSE(table.isDirectlyIndexed());
+  ASSERT_LE(table.capacity(), 32);
+  for (HypernodeID i = 0; i < 10; ++i) {
+    ASSERT_THAT(table.find(i * 100000), Eq(i));
+  }
+}
+
+TEST(ATimestampedIndexTable, SwitchesToDirectIndexingWhenItGrowsTooLarge) {
+  TimestampedIndexTable<HypernodeID> table(100);
+  for (HypernodeID i = 0; i < 60; ++i) {
+    table.insert(99 - i);
+  }
+  ASSERT_TRUE(table.isDirectlyIndexed());
+  ASSERT_THAT(table.capacity(), Eq(100));
+  for (HypernodeID i = 0; i < 60; ++i) {
+    ASSERT_THAT(table.find(99 - i), Eq(i));
+  }
+  ASSERT_THAT(table.find(0), Eq(TimestampedIndexTable<HypernodeID>::kInvalidIndex));
+}
+
+TEST(ADynamicSparseSet, IteratesInInsertionOrderAfterGrowingAndClearing) {
+  DynamicSparseSet<HypernodeID> sparse_set(1000);
+  for (HypernodeID i = 0; i < 500; ++i) {
+    sparse_set.add(2 * i);
+  }
+  sparse_set.clear();
+  sparse_set.add(17);
+  sparse_set.add(3);
+  sparse_set.add(17);
+  std::vector<HypernodeID> elements(sparse_set.begin(), sparse_set.end());
+  ASSERT_THAT(elements, ::testing::ElementsAre(17, 3));
+  ASSERT_FALSE(sparse_set.contains(2));
+}
+
 TYPED_TEST(ASparseSet, ReturnsFalseIfElementIsNotInTheSet) {
   this->sparse_set.add(6);
   ASSERT_FALSE(this->sparse_set.contains(5));
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/io/batch_manifest.h"
+
+using ::testing::Eq;
+using ::testing::HasSubstr;
+
+namespace kahypar {
+namespace io {
+TEST(ABatchManifest, ContainsOneJobPerLine) {
+  std::istringstream manifest(
+    "# instance k epsilon seed preset [partition file]\n"
+    "ibm01.hgr 2 0.03 1 km1.ini\n"
+    "\n"
+    "  ibm02.hgr 8 0.1 -1 cut.ini ibm02.part8\n");
+  std::vector<BatchJob> jobs;
+
+  ASSERT_TRUE(parseBatchManifest(manifest, jobs).ok());
+  ASSERT_THAT(jobs.size(), Eq(2));
+  ASSERT_THAT(jobs[0].graph_filename, Eq("ibm01.hgr"));
+  ASSERT_THAT(jobs[0].k, Eq(2));
+  ASSERT_THAT(jobs[0].epsilon, Eq(0.03));
+  ASSERT_THAT(jobs[0].seed, Eq(1));
+  ASSERT_THAT(jobs[0].preset, Eq("km1.ini"));
+  ASSERT_THAT(jobs[0].partition_filename, Eq(""));
+  ASSERT_THAT(jobs[1].graph_filename, Eq("ibm02.hgr"));
+  ASSERT_THAT(jobs[1].k, Eq(8));
+  ASSERT_THAT(jobs[1].seed, Eq(-1));
+  ASSERT_THAT(jobs[1].partition_filename, Eq("ibm02.part8"));
+}
+
+TEST(ABatchManifest, ReportsTheLineOfAnIncompleteJob) {
+  std::istringstream manifest("ibm01.hgr 2 0.03 1 km1.ini\nibm02.hgr 2 0.03\n");
+  std::vector<BatchJob> jobs;
+
+  const IOStatus status = parseBatchManifest(manifest, jobs);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), HasSubstr("line 2"));
+}
+
+TEST(ABatchManifest, RejectsInvalidPartitioningParameters) {
+  std::istringstream manifest("ibm01.hgr 1 0.03 1 km1.ini\n");
+  std::vector<BatchJob> jobs;
+
+  ASSERT_FALSE(parseBatchManifest(manifest, jobs).ok());
+}
+
+TEST(ABatchManifest, RejectsTrailingTokens) {
+  std::istringstream manifest("ibm01.hgr 2 0.03 1 km1.ini ibm01.part2 extra\n");
+  std::vector<BatchJob> jobs;
+
+  ASSERT_FALSE(parseBatchManifest(manifest, jobs).ok());
+}
+}  // namespace io
+}  // namespace kahypar
@@ -20,6 +20,17 @@
 
 #include "gmock/gmock.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kahypar/io/coarsening_hierarchy_io.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "tests/io/hypergraph_io_test_fixtures.h"
 
@@ -197,6 +208,27 @@ TEST_F(AHypergraphWithHypernodeAndHyperedgeWeights, CanBeWrittenToFile) {
   ASSERT_THAT(verifyEquivalenceWithPartitionInfo(*_hypergraph, hypergraph2), Eq(true));
 }
 
+static std::string fileContent(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+TEST(AParallelHypergraphWriter, ProducesTheSameFileAsTheSequentialWriter) {
+  for (const std::string instance : { "test_instances/unweighted_hypergraph.hgr",
+                                      "test_instances/weighted_hyperedges_hypergraph.hgr",
+                                      "test_instances/weighted_hypernodes_hypergraph.hgr",
+                                      "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr" }) {
+    const Hypergraph hypergraph = createHypergraphFromFile(instance, 2);
+    writeHypergraphFile(hypergraph, "test_instances/sequential.hgr");
+    for (const size_t num_threads : { 2, 3, 16 }) {
+      writeHypergraphFile(hypergraph, "test_instances/parallel.hgr", num_threads,
+                          /* min_lines_per_chunk */ 1);
+      ASSERT_THAT(fileContent("test_instances/parallel.hgr"),
+                  Eq(fileContent("test_instances/sequential.hgr"))) << instance;
+    }
+  }
+}
+
 TEST_F(APartitionOfAHypergraph, IsCorrectlyWrittenToFile) {
   multilevel::partition(_hypergraph, *_coarsener, *_refiner, _context);
   writePartitionFile(_hypergraph, _context.partition.graph_partition_filename);
@@ -208,6 +240,19 @@ TEST_F(APartitionOfAHypergraph, IsCorrectlyWrittenToFile) {
   }
 }
 
+TEST_F(APartitionOfAHypergraph, IsCorrectlyWrittenToBinaryFile) {
+  multilevel::partition(_hypergraph, *_coarsener, *_refiner, _context);
+  writePartitionFile(_hypergraph, _context.partition.graph_partition_filename, true);
+  ASSERT_TRUE(isBinaryPartitionFile(_context.partition.graph_partition_filename));
+
+  std::vector<PartitionID> read_partition;
+  readPartitionFile(_context.partition.graph_partition_filename, read_partition);
+  ASSERT_THAT(read_partition.size(), Eq(_hypergraph.initialNumNodes()));
+  for (const HypernodeID& hn : _hypergraph.nodes()) {
+    ASSERT_THAT(read_partition[hn], Eq(_hypergraph.partID(hn)));
+  }
+}
+
 TEST(AHypergraph, CanBeSerializedToPaToHFormat) {
   HyperedgeWeightVector he_weights = { 10, 15, 13, 18, 25, 20, 14, 27, 29 };
   HypernodeWeightVector hn_weights = HypernodeWeightVector { 80, 85, 30, 55, 42, 39, 90, 102 };
@@ -243,6 +288,594 @@ TEST(AHypergraph, CanBeSerializedToPaToHFormat) {
   ASSERT_THAT(serialized_lines, ::testing::ContainerEq(original_lines));
 }
 
+static void writeTextFile(const std::string& filename, const std::string& content) {
+  std::ofstream out_stream(filename);
+  out_stream << content;
+}
+
+static IOStatus parseText(const std::string& content, HypernodeID& num_hypernodes,
+                          HyperedgeID& num_hyperedges, HyperedgeIndexVector& index_vector,
+                          HyperedgeVector& edge_vector, HyperedgeWeightVector& hyperedge_weights,
+                          HypernodeWeightVector& hypernode_weights,
+                          const size_t num_threads = 1) {
+  const std::string filename("test_instances/parser_input.hgr");
+  writeTextFile(filename, content);
+  // Tiny chunks force the parallel parser to split even small inputs
+  return parseHypergraphFile(filename, num_hypernodes, num_hyperedges, index_vector,
+                             edge_vector, &hyperedge_weights, &hypernode_weights,
+                             num_threads, /* min chunk size */ 4);
+}
+
+struct ParsedHypergraph {
+  IOStatus status { };
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector { };
+  HyperedgeVector edge_vector { };
+  HyperedgeWeightVector hyperedge_weights { };
+  HypernodeWeightVector hypernode_weights { };
+};
+
+static ParsedHypergraph parseFile(const std::string& filename, const size_t num_threads,
+                                  const size_t min_chunk_size) {
+  ParsedHypergraph result;
+  result.status = parseHypergraphFile(filename, result.num_hypernodes, result.num_hyperedges,
+                                      result.index_vector, result.edge_vector,
+                                      &result.hyperedge_weights, &result.hypernode_weights,
+                                      num_threads, min_chunk_size);
+  return result;
+}
+
+static void expectEqual(const ParsedHypergraph& expected, const ParsedHypergraph& actual) {
+  ASSERT_THAT(actual.status.ok(), Eq(expected.status.ok()));
+  ASSERT_THAT(actual.status.message(), Eq(expected.status.message()));
+  ASSERT_THAT(actual.num_hypernodes, Eq(expected.num_hypernodes));
+  ASSERT_THAT(actual.num_hyperedges, Eq(expected.num_hyperedges));
+  ASSERT_THAT(actual.index_vector, ContainerEq(expected.index_vector));
+  ASSERT_THAT(actual.edge_vector, ContainerEq(expected.edge_vector));
+  ASSERT_THAT(actual.hyperedge_weights, ContainerEq(expected.hyperedge_weights));
+  ASSERT_THAT(actual.hypernode_weights, ContainerEq(expected.hypernode_weights));
+}
+
+TEST(AHypergraphParser, SkipsCommentsAndHandlesWindowsLineEndings) {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector;
+  HyperedgeVector edge_vector;
+  HyperedgeWeightVector hyperedge_weights;
+  HypernodeWeightVector hypernode_weights;
+  const IOStatus status = parseText("% comment\r\n2 3 11\r\n% another comment\r\n"
+                                    "5 1  3\r\n\t7 2 3 \r\n1\r\n2\r\n3",
+                                    num_hypernodes, num_hyperedges, index_vector,
+                                    edge_vector, hyperedge_weights, hypernode_weights);
+  ASSERT_TRUE(status.ok()) << status.message();
+  ASSERT_THAT(num_hyperedges, Eq(2));
+  ASSERT_THAT(num_hypernodes, Eq(3));
+  ASSERT_THAT(index_vector, ContainerEq(HyperedgeIndexVector { 0, 2, 4 }));
+  ASSERT_THAT(edge_vector, ContainerEq(HyperedgeVector { 0, 2, 1, 2 }));
+  ASSERT_THAT(hyperedge_weights, ContainerEq(HyperedgeWeightVector { 5, 7 }));
+  ASSERT_THAT(hypernode_weights, ContainerEq(HypernodeWeightVector { 1, 2, 3 }));
+}
+
+TEST(AHypergraphParser, ReportsMissingFiles) {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector;
+  HyperedgeVector edge_vector;
+  const IOStatus status = parseHypergraphFile("test_instances/does_not_exist.hgr",
+                                              num_hypernodes, num_hyperedges,
+                                              index_vector, edge_vector);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("does_not_exist.hgr"));
+}
+
+TEST(AHypergraphParser, ReportsInvalidInput) {
+  const std::vector<std::pair<std::string, std::string> > inputs {
+    { "2 3\n1 2\n", "File ends after 1 of 2 hyperedges" },
+    { "1 3\n1 4\n", "Invalid pin of hyperedge 0 (line 2)" },
+    { "1 3\n1 0\n", "Invalid pin of hyperedge 0" },
+    { "1 3\n1 x\n", "Invalid pin of hyperedge 0" },
+    { "1 3\n1 99999999999\n", "Invalid pin of hyperedge 0" },
+    { "1 3 1\n4\n", "Hyperedge 0 is empty" },
+    { "1 3 5\n1 2\n", "wrong type" },
+    { "a 3\n1 2\n", "Invalid header" },
+    { "1 3 10\n1 2\n1\n2\n", "Invalid weight of hypernode 2" }
+  };
+  for (const auto& input : inputs) {
+    HypernodeID num_hypernodes = 0;
+    HyperedgeID num_hyperedges = 0;
+    HyperedgeIndexVector index_vector;
+    HyperedgeVector edge_vector;
+    HyperedgeWeightVector hyperedge_weights;
+    HypernodeWeightVector hypernode_weights;
+    const IOStatus status = parseText(input.first, num_hypernodes, num_hyperedges, index_vector,
+                                      edge_vector, hyperedge_weights, hypernode_weights);
+    ASSERT_FALSE(status.ok()) << input.first;
+    ASSERT_THAT(status.message(), ::testing::HasSubstr(input.second)) << input.first;
+  }
+}
+
+TEST(AHypergraphParser, ReportsTheSameErrorsWhenParsingInParallel) {
+  const std::vector<std::string> inputs {
+    "3 3\n1 2\n2 3\n",
+    "3 3\n1 2\n1 4\n2 3\n",
+    "3 3\n1 2\n2 3\n\n",
+    "3 3 1\n1 1 2\n2 3\n4 4\n",
+    "3 3 10\n1 2\n2 3\n1 3\n1\n2\n",
+    "3 3 10\n1 2\n2 3\n1 3\n1\nx\n3\n",
+    "3 3 10\n1 2\n2 3\n1 4\n1\n2\n"
+  };
+  for (const std::string& input : inputs) {
+    writeTextFile("test_instances/parser_input.hgr", input);
+    const ParsedHypergraph sequential = parseFile("test_instances/parser_input.hgr", 1, 4);
+    ASSERT_FALSE(sequential.status.ok()) << input;
+    for (const size_t num_threads : { 2, 3, 8 }) {
+      const ParsedHypergraph parallel = parseFile("test_instances/parser_input.hgr",
+                                                  num_threads, 4);
+      ASSERT_THAT(parallel.status.message(), Eq(sequential.status.message())) << input;
+    }
+  }
+}
+
+TEST(AHypergraphParser, ProducesTheSameHypergraphWhenParsingInParallel) {
+  std::string content = "% header comment\n200 100 11\n";
+  for (HyperedgeID he = 0; he < 200; ++he) {
+    if (he % 17 == 0) {
+      content += "% comment inside the hyperedges\n";
+    }
+    content += std::to_string(he % 5 + 1);
+    for (HypernodeID pin = 0; pin < he % 7 + 1; ++pin) {
+      content += " " + std::to_string((he * 13 + pin * 31) % 100 + 1);
+    }
+    content += he % 3 == 0 ? "\r\n" : "\n";
+  }
+  for (HypernodeID hn = 0; hn < 100; ++hn) {
+    if (hn % 23 == 0) {
+      content += "% comment inside the hypernode weights\n";
+    }
+    content += std::to_string(hn % 4 + 1) + "\n";
+  }
+  writeTextFile("test_instances/parser_input.hgr", content);
+
+  const ParsedHypergraph sequential = parseFile("test_instances/parser_input.hgr", 1, 1);
+  ASSERT_TRUE(sequential.status.ok()) << sequential.status.message();
+  ASSERT_THAT(sequential.edge_vector.size(), Eq(sequential.index_vector.back()));
+  for (const size_t num_threads : { 2, 3, 4, 16 }) {
+    for (const size_t min_chunk_size : { 1, 64, 1024 }) {
+      expectEqual(sequential, parseFile("test_instances/parser_input.hgr",
+                                        num_threads, min_chunk_size));
+    }
+  }
+}
+
+TEST(AHypergraphParser, ParsesTestInstancesInParallel) {
+  for (const std::string filename : { "test_instances/unweighted_hypergraph.hgr",
+                                      "test_instances/star_like_structure.hgr",
+                                      "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr" }) {
+    const ParsedHypergraph sequential = parseFile(filename, 1, 1);
+    ASSERT_TRUE(sequential.status.ok()) << sequential.status.message();
+    expectEqual(sequential, parseFile(filename, 4, 1024));
+  }
+}
+
+static void expectIdenticalIncidences(const Hypergraph& expected, const Hypergraph& actual) {
+  for (const HyperedgeID& he : expected.edges()) {
+    const std::vector<HypernodeID> expected_pins(expected.pins(he).first,
+                                                 expected.pins(he).second);
+    const std::vector<HypernodeID> actual_pins(actual.pins(he).first, actual.pins(he).second);
+    ASSERT_THAT(actual_pins, ContainerEq(expected_pins));
+    ASSERT_THAT(actual.edgeWeight(he), Eq(expected.edgeWeight(he)));
+  }
+  for (const HypernodeID& hn : expected.nodes()) {
+    const std::vector<HyperedgeID> expected_nets(expected.incidentEdges(hn).first,
+                                                 expected.incidentEdges(hn).second);
+    const std::vector<HyperedgeID> actual_nets(actual.incidentEdges(hn).first,
+                                               actual.incidentEdges(hn).second);
+    ASSERT_THAT(actual_nets, ContainerEq(expected_nets));
+    ASSERT_THAT(actual.nodeWeight(hn), Eq(expected.nodeWeight(hn)));
+  }
+}
+
+TEST(ABinaryHypergraphFile, LoadsTheSameHypergraphAsTheHGRFile) {
+  for (const std::string filename : { "test_instances/unweighted_hypergraph.hgr",
+                                      "test_instances/weighted_hyperedges_hypergraph.hgr",
+                                      "test_instances/weighted_hypernodes_hypergraph.hgr",
+                                      "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr",
+                                      "test_instances/star_like_structure.hgr" }) {
+    const Hypergraph expected = createHypergraphFromFile(filename, 3);
+    const IOStatus write_status = writeBinaryHypergraphFile(expected,
+                                                            "test_instances/hypergraph.bin");
+    ASSERT_TRUE(write_status.ok()) << write_status.message();
+    ASSERT_TRUE(isBinaryHypergraphFile("test_instances/hypergraph.bin"));
+    ASSERT_FALSE(isBinaryHypergraphFile(filename));
+
+    const Hypergraph actual = createHypergraphFromFile("test_instances/hypergraph.bin", 3);
+    ASSERT_THAT(actual.type(), Eq(expected.type()));
+    ASSERT_THAT(actual.totalWeight(), Eq(expected.totalWeight()));
+    ASSERT_TRUE(verifyEquivalenceWithoutPartitionInfo(expected, actual)) << filename;
+    expectIdenticalIncidences(expected, actual);
+  }
+}
+
+static IOStatus readModifiedBinaryFile(const size_t offset, const char value) {
+  const Hypergraph hypergraph = createHypergraphFromFile(
+    "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr", 2);
+  writeBinaryHypergraphFile(hypergraph, "test_instances/hypergraph.bin");
+  std::fstream file("test_instances/hypergraph.bin",
+                    std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(offset);
+  file.put(value);
+  file.close();
+  Hypergraph loaded;
+  return readBinaryHypergraphFile("test_instances/hypergraph.bin", 2, loaded);
+}
+
+TEST(ABinaryHypergraphFile, DetectsCorruptedData) {
+  const IOStatus status = readModifiedBinaryFile(sizeof(BinaryHypergraphHeader) + 9, 42);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Checksum mismatch"));
+}
+
+TEST(ABinaryHypergraphFile, RejectsOtherFormatVersions) {
+  const IOStatus status = readModifiedBinaryFile(offsetof(BinaryHypergraphHeader, version), 7);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Unsupported binary format version 7"));
+}
+
+TEST(ABinaryHypergraphFile, RejectsTruncatedFiles) {
+  const Hypergraph hypergraph = createHypergraphFromFile(
+    "test_instances/unweighted_hypergraph.hgr", 2);
+  writeBinaryHypergraphFile(hypergraph, "test_instances/hypergraph.bin");
+  std::ifstream in("test_instances/hypergraph.bin", std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  writeTextFile("test_instances/hypergraph.bin", content.substr(0, content.size() - 8));
+  Hypergraph loaded;
+  const IOStatus status = readBinaryHypergraphFile("test_instances/hypergraph.bin", 2, loaded);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("header requires"));
+}
+
+TEST(ABinaryHypergraphFile, RejectsIncidentNetsThatAreNoTransposeOfThePins) {
+  const Hypergraph hypergraph = createHypergraphFromFile(
+    "test_instances/unweighted_hypergraph.hgr", 2);
+  writeBinaryHypergraphFile(hypergraph, "test_instances/hypergraph.bin");
+  std::ifstream in("test_instances/hypergraph.bin", std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+
+  // Hypernode 0 is contained in hyperedges 0 and 1. The incident nets are the
+  // last section; listing hyperedge 2 instead of 0 keeps them a valid CSR array.
+  const size_t incident_nets = content.size() -
+                               internal::paddedSize(hypergraph.initialNumPins() *
+                                                    sizeof(HyperedgeID));
+  const HyperedgeID wrong_net = 2;
+  content.replace(incident_nets, sizeof(wrong_net),
+                  reinterpret_cast<const char*>(&wrong_net), sizeof(wrong_net));
+  internal::BinaryChecksum checksum;
+  checksum.update(content.data() + sizeof(BinaryHypergraphHeader),
+                  content.size() - sizeof(BinaryHypergraphHeader));
+  const uint64_t checksum_value = checksum.value();
+  content.replace(offsetof(BinaryHypergraphHeader, checksum), sizeof(checksum_value),
+                  reinterpret_cast<const char*>(&checksum_value), sizeof(checksum_value));
+  writeTextFile("test_instances/hypergraph.bin", content);
+
+  Hypergraph loaded;
+  const IOStatus status = readBinaryHypergraphFile("test_instances/hypergraph.bin", 2, loaded);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Incident nets do not match the pins"));
+}
+
+TEST(ABinaryPartitionFile, RejectsInvalidBlockIDs) {
+  Hypergraph hypergraph(3, 1, HyperedgeIndexVector { 0, 3 }, HyperedgeVector { 0, 1, 2 }, 2);
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 1);
+  hypergraph.setNodePart(2, 1);
+  ASSERT_TRUE(writeBinaryPartitionFile(hypergraph, "test_instances/partition.bin").ok());
+
+  std::fstream file("test_instances/partition.bin",
+                    std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(sizeof(BinaryPartitionHeader) + sizeof(PartitionID));
+  file.put(2);
+  file.close();
+  std::vector<PartitionID> partition;
+  const IOStatus status = parsePartitionFile("test_instances/partition.bin", partition);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Hypernode 1 is assigned to invalid block"));
+  ASSERT_TRUE(partition.empty());
+}
+
+TEST(ABinaryPartitionFile, RejectsHeadersWhoseRequiredSizeOverflows) {
+  Hypergraph hypergraph(3, 1, HyperedgeIndexVector { 0, 3 }, HyperedgeVector { 0, 1, 2 }, 2);
+  hypergraph.setNodePart(0, 0);
+  hypergraph.setNodePart(1, 1);
+  hypergraph.setNodePart(2, 1);
+  ASSERT_TRUE(writeBinaryPartitionFile(hypergraph, "test_instances/partition.bin").ok());
+
+  // (2^62 + 3) * sizeof(PartitionID) wraps around to the size of three block IDs
+  const uint64_t num_hypernodes = (static_cast<uint64_t>(1) << 62) + 3;
+  std::fstream file("test_instances/partition.bin",
+                    std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(offsetof(BinaryPartitionHeader, num_hypernodes));
+  file.write(reinterpret_cast<const char*>(&num_hypernodes), sizeof(num_hypernodes));
+  file.close();
+  std::vector<PartitionID> partition;
+  const IOStatus status = parsePartitionFile("test_instances/partition.bin", partition);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("but header requires 4611686018427387907 "
+                                                     "block IDs"));
+  ASSERT_TRUE(partition.empty());
+}
+
+TEST(ATextPartitionFile, ReportsInvalidBlockIDs) {
+  writeTextFile("test_instances/partition.txt", "0\n1\nx\n");
+  std::vector<PartitionID> partition;
+  const IOStatus status = parsePartitionFile("test_instances/partition.txt", partition);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), Eq("Invalid block ID of hypernode 2 (line 3)"));
+}
+
+TEST(AnInputPartitionFile, IsAssignedToTheHypergraph) {
+  Hypergraph hypergraph(3, 1, HyperedgeIndexVector { 0, 3 }, HyperedgeVector { 0, 1, 2 }, 2);
+  writeTextFile("test_instances/input_partition.txt", "1\n0\n1\n");
+  ASSERT_TRUE(applyPartitionFile("test_instances/input_partition.txt", hypergraph).ok());
+  ASSERT_THAT(hypergraph.partID(0), Eq(1));
+  ASSERT_THAT(hypergraph.partID(1), Eq(0));
+  ASSERT_THAT(hypergraph.partID(2), Eq(1));
+}
+
+TEST(AnInputPartitionFile, MustContainOneBlockIDPerHypernode) {
+  Hypergraph hypergraph(3, 1, HyperedgeIndexVector { 0, 3 }, HyperedgeVector { 0, 1, 2 }, 2);
+  writeTextFile("test_instances/input_partition.txt", "1\n0\n");
+  const IOStatus status = applyPartitionFile("test_instances/input_partition.txt", hypergraph);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), Eq("test_instances/input_partition.txt contains 2 block IDs, "
+                                   "but the hypergraph has 3 hypernodes"));
+  ASSERT_THAT(hypergraph.partID(0), Eq(Hypergraph::kInvalidPartition));
+}
+
+TEST(AnInputPartitionFile, MustOnlyContainBlocksOfTheHypergraph) {
+  Hypergraph hypergraph(3, 1, HyperedgeIndexVector { 0, 3 }, HyperedgeVector { 0, 1, 2 }, 2);
+  writeTextFile("test_instances/input_partition.txt", "1\n0\n2\n");
+  IOStatus status = applyPartitionFile("test_instances/input_partition.txt", hypergraph);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), Eq("Invalid block ID 2 of hypernode 2 in "
+                                   "test_instances/input_partition.txt"));
+  ASSERT_THAT(hypergraph.partID(0), Eq(Hypergraph::kInvalidPartition));
+
+  writeTextFile("test_instances/input_partition.txt", "1\n-1\n0\n");
+  status = applyPartitionFile("test_instances/input_partition.txt", hypergraph);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), Eq("Invalid block ID -1 of hypernode 1 in "
+                                   "test_instances/input_partition.txt"));
+}
+
+static CoarseningHierarchy createCoarseningHierarchy() {
+  CoarseningHierarchy hierarchy;
+  hierarchy.hypergraph_fingerprint = 0x123456789abcdefULL;
+  hierarchy.configuration = "ml_style heavy_edge";
+  hierarchy.contraction_limit = 320;
+  hierarchy.max_allowed_node_weight = 17;
+  hierarchy.communities = { 0, 0, 1, 1, 2 };
+  hierarchy.random_state = "42 1 2 3";
+  hierarchy.history.emplace_back(Hypergraph::ContractionMemento { 0, 7, 3, 1 });
+  hierarchy.history.back().one_pin_hes_begin = 2;
+  hierarchy.history.back().one_pin_hes_size = 1;
+  hierarchy.history.emplace_back(Hypergraph::ContractionMemento { 2, 11, 2, 4 });
+  hierarchy.history.back().parallel_hes_begin = 5;
+  hierarchy.history.back().parallel_hes_size = 3;
+  return hierarchy;
+}
+
+TEST(ACoarseningHierarchyFile, StoresAllInformationOfTheHierarchy) {
+  const CoarseningHierarchy hierarchy = createCoarseningHierarchy();
+  ASSERT_TRUE(writeCoarseningHierarchyFile(hierarchy, "test_instances/hierarchy.chy").ok());
+
+  CoarseningHierarchy loaded;
+  const IOStatus status = readCoarseningHierarchyFile("test_instances/hierarchy.chy", loaded);
+  ASSERT_TRUE(status.ok()) << status.message();
+  ASSERT_THAT(loaded.hypergraph_fingerprint, Eq(hierarchy.hypergraph_fingerprint));
+  ASSERT_THAT(loaded.configuration, Eq(hierarchy.configuration));
+  ASSERT_THAT(loaded.contraction_limit, Eq(hierarchy.contraction_limit));
+  ASSERT_THAT(loaded.max_allowed_node_weight, Eq(hierarchy.max_allowed_node_weight));
+  ASSERT_THAT(loaded.communities, ContainerEq(hierarchy.communities));
+  ASSERT_THAT(loaded.random_state, Eq(hierarchy.random_state));
+  ASSERT_THAT(loaded.history.size(), Eq(hierarchy.history.size()));
+  for (size_t i = 0; i < hierarchy.history.size(); ++i) {
+    const CoarseningMemento& expected = hierarchy.history[i];
+    const CoarseningMemento& actual = loaded.history[i];
+    ASSERT_THAT(actual.contraction_memento.u, Eq(expected.contraction_memento.u));
+    ASSERT_THAT(actual.contraction_memento.u_first_entry,
+                Eq(expected.contraction_memento.u_first_entry));
+    ASSERT_THAT(actual.contraction_memento.u_size, Eq(expected.contraction_memento.u_size));
+    ASSERT_THAT(actual.contraction_memento.v, Eq(expected.contraction_memento.v));
+    ASSERT_THAT(actual.one_pin_hes_begin, Eq(expected.one_pin_hes_begin));
+    ASSERT_THAT(actual.one_pin_hes_size, Eq(expected.one_pin_hes_size));
+    ASSERT_THAT(actual.parallel_hes_begin, Eq(expected.parallel_hes_begin));
+    ASSERT_THAT(actual.parallel_hes_size, Eq(expected.parallel_hes_size));
+  }
+}
+
+TEST(ACoarseningHierarchyFile, DetectsCorruptedData) {
+  ASSERT_TRUE(writeCoarseningHierarchyFile(createCoarseningHierarchy(),
+                                           "test_instances/hierarchy.chy").ok());
+  std::fstream file("test_instances/hierarchy.chy", std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(sizeof(CoarseningHierarchyHeader) + 3);
+  file.put('x');
+  file.close();
+
+  CoarseningHierarchy loaded;
+  const IOStatus status = readCoarseningHierarchyFile("test_instances/hierarchy.chy", loaded);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Checksum mismatch"));
+}
+
+TEST(ABufferedWriter, FormatsIntegersLikeAStream) {
+  const std::vector<int64_t> values = { 0, 7, -1, 42, std::numeric_limits<int64_t>::max(),
+                                        std::numeric_limits<int64_t>::min() };
+  std::ostringstream expected;
+  {
+    BufferedWriter writer(1);
+    ASSERT_TRUE(writer.open("test_instances/buffered_writer.out").ok());
+    // enough output to fill the buffer several times
+    for (size_t i = 0; i < 3000; ++i) {
+      for (const int64_t value : values) {
+        writer << value << ' ' << static_cast<int>(value) << ' '
+               << static_cast<uint64_t>(value) << ' ' << (value > 0) << '\n';
+        expected << value << ' ' << static_cast<int>(value) << ' '
+                 << static_cast<uint64_t>(value) << ' ' << (value > 0) << '\n';
+      }
+    }
+    writer << std::string("end") << "\n";
+    expected << "end\n";
+    ASSERT_TRUE(writer.close().ok());
+  }
+  std::ifstream in("test_instances/buffered_writer.out", std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, Eq(expected.str()));
+}
+
+TEST(ABufferedWriter, ProducesTheSameFileInDirectMode) {
+  std::string expected;
+  for (size_t i = 0; i < 10000; ++i) {
+    expected += std::to_string(i) + "\n";
+  }
+  BufferedWriter writer(4096);
+  ASSERT_TRUE(writer.open("test_instances/buffered_writer.out",
+                          BufferedWriter::Mode::direct).ok());
+  writer.write(expected.data(), expected.size());
+  ASSERT_TRUE(writer.close().ok());
+
+  std::ifstream in("test_instances/buffered_writer.out", std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, Eq(expected));
+}
+
+TEST(ABufferedWriter, FormatsIntegersInDirectMode) {
+  std::string expected;
+  BufferedWriter writer(4096);
+  ASSERT_TRUE(writer.open("test_instances/buffered_writer.out",
+                          BufferedWriter::Mode::direct).ok());
+  // fills the first block up to all positions at which an integer might not fit
+  for (int64_t i = 0; i < 10000; ++i) {
+    const int64_t value = i % 3 == 0 ? -i * 1000000007 : i;
+    writer << value << ' ';
+    expected += std::to_string(value) + " ";
+  }
+  ASSERT_TRUE(writer.close().ok());
+
+  std::ifstream in("test_instances/buffered_writer.out", std::ios::binary);
+  const std::string content((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+  ASSERT_THAT(content, Eq(expected));
+}
+
+TEST(ABufferedWriter, ReportsErrors) {
+  BufferedWriter writer;
+  const IOStatus status = writer.open("test_instances/missing_directory/file.out");
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), ::testing::HasSubstr("Could not open file"));
+}
+
+TEST(AnOutputFile, ReportsThatItCouldNotBeOpened) {
+  BufferedWriter writer;
+  ASSERT_FALSE(openOutputFile(writer, "test_instances/missing_directory/file.out").ok());
+  ASSERT_FALSE(writer.isOpen());
+}
+
+#ifdef KAHYPAR_USE_ZLIB
+static void writeGzipFile(const std::string& filename, const std::string& content) {
+  gzFile file = gzopen(filename.c_str(), "wb");
+  gzwrite(file, content.data(), static_cast<unsigned>(content.size()));
+  gzclose(file);
+}
+
+static std::string readFile(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+TEST(AGzipLineBlockReader, HandsOutBlocksEndingAtLineBreaks) {
+  std::string content;
+  for (int i = 0; i < 1000; ++i) {
+    content += std::string(i % 37, 'x') + std::to_string(i) + "\n";
+  }
+  content += "last line without line break";
+  writeGzipFile("test_instances/compressed.gz", content);
+
+  GzipLineBlockReader reader(64, 2);
+  ASSERT_TRUE(reader.open("test_instances/compressed.gz").ok());
+  std::string decompressed;
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  size_t num_blocks = 0;
+  while (reader.next(begin, end)) {
+    decompressed.append(begin, end);
+    if (decompressed.size() < content.size()) {
+      ASSERT_THAT(*(end - 1), Eq('\n'));
+    }
+    ++num_blocks;
+  }
+  ASSERT_TRUE(reader.status().ok());
+  ASSERT_THAT(decompressed, Eq(content));
+  ASSERT_THAT(num_blocks, ::testing::Gt(100));
+}
+
+TEST(AGzipLineBlockReader, CanBeClosedBeforeTheEndOfTheInput) {
+  writeGzipFile("test_instances/compressed.gz", std::string(100000, '\n'));
+  GzipLineBlockReader reader(16, 1);
+  ASSERT_TRUE(reader.open("test_instances/compressed.gz").ok());
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  ASSERT_TRUE(reader.next(begin, end));
+}
+
+TEST(AGzipCompressedHGRFile, IsParsedLikeTheUncompressedFile) {
+  for (const std::string filename : { "test_instances/unweighted_hypergraph.hgr",
+                                      "test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr",
+                                      "test_instances/star_like_structure.hgr" }) {
+    writeGzipFile("test_instances/compressed.hgr.gz", readFile(filename));
+    const ParsedHypergraph expected = parseFile(filename, 1, 1);
+    expectEqual(expected, parseFile("test_instances/compressed.hgr.gz", 1, 1));
+
+    const Hypergraph hypergraph = createHypergraphFromFile("test_instances/compressed.hgr.gz", 2);
+    ASSERT_THAT(hypergraph.initialNumPins(), Eq(expected.edge_vector.size()));
+  }
+}
+
+TEST(AGzipCompressedHGRFile, ReportsTheSameErrorsAsTheUncompressedFile) {
+  for (const std::string content : { "% only a comment\n", "2 3\n1 2\n", "1 3\n1 4\n",
+                                     "1 3 10\n1 2\n1\n2\n" }) {
+    writeTextFile("test_instances/parser_input.hgr", content);
+    writeGzipFile("test_instances/compressed.hgr.gz", content);
+    const ParsedHypergraph expected = parseFile("test_instances/parser_input.hgr", 1, 1);
+    const ParsedHypergraph actual = parseFile("test_instances/compressed.hgr.gz", 1, 1);
+    ASSERT_FALSE(expected.status.ok()) << content;
+    ASSERT_THAT(actual.status.message(), Eq(expected.status.message()));
+  }
+}
+
+TEST(AnInputFileStream, ReadsCompressedAndUncompressedFiles) {
+  const std::string content = "first line\nsecond line\n";
+  writeTextFile("test_instances/parser_input.hgr", content);
+  writeGzipFile("test_instances/compressed.gz", content);
+  for (const std::string filename : { "test_instances/parser_input.hgr",
+                                      "test_instances/compressed.gz" }) {
+    InputFileStream in(filename);
+    ASSERT_TRUE(in.is_open());
+    std::string line;
+    std::getline(in, line);
+    ASSERT_THAT(line, Eq("first line"));
+    std::getline(in, line);
+    ASSERT_THAT(line, Eq("second line"));
+    ASSERT_FALSE(std::getline(in, line));
+  }
+  ASSERT_FALSE(InputFileStream("test_instances/does_not_exist").is_open());
+}
+#endif
+
 TEST(AHypergraphDeathTest, WithEmptyHyperedgesLeadsToProgramExit) {
   EXPECT_EXIT(createHypergraphFromFile("test_instances/corrupted_hypergraph_with_empty_hyperedges.hgr", 2),
               ::testing::ExitedWithCode(1),
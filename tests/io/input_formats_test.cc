@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/io/hypergraph_io.h"
+
+using ::testing::Eq;
+using ::testing::ContainerEq;
+using ::testing::HasSubstr;
+
+namespace kahypar {
+namespace io {
+static const char* kEmptyRowsMatrix =
+  "%%MatrixMarket matrix coordinate  real general\n6 4 8\n1 1 1\n1 4 3\n3 2 1\n"
+  "3 3 2\n6 1 1\n6 2 2\n6 3 3\n6 4 4\n";
+
+struct ParsedInput {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector { };
+  HyperedgeVector edge_vector { };
+  HyperedgeWeightVector hyperedge_weights { };
+  HypernodeWeightVector hypernode_weights { };
+  IOStatus status { };
+};
+
+static ParsedInput parseInput(const std::string& filename, const InputFormat format) {
+  ParsedInput input;
+  input.status = parseInputFile(filename, format, input.num_hypernodes, input.num_hyperedges,
+                                input.index_vector, input.edge_vector,
+                                &input.hyperedge_weights, &input.hypernode_weights);
+  return input;
+}
+
+static ParsedInput parseText(const std::string& content, const InputFormat format,
+                             const std::string& filename = "test_instances/input_format") {
+  {
+    std::ofstream out_stream(filename);
+    out_stream << content;
+  }
+  return parseInput(filename, format);
+}
+
+TEST(APaToHFile, IsParsedLikeTheEquivalentHMetisFile) {
+  const ParsedInput input = parseInput("test_instances/example_hypergraph.patoh",
+                                       InputFormat::patoh);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.num_hypernodes, Eq(8));
+  ASSERT_THAT(input.num_hyperedges, Eq(9));
+  ASSERT_THAT(input.index_vector,
+              ContainerEq(HyperedgeIndexVector { 0, 5, 9, 13, 15, 17, 20, 23, 26, 28 }));
+  ASSERT_THAT(input.edge_vector,
+              ContainerEq(HyperedgeVector { 7, 5, 2, 4, 1, 3, 4, 0, 6, 3, 1, 4, 6, 3, 6, 2, 4,
+                                            7, 1, 3, 5, 4, 1, 4, 6, 1, 7, 3 }));
+  ASSERT_THAT(input.hyperedge_weights,
+              ContainerEq(HyperedgeWeightVector { 10, 15, 13, 18, 25, 20, 14, 27, 29 }));
+  ASSERT_THAT(input.hypernode_weights,
+              ContainerEq(HypernodeWeightVector { 80, 85, 30, 55, 42, 39, 90, 102 }));
+}
+
+TEST(APaToHFile, CanUseZeroBasedIndicesAndCellWeightsSpanningSeveralLines) {
+  const ParsedInput input = parseText("% comment\n0 4 2 5 1\n0 1 2\n3 2\n1 2\n3\n4\n",
+                                      InputFormat::patoh);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 3, 5 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 1, 2, 3, 2 }));
+  ASSERT_THAT(input.hyperedge_weights.empty(), Eq(true));
+  ASSERT_THAT(input.hypernode_weights, ContainerEq(HypernodeWeightVector { 1, 2, 3, 4 }));
+}
+
+TEST(APaToHFile, ReportsInvalidInput) {
+  EXPECT_THAT(parseText("2 4 2 5\n1 2 3\n3\n", InputFormat::patoh).status.message(),
+              HasSubstr("Invalid index base"));
+  EXPECT_THAT(parseText("1 4 2 5\n1 2 5\n3 4\n", InputFormat::patoh).status.message(),
+              HasSubstr("Invalid pin of net 0 (line 2)"));
+  EXPECT_THAT(parseText("1 4 2 6\n1 2 3\n3 4\n", InputFormat::patoh).status.message(),
+              HasSubstr("Header specifies 6 pins"));
+  EXPECT_THAT(parseText("1 4 2 5\n1 2 3\n", InputFormat::patoh).status.message(),
+              HasSubstr("File ends after 1 of 2 nets"));
+  EXPECT_THAT(parseText("1 4 2 5 1\n1 2 3\n3 4\n1 2\n", InputFormat::patoh).status.message(),
+              HasSubstr("File ends after 2 of 4 cell weights"));
+  EXPECT_THAT(parseText("1 4 2 5 1 2\n1 2 3\n3 4\n", InputFormat::patoh).status.message(),
+              HasSubstr("Multi-constraint"));
+}
+
+TEST(AMatrixMarketFile, IsParsedLikeTheOutputOfMtxToHgr) {
+  const ParsedInput input = parseText(kEmptyRowsMatrix, InputFormat::mtx_row_net);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.num_hypernodes, Eq(4));
+  ASSERT_THAT(input.num_hyperedges, Eq(3));
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 2, 4, 8 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 3, 1, 2, 0, 1, 2, 3 }));
+}
+
+TEST(AMatrixMarketFile, CanBeParsedInTheColumnNetModel) {
+  const ParsedInput input = parseText(kEmptyRowsMatrix, InputFormat::mtx_column_net);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.num_hypernodes, Eq(6));
+  ASSERT_THAT(input.num_hyperedges, Eq(4));
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 2, 4, 6, 8 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 5, 2, 5, 2, 5, 0, 5 }));
+}
+
+TEST(AMatrixMarketFile, IsExpandedIfTheMatrixIsSymmetric) {
+  const ParsedInput input = parseText("%%MatrixMarket matrix coordinate  real     symmetric\n"
+                                      "3 3 4\n1 1 1.1\n2 2 2.2\n3 3 3.3\n3 2 1.0   \n",
+                                      InputFormat::mtx_row_net);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 1, 3, 5 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 1, 2, 2, 1 }));
+}
+
+TEST(AMatrixMarketFile, ReportsInvalidInput) {
+  EXPECT_THAT(parseText("3 3 1\n1 1\n", InputFormat::mtx_row_net).status.message(),
+              HasSubstr("Missing MatrixMarket banner"));
+  EXPECT_THAT(parseText("%%MatrixMarket matrix array real general\n3 3\n",
+                        InputFormat::mtx_row_net).status.message(),
+              HasSubstr("Only coordinate matrices"));
+  EXPECT_THAT(parseText("%%MatrixMarket matrix coordinate pattern general\n3 3 2\n1 4\n",
+                        InputFormat::mtx_row_net).status.message(),
+              HasSubstr("Invalid column index of entry 0 (line 3)"));
+  EXPECT_THAT(parseText("%%MatrixMarket matrix coordinate pattern general\n3 3 2\n1 1\n",
+                        InputFormat::mtx_row_net).status.message(),
+              HasSubstr("File ends after 1 of 2 entries"));
+}
+
+TEST(AnEdgeListFile, IsParsedIntoHyperedgesOfSizeTwo) {
+  const ParsedInput input = parseText("# comment\n0 1\n\n1 3\n2 2\n3 0\n",
+                                      InputFormat::edge_list);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.num_hypernodes, Eq(4));
+  ASSERT_THAT(input.num_hyperedges, Eq(3));
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 2, 4, 6 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 1, 1, 3, 3, 0 }));
+  ASSERT_THAT(input.hyperedge_weights.empty(), Eq(true));
+}
+
+TEST(AnEdgeListFile, CanContainEdgeWeights) {
+  const ParsedInput input = parseText("0 1 5\n1 2 7\n", InputFormat::edge_list);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.hyperedge_weights, ContainerEq(HyperedgeWeightVector { 5, 7 }));
+  EXPECT_THAT(parseText("0 1 5\n1 2\n", InputFormat::edge_list).status.message(),
+              HasSubstr("Invalid weight of edge 1 (line 2)"));
+  EXPECT_THAT(parseText("# no edges\n", InputFormat::edge_list).status.message(),
+              HasSubstr("Edge list contains no edges"));
+}
+
+TEST(TheInputFormat, IsDetectedAutomatically) {
+  ASSERT_THAT(detectInputFormat("test_instances/unweighted_hypergraph.hgr"),
+              Eq(InputFormat::hmetis));
+  ASSERT_THAT(detectInputFormat("test_instances/weighted_hyperedges_and_hypernodes_hypergraph.hgr"),
+              Eq(InputFormat::hmetis));
+  ASSERT_THAT(detectInputFormat("test_instances/example_hypergraph.patoh"),
+              Eq(InputFormat::patoh));
+  parseText(kEmptyRowsMatrix, InputFormat::mtx_row_net, "test_instances/input_format.mtx");
+  ASSERT_THAT(detectInputFormat("test_instances/input_format.mtx"),
+              Eq(InputFormat::mtx_row_net));
+  ASSERT_THAT(detectInputFormat("test_instances/unweighted_hypergraph.hgr.edgelist"),
+              Eq(InputFormat::edge_list));
+}
+
+TEST(TheInputFormat, IsDetectedWhenCreatingAHypergraphFromFile) {
+  const Hypergraph hypergraph =
+    createHypergraphFromFile("test_instances/example_hypergraph.patoh", 2);
+  ASSERT_THAT(hypergraph.currentNumNodes(), Eq(8));
+  ASSERT_THAT(hypergraph.currentNumEdges(), Eq(9));
+  ASSERT_THAT(hypergraph.nodeWeight(7), Eq(102));
+  ASSERT_THAT(hypergraph.edgeWeight(8), Eq(29));
+
+  const ParsedInput hmetis = parseInput("test_instances/unweighted_hypergraph.hgr",
+                                        InputFormat::automatic);
+  const ParsedInput expected = parseInput("test_instances/unweighted_hypergraph.hgr",
+                                          InputFormat::hmetis);
+  ASSERT_TRUE(hmetis.status.ok());
+  ASSERT_THAT(hmetis.index_vector, ContainerEq(expected.index_vector));
+  ASSERT_THAT(hmetis.edge_vector, ContainerEq(expected.edge_vector));
+}
+
+#ifdef KAHYPAR_USE_ZLIB
+TEST(ACompressedMatrixMarketFile, IsDetectedAndParsed) {
+  const std::string content = "%%MatrixMarket matrix coordinate pattern general\n"
+                              "2 3 3\n1 1\n1 3\n2 2\n";
+  gzFile file = gzopen("test_instances/input_format.mtx.gz", "wb");
+  gzwrite(file, content.data(), static_cast<unsigned>(content.size()));
+  gzclose(file);
+
+  ASSERT_THAT(detectInputFormat("test_instances/input_format.mtx.gz"),
+              Eq(InputFormat::mtx_row_net));
+  const ParsedInput input = parseInput("test_instances/input_format.mtx.gz",
+                                       InputFormat::automatic);
+  ASSERT_TRUE(input.status.ok()) << input.status.message();
+  ASSERT_THAT(input.index_vector, ContainerEq(HyperedgeIndexVector { 0, 2, 3 }));
+  ASSERT_THAT(input.edge_vector, ContainerEq(HyperedgeVector { 0, 2, 1 }));
+}
+#endif
+}  // namespace io
+}  // namespace kahypar
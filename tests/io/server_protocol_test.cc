@@ -0,0 +1,316 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kahypar/application/partitioning_server.h"
+#include "kahypar/io/server_protocol.h"
+#include "kahypar/io/unix_socket.h"
+#include "kahypar/partition/metrics.h"
+
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Le;
+using ::testing::Test;
+
+namespace kahypar {
+namespace io {
+TEST(AServerRequest, CanLoadAHypergraph) {
+  ServerRequest request;
+
+  ASSERT_TRUE(parseServerRequest("LOAD ibm01 /data/ibm01.hgr", request).ok());
+  ASSERT_THAT(request.command, Eq(ServerCommand::load));
+  ASSERT_THAT(request.name, Eq("ibm01"));
+  ASSERT_THAT(request.graph_filename, Eq("/data/ibm01.hgr"));
+}
+
+TEST(AServerRequest, CanPartitionAHypergraphWithAWarmStart) {
+  ServerRequest request;
+
+  ASSERT_TRUE(parseServerRequest("PARTITION ibm01 8 0.03 -1 km1.ini ibm01.part8", request).ok());
+  ASSERT_THAT(request.command, Eq(ServerCommand::partition));
+  ASSERT_THAT(request.name, Eq("ibm01"));
+  ASSERT_THAT(request.k, Eq(8));
+  ASSERT_THAT(request.epsilon, Eq(0.03));
+  ASSERT_THAT(request.seed, Eq(-1));
+  ASSERT_THAT(request.preset, Eq("km1.ini"));
+  ASSERT_THAT(request.warm_start_filename, Eq("ibm01.part8"));
+
+  ASSERT_TRUE(parseServerRequest("PARTITION ibm01 8 0.03 1 km1.ini", request).ok());
+  ASSERT_THAT(request.warm_start_filename, Eq(""));
+}
+
+TEST(AServerRequest, RejectsIncompleteAndUnknownRequests) {
+  ServerRequest request;
+
+  ASSERT_FALSE(parseServerRequest("PARTITION ibm01 8 0.03", request).ok());
+  ASSERT_FALSE(parseServerRequest("PARTITION ibm01 1 0.03 1 km1.ini", request).ok());
+  ASSERT_FALSE(parseServerRequest("UNLOAD ibm01 ibm02", request).ok());
+  ASSERT_FALSE(parseServerRequest("REFINE ibm01", request).ok());
+}
+
+TEST(APartitionResponse, ContainsTheMetricsOfThePartition) {
+  PartitionResponse response;
+
+  ASSERT_TRUE(parsePartitionResponse("OK 12752 865 913 0.0288 2.4", response).ok());
+  ASSERT_THAT(response.num_hypernodes, Eq(12752));
+  ASSERT_THAT(response.cut, Eq(865));
+  ASSERT_THAT(response.km1, Eq(913));
+  ASSERT_THAT(response.imbalance, Eq(0.0288));
+  ASSERT_THAT(response.seconds, Eq(2.4));
+}
+
+TEST(APartitionResponse, ForwardsTheErrorOfTheServer) {
+  PartitionResponse response;
+
+  const IOStatus status = parsePartitionResponse("ERROR Unknown hypergraph 'ibm01'", response);
+  ASSERT_FALSE(status.ok());
+  ASSERT_THAT(status.message(), Eq("Unknown hypergraph 'ibm01'"));
+}
+
+TEST(AUnixSocket, TransfersLinesToAnAcceptedConnection) {
+  const std::string path = "server_protocol_test.sock";
+  UnixSocket listener;
+  ASSERT_TRUE(UnixSocket::listen(path, listener).ok());
+  UnixSocket client;
+  ASSERT_TRUE(UnixSocket::connect(path, client).ok());
+  UnixSocket connection;
+  ASSERT_TRUE(listener.accept(connection).ok());
+
+  ASSERT_TRUE(client.write("SHUTDOWN\nOK").ok());
+  client = UnixSocket();
+  std::string line;
+  ASSERT_TRUE(connection.readLine(line));
+  ASSERT_THAT(line, Eq("SHUTDOWN"));
+  ASSERT_TRUE(connection.readLine(line));
+  ASSERT_THAT(line, Eq("OK"));
+  ASSERT_FALSE(connection.readLine(line));
+  unlink(path.c_str());
+}
+
+TEST(AUnixSocket, StopsReadingAfterATimeoutOrATooLongLine) {
+  const std::string path = "server_protocol_test_limits.sock";
+  UnixSocket listener;
+  ASSERT_TRUE(UnixSocket::listen(path, listener).ok());
+  UnixSocket client;
+  ASSERT_TRUE(UnixSocket::connect(path, client).ok());
+  UnixSocket connection;
+  ASSERT_TRUE(listener.accept(connection).ok());
+  ASSERT_TRUE(connection.setTimeout(0.05).ok());
+
+  std::string line;
+  ASSERT_TRUE(client.write("LOAD").ok());
+  ASSERT_FALSE(connection.readLine(line));
+
+  ASSERT_TRUE(client.write(std::string(100, 'x') + "\n").ok());
+  ASSERT_FALSE(connection.readLine(line, 64));
+  unlink(path.c_str());
+}
+
+TEST(AUnixSocket, DoesNotReplaceAFileThatIsNotASocket) {
+  const std::string path = "server_protocol_test.txt";
+  std::ofstream(path) << "content";
+  UnixSocket listener;
+  ASSERT_FALSE(UnixSocket::listen(path, listener).ok());
+  std::ifstream file(path);
+  std::string content;
+  file >> content;
+  ASSERT_THAT(content, Eq("content"));
+  unlink(path.c_str());
+}
+
+TEST(AUnixSocket, DoesNotTakeOverTheSocketOfARunningServer) {
+  const std::string path = "server_protocol_test_running.sock";
+  UnixSocket running;
+  ASSERT_TRUE(UnixSocket::listen(path, running).ok());
+  UnixSocket second;
+  ASSERT_FALSE(UnixSocket::listen(path, second).ok());
+  UnixSocket client;
+  ASSERT_TRUE(UnixSocket::connect(path, client).ok());
+  unlink(path.c_str());
+}
+
+TEST(AUnixSocket, ReplacesAStaleSocket) {
+  const std::string path = "server_protocol_test_stale.sock";
+  {
+    UnixSocket previous;
+    ASSERT_TRUE(UnixSocket::listen(path, previous).ok());
+  }
+  UnixSocket listener;
+  ASSERT_TRUE(UnixSocket::listen(path, listener).ok());
+  UnixSocket client;
+  ASSERT_TRUE(UnixSocket::connect(path, client).ok());
+  unlink(path.c_str());
+}
+
+// Runs a server with two workers on a temporary socket. Clients that do not
+// send a request are disconnected after 0.2 seconds.
+class APartitioningServer : public Test {
+ public:
+  APartitioningServer() :
+    listener(),
+    server(listener, 2, 0.2),
+    server_thread() {
+    UnixSocket::listen(kSocket, listener);
+    server_thread = std::thread(&PartitioningServer::run, &server);
+  }
+
+  ~APartitioningServer() {
+    if (server_thread.joinable()) {
+      request("SHUTDOWN");
+      server_thread.join();
+    }
+    unlink(kSocket);
+  }
+
+  APartitioningServer(const APartitioningServer&) = delete;
+  APartitioningServer& operator= (const APartitioningServer&) = delete;
+
+  APartitioningServer(APartitioningServer&&) = delete;
+  APartitioningServer& operator= (APartitioningServer&&) = delete;
+
+  // Returns the first line of the answer.
+  std::string request(const std::string& line) {
+    UnixSocket connection;
+    std::string response;
+    sendServerRequest(kSocket, line, connection, response);
+    return response;
+  }
+
+  IOStatus requestPartition(const std::string& line, PartitionResponse& response,
+                            std::vector<PartitionID>& partition) {
+    UnixSocket connection;
+    std::string first_line;
+    IOStatus status = sendServerRequest(kSocket, line, connection, first_line);
+    if (status.ok()) {
+      status = parsePartitionResponse(first_line, response);
+    }
+    if (status.ok()) {
+      status = readPartition(connection, response, partition);
+    }
+    return status;
+  }
+
+  static Hypergraph partitionedHypergraph(const std::vector<PartitionID>& partition) {
+    Hypergraph hypergraph(createHypergraphFromFile(kHypergraph, 2));
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      hypergraph.setNodePart(hn, partition[hn]);
+    }
+    return hypergraph;
+  }
+
+  static constexpr const char* kSocket = "server_protocol_test_server.sock";
+  static constexpr const char* kHypergraph = "test_instances/unweighted_hypergraph.hgr";
+  UnixSocket listener;
+  PartitioningServer server;
+  std::thread server_thread;
+};
+
+TEST_F(APartitioningServer, PartitionsALoadedHypergraph) {
+  ASSERT_THAT(request("LOAD h " + std::string(kHypergraph)), Eq("OK"));
+  PartitionResponse response;
+  std::vector<PartitionID> partition;
+  ASSERT_TRUE(requestPartition("PARTITION h 2 0.03 1 km1_direct_kway_sea17.ini", response,
+                               partition).ok());
+
+  ASSERT_THAT(response.num_hypernodes, Eq(7));
+  ASSERT_THAT(partition.size(), Eq(7));
+  const Hypergraph hypergraph = partitionedHypergraph(partition);
+  ASSERT_THAT(response.cut, Eq(metrics::hyperedgeCut(hypergraph)));
+  ASSERT_THAT(response.km1, Eq(metrics::km1(hypergraph)));
+}
+
+TEST_F(APartitioningServer, DoesNotWorsenAWarmStart) {
+  const std::vector<PartitionID> warm_start { 0, 1, 0, 1, 0, 1, 0 };
+  std::ofstream warm_start_file("server_protocol_test.part2");
+  for (const PartitionID part : warm_start) {
+    warm_start_file << part << "\n";
+  }
+  warm_start_file.close();
+  ASSERT_THAT(request("LOAD h " + std::string(kHypergraph)), Eq("OK"));
+  PartitionResponse response;
+  std::vector<PartitionID> partition;
+  ASSERT_TRUE(requestPartition("PARTITION h 2 0.03 1 km1_direct_kway_sea17.ini "
+                               "server_protocol_test.part2", response, partition).ok());
+
+  ASSERT_THAT(response.km1, Le(metrics::km1(partitionedHypergraph(warm_start))));
+  const Hypergraph hypergraph = partitionedHypergraph(partition);
+  ASSERT_THAT(hypergraph.partWeight(0), Le(4));
+  ASSERT_THAT(hypergraph.partWeight(1), Le(4));
+}
+
+TEST_F(APartitioningServer, AnswersInvalidRequestsWithAnError) {
+  ASSERT_THAT(request("REFINE h"), Eq("ERROR Unknown request 'REFINE'"));
+  ASSERT_THAT(request("PARTITION h 2 0.03 1 km1_direct_kway_sea17.ini"),
+              Eq("ERROR Unknown hypergraph 'h'"));
+  ASSERT_THAT(request("LOAD h " + std::string(kHypergraph)), Eq("OK"));
+  ASSERT_THAT(request("PARTITION h 2 0.03 1 missing.ini"),
+              Eq("ERROR Could not load context file at: missing.ini"));
+
+  std::ifstream km1_preset("km1_direct_kway_sea17.ini");
+  std::stringstream content;
+  content << km1_preset.rdbuf();
+  std::string twoway_preset = content.str();
+  twoway_preset.replace(twoway_preset.find("r-type=kway_fm_km1"),
+                        std::string("r-type=kway_fm_km1").size(), "r-type=twoway_fm");
+  std::ofstream("server_protocol_test_twoway.ini") << twoway_preset;
+  ASSERT_THAT(request("PARTITION h 3 0.03 1 server_protocol_test_twoway.ini"),
+              HasSubstr("twoway_fm cannot refine"));
+
+  PartitionResponse response;
+  std::vector<PartitionID> partition;
+  ASSERT_TRUE(requestPartition("PARTITION h 2 0.03 1 km1_direct_kway_sea17.ini", response,
+                               partition).ok());
+}
+
+TEST_F(APartitioningServer, ForgetsUnloadedHypergraphs) {
+  ASSERT_THAT(request("LOAD h " + std::string(kHypergraph)), Eq("OK"));
+  ASSERT_THAT(request("UNLOAD h"), Eq("OK"));
+  ASSERT_THAT(request("PARTITION h 2 0.03 1 km1_direct_kway_sea17.ini"),
+              Eq("ERROR Unknown hypergraph 'h'"));
+  ASSERT_THAT(request("UNLOAD h"), Eq("ERROR Unknown hypergraph 'h'"));
+}
+
+TEST_F(APartitioningServer, StopsAfterAShutdownRequest) {
+  ASSERT_THAT(request("SHUTDOWN"), Eq("OK"));
+  server_thread.join();
+}
+
+TEST_F(APartitioningServer, DisconnectsClientsThatDoNotSendARequest) {
+  // occupy both workers
+  UnixSocket silent_client;
+  ASSERT_TRUE(UnixSocket::connect(kSocket, silent_client).ok());
+  UnixSocket endless_client;
+  ASSERT_TRUE(UnixSocket::connect(kSocket, endless_client).ok());
+  endless_client.write(std::string(PartitioningServer::kMaxRequestLength + 1, 'x'));
+
+  ASSERT_THAT(request("LOAD h " + std::string(kHypergraph)), Eq("OK"));
+  std::string line;
+  ASSERT_FALSE(silent_client.readLine(line));
+  ASSERT_FALSE(endless_client.readLine(line));
+}
+}  // namespace io
+}  // namespace kahypar
@@ -0,0 +1,409 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/libkahypar.h"
+
+using ::testing::Eq;
+using ::testing::Le;
+using ::testing::Test;
+
+namespace kahypar {
+class ALibraryContext : public Test {
+ public:
+  ALibraryContext() :
+    context(kahypar_context_new()),
+    hyperedge_indices({ 0, 2, 6, 9,  /*sentinel*/ 12 }),
+    hyperedges({ 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }),
+    partition(7, -1) { }
+
+  ~ALibraryContext() {
+    kahypar_context_free(context);
+  }
+
+  ALibraryContext(const ALibraryContext&) = delete;
+  ALibraryContext& operator= (const ALibraryContext&) = delete;
+
+  ALibraryContext(ALibraryContext&&) = delete;
+  ALibraryContext& operator= (ALibraryContext&&) = delete;
+
+  kahypar_hyperedge_weight_t cut() const {
+    kahypar_hyperedge_weight_t cut = 0;
+    for (size_t he = 0; he + 1 < hyperedge_indices.size(); ++he) {
+      std::set<kahypar_partition_id_t> blocks;
+      for (size_t i = hyperedge_indices[he]; i < hyperedge_indices[he + 1]; ++i) {
+        blocks.insert(partition[hyperedges[i]]);
+      }
+      cut += blocks.size() > 1;
+    }
+    return cut;
+  }
+
+  kahypar_context_t* context;
+  std::vector<size_t> hyperedge_indices;
+  std::vector<kahypar_hyperedge_id_t> hyperedges;
+  std::vector<kahypar_partition_id_t> partition;
+};
+
+TEST_F(ALibraryContext, PartitionsAHypergraphGivenAsArrays) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_OK));
+
+  std::vector<int> block_weights(2, 0);
+  for (const kahypar_partition_id_t block : partition) {
+    ASSERT_TRUE(block == 0 || block == 1);
+    ++block_weights[block];
+  }
+  ASSERT_THAT(block_weights[0], Le(4));
+  ASSERT_THAT(block_weights[1], Le(4));
+  // for k = 2, the km1 metric equals the cut
+  ASSERT_THAT(objective, Eq(cut()));
+}
+
+TEST_F(ALibraryContext, CanBeReusedForSeveralPartitions) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t first_objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &first_objective, context, partition.data());
+  const std::vector<kahypar_partition_id_t> first_partition = partition;
+
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_OK));
+  ASSERT_THAT(objective, Eq(first_objective));
+  ASSERT_THAT(partition, ::testing::ContainerEq(first_partition));
+}
+
+TEST_F(ALibraryContext, PartitionsHypergraphsOfDifferentSizesOneAfterAnother) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t first_objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &first_objective, context, partition.data());
+  const std::vector<kahypar_partition_id_t> first_partition = partition;
+
+  const std::vector<size_t> small_indices { 0, 2, 4 };
+  const std::vector<kahypar_hyperedge_id_t> small_hyperedges { 0, 1, 2, 3 };
+  const std::vector<kahypar_hyperedge_weight_t> small_weights { 5, 7 };
+  std::vector<kahypar_partition_id_t> small_partition(4, -1);
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(4, 2, 0.03, 2, nullptr, small_weights.data(),
+                                small_indices.data(), small_hyperedges.data(), &objective,
+                                context, small_partition.data()),
+              Eq(KAHYPAR_OK));
+  ASSERT_THAT(objective, Eq(0));
+
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_OK));
+  ASSERT_THAT(objective, Eq(first_objective));
+  ASSERT_THAT(partition, ::testing::ContainerEq(first_partition));
+}
+
+TEST_F(ALibraryContext, CanBeUsedByConcurrentPartitioners) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &objective, context, partition.data());
+
+  const size_t num_threads = 4;
+  std::vector<std::vector<kahypar_partition_id_t> > partitions(
+    num_threads, std::vector<kahypar_partition_id_t>(7, -1));
+  std::vector<kahypar_hyperedge_weight_t> objectives(num_threads, -1);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+        for (int run = 0; run < 10; ++run) {
+          kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                            hyperedges.data(), &objectives[i], context, partitions[i].data());
+        }
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < num_threads; ++i) {
+    ASSERT_THAT(objectives[i], Eq(objective));
+    ASSERT_THAT(partitions[i], ::testing::ContainerEq(partition));
+  }
+}
+
+static int cancelAndCount(void* data) {
+  ++*static_cast<int*>(data);
+  return 1;
+}
+
+TEST_F(ALibraryContext, ReturnsAPartitionIfTheCallIsCancelled) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  int num_polls = 0;
+  kahypar_set_cancel_callback(context, cancelAndCount, &num_polls);
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_OK));
+
+  ASSERT_THAT(num_polls, ::testing::Gt(0));
+  for (const kahypar_partition_id_t block : partition) {
+    ASSERT_TRUE(block == 0 || block == 1);
+  }
+  ASSERT_THAT(objective, Eq(cut()));
+
+  kahypar_set_cancel_callback(context, nullptr, nullptr);
+  const int num_polls_of_cancelled_call = num_polls;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &objective, context, partition.data());
+  ASSERT_THAT(num_polls, Eq(num_polls_of_cancelled_call));
+}
+
+static void recordProgress(const kahypar_progress_t* progress, void* data) {
+  static_cast<std::vector<kahypar_progress_t>*>(data)->push_back(*progress);
+}
+
+TEST_F(ALibraryContext, ReportsTheProgressOfEachPhase) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  std::vector<kahypar_progress_t> reports;
+  kahypar_set_progress_callback(context, recordProgress, 0.0, &reports);
+  kahypar_hyperedge_weight_t objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &objective, context, partition.data());
+
+  std::vector<kahypar_phase_t> phases;
+  for (size_t i = 0; i < reports.size(); ++i) {
+    phases.push_back(reports[i].phase);
+    if (i > 0) {
+      ASSERT_THAT(reports[i].elapsed_seconds, ::testing::Ge(reports[i - 1].elapsed_seconds));
+    }
+  }
+  ASSERT_THAT(phases, ::testing::ElementsAre(KAHYPAR_PHASE_PREPROCESSING,
+                                             KAHYPAR_PHASE_COARSENING,
+                                             KAHYPAR_PHASE_INITIAL_PARTITIONING,
+                                             KAHYPAR_PHASE_UNCOARSENING,
+                                             KAHYPAR_PHASE_FINISHED));
+  ASSERT_THAT(reports.front().km1, Eq(0));
+  ASSERT_THAT(reports.back().num_vertices, Eq(7));
+  ASSERT_THAT(reports.back().km1, Eq(objective));
+}
+
+TEST_F(ALibraryContext, KeepsThePartitionIfTheHypergraphDidNotChange) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t first_objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &first_objective, context, partition.data());
+  const std::vector<kahypar_partition_id_t> first_partition = partition;
+
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_repartition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                  hyperedges.data(), 0, nullptr, &objective, context,
+                                  partition.data()),
+              Eq(KAHYPAR_OK));
+  ASSERT_THAT(objective, Eq(first_objective));
+  ASSERT_THAT(partition, ::testing::ContainerEq(first_partition));
+}
+
+TEST_F(ALibraryContext, AssignsAddedVerticesWhenRepartitioning) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t first_objective = -1;
+  kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                    hyperedges.data(), &first_objective, context, partition.data());
+
+  // add vertex 7 and hyperedge {6, 7}
+  hyperedges.push_back(6);
+  hyperedges.push_back(7);
+  hyperedge_indices.push_back(14);
+  partition.push_back(-1);
+  const std::vector<kahypar_hypernode_id_t> changed_vertices { 6, 7 };
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_repartition(8, 5, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                  hyperedges.data(), changed_vertices.size(),
+                                  changed_vertices.data(), &objective, context,
+                                  partition.data()),
+              Eq(KAHYPAR_OK));
+
+  std::vector<int> block_weights(2, 0);
+  for (const kahypar_partition_id_t block : partition) {
+    ASSERT_TRUE(block == 0 || block == 1);
+    ++block_weights[block];
+  }
+  ASSERT_THAT(block_weights[0], Le(4));
+  ASSERT_THAT(block_weights[1], Le(4));
+  ASSERT_THAT(objective, Eq(cut()));
+  ASSERT_THAT(objective, Le(first_objective + 1));
+}
+
+TEST_F(ALibraryContext, RejectsAPreviousPartitionWithInvalidBlocks) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  partition = { 0, 0, 1, 0, 2, 1, 1 };
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_repartition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                  hyperedges.data(), 0, nullptr, &objective, context,
+                                  partition.data()),
+              Eq(KAHYPAR_INVALID_ARGUMENT));
+}
+
+TEST_F(ALibraryContext, MustBeConfiguredBeforePartitioning) {
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "missing.ini"),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+}
+
+// Writes a copy of the source preset in which from is replaced by to.
+static std::string writeModifiedPreset(const std::string& filename, const std::string& from,
+                                       const std::string& to,
+                                       const std::string& source = "km1_direct_kway_sea17.ini") {
+  std::ifstream preset(source);
+  std::stringstream buffer;
+  buffer << preset.rdbuf();
+  std::string content = buffer.str();
+  content.replace(content.find(from), from.size(), to);
+  std::ofstream(filename) << content;
+  return filename;
+}
+
+TEST_F(ALibraryContext, RejectsAPresetWithAnIllegalOptionValue) {
+  const std::string preset = writeModifiedPreset("misspelled.ini", "r-type=kway_fm_km1",
+                                                 "r-type=kway_fm_kmi");
+  ASSERT_THAT(kahypar_configure_context_from_file(context, preset.c_str()),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+}
+
+TEST_F(ALibraryContext, RejectsAPresetWithoutPartitioningMode) {
+  const std::string preset = writeModifiedPreset("without_mode.ini", "mode=direct", "");
+  ASSERT_THAT(kahypar_configure_context_from_file(context, preset.c_str()),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+}
+
+TEST_F(ALibraryContext, RejectsTwoWayFMForDirectKWayPartitioningWithoutPrompting) {
+  const std::string preset = writeModifiedPreset("direct_twoway.ini", "r-type=kway_fm_km1",
+                                                 "r-type=twoway_fm");
+  ASSERT_THAT(kahypar_configure_context_from_file(context, preset.c_str()), Eq(KAHYPAR_OK));
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 3, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_INVALID_CONTEXT));
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_OK));
+}
+
+TEST_F(ALibraryContext, RejectsPinsOutsideOfTheVertexRange) {
+  ASSERT_THAT(kahypar_configure_context_from_file(context, "km1_direct_kway_sea17.ini"),
+              Eq(KAHYPAR_OK));
+  hyperedges[5] = 7;
+  kahypar_hyperedge_weight_t objective = -1;
+  ASSERT_THAT(kahypar_partition(7, 4, 0.03, 2, nullptr, nullptr, hyperedge_indices.data(),
+                                hyperedges.data(), &objective, context, partition.data()),
+              Eq(KAHYPAR_INVALID_HYPERGRAPH));
+}
+
+TEST_F(ALibraryContext, OffersTheHMetisInterface) {
+  std::vector<int> eptr(hyperedge_indices.begin(), hyperedge_indices.end());
+  std::vector<int> eind(hyperedges.begin(), hyperedges.end());
+  int options[9] { 1, 1, 1, 1, 1, 0, 0, -1, 0 };
+
+  int edgecut = -1;
+  HMETIS_PartRecursive(7, 4, nullptr, eptr.data(), eind.data(), nullptr, 2, 5, options,
+                       partition.data(), &edgecut);
+  ASSERT_THAT(edgecut, Eq(cut()));
+
+  HMETIS_PartKway(7, 4, nullptr, eptr.data(), eind.data(), nullptr, 2, 5, options,
+                  partition.data(), &edgecut);
+  ASSERT_THAT(edgecut, Eq(cut()));
+}
+
+TEST_F(ALibraryContext, UsesTheCutRefinerInTheHMetisKWayInterface) {
+  // Random nets of three to five pins, on which the refiners for cut and km1
+  // end in different partitions.
+  const int num_vertices = 2000;
+  std::mt19937 random(42);
+  hyperedge_indices = { 0 };
+  hyperedges.clear();
+  for (int he = 0; he < num_vertices; ++he) {
+    const size_t size = 3 + random() % 3;
+    while (hyperedges.size() < hyperedge_indices.back() + size) {
+      const kahypar_hypernode_id_t pin = random() % num_vertices;
+      if (std::find(hyperedges.begin() + hyperedge_indices.back(), hyperedges.end(), pin) ==
+          hyperedges.end()) {
+        hyperedges.push_back(pin);
+      }
+    }
+    hyperedge_indices.push_back(hyperedges.size());
+  }
+
+  const auto partition_with = [&](const std::string& preset) {
+      kahypar_context_t* preset_context = kahypar_context_new();
+      kahypar_configure_context_from_file(preset_context, preset.c_str());
+      kahypar_set_seed(preset_context, 1);
+      std::vector<kahypar_partition_id_t> preset_partition(num_vertices, -1);
+      kahypar_hyperedge_weight_t objective = -1;
+      kahypar_partition(num_vertices, num_vertices, 0.03, 4, nullptr, nullptr,
+                        hyperedge_indices.data(), hyperedges.data(), &objective,
+                        preset_context, preset_partition.data());
+      kahypar_context_free(preset_context);
+      return preset_partition;
+    };
+  const std::string cut_preset = writeModifiedPreset("cut_direct_kway.ini", "objective=km1",
+                                                     "objective=cut");
+  const std::vector<kahypar_partition_id_t> km1_refiner_partition = partition_with(cut_preset);
+  const std::vector<kahypar_partition_id_t> cut_refiner_partition =
+    partition_with(writeModifiedPreset("cut_direct_kway_fm.ini", "r-type=kway_fm_km1",
+                                       "r-type=kway_fm", cut_preset));
+  ASSERT_NE(km1_refiner_partition, cut_refiner_partition);
+
+  std::vector<int> eptr(hyperedge_indices.begin(), hyperedge_indices.end());
+  std::vector<int> eind(hyperedges.begin(), hyperedges.end());
+  int options[9] { 1, 1, 1, 1, 1, 0, 0, 1, 0 };
+  int edgecut = -1;
+  partition.assign(num_vertices, -1);
+  HMETIS_PartKway(num_vertices, num_vertices, nullptr, eptr.data(), eind.data(), nullptr, 4, 3,
+                  options, partition.data(), &edgecut);
+  ASSERT_THAT(partition, ::testing::ContainerEq(cut_refiner_partition));
+  ASSERT_THAT(edgecut, Eq(cut()));
+}
+}  // namespace kahypar
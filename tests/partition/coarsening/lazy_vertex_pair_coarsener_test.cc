@@ -82,6 +82,18 @@ TEST_F(ACoarsener, DoesNotCoarsenUntilCoarseningLimit) {
   doesNotCoarsenUntilCoarseningLimit(coarsener, hypergraph, context);
 }
 
+TEST_F(ACoarsener, StopsCoarseningOnceTheTimeBudgetIsExhausted) {
+  stopsCoarseningOnceTheTimeBudgetIsExhausted(coarsener, hypergraph, context);
+}
+
+TEST(ACoarseningHierarchy, CanBeReplayedByAnotherCoarsener) {
+  replaysTheContractionsOfAPreviousCoarsening<CoarsenerType>();
+}
+
+TEST(ACoarseningHierarchy, IsOnlyReplayedUntilTheContractionLimit) {
+  stopsReplayingAtTheContractionLimit<CoarsenerType>();
+}
+
 TEST(ALazyUpdateCoarsener, InvalidatesAdjacentHypernodesInsteadOfReratingThem) {
   Hypergraph hypergraph(5, 2, HyperedgeIndexVector { 0, 2,  /*sentinel*/ 7 },
                         HyperedgeVector { 0, 1, 0, 1, 2, 3, 4 });
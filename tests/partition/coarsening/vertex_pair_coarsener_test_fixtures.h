@@ -272,4 +272,62 @@ void doesNotCoarsenUntilCoarseningLimit(Coarsener& coarsener, HypergraphT& hyper
   }
   ASSERT_THAT(hypergraph->currentNumNodes(), Eq(3));
 }
+
+template <class Coarsener, class HypergraphT>
+void stopsCoarseningOnceTheTimeBudgetIsExhausted(Coarsener& coarsener, HypergraphT& hypergraph,
+                                                 Context& context) {
+  context.partition.cancel = []() {
+                               return true;
+                             };
+  coarsener.coarsen(2);
+  ASSERT_THAT(hypergraph->currentNumNodes(), Eq(7));
+}
+
+template <class CoarsenerType>
+void replaysTheContractionsOfAPreviousCoarsening() {
+  Context context;
+  context.coarsening.max_allowed_node_weight = 5;
+  Hypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                        HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  Hypergraph replayed_hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                                 HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  CoarsenerType coarsener(hypergraph, context,  /* heaviest_node_weight */ 1);
+  CoarsenerType replaying_coarsener(replayed_hypergraph, context,  /* heaviest_node_weight */ 1);
+
+  coarsener.coarsen(2);
+  ASSERT_THAT(replaying_coarsener.replay(coarsener.history(), 2), Eq(coarsener.history().size()));
+
+  ASSERT_THAT(replayed_hypergraph.currentNumNodes(), Eq(hypergraph.currentNumNodes()));
+  ASSERT_THAT(replayed_hypergraph.currentNumEdges(), Eq(hypergraph.currentNumEdges()));
+  ASSERT_THAT(replayed_hypergraph.currentNumPins(), Eq(hypergraph.currentNumPins()));
+  for (HypernodeID hn = 0; hn < hypergraph.initialNumNodes(); ++hn) {
+    ASSERT_THAT(replayed_hypergraph.nodeIsEnabled(hn), Eq(hypergraph.nodeIsEnabled(hn)));
+    if (hypergraph.nodeIsEnabled(hn)) {
+      ASSERT_THAT(replayed_hypergraph.nodeWeight(hn), Eq(hypergraph.nodeWeight(hn)));
+    }
+  }
+  for (HyperedgeID he = 0; he < hypergraph.initialNumEdges(); ++he) {
+    ASSERT_THAT(replayed_hypergraph.edgeIsEnabled(he), Eq(hypergraph.edgeIsEnabled(he)));
+    if (hypergraph.edgeIsEnabled(he)) {
+      ASSERT_THAT(replayed_hypergraph.edgeWeight(he), Eq(hypergraph.edgeWeight(he)));
+    }
+  }
+}
+
+template <class CoarsenerType>
+void stopsReplayingAtTheContractionLimit() {
+  Context context;
+  context.coarsening.max_allowed_node_weight = 5;
+  Hypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                        HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  Hypergraph replayed_hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                                 HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  CoarsenerType coarsener(hypergraph, context,  /* heaviest_node_weight */ 1);
+  CoarsenerType replaying_coarsener(replayed_hypergraph, context,  /* heaviest_node_weight */ 1);
+
+  coarsener.coarsen(2);
+  ASSERT_THAT(replaying_coarsener.replay(coarsener.history(), 5), Eq(2));
+  ASSERT_THAT(replayed_hypergraph.currentNumNodes(), Eq(5));
+  ASSERT_THAT(replaying_coarsener.history().size(), Eq(2));
+}
 }  // namespace kahypar
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/context.h"
+#include "kahypar/partition/memory_limit.h"
+
+using ::testing::Test;
+using ::testing::Eq;
+using ::testing::Gt;
+
+namespace kahypar {
+namespace memory {
+class AMemoryLimit : public Test {
+ public:
+  AMemoryLimit() :
+    context(),
+    estimate() {
+    context.partition.k = 32;
+    context.partition.mode = Mode::direct_kway;
+    context.partition.objective = Objective::cut;
+    context.partition.quiet_mode = true;
+    context.preprocessing.enable_min_hash_sparsifier = true;
+    context.preprocessing.enable_community_detection = true;
+    context.coarsening.contraction_limit_multiplier = 160;
+    context.local_search.algorithm = RefinementAlgorithm::kway_fm;
+    context.initial_partitioning.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  }
+
+  size_t totalWith(const RefinementAlgorithm algorithm) {
+    Context lean(context);
+    lean.preprocessing.enable_min_hash_sparsifier = false;
+    lean.preprocessing.enable_community_detection = false;
+    lean.local_search.algorithm = algorithm;
+    return memory::estimate(kNumHypernodes, kNumHyperedges, kNumPins, false, lean).total();
+  }
+
+  static constexpr HypernodeID kNumHypernodes = 1000000;
+  static constexpr HyperedgeID kNumHyperedges = 1000000;
+  static constexpr size_t kNumPins = 4000000;
+  Context context;
+  MemoryEstimate estimate;
+};
+
+TEST_F(AMemoryLimit, EstimatesMoreMemoryForMoreBlocks) {
+  const size_t total = memory::estimate(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                                        context).total();
+  context.partition.k = 64;
+  ASSERT_THAT(memory::estimate(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                               context).total(), Gt(total));
+}
+
+TEST_F(AMemoryLimit, KeepsTheConfigurationIfTheEstimateFits) {
+  context.partition.memory_limit = 1024 * 1024;
+  ASSERT_TRUE(fitIntoMemoryLimit(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                                 context, estimate));
+  ASSERT_TRUE(context.preprocessing.enable_min_hash_sparsifier);
+  ASSERT_TRUE(context.preprocessing.enable_community_detection);
+  ASSERT_THAT(context.local_search.algorithm, Eq(RefinementAlgorithm::kway_fm));
+}
+
+TEST_F(AMemoryLimit, DisablesTheSparsifierBeforeChangingTheRefiner) {
+  context.partition.memory_limit = totalWith(RefinementAlgorithm::kway_fm) / kBytesPerMB + 1;
+  ASSERT_TRUE(fitIntoMemoryLimit(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                                 context, estimate));
+  ASSERT_FALSE(context.preprocessing.enable_min_hash_sparsifier);
+  ASSERT_THAT(context.local_search.algorithm, Eq(RefinementAlgorithm::kway_fm));
+}
+
+TEST_F(AMemoryLimit, UsesLabelPropagationInsteadOfKWayFMForTheCutObjective) {
+  context.partition.memory_limit = totalWith(RefinementAlgorithm::label_propagation) /
+                                   kBytesPerMB + 1;
+  ASSERT_TRUE(fitIntoMemoryLimit(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                                 context, estimate));
+  ASSERT_THAT(context.local_search.algorithm, Eq(RefinementAlgorithm::label_propagation));
+  ASSERT_THAT(estimate.total(), Eq(totalWith(RefinementAlgorithm::label_propagation)));
+}
+
+TEST_F(AMemoryLimit, KeepsTheKm1RefinerAndFailsIfTheLimitIsTooSmall) {
+  context.partition.objective = Objective::km1;
+  context.local_search.algorithm = RefinementAlgorithm::kway_fm_km1;
+  context.partition.memory_limit = totalWith(RefinementAlgorithm::kway_fm_km1) / kBytesPerMB - 1;
+  ASSERT_FALSE(fitIntoMemoryLimit(kNumHypernodes, kNumHyperedges, kNumPins, true,
+                                  context, estimate));
+  ASSERT_THAT(context.local_search.algorithm, Eq(RefinementAlgorithm::kway_fm_km1));
+  ASSERT_THAT(estimate.total(), Gt(context.partition.memory_limit * kBytesPerMB));
+}
+}  // namespace memory
+}  // namespace kahypar
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "kahypar/application/command_line_options.h"
+#include "kahypar/definitions.h"
+#include "kahypar/io/coarsening_hierarchy_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/coarsening/coarsening_hierarchy.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/partitioner_session.h"
+
+using ::testing::Test;
+using ::testing::Gt;
+using ::testing::Le;
+using ::testing::ContainerEq;
+
+namespace kahypar {
+class APartitionerSession : public Test {
+ public:
+  APartitionerSession() :
+    session(),
+    context(),
+    hyperedge_offsets(),
+    pins() {
+    parseIniToContext(context, "km1_direct_kway_sea17.ini");
+    context.partition.epsilon = 0.03;
+    context.partition.seed = 1;
+    context.partition.rb_lower_k = 0;
+    context.partition.rb_upper_k = 0;
+    context.partition.quiet_mode = true;
+
+    // grid of kRows x kColumns hypernodes, each net connects a hypernode
+    // with its right and lower neighbor
+    hyperedge_offsets.push_back(0);
+    for (HypernodeID row = 0; row < kRows; ++row) {
+      for (HypernodeID column = 0; column < kColumns; ++column) {
+        const HypernodeID hn = row * kColumns + column;
+        pins.push_back(hn);
+        if (column + 1 < kColumns) {
+          pins.push_back(hn + 1);
+        }
+        if (row + 1 < kRows) {
+          pins.push_back(hn + kColumns);
+        }
+        hyperedge_offsets.push_back(pins.size());
+      }
+    }
+  }
+
+  std::vector<PartitionID> partition(const PartitionID k, const int seed,
+                                     CoarseningHierarchy& hierarchy) {
+    Context run_context(context);
+    run_context.partition.k = k;
+    run_context.partition.seed = seed;
+    const Hypergraph& hypergraph = session.setHypergraph(kRows * kColumns, kRows * kColumns,
+                                                         hyperedge_offsets.data(), pins.data(),
+                                                         k);
+    session.partition(run_context, hierarchy);
+    return partIDs(hypergraph);
+  }
+
+  // Improves the given partition for k = 4 and returns the km1 metric of the
+  // given and of the improved partition.
+  std::pair<HyperedgeWeight, HyperedgeWeight> improve(const std::vector<PartitionID>& partition,
+                                                      Context& run_context) {
+    run_context.partition.k = 4;
+    Hypergraph& hypergraph = session.setHypergraph(kRows * kColumns, kRows * kColumns,
+                                                   hyperedge_offsets.data(), pins.data(), 4);
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      hypergraph.setNodePart(hn, partition[hn]);
+    }
+    const HyperedgeWeight initial_km1 = metrics::km1(hypergraph);
+    session.improve(run_context);
+    return std::make_pair(initial_km1, metrics::km1(hypergraph));
+  }
+
+  bool isBalanced(const Context& run_context) const {
+    for (PartitionID part = 0; part < run_context.partition.k; ++part) {
+      if (session.hypergraph().partWeight(part) > run_context.partition.max_part_weights[part]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Partitions with --c-hierarchy-file, i.e., only the file is shared with
+  // other calls.
+  std::vector<PartitionID> partitionWithHierarchyFile(const PartitionID k, const int seed) {
+    Context run_context(context);
+    return partitionWithHierarchyFile(k, seed, run_context);
+  }
+
+  std::vector<PartitionID> partitionWithHierarchyFile(const PartitionID k, const int seed,
+                                                      Context& run_context) {
+    run_context.partition.k = k;
+    run_context.partition.seed = seed;
+    run_context.coarsening.hierarchy_file = kHierarchyFile;
+    const Hypergraph& hypergraph = session.setHypergraph(kRows * kColumns, kRows * kColumns,
+                                                         hyperedge_offsets.data(), pins.data(),
+                                                         k);
+    session.partition(run_context);
+    return partIDs(hypergraph);
+  }
+
+  static CoarseningHierarchy storedHierarchy() {
+    CoarseningHierarchy hierarchy;
+    EXPECT_TRUE(io::readCoarseningHierarchyFile(kHierarchyFile, hierarchy).ok());
+    return hierarchy;
+  }
+
+  static std::vector<PartitionID> partIDs(const Hypergraph& hypergraph) {
+    std::vector<PartitionID> part_ids;
+    for (const HypernodeID& hn : hypergraph.nodes()) {
+      part_ids.push_back(hypergraph.partID(hn));
+    }
+    return part_ids;
+  }
+
+  static std::vector<std::pair<HypernodeID, HypernodeID> > contractions(
+    const CoarseningHierarchy& hierarchy) {
+    std::vector<std::pair<HypernodeID, HypernodeID> > pairs;
+    for (const CoarseningMemento& memento : hierarchy.history) {
+      pairs.emplace_back(memento.contraction_memento.u, memento.contraction_memento.v);
+    }
+    return pairs;
+  }
+
+  static constexpr const char* kHierarchyFile = "partitioner_session_test.hierarchy";
+  static constexpr HypernodeID kRows = 40;
+  static constexpr HypernodeID kColumns = 50;
+  PartitionerSession session;
+  Context context;
+  std::vector<size_t> hyperedge_offsets;
+  std::vector<HypernodeID> pins;
+};
+
+TEST_F(APartitionerSession, PartitionsTheLargestKOfASweepLikeASingleRun) {
+  CoarseningHierarchy hierarchy;
+  const std::vector<PartitionID> sweep_partition = partition(4, 1, hierarchy);
+  ASSERT_THAT(hierarchy.history.size(), Gt(0));
+
+  Hypergraph hypergraph(kRows * kColumns, kRows * kColumns, HyperedgeIndexVector(
+                          hyperedge_offsets.begin(), hyperedge_offsets.end()),
+                        HyperedgeVector(pins.begin(), pins.end()), 4);
+  Context single_run_context(context);
+  single_run_context.partition.k = 4;
+  Randomize::instance().setSeed(single_run_context.partition.seed);
+  Partitioner().partition(hypergraph, single_run_context);
+
+  ASSERT_THAT(partIDs(hypergraph), ContainerEq(sweep_partition));
+}
+
+TEST_F(APartitionerSession, ReplaysTheHierarchyOfTheLargerKInsteadOfRecomputingIt) {
+  CoarseningHierarchy hierarchy;
+  partition(4, 1, hierarchy);
+
+  // A hierarchy computed with another seed is recognizably different. If it
+  // is passed off as the hierarchy of seed 1, a run for a smaller k has to
+  // start from its contractions instead of recomputing them.
+  CoarseningHierarchy other_hierarchy;
+  partition(4, 2, other_hierarchy);
+  const std::vector<std::pair<HypernodeID, HypernodeID> > stored = contractions(other_hierarchy);
+  ASSERT_NE(stored, contractions(hierarchy));
+  other_hierarchy.configuration = hierarchy.configuration;
+
+  partition(2, 1, other_hierarchy);
+  const std::vector<std::pair<HypernodeID, HypernodeID> > extended =
+    contractions(other_hierarchy);
+  ASSERT_THAT(extended.size(), Gt(stored.size()));
+  ASSERT_TRUE(std::equal(stored.begin(), stored.end(), extended.begin()));
+}
+
+TEST_F(APartitionerSession, DoesNotWorsenAFeasiblePartitionWhenImprovingIt) {
+  // horizontal stripes of ten rows each are balanced and already good
+  std::vector<PartitionID> stripes;
+  for (HypernodeID hn = 0; hn < kRows * kColumns; ++hn) {
+    stripes.push_back(hn / (kRows * kColumns / 4));
+  }
+  Context run_context(context);
+  const std::pair<HyperedgeWeight, HyperedgeWeight> km1 = improve(stripes, run_context);
+  ASSERT_THAT(km1.second, Le(km1.first));
+  ASSERT_TRUE(isBalanced(run_context));
+}
+
+TEST_F(APartitionerSession, DoesNotWorsenThePartitionOfAPreviousRunWhenImprovingIt) {
+  CoarseningHierarchy hierarchy;
+  const std::vector<PartitionID> previous_partition = partition(4, 2, hierarchy);
+  Context run_context(context);
+  const std::pair<HyperedgeWeight, HyperedgeWeight> km1 = improve(previous_partition,
+                                                                  run_context);
+  ASSERT_THAT(km1.second, Le(km1.first));
+  ASSERT_TRUE(isBalanced(run_context));
+}
+
+TEST_F(APartitionerSession, ReproducesAPartitionFromAStoredHierarchyFile) {
+  std::remove(kHierarchyFile);
+  const std::vector<PartitionID> first_partition = partitionWithHierarchyFile(4, 1);
+  const CoarseningHierarchy first_hierarchy = storedHierarchy();
+  ASSERT_THAT(first_hierarchy.history.size(), Gt(0));
+  ASSERT_THAT(partitionWithHierarchyFile(4, 1), ContainerEq(first_partition));
+
+  // The hierarchy of another seed, passed off as the one of seed 1, leads to
+  // the partition of the other seed, since its random state is restored too.
+  std::remove(kHierarchyFile);
+  const std::vector<PartitionID> other_partition = partitionWithHierarchyFile(4, 2);
+  ASSERT_NE(other_partition, first_partition);
+  CoarseningHierarchy other_hierarchy = storedHierarchy();
+  other_hierarchy.configuration = first_hierarchy.configuration;
+  ASSERT_TRUE(io::writeCoarseningHierarchyFile(other_hierarchy, kHierarchyFile).ok());
+  ASSERT_THAT(partitionWithHierarchyFile(4, 1), ContainerEq(other_partition));
+  std::remove(kHierarchyFile);
+}
+
+TEST_F(APartitionerSession, ExtendsAStoredHierarchyFileForASmallerK) {
+  std::remove(kHierarchyFile);
+  partitionWithHierarchyFile(4, 1);
+  const std::vector<std::pair<HypernodeID, HypernodeID> > stored =
+    contractions(storedHierarchy());
+
+  partitionWithHierarchyFile(2, 1);
+  const std::vector<std::pair<HypernodeID, HypernodeID> > extended =
+    contractions(storedHierarchy());
+  ASSERT_THAT(extended.size(), Gt(stored.size()));
+  ASSERT_TRUE(std::equal(stored.begin(), stored.end(), extended.begin()));
+  std::remove(kHierarchyFile);
+}
+
+TEST_F(APartitionerSession, ResumesFromAPartiallyReplayedHierarchyFile) {
+  // A larger k stops coarsening earlier, so only a prefix of the stored
+  // contractions is replayed.
+  std::remove(kHierarchyFile);
+  partitionWithHierarchyFile(2, 1);
+  const std::vector<std::pair<HypernodeID, HypernodeID> > stored =
+    contractions(storedHierarchy());
+
+  Context run_context(context);
+  const std::vector<PartitionID> resumed_partition = partitionWithHierarchyFile(4, 1,
+                                                                                run_context);
+  ASSERT_TRUE(isBalanced(run_context));
+  ASSERT_THAT(partitionWithHierarchyFile(4, 1), ContainerEq(resumed_partition));
+  ASSERT_THAT(contractions(storedHierarchy()), ContainerEq(stored));
+  std::remove(kHierarchyFile);
+}
+}  // namespace kahypar
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+
+using ::testing::Eq;
+using ::testing::ElementsAre;
+using ::testing::Test;
+
+namespace kahypar {
+class AKwayGainCache : public Test {
+ public:
+  AKwayGainCache() :
+    cache(3, 8) { }
+
+  std::vector<PartitionID> adjacentParts(const HypernodeID hn) const {
+    return std::vector<PartitionID>(cache.adjacentParts(hn).begin(),
+                                    cache.adjacentParts(hn).end());
+  }
+
+  KwayGainCache<Gain> cache;
+};
+
+TEST_F(AKwayGainCache, StoresAdjacentPartsDensely) {
+  cache.initializeEntry(1, 5, 10);
+  cache.initializeEntry(1, 2, 20);
+  cache.initializeEntry(1, 7, 30);
+  ASSERT_THAT(adjacentParts(1), ElementsAre(5, 2, 7));
+  ASSERT_THAT(cache.entry(1, 2), Eq(20));
+  ASSERT_THAT(cache.entryExists(1, 3), Eq(false));
+  ASSERT_THAT(cache.entry(1, 3), Eq(KwayGainCache<Gain>::kNotCached));
+  ASSERT_THAT(adjacentParts(0), ElementsAre());
+}
+
+TEST_F(AKwayGainCache, KeepsGainsOfRemainingPartsOnRemoval) {
+  cache.initializeEntry(1, 5, 10);
+  cache.initializeEntry(1, 2, 20);
+  cache.initializeEntry(1, 7, 30);
+  cache.removeEntryDueToConnectivityDecrease(1, 5);
+  ASSERT_THAT(adjacentParts(1), ElementsAre(7, 2));
+  ASSERT_THAT(cache.entry(1, 7), Eq(30));
+  ASSERT_THAT(cache.entry(1, 2), Eq(20));
+  ASSERT_THAT(cache.entryExists(1, 5), Eq(false));
+}
+
+TEST_F(AKwayGainCache, UpdatesAllEntriesExceptTheExcludedPart) {
+  cache.initializeEntry(1, 5, 10);
+  cache.initializeEntry(1, 2, 20);
+  cache.initializeEntry(1, 7, 30);
+  cache.updateExistingEntriesExcept(1, 2, 5);
+  ASSERT_THAT(cache.entry(1, 5), Eq(15));
+  ASSERT_THAT(cache.entry(1, 2), Eq(20));
+  ASSERT_THAT(cache.entry(1, 7), Eq(35));
+  cache.updateExistingEntriesExcept(1, Hypergraph::kInvalidPartition, -1);
+  ASSERT_THAT(cache.entry(1, 5), Eq(14));
+  ASSERT_THAT(cache.entry(1, 2), Eq(19));
+  ASSERT_THAT(cache.entry(1, 7), Eq(34));
+}
+
+TEST_F(AKwayGainCache, RestoresPreviousStateOnRollback) {
+  cache.initializeEntry(1, 5, 10);
+  cache.initializeEntry(1, 2, 20);
+  cache.initializeEntry(2, 3, 7);
+  cache.resetDelta();
+
+  cache.updateExistingEntriesExcept(1, 5, 3);
+  cache.removeEntryDueToConnectivityDecrease(1, 5);
+  cache.addEntryDueToConnectivityIncrease(1, 6, 4);
+  cache.updateExistingEntriesExcept(1, Hypergraph::kInvalidPartition, 2);
+  cache.updateExistingEntry(2, 3, -1);
+  cache.updateFromAndToPartOfMovedHN(2, 1, 3, true);
+  cache.rollbackDelta();
+
+  ASSERT_THAT(cache.entry(1, 5), Eq(10));
+  ASSERT_THAT(cache.entry(1, 2), Eq(20));
+  ASSERT_THAT(cache.entryExists(1, 6), Eq(false));
+  ASSERT_THAT(cache.entry(2, 3), Eq(7));
+  ASSERT_THAT(cache.entryExists(2, 1), Eq(false));
+  ASSERT_THAT(adjacentParts(2), ElementsAre(3));
+}
+
+TEST_F(AKwayGainCache, IsEmptyAfterClear) {
+  cache.initializeEntry(1, 5, 10);
+  cache.initializeEntry(1, 2, 20);
+  cache.clear(1);
+  ASSERT_THAT(adjacentParts(1), ElementsAre());
+  ASSERT_THAT(cache.entryExists(1, 5), Eq(false));
+  ASSERT_THAT(cache.entry(1, 2), Eq(KwayGainCache<Gain>::kNotCached));
+}
+}  // namespace kahypar
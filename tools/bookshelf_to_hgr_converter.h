@@ -30,13 +30,15 @@
 #include <vector>
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/gzip_file_reader.h"
 #include "kahypar/macros.h"
+#include "tools/streaming_conversion.h"
 
 using kahypar::HypernodeID;
 
 static inline void convertBookshelfToHgr(const std::string& bookshelf_source_filename,
                                          const std::string& hgr_target_filename) {
-  std::ifstream bookshelf_stream(bookshelf_source_filename);
+  kahypar::io::InputFileStream bookshelf_stream(bookshelf_source_filename);
   std::string line;
 
   // get header line
@@ -66,8 +68,13 @@ static inline void convertBookshelfToHgr(const std::string& bookshelf_source_fil
   // skip empty line
   std::getline(bookshelf_stream, line);
 
+  // Hyperedges are written as soon as they are parsed. Only the mapping
+  // from node names to hypernode IDs is kept in memory.
+  kahypar::streaming::StreamingHypergraphWriter writer(
+    hgr_target_filename, kahypar::streaming::outputFormatFromFilename(hgr_target_filename));
+  kahypar::io::IOStatus status = writer.open();
   std::unordered_map<std::string, HypernodeID> node_to_hn;
-  std::vector<std::vector<HypernodeID> > hyperedges;
+  std::vector<HypernodeID> hyperedge;
 
   // since netlists can contain nets with duplicate pins
   // we use this set to make sure that we have each pin only
@@ -84,7 +91,7 @@ static inline void convertBookshelfToHgr(const std::string& bookshelf_source_fil
   while (std::getline(bookshelf_stream, line)) {
     ALWAYS_ASSERT(line.substr(0, 9) == "NetDegree", "Error");
     // new hyperedge
-    hyperedges.emplace_back(std::vector<HypernodeID>());
+    hyperedge.clear();
     contained_pins.clear();
 
     std::regex_search(line, match, digit_regex);
@@ -98,7 +105,7 @@ static inline void convertBookshelfToHgr(const std::string& bookshelf_source_fil
       if (entry != node_to_hn.end()) {
         ALWAYS_ASSERT(entry->second < num_hypernodes, "Error");
         if (contained_pins.find(entry->second) == contained_pins.end()) {
-          hyperedges.back().push_back(entry->second);
+          hyperedge.push_back(entry->second);
           contained_pins.insert(entry->second);
           ++num_actual_pins;
         } else {
@@ -106,32 +113,27 @@ static inline void convertBookshelfToHgr(const std::string& bookshelf_source_fil
         }
       } else {
         ALWAYS_ASSERT(contained_pins.find(num_hypernodes) == contained_pins.end(), "Error");
-        hyperedges.back().push_back(num_hypernodes);
+        hyperedge.push_back(num_hypernodes);
         contained_pins.insert(num_hypernodes);
         node_to_hn[match.str()] = num_hypernodes++;
         ++num_actual_pins;
       }
     }
+    ALWAYS_ASSERT(!hyperedge.empty(), "Instance contains empty hypereges");
+    writer.addHyperedge(hyperedge);
   }
 
   bookshelf_stream.close();
 
   // sanity check
-  ALWAYS_ASSERT(num_hyperedges == hyperedges.size(), "wrong # HEs");
+  ALWAYS_ASSERT(num_hyperedges == writer.numHyperedges(), "wrong # HEs");
   ALWAYS_ASSERT(num_actual_pins + num_duplicate_pins == num_pins, "wrong # pins");
 
-  std::ofstream out_stream(hgr_target_filename.c_str());
-  out_stream << num_hyperedges << " " << num_hypernodes << std::endl;
-  for (const auto& hyperedge : hyperedges) {
-    ALWAYS_ASSERT(!hyperedge.empty(), "Instance contains empty hypereges");
-    for (auto pin_iter = hyperedge.cbegin(); pin_iter != hyperedge.cend(); ++pin_iter) {
-      // hgr format is 1-based;
-      out_stream << (*pin_iter + 1);
-      if (pin_iter + 1 != hyperedge.end()) {
-        out_stream << " ";
-      }
-    }
-    out_stream << std::endl;
+  if (status.ok()) {
+    status = writer.close(num_hypernodes);
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    std::exit(-1);
   }
-  out_stream.close();
 }
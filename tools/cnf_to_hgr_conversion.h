@@ -21,15 +21,24 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <iostream>
 #include <sstream>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 #include <vector>
 
+#include "kahypar/definitions.h"
+#include "kahypar/io/gzip_file_reader.h"
 #include "kahypar/macros.h"
+#include "tools/streaming_conversion.h"
 
 namespace cnfconversion {
+using kahypar::HyperedgeID;
+using kahypar::HypernodeID;
+
 // Convert a SAT instance from simplified DIMACS format
 // (http://www.satcompetition.org/2009/format-benchmarks2009.html) to hMetis HGR format.
 
@@ -71,133 +80,126 @@ static inline std::string toString(const HypergraphRepresentation& rep) {
 
 struct PrimalRepresentationTag { };
 struct DualRepresentationTag { };
+struct LiteralRepresentationTag { };
 
-using Hyperedges = std::vector<std::vector<uint64_t> >;
-
-static inline void writeHGRFile(const Hyperedges& hyperedges,
-                                const uint64_t num_hyperedges,
-                                const uint64_t num_hypernodes,
-                                const std::string& hgr_target_filename) {
-  std::ofstream out_stream(hgr_target_filename.c_str());
-  out_stream << num_hyperedges << " " << num_hypernodes << std::endl;
-  uint64_t num_nonempty_hes = 0;
-  for (const auto& hyperedge : hyperedges) {
-    if (!hyperedge.empty()) {
-      for (auto pin_iter = hyperedge.cbegin(); pin_iter != hyperedge.cend(); ++pin_iter) {
-        out_stream << *pin_iter;
-        if (pin_iter + 1 != hyperedge.end()) {
-          out_stream << " ";
-        }
-      }
-      out_stream << std::endl;
-      ++num_nonempty_hes;
+// Calls f for each non-zero literal of a clause line.
+template <typename F>
+static inline void forEachLiteral(const std::string& line, F f) {
+  const char* pos = line.c_str();
+  char* end = nullptr;
+  while (true) {
+    const int64_t literal = std::strtoll(pos, &end, 10);
+    if (end == pos) {
+      break;
     }
+    if (literal != 0) {
+      f(literal);
+    }
+    pos = end;
   }
-  out_stream.close();
-  if (num_nonempty_hes != num_hyperedges) {
-    std::remove(hgr_target_filename.c_str());
-    std::cerr << "Hypergraph contained empty hyperedges" << std::endl;
+}
+
+static inline void abortOnError(const kahypar::io::IOStatus& status) {
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
     exit(-1);
   }
 }
 
-static inline void convertToLiteral(std::ifstream& cnf_file,
-                                    const uint64_t num_variables,
-                                    const uint64_t num_clauses,
-                                    const std::string& hgr_target_filename) {
+static inline void abortOnEmptyHyperedge(const std::string& hgr_target_filename) {
+  std::remove(hgr_target_filename.c_str());
+  std::cerr << "Hypergraph contained empty hyperedges" << std::endl;
+  exit(-1);
+}
+
+// Primal and literal representation: each clause is written as hyperedge as
+// soon as it is parsed. Hypernode IDs are assigned in order of first occurrence.
+template <typename T>
+static inline bool writeClauseHyperedges(std::istream& cnf_file,
+                                         const uint64_t num_variables,
+                                         const uint64_t num_clauses,
+                                         kahypar::streaming::StreamingHypergraphWriter& writer,
+                                         HypernodeID& num_hypernodes) {
+  const bool literal_representation = !std::is_same<T, PrimalRepresentationTag>::value;
   // number of literals = 2x number of variables
-  int num_possible_literals = 2 * num_variables;
+  const uint64_t num_possible_literals = literal_representation ? 2 * num_variables :
+                                         num_variables;
   LOG << V(num_possible_literals);
 
-  Hyperedges hyperedges(num_clauses);
-
-  // In HGR format, the HNs are numbered 1...N.
-  // Since we don't know, how many of the possible 2 * num_variables
-  // literals will be used, we use this map to store the mapping from
-  // literal to hypernode id.
-  std::unordered_map<int64_t, int64_t> literal_to_hypernode;
-
-  int64_t literal = -1;
-  int64_t num_hypernodes = 0;
+  // Since we don't know, which of the possible literals (or variables) will
+  // be used, we store the mapping to hypernode IDs (+ 1, 0 = unused).
+  std::vector<HypernodeID> hypernode_map(num_possible_literals + 1, 0);
 
   std::string line;
   // parse hyperedges
-  for (uint32_t i = 0; i < num_clauses; ++i) {
+  for (uint64_t i = 0; i < num_clauses; ++i) {
     std::getline(cnf_file, line);
-    std::istringstream line_stream(line);
-    while (line_stream >> literal) {
-      if (literal != 0) {
-        if (literal_to_hypernode.find(literal) == literal_to_hypernode.end()) {
-          ++num_hypernodes;
-          literal_to_hypernode[literal] = num_hypernodes;
-        }
-        hyperedges[i].push_back(literal_to_hypernode[literal]);
-      }
+    bool empty = true;
+    forEachLiteral(line, [&](const int64_t literal) {
+          const uint64_t variable = std::abs(literal);
+          ALWAYS_ASSERT(variable <= num_variables, V(variable));
+          const uint64_t index = literal_representation ?
+                                 (literal > 0 ? 2 * variable - 1 : 2 * variable) : variable;
+          if (hypernode_map[index] == 0) {
+            hypernode_map[index] = ++num_hypernodes;
+          }
+          writer.addPin(hypernode_map[index] - 1);
+          empty = false;
+        });
+    if (empty) {
+      return false;
     }
+    writer.finishHyperedge();
   }
-  LOG << V(literal_to_hypernode.size());
-  writeHGRFile(hyperedges, num_clauses, num_hypernodes, hgr_target_filename);
+  return true;
 }
 
-template <typename T>
-static inline void convertToT(std::ifstream& cnf_file,
-                              const uint64_t num_variables,
-                              const uint64_t num_clauses,
-                              const std::string& hgr_target_filename) {
-  uint64_t num_hyperedges = 0;
-  if (std::is_same<T, PrimalRepresentationTag>::value) {
-    num_hyperedges = num_clauses;
-  } else if (std::is_same<T, DualRepresentationTag>::value) {
-    num_hyperedges = num_variables;
-  }
-
-  Hyperedges hyperedges(num_hyperedges);
-  std::unordered_map<uint64_t, uint64_t> hypernode_map;
+// Dual representation: the clauses containing each variable are obtained
+// via an external sort of the (variable, clause) pairs.
+static inline void writeVariableHyperedges(std::istream& cnf_file,
+                                           const uint64_t num_variables,
+                                           const uint64_t num_clauses,
+                                           const std::string& hgr_target_filename,
+                                           kahypar::streaming::StreamingHypergraphWriter& writer,
+                                           const size_t memory_limit) {
+  std::vector<HyperedgeID> hyperedge_map(num_variables + 1, 0);
+  HyperedgeID num_hyperedges = 0;
+  kahypar::streaming::ExternalSorter clauses(hgr_target_filename + ".clauses", memory_limit);
 
-  int64_t literal = 0;
-  uint64_t num_hypernodes = 0;
   std::string line;
-  // parse hyperedges
-  for (uint32_t i = 0; i < num_clauses; ++i) {
+  for (uint64_t i = 0; i < num_clauses; ++i) {
     std::getline(cnf_file, line);
-    std::istringstream line_stream(line);
-    while (line_stream >> literal) {
-      if (literal != 0) {
-        const uint64_t variable = std::abs(literal);
-        ALWAYS_ASSERT(variable <= num_variables, V(variable));
-        if (hypernode_map.find(variable) == hypernode_map.end()) {
-          ++num_hypernodes;
-          hypernode_map[variable] = num_hypernodes;
-        }
-        if (std::is_same<T, PrimalRepresentationTag>::value) {
-          hyperedges[i].push_back(hypernode_map[variable]);
-        } else if (std::is_same<T, DualRepresentationTag>::value) {
-          // internally HE-IDs start with 0, while HN-IDs start with 1
-          hyperedges[hypernode_map[variable] - 1].push_back(i + 1);
-        }
-      }
-    }
+    forEachLiteral(line, [&](const int64_t literal) {
+          const uint64_t variable = std::abs(literal);
+          ALWAYS_ASSERT(variable <= num_variables, V(variable));
+          if (hyperedge_map[variable] == 0) {
+            hyperedge_map[variable] = ++num_hyperedges;
+          }
+          clauses.push(hyperedge_map[variable] - 1, i);
+        });
   }
+  std::vector<HyperedgeID>().swap(hyperedge_map);
 
-  // in dual representation, the number of hypernodes equals the number of clauses
-  if (std::is_same<T, DualRepresentationTag>::value) {
-    num_hypernodes = num_clauses;
-    // since hyperedges corresponding to unused variable ids might be empty,
-    // we adjust the number of hyperedges accordingly
-    for (const auto& hyperedge : hyperedges) {
-      if (hyperedge.empty()) {
-        --num_hyperedges;
-      }
-    }
+  // Hyperedges corresponding to unused variable ids are omitted.
+  abortOnError(clauses.sort());
+  kahypar::streaming::ExternalSorter::Entry entry;
+  bool has_entry = clauses.next(entry);
+  while (has_entry) {
+    const uint32_t hyperedge = entry.key;
+    do {
+      writer.addPin(entry.value);
+      has_entry = clauses.next(entry);
+    } while (has_entry && entry.key == hyperedge);
+    writer.finishHyperedge();
   }
-
-  writeHGRFile(hyperedges, num_hyperedges, num_hypernodes, hgr_target_filename);
 }
 
 static inline void convertInstance(const std::string& cnf_source_filename,
                                    const std::string& hgr_target_filename,
-                                   const HypergraphRepresentation& representation) {
-  std::ifstream cnf_file(cnf_source_filename);
+                                   const HypergraphRepresentation& representation,
+                                   const size_t memory_limit =
+                                     kahypar::streaming::kDefaultMemoryLimit) {
+  kahypar::io::InputFileStream cnf_file(cnf_source_filename);
 
   std::string line;
   std::getline(cnf_file, line);
@@ -233,17 +235,36 @@ static inline void convertInstance(const std::string& cnf_source_filename,
   LOG << V(num_variables);
   LOG << V(num_clauses);
 
-  switch (representation) {
-    case HypergraphRepresentation::Primal:
-      convertToT<PrimalRepresentationTag>(cnf_file, num_variables, num_clauses,
-                                          hgr_target_filename);
-      break;
-    case HypergraphRepresentation::Dual:
-      convertToT<DualRepresentationTag>(cnf_file, num_variables, num_clauses,
-                                        hgr_target_filename);
-      break;
-    case HypergraphRepresentation::Literal:
-      convertToLiteral(cnf_file, num_variables, num_clauses, hgr_target_filename);
+  bool success = true;
+  {
+    kahypar::streaming::StreamingHypergraphWriter writer(
+      hgr_target_filename, kahypar::streaming::outputFormatFromFilename(hgr_target_filename),
+      memory_limit / 2);
+    abortOnError(writer.open());
+    HypernodeID num_hypernodes = 0;
+    switch (representation) {
+      case HypergraphRepresentation::Primal:
+        success = writeClauseHyperedges<PrimalRepresentationTag>(cnf_file, num_variables,
+                                                                 num_clauses, writer,
+                                                                 num_hypernodes);
+        break;
+      case HypergraphRepresentation::Dual:
+        writeVariableHyperedges(cnf_file, num_variables, num_clauses, hgr_target_filename,
+                                writer, memory_limit / 2);
+        // in dual representation, the number of hypernodes equals the number of clauses
+        num_hypernodes = num_clauses;
+        break;
+      case HypergraphRepresentation::Literal:
+        success = writeClauseHyperedges<LiteralRepresentationTag>(cnf_file, num_variables,
+                                                                  num_clauses, writer,
+                                                                  num_hypernodes);
+    }
+    if (success) {
+      abortOnError(writer.close(num_hypernodes));
+    }
+  }
+  if (!success) {
+    abortOnEmptyHyperedge(hgr_target_filename);
   }
   cnf_file.close();
 }
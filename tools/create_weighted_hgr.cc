@@ -18,6 +18,8 @@
  *
 ******************************************************************************/
 
+#include <thread>
+
 #include "kahypar/definitions.h"
 #include "kahypar/io/hypergraph_io.h"
 
@@ -41,7 +43,7 @@ int main(int argc, char* argv[]) {
 
   hypergraph.setType(Hypergraph::Type::EdgeWeights);
 
-  io::writeHypergraphFile(hypergraph, out_hgr_filename);
+  io::writeHypergraphFile(hypergraph, out_hgr_filename, std::thread::hardware_concurrency());
 
 
   return 0;
@@ -18,12 +18,16 @@
  *
  ******************************************************************************/
 
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 
+#include "kahypar/io/gzip_file_reader.h"
 #include "kahypar/macros.h"
+#include "tools/streaming_conversion.h"
 
 void parseHeader(std::string& header_line, int& num_nodes, int& num_edges) {
   std::istringstream line_stream(header_line);
@@ -31,16 +35,17 @@ void parseHeader(std::string& header_line, int& num_nodes, int& num_edges) {
 }
 
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cout << "No .mtx file specified" << std::endl;
+  if (argc != 2 && argc != 3) {
+    std::cout << "Usage: GraphToHgr <graph file> [output file (.hgr or .bin)]" << std::endl;
+    exit(0);
   }
   std::string graph_filename(argv[1]);
-  std::string hgr_filename(graph_filename + ".hgr");
+  std::string hgr_filename(argc == 3 ? argv[2] : graph_filename + ".hgr");
   std::cout << "Converting graph " << graph_filename << " to HGR hypergraph format: "
             << hgr_filename << "..." << std::endl;
 
   std::string line;
-  std::ifstream in_stream(graph_filename.c_str());
+  kahypar::io::InputFileStream in_stream(graph_filename);
   std::getline(in_stream, line);
 
   int num_nodes = -1;
@@ -48,20 +53,32 @@ int main(int argc, char* argv[]) {
   parseHeader(line, num_nodes, num_edges);
   ALWAYS_ASSERT(num_nodes > 0 && num_edges > 0, V(num_nodes) << V(num_edges));
 
-  std::ofstream out_stream(hgr_filename.c_str());
-  out_stream << num_edges << " " << num_nodes << std::endl;
-  for (int i = 1; i <= num_nodes; ++i) {
+  // each edge is written as soon as it is parsed
+  kahypar::streaming::StreamingHypergraphWriter writer(
+    hgr_filename, kahypar::streaming::outputFormatFromFilename(hgr_filename));
+  kahypar::io::IOStatus status = writer.open();
+  for (int i = 1; i <= num_nodes && status.ok(); ++i) {
     std::getline(in_stream, line);
-    std::istringstream line_stream(line);
-    int node;
-    while (line_stream >> node) {
+    const char* pos = line.c_str();
+    char* end = nullptr;
+    for (int64_t node = std::strtoll(pos, &end, 10); end != pos;
+         node = std::strtoll(pos, &end, 10)) {
+      pos = end;
       if (node > i) {
-        out_stream << i << " " << node << std::endl;
+        writer.addPin(i - 1);
+        writer.addPin(node - 1);
+        writer.finishHyperedge();
       }
     }
   }
   in_stream.close();
-  out_stream.close();
+  if (status.ok()) {
+    status = writer.close(num_nodes);
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    return -1;
+  }
   std::cout << " ... done!" << std::endl;
   return 0;
 }
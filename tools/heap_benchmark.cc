@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+// Microbenchmark comparing the binary heap with d-ary heaps on an FM-like
+// workload (bulk insertion, many gain updates, deleteMax until empty).
+// For each heap size, one RESULT line per heap variant is printed, which
+// allows to determine the crossover points between the implementations.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/d_ary_heap.h"
+#include "kahypar/definitions.h"
+
+using namespace kahypar;
+
+struct Operation {
+  HypernodeID hn;
+  Gain delta;
+};
+
+template <typename Heap>
+void runBenchmark(const std::string& name, const HypernodeID num_elements,
+                  const std::vector<Gain>& keys, const std::vector<Operation>& updates) {
+  Heap heap(num_elements);
+  Gain checksum = 0;
+
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  for (HypernodeID hn = 0; hn < num_elements; ++hn) {
+    heap.push(hn, keys[hn]);
+  }
+  const HighResClockTimepoint after_push = std::chrono::high_resolution_clock::now();
+  for (const Operation& op : updates) {
+    heap.updateKeyBy(op.hn, op.delta);
+  }
+  const HighResClockTimepoint after_update = std::chrono::high_resolution_clock::now();
+  while (!heap.empty()) {
+    checksum += heap.topKey();
+    heap.pop();
+  }
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+
+  const std::chrono::duration<double> push_time = after_push - start;
+  const std::chrono::duration<double> update_time = after_update - after_push;
+  const std::chrono::duration<double> pop_time = end - after_update;
+  const std::chrono::duration<double> total_time = end - start;
+
+  std::cout << "RESULT heap=" << name
+            << " n=" << num_elements
+            << " updates=" << updates.size()
+            << " push=" << push_time.count()
+            << " update=" << update_time.count()
+            << " pop=" << pop_time.count()
+            << " total=" << total_time.count()
+            << " checksum=" << checksum
+            << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 3) {
+    std::cout << "Usage: HeapBenchmark [max_log2_size (default: 22)] [seed (default: 0)]"
+              << std::endl;
+    exit(1);
+  }
+
+  const int max_log_size = argc > 1 ? std::atoi(argv[1]) : 22;
+  const int seed = argc > 2 ? std::atoi(argv[2]) : 0;
+  std::mt19937 gen(seed);
+
+  for (int log_size = 8; log_size <= max_log_size; log_size += 2) {
+    const HypernodeID num_elements = static_cast<HypernodeID>(1) << log_size;
+    std::uniform_int_distribution<HypernodeID> node_dist(0, num_elements - 1);
+    std::uniform_int_distribution<Gain> key_dist(-1000, 1000);
+    std::uniform_int_distribution<Gain> delta_dist(-10, 10);
+
+    std::vector<Gain> keys(num_elements);
+    for (Gain& key : keys) {
+      key = key_dist(gen);
+    }
+    std::vector<Operation> updates(4 * static_cast<size_t>(num_elements));
+    for (Operation& op : updates) {
+      op = { node_dist(gen), delta_dist(gen) };
+    }
+
+    runBenchmark<ds::BinaryMaxHeap<HypernodeID, Gain> >("binary", num_elements, keys, updates);
+    runBenchmark<ds::DAryMaxHeap<HypernodeID, Gain, 2> >("2-ary", num_elements, keys, updates);
+    runBenchmark<ds::DAryMaxHeap<HypernodeID, Gain, 4> >("4-ary", num_elements, keys, updates);
+    runBenchmark<ds::DAryMaxHeap<HypernodeID, Gain, 8> >("8-ary", num_elements, keys, updates);
+    runBenchmark<ds::DAryMaxHeap<HypernodeID, Gain, 16> >("16-ary", num_elements, keys, updates);
+  }
+  return 0;
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+// Compares the load time of the memory mapped hMetis reader (sequential and
+// parallel) with the previous reader based on std::getline and std::istringstream.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/gzip_file_reader.h"
+#include "kahypar/io/hypergraph_io.h"
+
+using namespace kahypar;
+
+struct HypergraphData {
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_hyperedges = 0;
+  HyperedgeIndexVector index_vector { };
+  HyperedgeVector edge_vector { };
+  HyperedgeWeightVector hyperedge_weights { };
+  HypernodeWeightVector hypernode_weights { };
+
+  bool operator== (const HypergraphData& other) const {
+    return num_hypernodes == other.num_hypernodes && num_hyperedges == other.num_hyperedges &&
+           index_vector == other.index_vector && edge_vector == other.edge_vector &&
+           hyperedge_weights == other.hyperedge_weights &&
+           hypernode_weights == other.hypernode_weights;
+  }
+};
+
+static void readWithStreams(const std::string& filename, HypergraphData& data) {
+  io::InputFileStream file(filename);
+  if (!file) {
+    std::cerr << "Error: File not found: " << filename << std::endl;
+    exit(1);
+  }
+  HypergraphType hypergraph_type = HypergraphType::Unweighted;
+  io::readHGRHeader(file, data.num_hyperedges, data.num_hypernodes, hypergraph_type);
+  const bool has_hyperedge_weights = hypergraph_type == HypergraphType::EdgeWeights ||
+                                     hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+  const bool has_hypernode_weights = hypergraph_type == HypergraphType::NodeWeights ||
+                                     hypergraph_type == HypergraphType::EdgeAndNodeWeights;
+
+  data.index_vector.reserve(static_cast<size_t>(data.num_hyperedges) + 1);
+  data.index_vector.push_back(data.edge_vector.size());
+  std::string line;
+  for (HyperedgeID i = 0; i < data.num_hyperedges; ++i) {
+    std::getline(file, line);
+    std::istringstream line_stream(line);
+    if (has_hyperedge_weights) {
+      HyperedgeWeight edge_weight;
+      line_stream >> edge_weight;
+      data.hyperedge_weights.push_back(edge_weight);
+    }
+    HypernodeID pin;
+    while (line_stream >> pin) {
+      data.edge_vector.push_back(pin - 1);
+    }
+    data.index_vector.push_back(data.edge_vector.size());
+  }
+  if (has_hypernode_weights) {
+    for (HypernodeID i = 0; i < data.num_hypernodes; ++i) {
+      std::getline(file, line);
+      std::istringstream line_stream(line);
+      HypernodeWeight node_weight;
+      line_stream >> node_weight;
+      data.hypernode_weights.push_back(node_weight);
+    }
+  }
+}
+
+static void readWithMemoryMapping(const std::string& filename, HypergraphData& data,
+                                  const size_t num_threads) {
+  const io::IOStatus status = io::parseHypergraphFile(filename, data.num_hypernodes,
+                                                      data.num_hyperedges, data.index_vector,
+                                                      data.edge_vector, &data.hyperedge_weights,
+                                                      &data.hypernode_weights, num_threads);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    exit(1);
+  }
+}
+
+template <typename Reader>
+static double measure(const Reader& reader, const std::string& filename, HypergraphData& data) {
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  reader(filename, data);
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argc > 3) {
+    std::cout << "Usage: HgrReaderBenchmark <hypergraph.hgr> [repetitions (default: 3)]"
+              << std::endl;
+    exit(1);
+  }
+  const std::string filename(argv[1]);
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 3;
+  const size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  const auto sequential_reader = [](const std::string& file, HypergraphData& data) {
+                                   readWithMemoryMapping(file, data, 1);
+                                 };
+  const auto parallel_reader = [num_threads](const std::string& file, HypergraphData& data) {
+                                 readWithMemoryMapping(file, data, num_threads);
+                               };
+
+  for (int i = 0; i < repetitions; ++i) {
+    HypergraphData stream_data;
+    HypergraphData mmap_data;
+    HypergraphData parallel_data;
+    const double stream_time = measure(readWithStreams, filename, stream_data);
+    const double mmap_time = measure(sequential_reader, filename, mmap_data);
+    const double parallel_time = measure(parallel_reader, filename, parallel_data);
+    std::cout << "RESULT graph=" << filename.substr(filename.find_last_of('/') + 1)
+              << " repetition=" << i
+              << " numHNs=" << mmap_data.num_hypernodes
+              << " numHEs=" << mmap_data.num_hyperedges
+              << " numPins=" << mmap_data.edge_vector.size()
+              << " stream_time=" << stream_time
+              << " mmap_time=" << mmap_time
+              << " speedup=" << stream_time / mmap_time
+              << " threads=" << num_threads
+              << " parallel_time=" << parallel_time
+              << " parallel_speedup=" << stream_time / parallel_time
+              << " identical=" << std::boolalpha
+              << (stream_data == mmap_data && stream_data == parallel_data)
+              << std::endl;
+  }
+  return 0;
+}
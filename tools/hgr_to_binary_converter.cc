@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2016 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+// Converts a hypergraph in hMetis format into the binary format, which
+// KaHyPar loads via mmap without parsing.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/macros.h"
+
+using namespace kahypar;
+
+int main(int argc, char* argv[]) {
+  if (argc != 2 && argc != 3) {
+    std::cout << "No .hgr file specified" << std::endl;
+    std::cout << "Usage: HgrToBinary <.hgr> [outfile (default: <.hgr>.bin)]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const std::string out_filename(argc == 3 ? argv[2] : hgr_filename + ".bin");
+
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  const Hypergraph hypergraph(
+    io::createHypergraphFromFile(hgr_filename, 2, std::thread::hardware_concurrency()));
+  const HighResClockTimepoint parsed = std::chrono::high_resolution_clock::now();
+
+  const io::IOStatus status = io::writeBinaryHypergraphFile(hypergraph, out_filename);
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    exit(1);
+  }
+
+  const HighResClockTimepoint written = std::chrono::high_resolution_clock::now();
+  const Hypergraph loaded(io::createHypergraphFromFile(out_filename, 2));
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+
+  std::cout << "RESULT graph=" << hgr_filename.substr(hgr_filename.find_last_of('/') + 1)
+            << " numHNs=" << loaded.initialNumNodes()
+            << " numHEs=" << loaded.initialNumEdges()
+            << " numPins=" << loaded.initialNumPins()
+            << " hgr_time=" << std::chrono::duration<double>(parsed - start).count()
+            << " write_time=" << std::chrono::duration<double>(written - parsed).count()
+            << " binary_time=" << std::chrono::duration<double>(end - written).count()
+            << std::endl;
+  return 0;
+}
@@ -24,6 +24,7 @@
 #include <string>
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/buffered_writer.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/macros.h"
 
@@ -38,12 +39,15 @@ int main(int argc, char* argv[]) {
 
   Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, 2));
 
-  std::ofstream out_stream(graphml_filename.c_str());
+  kahypar::io::BufferedWriter out_stream;
+  if (!kahypar::io::openOutputFile(out_stream, graphml_filename).ok()) {
+    return 1;
+  }
 
   // Vertices: hypernodes + hyperedges
   // Edges: One edge for each pin!
 
-  out_stream << hypergraph.initialNumNodes() + hypergraph.initialNumEdges() << " " << hypergraph.initialNumPins() << std::endl;
+  out_stream << hypergraph.initialNumNodes() + hypergraph.initialNumEdges() << " " << hypergraph.initialNumPins() << '\n';
 
   for (const HypernodeID& hn : hypergraph.nodes()) {
     // vertex ids start with 1
@@ -51,7 +55,7 @@ int main(int argc, char* argv[]) {
       const HyperedgeID he_id = hypergraph.initialNumNodes() + he + 1;
       out_stream << he_id << " ";
     }
-    out_stream << std::endl;
+    out_stream << '\n';
   }
 
   for (const HyperedgeID& he : hypergraph.edges()) {
@@ -59,10 +63,10 @@ int main(int argc, char* argv[]) {
       const HypernodeID hn_id = pin + 1;
       out_stream << hn_id << " ";
     }
-    out_stream << std::endl;
+    out_stream << '\n';
   }
 
-  out_stream.close();
+  kahypar::io::closeOutputFile(out_stream);
   std::cout << " ... done!" << std::endl;
   return 0;
 }
@@ -23,6 +23,7 @@
 #include <sstream>
 #include <string>
 
+#include "kahypar/io/buffered_writer.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/macros.h"
 #include "tools/hgr_to_edgelist_conversion.h"
@@ -38,12 +39,15 @@ int main(int argc, char* argv[]) {
 
   EdgeVector edges = createEdgeVector(kahypar::io::createHypergraphFromFile(hgr_filename, 2));
 
-  std::ofstream out_stream(graphml_filename.c_str());
+  kahypar::io::BufferedWriter out_stream;
+  if (!kahypar::io::openOutputFile(out_stream, graphml_filename).ok()) {
+    return 1;
+  }
   for (const Edge& edge : edges) {
-    out_stream << edge.src << " " << edge.dest << std::endl;
+    out_stream << edge.src << " " << edge.dest << '\n';
   }
 
-  out_stream.close();
+  kahypar::io::closeOutputFile(out_stream);
   std::cout << "done" << std::endl;
   return 0;
 }
@@ -24,6 +24,7 @@
 #include <string>
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/buffered_writer.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/macros.h"
 
@@ -38,28 +39,31 @@ int main(int argc, char* argv[]) {
 
   Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, 2));
 
-  std::ofstream out_stream(graphml_filename.c_str());
-  out_stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+  kahypar::io::BufferedWriter out_stream;
+  if (!kahypar::io::openOutputFile(out_stream, graphml_filename).ok()) {
+    return 1;
+  }
+  out_stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << '\n';
   out_stream << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\"";
   out_stream << " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"";
   out_stream << " xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns";
   out_stream << " http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">"
-             << std::endl;
-  out_stream << "<graph id=\"G\" edgedefault=\"undirected\">" << std::endl;
+             << '\n';
+  out_stream << "<graph id=\"G\" edgedefault=\"undirected\">" << '\n';
   for (const HypernodeID& hn : hypergraph.nodes()) {
-    out_stream << "<node id=\"n" << hn << "\"/>" << std::endl;
+    out_stream << "<node id=\"n" << hn << "\"/>" << '\n';
   }
   for (const HyperedgeID& he : hypergraph.edges()) {
-    out_stream << "<hyperedge>" << std::endl;
+    out_stream << "<hyperedge>" << '\n';
     for (const HypernodeID& pin : hypergraph.pins(he)) {
-      out_stream << "<endpoint node=\"n" << pin << "\"/>" << std::endl;
+      out_stream << "<endpoint node=\"n" << pin << "\"/>" << '\n';
     }
-    out_stream << "</hyperedge>" << std::endl;
+    out_stream << "</hyperedge>" << '\n';
   }
 
-  out_stream << "</graph>" << std::endl;
-  out_stream << "</graphml>" << std::endl;
-  out_stream.close();
+  out_stream << "</graph>" << '\n';
+  out_stream << "</graphml>" << '\n';
+  kahypar::io::closeOutputFile(out_stream);
   std::cout << " ... done!" << std::endl;
   return 0;
 }
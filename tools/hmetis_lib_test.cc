@@ -24,7 +24,7 @@
 
 extern "C" void HMETIS_PartRecursive(int, int, int*, int*, int*, int*, int, int, int*, int*, int*);
 
-int main(int argn, char** argv) {
+int main() {
   std::vector<int> a { 0, 2, 6, 9,  /*sentinel*/ 12 };
   std::vector<int> b { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 };
   int cut;
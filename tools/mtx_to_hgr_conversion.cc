@@ -18,16 +18,21 @@
  *
  ******************************************************************************/
 
+#include <cstdlib>
+#include <iostream>
 #include <sstream>
 #include <string>
 
+#include "kahypar/io/buffered_writer.h"
+#include "kahypar/io/gzip_file_reader.h"
 #include "kahypar/macros.h"
 #include "tools/mtx_to_hgr_conversion.h"
+#include "tools/streaming_conversion.h"
 
 namespace mtxconversion {
 static constexpr bool debug = false;
 
-MatrixInfo parseHeader(std::ifstream& file) {
+MatrixInfo parseHeader(std::istream& file) {
   std::string line;
   std::getline(file, line);
   std::istringstream sstream(line);
@@ -59,7 +64,7 @@ MatrixInfo parseHeader(std::ifstream& file) {
   return info;
 }
 
-void parseDimensionInformation(std::ifstream& file, MatrixInfo& info) {
+void parseDimensionInformation(std::istream& file, MatrixInfo& info) {
   std::string line;
   std::getline(file, line);
   // skip any comments
@@ -73,7 +78,7 @@ void parseDimensionInformation(std::ifstream& file, MatrixInfo& info) {
   LOG << "num_entries=" << info.num_entries;
 }
 
-void parseMatrixEntries(std::ifstream& file, MatrixInfo& info, MatrixData& matrix_data) {
+void parseMatrixEntries(std::istream& file, MatrixInfo& info, MatrixData& matrix_data) {
   // row-net representation
   matrix_data.resize(info.num_rows);
 
@@ -84,7 +89,7 @@ void parseMatrixEntries(std::ifstream& file, MatrixInfo& info, MatrixData& matri
   }
 }
 
-void parseCoordinateMatrixEntries(std::ifstream& file, MatrixInfo& info,
+void parseCoordinateMatrixEntries(std::istream& file, MatrixInfo& info,
                                   MatrixData& matrix_data) {
   std::string line;
   int row = -1;
@@ -124,8 +129,11 @@ void parseCoordinateMatrixEntries(std::ifstream& file, MatrixInfo& info,
 
 void writeMatrixInHgrFormat(const MatrixInfo& info, const MatrixData& matrix_data,
                             const std::string& filename) {
-  std::ofstream out_stream(filename.c_str());
-  out_stream << info.num_rows << " " << info.num_columns << std::endl;
+  kahypar::io::BufferedWriter out_stream;
+  if (!kahypar::io::openOutputFile(out_stream, filename).ok()) {
+    return;
+  }
+  out_stream << info.num_rows << " " << info.num_columns << '\n';
   for (const auto& hyperedge : matrix_data) {
     if (hyperedge.size() != 0) {
       for (auto pin_iter = hyperedge.begin(); pin_iter != hyperedge.end(); ++pin_iter) {
@@ -135,20 +143,72 @@ void writeMatrixInHgrFormat(const MatrixInfo& info, const MatrixData& matrix_dat
           out_stream << " ";
         }
       }
-      out_stream << std::endl;
+      out_stream << '\n';
     }
   }
-  out_stream.close();
+  kahypar::io::closeOutputFile(out_stream);
 }
 
 void convertMtxToHgr(const std::string& matrix_filename, const std::string& hypergraph_filename) {
-  std::ifstream mtx_file(matrix_filename);
-  MatrixInfo info = parseHeader(mtx_file);
+  convertMtxToHgr(matrix_filename, hypergraph_filename, kahypar::streaming::kDefaultMemoryLimit);
+}
 
+void convertMtxToHgr(const std::string& matrix_filename, const std::string& hypergraph_filename,
+                     const size_t memory_limit) {
+  kahypar::io::InputFileStream mtx_file(matrix_filename);
+  MatrixInfo info = parseHeader(mtx_file);
   parseDimensionInformation(mtx_file, info);
-  MatrixData matrix_data;
-  parseMatrixEntries(mtx_file, info, matrix_data);
+
+  // The entries are sorted by row to obtain the row-net representation. Since
+  // the sort is stable, the pins of each row remain in input order.
+  kahypar::streaming::ExternalSorter entries(hypergraph_filename + ".rows",
+                                               memory_limit / 2);
+  std::string line;
+  for (int i = 0; i < info.num_entries; ++i) {
+    std::getline(mtx_file, line);
+    DBG << line;
+    char* pos = nullptr;
+    // indices start at 1
+    const int row = static_cast<int>(std::strtol(line.c_str(), &pos, 10)) - 1;
+    const int column = static_cast<int>(std::strtol(pos, nullptr, 10)) - 1;
+    entries.push(row, column);
+    if (info.symmetry == MatrixSymmetry::SYMMETRIC && row != column) {
+      entries.push(column, row);
+    }
+  }
   mtx_file.close();
-  writeMatrixInHgrFormat(info, matrix_data, hypergraph_filename);
+
+  kahypar::streaming::StreamingHypergraphWriter writer(
+    hypergraph_filename, kahypar::streaming::outputFormatFromFilename(hypergraph_filename),
+    memory_limit / 2);
+  kahypar::io::IOStatus status = entries.sort();
+  if (status.ok()) {
+    status = writer.open();
+  }
+  if (status.ok()) {
+    kahypar::streaming::ExternalSorter::Entry entry;
+    bool has_entry = entries.next(entry);
+    while (has_entry) {
+      const uint32_t row = entry.key;
+      do {
+        writer.addPin(entry.value);
+        has_entry = entries.next(entry);
+      } while (has_entry && entry.key == row);
+      writer.finishHyperedge();
+    }
+
+    const int num_empty_hyperedges = info.num_rows - static_cast<int>(writer.numHyperedges());
+    if (num_empty_hyperedges > 0) {
+      std::cout << "WARNING: matrix contains " << num_empty_hyperedges << " empty hyperedges"
+                << std::endl;
+      std::cout << "Number of hyperedges in hypergraph will be adjusted!"
+                << std::endl;
+    }
+    status = writer.close(info.num_columns);
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    std::exit(-1);
+  }
 }
 }  // namespace mtxconversion
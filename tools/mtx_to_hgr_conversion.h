@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <fstream>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -38,10 +40,16 @@ struct MatrixInfo {
 
 using MatrixData = std::vector<std::vector<int> >;
 
-MatrixInfo parseHeader(std::ifstream& file);
-void parseDimensionInformation(std::ifstream& file, MatrixInfo& info);
-void parseMatrixEntries(std::ifstream& file, MatrixInfo& info, MatrixData& matrix_data);
-void parseCoordinateMatrixEntries(std::ifstream& file, MatrixInfo& info, MatrixData& matrix_data);
+MatrixInfo parseHeader(std::istream& file);
+void parseDimensionInformation(std::istream& file, MatrixInfo& info);
+void parseMatrixEntries(std::istream& file, MatrixInfo& info, MatrixData& matrix_data);
+void parseCoordinateMatrixEntries(std::istream& file, MatrixInfo& info, MatrixData& matrix_data);
 void writeMatrixInHgrFormat(const MatrixInfo& info, const MatrixData& matrix_data, const std::string& filename);
+
+// Converts the matrix without keeping it in memory. Rows are grouped via an
+// external sort that uses at most memory_limit bytes of buffers. If the
+// hypergraph filename ends in .bin, the binary hypergraph format is written.
 void convertMtxToHgr(const std::string& matrix_filename, const std::string& hypergraph_filename);
+void convertMtxToHgr(const std::string& matrix_filename, const std::string& hypergraph_filename,
+                     const size_t memory_limit);
 }  // namespace mtxconversion
@@ -25,11 +25,12 @@
 #include "tools/mtx_to_hgr_conversion.h"
 
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cout << "No .mtx file specified" << std::endl;
+  if (argc != 2 && argc != 3) {
+    std::cout << "Usage: MtxToHgr <.mtx file> [output file (.hgr or .bin)]" << std::endl;
+    exit(0);
   }
   std::string mtx_filename(argv[1]);
-  std::string hgr_filename(mtx_filename + ".hgr");
+  std::string hgr_filename(argc == 3 ? argv[2] : mtx_filename + ".hgr");
   std::cout << "Converting MTX matrix " << mtx_filename << " to HGR hypergraph format: "
             << hgr_filename << "..." << std::endl;
   mtxconversion::convertMtxToHgr(mtx_filename, hgr_filename);
@@ -20,6 +20,10 @@
 
 #include "gtest/gtest.h"
 
+#include <fstream>
+#include <iterator>
+#include <string>
+
 #include "kahypar/definitions.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "tools/mtx_to_hgr_conversion.h"
@@ -88,4 +92,35 @@ TEST(AnMtxToHgrConversionRoutine, AdjustsNumberOfHyperedgesIfEmptyRowsArePresent
   ASSERT_EQ(kahypar::ds::verifyEquivalenceWithoutPartitionInfo(hypergraph,
                                                                correct_hypergraph), true);
 }
+
+TEST(AnMtxToHgrConversionRoutine, WritesSameHypergraphIfEntriesDoNotFitIntoMemory) {
+  std::string mtx_filename("test_instances/LargeSymmetric.mtx");
+  std::ofstream mtx_file(mtx_filename);
+  mtx_file << "%%MatrixMarket matrix coordinate real symmetric\n";
+  mtx_file << "500 500 5000\n";
+  for (int i = 0; i < 5000; ++i) {
+    mtx_file << (i * 7919) % 500 + 1 << " " << (i * 104729) % 500 + 1 << " 1.0\n";
+  }
+  mtx_file.close();
+
+  convertMtxToHgr(mtx_filename, "test_instances/LargeSymmetric.hgr");
+  convertMtxToHgr(mtx_filename, "test_instances/LargeSymmetricSpilled.hgr", 1);
+
+  std::ifstream expected("test_instances/LargeSymmetric.hgr");
+  std::ifstream actual("test_instances/LargeSymmetricSpilled.hgr");
+  ASSERT_EQ(std::string(std::istreambuf_iterator<char>(expected), { }),
+            std::string(std::istreambuf_iterator<char>(actual), { }));
+}
+
+TEST(AnMtxToHgrConversionRoutine, ConvertsMTXMatrixToBinaryFormat) {
+  std::string mtx_filename("test_instances/CoordinateSymmetric.mtx");
+  convertMtxToHgr(mtx_filename, "test_instances/CoordinateSymmetric.hgr");
+  convertMtxToHgr(mtx_filename, "test_instances/CoordinateSymmetric.bin");
+
+  Hypergraph expected = kahypar::io::createHypergraphFromFile(
+    "test_instances/CoordinateSymmetric.hgr", 2);
+  Hypergraph hypergraph = kahypar::io::createHypergraphFromFile(
+    "test_instances/CoordinateSymmetric.bin", 2);
+  ASSERT_EQ(kahypar::ds::verifyEquivalenceWithoutPartitionInfo(hypergraph, expected), true);
+}
 }  // namespace mtxconversion
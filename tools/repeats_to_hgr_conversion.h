@@ -21,7 +21,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <iostream>
+#include <istream>
 #include <map>
 #include <sstream>
 #include <string>
@@ -29,14 +32,13 @@
 
 #include "kahypar/definitions.h"
 #include "kahypar/macros.h"
+#include "tools/streaming_conversion.h"
 
 namespace kahypar {
 namespace phylo {
 static constexpr bool debug = false;
 
-using Hyperedges = std::vector<std::vector<HypernodeID> >;
-
-static inline void convertToHypergraph(std::ifstream& repeats,
+static inline void convertToHypergraph(std::istream& repeats,
                                        const std::string& hgr_target_filename) {
   std::string line;
   std::getline(repeats, line);
@@ -51,7 +53,12 @@ static inline void convertToHypergraph(std::ifstream& repeats,
 
   std::multimap<HypernodeID, HypernodeID> tree_node_induced_hes;
   int identifier = -1;
-  Hyperedges hes;
+  // Hyperedges are written line by line, i.e., only the tree nodes of the
+  // current line are kept in memory.
+  streaming::StreamingHypergraphWriter writer(hgr_target_filename,
+                                              streaming::outputFormatFromFilename(
+                                                hgr_target_filename));
+  io::IOStatus status = writer.open();
   while (std::getline(repeats, line)) {
     int max_identifier = 0;
     std::istringstream line_stream(line);
@@ -65,12 +72,13 @@ static inline void convertToHypergraph(std::ifstream& repeats,
     for (int i = 1; i <= max_identifier; ++i) {
       auto range = tree_node_induced_hes.equal_range(i);
       if (std::distance(range.first, range.second) > 1) {
-        hes.emplace_back();
         DBG << V(i);
         for (auto iter = range.first; iter != range.second; ++iter) {
-          hes.back().push_back(iter->second);
+          ALWAYS_ASSERT(iter->second > 0, V(iter->second));
+          writer.addPin(iter->second - 1);
           DBG << iter->second;
         }
+        writer.finishHyperedge();
         DBG << "";
       }
     }
@@ -78,20 +86,13 @@ static inline void convertToHypergraph(std::ifstream& repeats,
     DBG << "-----";
   }
 
-  std::ofstream out_stream(hgr_target_filename.c_str());
-  out_stream << hes.size() << " " << num_nodes << std::endl;
-  for (const auto& he : hes) {
-    ALWAYS_ASSERT(he.size() > 1, V(he.size()));
-    for (auto pin_iter = he.begin(); pin_iter != he.end(); ++pin_iter) {
-      ALWAYS_ASSERT(*pin_iter > 0, V(*pin_iter));
-      out_stream << *pin_iter;
-      if (pin_iter + 1 != he.end()) {
-        out_stream << " ";
-      }
-    }
-    out_stream << std::endl;
+  if (status.ok()) {
+    status = writer.close(num_nodes);
+  }
+  if (!status.ok()) {
+    std::cerr << "Error: " << status.message() << std::endl;
+    std::exit(-1);
   }
-  out_stream.close();
 }
 }  // namespace phylo
 }  // namespace kahypar
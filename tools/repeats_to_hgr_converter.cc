@@ -21,18 +21,20 @@
 #include <iostream>
 #include <string>
 
+#include "kahypar/io/gzip_file_reader.h"
 #include "kahypar/macros.h"
 #include "tools/repeats_to_hgr_conversion.h"
 
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cout << "No repeats file specified" << std::endl;
+  if (argc != 2 && argc != 3) {
+    std::cout << "Usage: RepeatsToHgr <repeats file> [output file (.hgr or .bin)]" << std::endl;
+    exit(0);
   }
   std::string repeats_filename(argv[1]);
-  std::string hgr_filename(repeats_filename + ".phylo.hgr");
+  std::string hgr_filename(argc == 3 ? argv[2] : repeats_filename + ".phylo.hgr");
   LOG << "Converting Repeats" << repeats_filename << "to HGR hypergraph format:"
       << hgr_filename << "...";
-  std::ifstream repeates_file(repeats_filename);
+  kahypar::io::InputFileStream repeates_file(repeats_filename);
   kahypar::phylo::convertToHypergraph(repeates_file, hgr_filename);
   LOG << "... done!";
   return 0;
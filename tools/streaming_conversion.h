@@ -0,0 +1,513 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/binary_hypergraph_io.h"
+#include "kahypar/io/buffered_writer.h"
+#include "kahypar/io/memory_mapped_file.h"
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace streaming {
+using io::BufferedWriter;
+using io::IOStatus;
+
+// Memory used for buffering by the streaming converters.
+static constexpr size_t kDefaultMemoryLimit = 256 * 1024 * 1024;
+
+enum class OutputFormat : uint8_t {
+  hgr,
+  binary
+};
+
+// Output files ending in .bin are written in the binary hypergraph format.
+static inline OutputFormat outputFormatFromFilename(const std::string& filename) {
+  return filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0 ?
+         OutputFormat::binary : OutputFormat::hgr;
+}
+
+namespace internal {
+// Sequential reader for temporary files written by the streaming converters.
+class TemporaryFileReader {
+ public:
+  TemporaryFileReader() :
+    _fd(-1),
+    _buffer(),
+    _pos(0),
+    _size(0) { }
+
+  TemporaryFileReader(const TemporaryFileReader&) = delete;
+  TemporaryFileReader& operator= (const TemporaryFileReader&) = delete;
+
+  TemporaryFileReader(TemporaryFileReader&& other) :
+    _fd(other._fd),
+    _buffer(std::move(other._buffer)),
+    _pos(other._pos),
+    _size(other._size) {
+    other._fd = -1;
+  }
+
+  TemporaryFileReader& operator= (TemporaryFileReader&&) = delete;
+
+  ~TemporaryFileReader() {
+    if (_fd != -1) {
+      ::close(_fd);
+    }
+  }
+
+  IOStatus open(const std::string& filename, const size_t buffer_size) {
+    _fd = ::open(filename.c_str(), O_RDONLY);
+    if (_fd == -1) {
+      return IOStatus::error("Could not open temporary file " + filename + ": "
+                             + std::strerror(errno));
+    }
+    _buffer.resize(std::max(buffer_size, static_cast<size_t>(4096)));
+    _pos = 0;
+    _size = 0;
+    return IOStatus();
+  }
+
+  // Reads exactly num_bytes. Returns false at the end of the file.
+  bool read(char* data, const size_t num_bytes) {
+    return readSome(data, num_bytes) == num_bytes;
+  }
+
+  // Reads up to num_bytes, which are only fewer at the end of the file.
+  size_t readSome(char* data, const size_t num_bytes) {
+    size_t num_read = 0;
+    while (num_read < num_bytes) {
+      if (_pos == _size && !refill()) {
+        break;
+      }
+      const size_t available = std::min(num_bytes - num_read, _size - _pos);
+      std::memcpy(data + num_read, _buffer.data() + _pos, available);
+      _pos += available;
+      num_read += available;
+    }
+    return num_read;
+  }
+
+ private:
+  bool refill() {
+    ssize_t result = -1;
+    do {
+      result = ::read(_fd, _buffer.data(), _buffer.size());
+    } while (result == -1 && errno == EINTR);
+    _pos = 0;
+    _size = result > 0 ? static_cast<size_t>(result) : 0;
+    return _size > 0;
+  }
+
+  int _fd;
+  std::vector<char> _buffer;
+  size_t _pos;
+  size_t _size;
+};
+}  // namespace internal
+
+// Sorts (key, value) pairs by key using a bounded amount of memory. If the
+// pairs do not fit into memory, sorted runs are written to temporary files
+// and merged afterwards. Pairs with equal keys keep their insertion order.
+class ExternalSorter {
+ public:
+  struct Entry {
+    uint32_t key;
+    uint32_t value;
+  };
+
+  ExternalSorter(const std::string& temporary_prefix, const size_t memory_limit) :
+    _temporary_prefix(temporary_prefix),
+    _max_entries(std::max(memory_limit / sizeof(Entry), static_cast<size_t>(1024))),
+    _entries(),
+    _next(0),
+    _runs(),
+    _readers(),
+    _heap(),
+    _status() { }
+
+  ExternalSorter(const ExternalSorter&) = delete;
+  ExternalSorter& operator= (const ExternalSorter&) = delete;
+
+  ~ExternalSorter() {
+    _readers.clear();
+    for (const std::string& run : _runs) {
+      std::remove(run.c_str());
+    }
+  }
+
+  void push(const uint32_t key, const uint32_t value) {
+    if (_entries.size() == _max_entries) {
+      writeRun();
+    }
+    _entries.push_back({ key, value });
+  }
+
+  // Finishes the input. Afterwards, the sorted pairs can be retrieved via next().
+  IOStatus sort() {
+    if (_runs.empty()) {
+      sortRun();
+      return IOStatus();
+    }
+    if (!_entries.empty()) {
+      writeRun();
+    }
+    std::vector<Entry>().swap(_entries);
+    if (!_status.ok()) {
+      return _status;
+    }
+    const size_t buffer_size = _max_entries * sizeof(Entry) / _runs.size();
+    for (size_t run = 0; run < _runs.size(); ++run) {
+      _readers.emplace_back();
+      const IOStatus status = _readers.back().open(_runs[run], buffer_size);
+      if (!status.ok()) {
+        return status;
+      }
+      pushNextOfRun(run);
+    }
+    return IOStatus();
+  }
+
+  bool next(Entry& entry) {
+    if (_runs.empty()) {
+      if (_next == _entries.size()) {
+        return false;
+      }
+      entry = _entries[_next++];
+      return true;
+    }
+    if (_heap.empty()) {
+      return false;
+    }
+    const HeapElement top = _heap.top();
+    _heap.pop();
+    entry = top.entry;
+    pushNextOfRun(top.run);
+    return true;
+  }
+
+  size_t numRuns() const {
+    return _runs.size();
+  }
+
+ private:
+  struct HeapElement {
+    Entry entry;
+    size_t run;
+
+    // Inverted for std::priority_queue. Runs contain consecutive parts of
+    // the input, so ties are broken by run to keep the sort stable.
+    bool operator< (const HeapElement& other) const {
+      return entry.key > other.entry.key ||
+             (entry.key == other.entry.key && run > other.run);
+    }
+  };
+
+  void sortRun() {
+    std::stable_sort(_entries.begin(), _entries.end(),
+                     [](const Entry& lhs, const Entry& rhs) {
+          return lhs.key < rhs.key;
+        });
+  }
+
+  void writeRun() {
+    sortRun();
+    _runs.push_back(_temporary_prefix + ".run" + std::to_string(_runs.size()) + ".tmp");
+    BufferedWriter writer;
+    IOStatus status = writer.open(_runs.back());
+    if (status.ok()) {
+      writer.write(reinterpret_cast<const char*>(_entries.data()),
+                   _entries.size() * sizeof(Entry));
+      status = writer.close();
+    }
+    if (!status.ok() && _status.ok()) {
+      _status = status;
+    }
+    _entries.clear();
+  }
+
+  void pushNextOfRun(const size_t run) {
+    Entry entry;
+    if (_readers[run].read(reinterpret_cast<char*>(&entry), sizeof(Entry))) {
+      _heap.push({ entry, run });
+    }
+  }
+
+  const std::string _temporary_prefix;
+  const size_t _max_entries;
+  std::vector<Entry> _entries;
+  size_t _next;
+  std::vector<std::string> _runs;
+  std::vector<internal::TemporaryFileReader> _readers;
+  std::priority_queue<HeapElement> _heap;
+  IOStatus _status;
+};
+
+// Writes an unweighted hypergraph hyperedge by hyperedge, without keeping it
+// in memory. Since the header is only known at the end, hyperedges are
+// written to temporary files first, which are combined by close().
+// For the binary format, the incident nets of the hypernodes are computed
+// via an ExternalSorter.
+class StreamingHypergraphWriter {
+ public:
+  StreamingHypergraphWriter(const std::string& filename, const OutputFormat format,
+                            const size_t memory_limit = kDefaultMemoryLimit) :
+    _filename(filename),
+    _format(format),
+    _pins(),
+    _offsets(),
+    _incident_nets(filename + ".nets", memory_limit / 2),
+    _degrees(),
+    _num_hyperedges(0),
+    _num_pins(0),
+    _pins_of_current_hyperedge(0) { }
+
+  StreamingHypergraphWriter(const StreamingHypergraphWriter&) = delete;
+  StreamingHypergraphWriter& operator= (const StreamingHypergraphWriter&) = delete;
+
+  ~StreamingHypergraphWriter() {
+    _pins.close();
+    _offsets.close();
+    std::remove(pinsFilename().c_str());
+    std::remove(offsetsFilename().c_str());
+  }
+
+  IOStatus open() {
+    IOStatus status = _pins.open(pinsFilename());
+    if (status.ok() && _format == OutputFormat::binary) {
+      status = _offsets.open(offsetsFilename());
+      const uint64_t offset = 0;
+      _offsets.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    return status;
+  }
+
+  // Pins are 0-based. A hyperedge is finished via finishHyperedge().
+  void addPin(const HypernodeID pin) {
+    if (_format == OutputFormat::hgr) {
+      if (_pins_of_current_hyperedge > 0) {
+        _pins << ' ';
+      }
+      _pins << pin + 1;
+    } else {
+      _pins.write(reinterpret_cast<const char*>(&pin), sizeof(pin));
+      _incident_nets.push(pin, _num_hyperedges);
+      if (pin >= _degrees.size()) {
+        _degrees.resize(static_cast<size_t>(pin) + 1, 0);
+      }
+      ++_degrees[pin];
+    }
+    ++_pins_of_current_hyperedge;
+  }
+
+  void finishHyperedge() {
+    ASSERT(_pins_of_current_hyperedge > 0, "Hyperedge" << _num_hyperedges << "is empty");
+    _num_pins += _pins_of_current_hyperedge;
+    _pins_of_current_hyperedge = 0;
+    ++_num_hyperedges;
+    if (_format == OutputFormat::hgr) {
+      _pins << '\n';
+    } else {
+      const uint64_t offset = _num_pins;
+      _offsets.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+  }
+
+  template <typename Pins>
+  void addHyperedge(const Pins& pins) {
+    for (const HypernodeID pin : pins) {
+      addPin(pin);
+    }
+    finishHyperedge();
+  }
+
+  HyperedgeID numHyperedges() const {
+    return _num_hyperedges;
+  }
+
+  // Writes the output file for a hypergraph with num_hypernodes hypernodes.
+  IOStatus close(const HypernodeID num_hypernodes) {
+    IOStatus status = _pins.close();
+    if (status.ok()) {
+      status = _offsets.close();
+    }
+    if (!status.ok()) {
+      return status;
+    }
+    return _format == OutputFormat::hgr ? writeHGRFile(num_hypernodes) :
+           writeBinaryFile(num_hypernodes);
+  }
+
+ private:
+  std::string pinsFilename() const {
+    return _filename + ".pins.tmp";
+  }
+
+  std::string offsetsFilename() const {
+    return _filename + ".offsets.tmp";
+  }
+
+  // Appends the content of a temporary file. If checksum is given, the data
+  // is padded to a multiple of 8 bytes and included in the checksum.
+  static IOStatus append(const std::string& filename, BufferedWriter& writer,
+                         io::internal::BinaryChecksum* checksum) {
+    internal::TemporaryFileReader reader;
+    IOStatus status = reader.open(filename, 1024 * 1024);
+    if (!status.ok()) {
+      return status;
+    }
+    std::vector<char> block(1024 * 1024);
+    size_t num_bytes = 0;
+    while ((num_bytes = reader.readSome(block.data(), block.size())) > 0) {
+      if (checksum != nullptr) {
+        const size_t padded_size = io::internal::paddedSize(num_bytes);
+        std::fill(block.begin() + num_bytes, block.begin() + padded_size, 0);
+        num_bytes = padded_size;
+        checksum->update(block.data(), num_bytes);
+      }
+      writer.write(block.data(), num_bytes);
+    }
+    return IOStatus();
+  }
+
+  IOStatus writeHGRFile(const HypernodeID num_hypernodes) {
+    BufferedWriter writer;
+    IOStatus status = writer.open(_filename);
+    if (!status.ok()) {
+      return status;
+    }
+    writer << _num_hyperedges << ' ' << num_hypernodes << '\n';
+    status = append(pinsFilename(), writer, nullptr);
+    if (!status.ok()) {
+      return status;
+    }
+    return writer.close();
+  }
+
+  IOStatus writeBinaryFile(const HypernodeID num_hypernodes) {
+    if (_degrees.size() > num_hypernodes) {
+      return IOStatus::error("Pin " + std::to_string(_degrees.size() - 1) + " exceeds the "
+                             + std::to_string(num_hypernodes) + " hypernodes");
+    }
+    _degrees.resize(num_hypernodes, 0);
+    IOStatus status = _incident_nets.sort();
+    if (!status.ok()) {
+      return status;
+    }
+
+    io::BinaryHypergraphHeader header;
+    std::memcpy(header.magic, io::kBinaryHypergraphMagic, sizeof(header.magic));
+    header.version = io::kBinaryHypergraphVersion;
+    header.type = static_cast<int32_t>(HypergraphType::Unweighted);
+    header.num_hypernodes = num_hypernodes;
+    header.num_hyperedges = _num_hyperedges;
+    header.num_pins = _num_pins;
+    header.checksum = 0;
+
+    io::internal::BinaryChecksum checksum;
+    {
+      BufferedWriter writer;
+      status = writer.open(_filename);
+      if (!status.ok()) {
+        return status;
+      }
+      writer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      status = append(offsetsFilename(), writer, &checksum);
+      if (status.ok()) {
+        status = append(pinsFilename(), writer, &checksum);
+      }
+      if (!status.ok()) {
+        return status;
+      }
+
+      // hypernode offsets
+      uint64_t offset = 0;
+      writer.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+      checksum.update(reinterpret_cast<const char*>(&offset), sizeof(offset));
+      for (const HyperedgeID degree : _degrees) {
+        offset += degree;
+        writer.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        checksum.update(reinterpret_cast<const char*>(&offset), sizeof(offset));
+      }
+      std::vector<HyperedgeID>().swap(_degrees);
+
+      // incident nets, padded to a multiple of 8 bytes
+      ExternalSorter::Entry entry;
+      uint32_t word[2] = { 0, 0 };
+      size_t num_values = 0;
+      while (_incident_nets.next(entry)) {
+        word[num_values++] = entry.value;
+        if (num_values == 2) {
+          writer.write(reinterpret_cast<const char*>(word), sizeof(word));
+          checksum.update(reinterpret_cast<const char*>(word), sizeof(word));
+          num_values = 0;
+        }
+      }
+      if (num_values == 1) {
+        word[1] = 0;
+        writer.write(reinterpret_cast<const char*>(word), sizeof(word));
+        checksum.update(reinterpret_cast<const char*>(word), sizeof(word));
+      }
+      status = writer.close();
+      if (!status.ok()) {
+        return status;
+      }
+    }
+
+    header.checksum = checksum.value();
+    const int fd = ::open(_filename.c_str(), O_WRONLY);
+    if (fd == -1 || pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+      const int error = errno;
+      if (fd != -1) {
+        ::close(fd);
+      }
+      return IOStatus::error("Could not write file " + _filename + ": " + std::strerror(error));
+    }
+    ::close(fd);
+    return IOStatus();
+  }
+
+  const std::string _filename;
+  const OutputFormat _format;
+  BufferedWriter _pins;
+  BufferedWriter _offsets;
+  ExternalSorter _incident_nets;
+  std::vector<HyperedgeID> _degrees;
+  HyperedgeID _num_hyperedges;
+  size_t _num_pins;
+  size_t _pins_of_current_hyperedge;
+};
+}  // namespace streaming
+}  // namespace kahypar
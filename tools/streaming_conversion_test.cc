@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2014 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "tools/streaming_conversion.h"
+
+using ::testing::Test;
+
+namespace kahypar {
+namespace streaming {
+using Entry = ExternalSorter::Entry;
+
+static std::vector<Entry> sortedEntries(const size_t num_entries, const size_t memory_limit,
+                                        size_t& num_runs) {
+  ExternalSorter sorter("test_instances/sorter", memory_limit);
+  for (size_t i = 0; i < num_entries; ++i) {
+    sorter.push((i * 7919) % 100, i);
+  }
+  EXPECT_TRUE(sorter.sort().ok());
+  num_runs = sorter.numRuns();
+  std::vector<Entry> entries;
+  Entry entry;
+  while (sorter.next(entry)) {
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+TEST(AnExternalSorter, SortsStablyInMemory) {
+  size_t num_runs = 0;
+  const std::vector<Entry> entries = sortedEntries(1000, kDefaultMemoryLimit, num_runs);
+  ASSERT_EQ(num_runs, 0);
+  ASSERT_EQ(entries.size(), 1000);
+  for (size_t i = 1; i < entries.size(); ++i) {
+    ASSERT_TRUE(entries[i - 1].key < entries[i].key ||
+                (entries[i - 1].key == entries[i].key &&
+                 entries[i - 1].value < entries[i].value));
+  }
+}
+
+TEST(AnExternalSorter, MergesSortedRunsStably) {
+  size_t num_runs = 0;
+  const std::vector<Entry> entries = sortedEntries(10000, 0, num_runs);
+  ASSERT_GT(num_runs, 1);
+  ASSERT_EQ(entries.size(), 10000);
+  for (size_t i = 1; i < entries.size(); ++i) {
+    ASSERT_TRUE(entries[i - 1].key < entries[i].key ||
+                (entries[i - 1].key == entries[i].key &&
+                 entries[i - 1].value < entries[i].value));
+  }
+}
+
+static void writeHypergraph(const std::string& filename, const size_t memory_limit) {
+  StreamingHypergraphWriter writer(filename, outputFormatFromFilename(filename), memory_limit);
+  ASSERT_TRUE(writer.open().ok());
+  for (HypernodeID i = 0; i < 3000; ++i) {
+    writer.addHyperedge(std::vector<HypernodeID>({ i % 1000, (i * 31 + 1) % 1000 }));
+  }
+  writer.addHyperedge(std::vector<HypernodeID>({ 0, 2, 4, 6 }));
+  ASSERT_EQ(writer.numHyperedges(), 3001);
+  const io::IOStatus status = writer.close(1001);
+  ASSERT_TRUE(status.ok()) << status.message();
+}
+
+TEST(AStreamingHypergraphWriter, WritesSameHypergraphInHGRAndBinaryFormat) {
+  writeHypergraph("test_instances/streamed.hgr", kDefaultMemoryLimit);
+  writeHypergraph("test_instances/streamed.bin", 0);
+
+  Hypergraph expected = io::createHypergraphFromFile("test_instances/streamed.hgr", 2);
+  Hypergraph hypergraph = io::createHypergraphFromFile("test_instances/streamed.bin", 2);
+  ASSERT_EQ(expected.initialNumNodes(), 1001);
+  ASSERT_EQ(expected.initialNumEdges(), 3001);
+  ASSERT_EQ(ds::verifyEquivalenceWithoutPartitionInfo(hypergraph, expected), true);
+}
+
+TEST(AStreamingHypergraphWriter, RemovesTemporaryFiles) {
+  writeHypergraph("test_instances/streamed.bin", 0);
+  ASSERT_FALSE(std::ifstream("test_instances/streamed.bin.pins.tmp").good());
+  ASSERT_FALSE(std::ifstream("test_instances/streamed.bin.offsets.tmp").good());
+  ASSERT_FALSE(std::ifstream("test_instances/streamed.bin.nets.run0.tmp").good());
+}
+
+TEST(AStreamingHypergraphWriter, RejectsPinsExceedingTheNumberOfHypernodes) {
+  StreamingHypergraphWriter writer("test_instances/invalid.bin", OutputFormat::binary);
+  ASSERT_TRUE(writer.open().ok());
+  writer.addHyperedge(std::vector<HypernodeID>({ 0, 5 }));
+  ASSERT_FALSE(writer.close(3).ok());
+}
+}  // namespace streaming
+}  // namespace kahypar